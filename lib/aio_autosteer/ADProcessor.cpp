@@ -2,16 +2,21 @@
 #include "EventLogger.h"
 #include "HardwareManager.h"
 #include "ConfigManager.h"
+#include "TeensyADCSource.h"
 
 // Static instance
 ADProcessor* ADProcessor::instance = nullptr;
 
 ADProcessor::ADProcessor() : 
     wasRaw(0),
+    wasFiltered(0.0f),
+    wasSimulated(false),
+    simulatedWASRaw(0),
     wasOffset(0),
     wasCountsPerDegree(1.0f),
     kickoutAnalogRaw(0),
     pressureReading(0.0f),
+    pressureReadingUs(0),
     motorCurrentRaw(0),
     currentReading(0.0f),
     analogWorkSwitchEnabled(false),
@@ -21,18 +26,40 @@ ADProcessor::ADProcessor() :
     invertWorkSwitch(false),
     debounceDelay(50),  // 50ms default debounce
     lastProcessTime(0),
-    currentBufferIndex(0),
-    teensyADC(nullptr)
+    teensyADC(nullptr),
+    analogSource(nullptr),
+    outputHandler(nullptr),
+    outputContext(nullptr)
 {
     // Initialize switch states
     workSwitch = {false, false, 0, false};
     steerSwitch = {false, false, 0, false};
     
-    // Initialize current buffer
-    for (int i = 0; i < CURRENT_BUFFER_SIZE; i++) {
-        currentBuffer[i] = 0.0f;
+    // Filter chains over the 1kHz scan:
+    // WAS       2:1 decimation + 2-tap average, ~14 bits at 1.5ms delay
+    // Current   5:1 decimation + 10-tap average, the old 50ms window
+    // Pressure  10:1 to 100Hz, median-3 for spikes, then alpha 1/4 low-pass
+    // Work      10:1 to 100Hz, median-3 so a spike cannot flip the switch
+    AnalogFilterConfig wasCfg;
+    wasCfg.decimation = 2;
+    wasCfg.average = 2;
+    AnalogFilterConfig currentCfg;
+    currentCfg.decimation = 5;
+    currentCfg.average = 10;
+    AnalogFilterConfig pressureCfg;
+    pressureCfg.decimation = 10;
+    pressureCfg.median = 3;
+    pressureCfg.iirShift = 2;
+    AnalogFilterConfig workCfg;
+    workCfg.decimation = 10;
+    workCfg.median = 3;
+    filters[SCAN_WAS].configure(wasCfg);
+    filters[SCAN_CURRENT].configure(currentCfg);
+    filters[SCAN_PRESSURE].configure(pressureCfg);
+    filters[SCAN_WORK].configure(workCfg);
+    for (uint8_t i = 0; i < SCAN_CHANNEL_COUNT; i++) {
+        scanTails[i] = 0;
     }
-    currentRunningSum = 0.0f;
     
     // Initialize JD PWM data
     jdPWMMode = false;
@@ -122,30 +149,35 @@ bool ADProcessor::init()
     
     // Register ADC configuration with HardwareManager
     
-    // Register ADC0 config (WAS reading)
-    if (!hwMgr->requestADCConfig(HardwareManager::ADC_MODULE_0, 12, 4, "ADProcessor")) {
+    // Both modules run the background scan; pins go to whichever ADC can
+    // convert them
+    if (!hwMgr->requestADCConfig(HardwareManager::ADC_MODULE_0, 12, ADC_AVERAGING, "ADProcessor")) {
         LOG_WARNING(EventSource::AUTOSTEER, "Failed to register ADC0 configuration");
     }
-    
-    // Register ADC1 config (other sensors)
-    if (!hwMgr->requestADCConfig(HardwareManager::ADC_MODULE_1, 12, 1, "ADProcessor")) {
+    if (!hwMgr->requestADCConfig(HardwareManager::ADC_MODULE_1, 12, ADC_AVERAGING, "ADProcessor")) {
         LOG_WARNING(EventSource::AUTOSTEER, "Failed to register ADC1 configuration");
     }
     
-    // Configure ADC0 for WAS reading - optimized settings
-    teensyADC->adc0->setAveraging(4);                                      // Reduced from 16 for faster reads
-    teensyADC->adc0->setResolution(12);                                    // 12-bit resolution
-    teensyADC->adc0->setConversionSpeed(ADC_CONVERSION_SPEED::HIGH_SPEED); // Faster than MED_SPEED
-    teensyADC->adc0->setSamplingSpeed(ADC_SAMPLING_SPEED::HIGH_SPEED);     // Faster than MED_SPEED
+    // Hardware averaging happens inside each conversion, so it costs ADC
+    // time, not CPU time
+    teensyADC->adc0->setAveraging(ADC_AVERAGING);
+    teensyADC->adc0->setResolution(12);
+    teensyADC->adc0->setConversionSpeed(ADC_CONVERSION_SPEED::MED_SPEED);
+    teensyADC->adc0->setSamplingSpeed(ADC_SAMPLING_SPEED::MED_SPEED);
     
-    // Configure ADC1 for other sensors if needed
-    teensyADC->adc1->setAveraging(1);  // No averaging
+    teensyADC->adc1->setAveraging(ADC_AVERAGING);
     teensyADC->adc1->setResolution(12);
     teensyADC->adc1->setConversionSpeed(ADC_CONVERSION_SPEED::MED_SPEED);
     teensyADC->adc1->setSamplingSpeed(ADC_SAMPLING_SPEED::MED_SPEED);
     
-    // Take initial readings
-    updateWAS();
+    if (!analogSource) {
+        analogSource = new TeensyADCSource(teensyADC);
+    }
+    configureScan();
+    
+    // Take initial readings once a couple of scans are in
+    delay(2 * SCAN_PERIOD_US / 1000 + 1);
+    sampleWAS();
     updateSwitches();
     
     // Clear any initial change flags
@@ -166,36 +198,18 @@ void ADProcessor::process()
 {
     uint32_t now = millis();
     
-    // Update WAS at 200Hz (every 5ms) - more than enough for 100Hz autosteer
-    static uint32_t lastWASUpdate = 0;
-    if (now - lastWASUpdate >= 5) {
-        lastWASUpdate = now;
-        updateWAS();
-    }
-    
-    // Fast current sensor sampling (every 1ms like test sketch)
-    static uint32_t lastCurrentSample = 0;
+    // WAS is sampled by AutosteerProcessor at the start of each control tick
     
-    if (now - lastCurrentSample >= 1) {
-        lastCurrentSample = now;
-        
-        // Read current sensor and store in buffer
-        uint16_t reading = teensyADC->adc1->analogRead(AD_CURRENT_PIN);
-        
-        // Simple approach from test sketch - subtract baseline offset
-        float adjusted = (float)(reading - 77);  // 77 is our baseline
-        float newValue = (adjusted > 0) ? adjusted : 0.0f;
-        
-        // Update running sum by removing old value and adding new value
-        currentRunningSum -= currentBuffer[currentBufferIndex];
-        currentRunningSum += newValue;
-        currentBuffer[currentBufferIndex] = newValue;
-        currentBufferIndex = (currentBufferIndex + 1) % CURRENT_BUFFER_SIZE;
-        
-        // Calculate average from running sum (much faster!)
-        currentReading = currentRunningSum / CURRENT_BUFFER_SIZE;
+    // Current sensor: every scan since the last call, zero subtracted
+    if (filterScan(SCAN_CURRENT, CURRENT_BASELINE) > 0) {
+        currentReading = filters[SCAN_CURRENT].outputCounts();
     }
     
+    // Pressure and analog work switch keep their filters current; the
+    // 100Hz logic below uses the latest outputs
+    filterScan(SCAN_PRESSURE);
+    filterScan(SCAN_WORK);
+    
     // Read other sensors at reduced rate (every 10ms = 100Hz)
     static uint32_t lastSlowRead = 0;
     
@@ -293,39 +307,117 @@ void ADProcessor::process()
             }
         } else {
             // Normal analog pressure sensor mode
-            kickoutAnalogRaw = analogRead(AD_KICKOUT_A_PIN);
+            const AnalogFilter& pressureFilter = filters[SCAN_PRESSURE];
+            kickoutAnalogRaw = pressureFilter.outputRounded();
             
             // Debug current sensor reading
             static uint32_t lastCurrentDebug = 0;
             
             if (millis() - lastCurrentDebug > 2000) {  // Every 2 seconds
                 lastCurrentDebug = millis();
-                LOG_DEBUG(EventSource::AUTOSTEER, "Current sensor: Averaged reading=%.1f (from %d samples)", 
-                          currentReading, CURRENT_BUFFER_SIZE);
+                LOG_DEBUG(EventSource::AUTOSTEER, "Current sensor: Filtered reading=%.1f (%.1fms delay)", 
+                          currentReading, getFilterDelayMs(SCAN_CURRENT));
             }
             
-            // Update pressure sensor reading with filtering
+            // Filtered by the scan filter chain (median + low-pass)
             // Scale 12-bit ADC (0-4095) to match NG-V6 behavior
-            float sensorSample = (float)kickoutAnalogRaw;
-            sensorSample *= 0.15f;  // Scale down to try matching old AIO
-            sensorSample = min(sensorSample, 255.0f);  // Limit to 1 byte (0-255)
-            pressureReading = pressureReading * 0.8f + sensorSample * 0.2f;  // 80/20 filter
+            float sensorSample = pressureFilter.outputCounts();
+            sensorSample *= PRESSURE_SCALE;  // Scale down to try matching old AIO
+            pressureReading = min(sensorSample, 255.0f);  // Limit to 1 byte (0-255)
         }
+        pressureReadingUs = micros();
     }
     
     lastProcessTime = millis();
 }
 
-void ADProcessor::updateWAS()
+void ADProcessor::sampleWAS()
 {
-    // Read WAS using Teensy ADC library (4 samples averaging)
-    // Use ADC1 like the old firmware
-    wasRaw = teensyADC->adc1->analogRead(AD_WAS_PIN);
+    if (wasSimulated) {
+        wasRaw = simulatedWASRaw;
+        wasFiltered = wasRaw;
+        return;
+    }
+
+    // Run the scans since the last tick through the WAS filter; keep the
+    // last value if the scan stalled
+    if (filterScan(SCAN_WAS) > 0) {
+        const AnalogFilter& wasFilter = filters[SCAN_WAS];
+        wasFiltered = wasFilter.outputCounts();
+        wasRaw = (int16_t)wasFilter.outputRounded();
+    }
     
     // Note: The old firmware applies 3.23x scaling, but in our architecture
     // the calibration (wasOffset and wasCountsPerDegree) handles the scaling
 }
 
+bool ADProcessor::getScannedRaw(uint8_t pin, uint16_t& raw) const
+{
+    int8_t channel = scan.findPin(pin);
+    AnalogSample sample;
+    if (channel < 0 || !scan.latest(channel, sample)) {
+        return false;
+    }
+    raw = sample.value;
+    return true;
+}
+
+uint8_t ADProcessor::filterScan(ScanChannel channel, uint16_t baseline)
+{
+    AnalogSample samples[AnalogRing::SIZE];
+    uint8_t count = scan.ring(channel).readSince(scanTails[channel], samples, AnalogRing::SIZE);
+    uint8_t outputs = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        uint16_t value = samples[i].value > baseline ? samples[i].value - baseline : 0;
+        if (filters[channel].push(value)) {
+            outputs++;
+            if (outputHandler) {
+                outputHandler(channel, filters[channel].output(), samples[i].us, outputContext);
+            }
+        }
+    }
+    return outputs;
+}
+
+void ADProcessor::setFilterOutputHandler(FilterOutputHandler handler, void* context)
+{
+    outputContext = context;
+    outputHandler = handler;
+}
+
+void ADProcessor::setFilterConfig(ScanChannel channel, const AnalogFilterConfig& cfg)
+{
+    if (channel >= SCAN_CHANNEL_COUNT) {
+        return;
+    }
+    filters[channel].configure(cfg);
+    LOG_INFO(EventSource::AUTOSTEER, "Analog filter %d: %.1f bits, %.1fms delay", channel,
+             filters[channel].effectiveBits(12, ADC_AVERAGING), getFilterDelayMs(channel));
+}
+
+float ADProcessor::getFilterDelayMs(ScanChannel channel) const
+{
+    // Conversion happens at the end of the scan slot, so only the filter counts
+    return filters[channel].groupDelaySamples() * SCAN_PERIOD_US / 1000.0f;
+}
+
+void ADProcessor::configureScan()
+{
+    // Only convert what the current modes use
+    scan.setChannel(SCAN_WAS, AD_WAS_PIN, true);
+    scan.setChannel(SCAN_CURRENT, AD_CURRENT_PIN, true);
+    scan.setChannel(SCAN_PRESSURE, AD_KICKOUT_A_PIN, !jdPWMMode);
+    scan.setChannel(SCAN_WORK, AD_WORK_PIN, analogWorkSwitchEnabled);
+    
+    if (!scan.start(analogSource, SCAN_PERIOD_US)) {
+        LOG_ERROR(EventSource::AUTOSTEER, "Analog scan failed to start (%s)",
+                  analogSource ? analogSource->getName() : "no source");
+        return;
+    }
+    LOG_DEBUG(EventSource::AUTOSTEER, "Analog scan: %d channels every %luus (%s)",
+              scan.getActiveCount(), scan.getPeriodUs(), analogSource->getName());
+}
+
 void ADProcessor::updateSwitches()
 {
     // Simple digital read - just like old firmware
@@ -333,8 +425,8 @@ void ADProcessor::updateSwitches()
     
     bool workRaw;
     if (analogWorkSwitchEnabled) {
-        // Read analog value
-        workSwitchAnalogRaw = teensyADC->adc1->analogRead(AD_WORK_PIN);
+        // Filtered background scan of the work input
+        workSwitchAnalogRaw = filters[SCAN_WORK].outputRounded();
         
         // Convert to percentage (0-100%)
         float currentPercent = getWorkSwitchAnalogPercent();
@@ -418,7 +510,7 @@ float ADProcessor::getWASAngle() const
     
     // Use raw ADC value directly (no 3.23x scaling here)
     // The counts per degree from AgOpenGPS already accounts for the scaling
-    float centeredWAS = wasRaw - 2048.0f - wasOffset;
+    float centeredWAS = wasFiltered - 2048.0f - wasOffset;
     
     // Calculate angle
     if (wasCountsPerDegree != 0) {
@@ -450,7 +542,7 @@ float ADProcessor::getWASVoltage() const
     // This divides by 2: 0-5V sensor -> 0-2.5V ADC
     // ADC voltage = (wasRaw * 3.3V) / 4095
     // Sensor voltage = ADC voltage * 2
-    float adcVoltage = (wasRaw * 3.3f) / 4095.0f;
+    float adcVoltage = (wasFiltered * 3.3f) / 4095.0f;
     return adcVoltage * 2.0f;  // Account for voltage divider
 }
 
@@ -479,7 +571,7 @@ void ADProcessor::printStatus() const
     
     // WAS information
     LOG_INFO(EventSource::AUTOSTEER, "WAS (Wheel Angle Sensor):");
-    LOG_INFO(EventSource::AUTOSTEER, "  Raw ADC: %d", wasRaw);
+    LOG_INFO(EventSource::AUTOSTEER, "  Raw ADC: %d (filtered %.2f)", wasRaw, wasFiltered);
     LOG_INFO(EventSource::AUTOSTEER, "  Voltage: %.3fV", getWASVoltage());
     LOG_INFO(EventSource::AUTOSTEER, "  Angle: %.2f°", getWASAngle());
     LOG_INFO(EventSource::AUTOSTEER, "  Offset: %d", wasOffset);
@@ -505,8 +597,19 @@ void ADProcessor::printStatus() const
     // Configuration
     LOG_INFO(EventSource::AUTOSTEER, "Configuration:");
     LOG_INFO(EventSource::AUTOSTEER, "  Debounce delay: %dms", debounceDelay);
-    LOG_INFO(EventSource::AUTOSTEER, "  ADC resolution: 12-bit");
-    LOG_INFO(EventSource::AUTOSTEER, "  ADC averaging: 16 samples");
+    LOG_INFO(EventSource::AUTOSTEER, "  ADC resolution: 12-bit, hardware averaging: %d", ADC_AVERAGING);
+    LOG_INFO(EventSource::AUTOSTEER, "  Analog scan: %s, %d channels every %luus, %lu overruns",
+             scan.isRunning() ? "running" : "STOPPED", scan.getActiveCount(), scan.getPeriodUs(),
+             analogSource ? analogSource->getOverruns() : 0UL);
+    static const char* const channelNames[SCAN_CHANNEL_COUNT] = {"WAS", "Current", "Pressure", "Work"};
+    for (uint8_t c = 0; c < SCAN_CHANNEL_COUNT; c++) {
+        const AnalogFilter& f = filters[c];
+        const AnalogFilterConfig& cfg = f.getConfig();
+        LOG_INFO(EventSource::AUTOSTEER, "  %-8s /%d median %d avg %d iir 1/%d: %.1f bits, %.1fms delay%s",
+                 channelNames[c], cfg.decimation, cfg.median, cfg.average, 1 << cfg.iirShift,
+                 f.effectiveBits(12, ADC_AVERAGING), getFilterDelayMs((ScanChannel)c),
+                 scan.isChannelEnabled(c) ? "" : " (not scanned)");
+    }
     
     LOG_INFO(EventSource::AUTOSTEER, "=============================");
 }
@@ -521,6 +624,11 @@ void ADProcessor::configureWorkPin()
         pinMode(AD_WORK_PIN, INPUT_PULLUP);    // Digital with pullup
         LOG_INFO(EventSource::AUTOSTEER, "Work switch configured for DIGITAL input");
     }
+    
+    // Add or drop the work input from the scan once it is running
+    if (analogSource) {
+        configureScan();
+    }
 }
 
 void ADProcessor::setAnalogWorkSwitchEnabled(bool enabled)
@@ -531,6 +639,7 @@ void ADProcessor::setAnalogWorkSwitchEnabled(bool enabled)
     configManager.saveAnalogWorkSwitchConfig();
     LOG_INFO(EventSource::AUTOSTEER, "Analog work switch mode saved to EEPROM: %s", 
              enabled ? "ENABLED" : "DISABLED");
+    configureWorkPin();
 }
 
 void ADProcessor::setWorkSwitchSetpoint(float sp)
@@ -591,6 +700,11 @@ void ADProcessor::setJDPWMMode(bool enabled)
             LOG_INFO(EventSource::AUTOSTEER, "JD_ENC: Mode DISABLED - analog pressure mode restored");
         }
     }
+    
+    // Pressure input only converted in analog mode
+    if (analogSource) {
+        configureScan();
+    }
 }
 
 // JD PWM interrupt handlers
@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 #include <ADC.h>
+#include "AnalogScan.h"
+#include "AnalogFilter.h"
 
 /**
  * ADProcessor - Analog/Digital Input Processor for Autosteer
@@ -15,6 +17,11 @@
  *   ADC value at center = 1553 (1.25V/3.3V * 4095)
  * - Work switch input with debouncing
  * - Steer switch input with debouncing
+ *
+ * Analog inputs (WAS, motor current, pressure, analog work switch) are
+ * converted by a 1kHz background scan (AnalogScan) with hardware averaging;
+ * nothing here waits for a conversion. Each input's stream then goes
+ * through its own integer filter chain (AnalogFilter).
  */
 class ADProcessor {
 public:
@@ -39,13 +46,43 @@ public:
     void clearSteerSwitchChange() { steerSwitch.hasChanged = false; }
     
     // WAS readings (Teensy ADC only)
+    void sampleWAS();  // Latest WAS filter output after feeding it the new scans - the autosteer tick (sense stage)
     int16_t getWASRaw() const { return wasRaw; }
+    float getWASFiltered() const { return wasFiltered; }  // Counts, with the resolution the filter gained
     float getWASAngle() const;
     float getWASVoltage() const;
     
+    // Simulated WAS (SimMotorDriver): while enabled sampleWAS() takes the
+    // injected counts instead of reading the ADC
+    void setWASSimulation(bool enabled) { wasSimulated = enabled; }
+    bool isWASSimulated() const { return wasSimulated; }
+    void injectWASRaw(int16_t raw) { simulatedWASRaw = raw; }
+    
+    // Analog acquisition. Defaults to the Teensy ADCs; set another source
+    // (SimAnalogSource) before init()
+    enum ScanChannel : uint8_t { SCAN_WAS, SCAN_CURRENT, SCAN_PRESSURE, SCAN_WORK, SCAN_CHANNEL_COUNT };
+    void setAnalogSource(AnalogSource* source) { analogSource = source; }
+    const AnalogScan& getAnalogScan() const { return scan; }
+    bool getScannedRaw(uint8_t pin, uint16_t& raw) const;  // Latest scan of a pin, false if not scanned
+    
+    // Filter chain per input, run over the scan stream; restarts the filter
+    void setFilterConfig(ScanChannel channel, const AnalogFilterConfig& cfg);
+    const AnalogFilter& getFilter(ScanChannel channel) const { return filters[channel]; }
+    float getFilterDelayMs(ScanChannel channel) const;
+    
+    // Called from process() for every new filter output, with the scan time
+    // of its newest sample; channel is a ScanChannel, value is
+    // counts << AnalogFilter::FRACTION_BITS
+    typedef void (*FilterOutputHandler)(uint8_t channel, uint32_t value, uint32_t us, void* context);
+    void setFilterOutputHandler(FilterOutputHandler handler, void* context);
+    
+    // Filtered pressure counts to the 0-255 PGN 250 scale
+    static constexpr float PRESSURE_SCALE = 0.15f;
+    
     // Kickout sensor readings
     uint16_t getKickoutAnalog() const { return kickoutAnalogRaw; }
     float getPressureReading() const { return pressureReading; }
+    uint32_t getPressureReadingTime() const { return pressureReadingUs; }  // micros() of the last 100Hz update
     uint16_t getMotorCurrent() const { 
         // Return filtered current reading, clamped to positive values
         // We clamp here instead of during filtering to preserve filter state
@@ -100,6 +137,10 @@ private:
     static constexpr uint8_t AD_KICKOUT_D_PIN = 3;     // Digital kickout input - used for JD PWM encoder
     static constexpr uint8_t AD_CURRENT_PIN = A13;     // Motor current sensor (CURRENT_PIN from pcb.h)
     
+    // Background scan
+    static constexpr uint32_t SCAN_PERIOD_US = 1000;   // 1kHz, as the current sensor was sampled
+    static constexpr uint8_t ADC_AVERAGING = 4;        // Hardware averaging per conversion
+    
     // Switch debouncing structure
     struct SwitchState {
         bool currentState;
@@ -113,12 +154,16 @@ private:
     
     // WAS data
     int16_t wasRaw;
+    float wasFiltered;
+    bool wasSimulated;
+    volatile int16_t simulatedWASRaw;
     int16_t wasOffset;
     float wasCountsPerDegree;
     
     // Kickout sensor data
     uint16_t kickoutAnalogRaw;
     float pressureReading;  // Filtered pressure sensor reading
+    uint32_t pressureReadingUs;
     uint16_t motorCurrentRaw;
     float currentReading;   // Filtered current sensor reading
     
@@ -147,17 +192,23 @@ private:
     // Timing
     uint32_t lastProcessTime;
     
-    // Current sensor averaging buffer
-    static constexpr uint8_t CURRENT_BUFFER_SIZE = 50;  // Reduced for faster response
-    float currentBuffer[CURRENT_BUFFER_SIZE];
-    uint8_t currentBufferIndex;
-    float currentRunningSum;  // Running sum to avoid recalculating every time
+    // Current sensor zero, subtracted from every sample before filtering
+    static constexpr uint16_t CURRENT_BASELINE = 77;
     
     // Teensy ADC object
     ADC* teensyADC;
     
+    // Background analog scan
+    AnalogScan scan;
+    AnalogSource* analogSource;
+    AnalogFilter filters[SCAN_CHANNEL_COUNT];
+    uint32_t scanTails[SCAN_CHANNEL_COUNT];     // Ring positions already filtered
+    FilterOutputHandler outputHandler;
+    void* outputContext;
+    
     // Helper methods
-    void updateWAS();
+    void configureScan();
+    uint8_t filterScan(ScanChannel channel, uint16_t baseline = 0);
     bool debounceSwitch(SwitchState& sw, bool rawState);
 };
 
@@ -0,0 +1,128 @@
+// AnalogFilter.cpp - Integer oversampling/decimation filter for one analog input
+#include "AnalogFilter.h"
+#include <math.h>
+
+namespace {
+
+// Keeps the low-pass from stalling short of the input on small steps
+constexpr uint8_t IIR_EXTRA_BITS = 8;
+
+uint8_t clampSetting(uint8_t value, uint8_t low, uint8_t high) {
+    return value < low ? low : (value > high ? high : value);
+}
+
+} // namespace
+
+void AnalogFilter::configure(const AnalogFilterConfig& cfg) {
+    config.decimation = clampSetting(cfg.decimation, 1, MAX_DECIMATION);
+    config.median = cfg.median >= 5 ? 5 : (cfg.median >= 3 ? 3 : 1);
+    config.average = clampSetting(cfg.average, 1, MAX_AVERAGE);
+    config.iirShift = clampSetting(cfg.iirShift, 0, MAX_IIR_SHIFT);
+    reset();
+}
+
+void AnalogFilter::reset() {
+    decimatorSum = 0;
+    decimatorCount = 0;
+    medianIndex = 0;
+    medianCount = 0;
+    averageSum = 0;
+    averageIndex = 0;
+    averageCount = 0;
+    iirState = 0;
+    iirStarted = false;
+    out = 0;
+    valid = false;
+}
+
+bool AnalogFilter::push(uint16_t raw) {
+    decimatorSum += raw;
+    if (++decimatorCount < config.decimation) {
+        return false;
+    }
+
+    // 12-bit counts * 16 still fit the 16-bit stage histories
+    uint16_t x = (uint16_t)(((decimatorSum << FRACTION_BITS) + config.decimation / 2) / config.decimation);
+    decimatorSum = 0;
+    decimatorCount = 0;
+
+    if (config.median > 1) {
+        x = median(x);
+    }
+    if (config.average > 1) {
+        x = average(x);
+    }
+    if (config.iirShift > 0) {
+        x = lowPass(x);
+    }
+
+    out = x;
+    valid = true;
+    return true;
+}
+
+uint16_t AnalogFilter::median(uint16_t x) {
+    medianHistory[medianIndex] = x;
+    medianIndex = (medianIndex + 1) % config.median;
+    if (medianCount < config.median) {
+        medianCount++;
+    }
+
+    // Insertion sort of at most five values
+    uint16_t sorted[MAX_MEDIAN];
+    for (uint8_t i = 0; i < medianCount; i++) {
+        uint16_t v = medianHistory[i];
+        uint8_t j = i;
+        for (; j > 0 && sorted[j - 1] > v; j--) {
+            sorted[j] = sorted[j - 1];
+        }
+        sorted[j] = v;
+    }
+    return sorted[medianCount / 2];
+}
+
+uint16_t AnalogFilter::average(uint16_t x) {
+    if (averageCount < config.average) {
+        averageCount++;
+    } else {
+        averageSum -= averageHistory[averageIndex];
+    }
+    averageHistory[averageIndex] = x;
+    averageSum += x;
+    averageIndex = (averageIndex + 1) % config.average;
+    return (uint16_t)((averageSum + averageCount / 2) / averageCount);
+}
+
+uint16_t AnalogFilter::lowPass(uint16_t x) {
+    uint32_t target = (uint32_t)x << IIR_EXTRA_BITS;
+    if (!iirStarted) {
+        iirState = target;
+        iirStarted = true;
+    } else {
+        iirState = (uint32_t)((int32_t)iirState + (((int32_t)target - (int32_t)iirState) >> config.iirShift));
+    }
+    return (uint16_t)((iirState + (1u << (IIR_EXTRA_BITS - 1))) >> IIR_EXTRA_BITS);
+}
+
+float AnalogFilter::effectiveBits(uint8_t adcBits, uint8_t hardwareAveraging) const {
+    // Averaging n independent samples cuts the noise by sqrt(n), half a bit
+    // per doubling. The low-pass averages (2 - a) / a samples' worth
+    float samples = (float)hardwareAveraging * config.decimation * config.average;
+    if (config.iirShift > 0) {
+        float a = 1.0f / (1 << config.iirShift);
+        samples *= (2.0f - a) / a;
+    }
+    float bits = adcBits + 0.5f * log2f(samples);
+    float limit = (float)(adcBits + FRACTION_BITS);
+    return bits < limit ? bits : limit;
+}
+
+float AnalogFilter::groupDelaySamples() const {
+    // Decimator centre, then each later stage in decimated samples
+    float decimated = (config.median - 1) / 2.0f + (config.average - 1) / 2.0f;
+    if (config.iirShift > 0) {
+        float a = 1.0f / (1 << config.iirShift);
+        decimated += (1.0f - a) / a;
+    }
+    return (config.decimation - 1) / 2.0f + decimated * config.decimation;
+}
@@ -0,0 +1,83 @@
+// AnalogFilter.h - Integer oversampling/decimation filter for one analog input
+// Stages, each optional, run over the raw scan stream in this order:
+//   decimator       boxcar (first-order CIC) sum of N samples, one output per N
+//   median          3 or 5 taps on the decimated stream, removes single spikes
+//   moving average  integer running sum, so it cannot drift like a float sum
+//   low-pass        first order, alpha = 1/2^shift
+// Outputs are fixed point with FRACTION_BITS below the ADC count, so the
+// resolution gained by averaging is kept instead of rounded away.
+//
+// Plain C++ with fixed storage and no Arduino dependencies.
+#ifndef ANALOG_FILTER_H
+#define ANALOG_FILTER_H
+
+#include <stdint.h>
+
+struct AnalogFilterConfig {
+    uint8_t decimation = 1;     // Input samples per output (1-64)
+    uint8_t median = 1;         // Median window: 1 (off), 3 or 5
+    uint8_t average = 1;        // Moving average window in outputs (1-64)
+    uint8_t iirShift = 0;       // Low-pass alpha = 1/2^shift, 0 = off (max 8)
+};
+
+class AnalogFilter {
+public:
+    static constexpr uint8_t FRACTION_BITS = 4;     // Outputs are counts * 16
+    static constexpr uint8_t MAX_DECIMATION = 64;
+    static constexpr uint8_t MAX_MEDIAN = 5;
+    static constexpr uint8_t MAX_AVERAGE = 64;
+    static constexpr uint8_t MAX_IIR_SHIFT = 8;
+
+    AnalogFilter() { reset(); }
+    explicit AnalogFilter(const AnalogFilterConfig& cfg) { configure(cfg); }
+
+    // Out of range settings are clamped; the filter restarts
+    void configure(const AnalogFilterConfig& cfg);
+    const AnalogFilterConfig& getConfig() const { return config; }
+    void reset();
+
+    // Feed one raw sample; true when a new output is ready
+    bool push(uint16_t raw);
+
+    bool hasOutput() const { return valid; }
+    uint32_t output() const { return out; }                 // Counts << FRACTION_BITS
+    float outputCounts() const { return out / (float)(1 << FRACTION_BITS); }
+    uint16_t outputRounded() const { return (uint16_t)((out + (1 << (FRACTION_BITS - 1))) >> FRACTION_BITS); }
+
+    // Resolution with white noise of at least 1 LSB at the input, counting
+    // the ADC's own hardware averaging. The median is counted as no gain
+    float effectiveBits(uint8_t adcBits, uint8_t hardwareAveraging = 1) const;
+
+    // Low-frequency group delay, in input samples
+    float groupDelaySamples() const;
+
+    // Input samples per output
+    uint8_t getDecimation() const { return config.decimation; }
+
+private:
+    AnalogFilterConfig config;
+
+    uint32_t decimatorSum;
+    uint8_t decimatorCount;
+
+    uint16_t medianHistory[MAX_MEDIAN];
+    uint8_t medianIndex;
+    uint8_t medianCount;
+
+    uint16_t averageHistory[MAX_AVERAGE];
+    uint32_t averageSum;
+    uint8_t averageIndex;
+    uint8_t averageCount;
+
+    uint32_t iirState;          // Output << IIR_EXTRA_BITS
+    bool iirStarted;
+
+    uint32_t out;
+    bool valid;
+
+    uint16_t median(uint16_t x);
+    uint16_t average(uint16_t x);
+    uint16_t lowPass(uint16_t x);
+};
+
+#endif // ANALOG_FILTER_H
@@ -0,0 +1,103 @@
+// AnalogScan.cpp - Non-blocking analog acquisition
+#include "AnalogScan.h"
+
+bool AnalogRing::latest(AnalogSample& out) const {
+    uint32_t h = getHead();
+    if (h == 0) {
+        return false;
+    }
+    out = samples[(h - 1) & (SIZE - 1)];
+    return true;
+}
+
+uint8_t AnalogRing::readSince(uint32_t& tail, AnalogSample* out, uint8_t maxCount) const {
+    uint32_t h = getHead();
+    if (h - tail > SIZE - GUARD) {
+        tail = h - (SIZE - GUARD);
+    }
+    uint8_t n = 0;
+    while (tail != h && n < maxCount) {
+        out[n++] = samples[tail & (SIZE - 1)];
+        tail++;
+    }
+    return n;
+}
+
+bool AnalogRing::averageSince(uint32_t& tail, uint16_t& mean, uint8_t* count) const {
+    uint32_t h = getHead();
+    if (h - tail > SIZE - GUARD) {
+        tail = h - (SIZE - GUARD);
+    }
+    uint32_t sum = 0;
+    uint8_t n = 0;
+    for (; tail != h; tail++, n++) {
+        sum += samples[tail & (SIZE - 1)].value;
+    }
+    if (count) {
+        *count = n;
+    }
+    if (n == 0) {
+        return false;
+    }
+    mean = (uint16_t)((sum + n / 2) / n);
+    return true;
+}
+
+void AnalogScan::setChannel(uint8_t channel, uint8_t pin, bool enabled) {
+    if (channel >= MAX_CHANNELS) {
+        return;
+    }
+    channels[channel].pin = pin;
+    channels[channel].enabled = enabled;
+}
+
+bool AnalogScan::start(AnalogSource* src, uint32_t period) {
+    stop();
+    source = src;
+    periodUs = period;
+    if (!source) {
+        return false;
+    }
+
+    uint8_t pins[MAX_CHANNELS];
+    slotCount = 0;
+    for (uint8_t c = 0; c < MAX_CHANNELS; c++) {
+        if (channels[c].enabled) {
+            slotChannel[slotCount] = c;
+            pins[slotCount] = channels[c].pin;
+            slotCount++;
+        }
+    }
+    if (slotCount == 0) {
+        return true;    // Nothing to convert is not an error
+    }
+
+    running = source->start(pins, slotCount, periodUs, onSample, this);
+    return running;
+}
+
+void AnalogScan::stop() {
+    if (source && running) {
+        source->stop();
+    }
+    running = false;
+}
+
+int8_t AnalogScan::findPin(uint8_t pin) const {
+    if (!running) {
+        return -1;
+    }
+    for (uint8_t s = 0; s < slotCount; s++) {
+        if (channels[slotChannel[s]].pin == pin) {
+            return (int8_t)slotChannel[s];
+        }
+    }
+    return -1;
+}
+
+void AnalogScan::onSample(uint8_t slot, uint16_t value, uint32_t us, void* context) {
+    AnalogScan* scan = static_cast<AnalogScan*>(context);
+    if (slot < scan->slotCount) {
+        scan->rings[scan->slotChannel[slot]].push(value, us);
+    }
+}
@@ -0,0 +1,119 @@
+// AnalogScan.h - Non-blocking analog acquisition
+// An AnalogSource converts a fixed list of pins once per scan period and
+// hands every result, timestamped, to AnalogScan - from interrupt context
+// on the board. AnalogScan keeps a short ring per channel, so the loop
+// reads the newest samples (or everything since its last look) without
+// ever waiting for a conversion, and samples are evenly spaced in time
+// whatever the loop is doing.
+//
+// The source is the hardware seam: TeensyADCSource on the board,
+// SimAnalogSource on the host. Plain C++ with fixed storage and no Arduino
+// dependencies.
+#ifndef ANALOG_SCAN_H
+#define ANALOG_SCAN_H
+
+#include <stdint.h>
+#include <atomic>
+
+struct AnalogSample {
+    uint32_t us;            // When the conversion finished
+    uint16_t value;         // Raw counts
+};
+
+class AnalogSource {
+public:
+    typedef void (*SampleHandler)(uint8_t slot, uint16_t value, uint32_t us, void* context);
+
+    static constexpr uint8_t MAX_PINS = 8;
+
+    virtual ~AnalogSource() = default;
+
+    virtual const char* getName() const = 0;
+
+    // Convert pins[0..count) every periodUs. slot is the index into pins;
+    // the handler may run in interrupt context
+    virtual bool start(const uint8_t* pins, uint8_t count, uint32_t periodUs,
+                       SampleHandler handler, void* context) = 0;
+    virtual void stop() = 0;
+
+    // Scans skipped because the previous one was still converting
+    virtual uint32_t getOverruns() const { return 0; }
+};
+
+// One producer (the source) and one consumer (the loop); neither side ever
+// waits. A reader more than a ring behind loses the oldest samples.
+class AnalogRing {
+public:
+    static constexpr uint8_t SIZE = 64;     // Power of two
+
+    void push(uint16_t value, uint32_t us) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        samples[h & (SIZE - 1)].us = us;
+        samples[h & (SIZE - 1)].value = value;
+        head.store(h + 1, std::memory_order_release);   // Publish after the write
+    }
+
+    // Samples pushed so far; a reader keeps its own tail against this
+    uint32_t getHead() const { return head.load(std::memory_order_acquire); }
+
+    // Newest sample, false if nothing has arrived yet
+    bool latest(AnalogSample& out) const;
+
+    // Copies the samples after tail, oldest first, and moves tail up to them
+    uint8_t readSince(uint32_t& tail, AnalogSample* out, uint8_t maxCount) const;
+
+    // Mean of the samples after tail, rounded; false if none arrived
+    bool averageSince(uint32_t& tail, uint16_t& mean, uint8_t* count = nullptr) const;
+
+private:
+    // Samples a late reader gives up so the producer cannot overwrite what
+    // is being copied
+    static constexpr uint8_t GUARD = 4;
+
+    AnalogSample samples[SIZE] = {};
+    std::atomic<uint32_t> head{0};
+};
+
+class AnalogScan {
+public:
+    static constexpr uint8_t MAX_CHANNELS = AnalogSource::MAX_PINS;
+
+    // Channel numbers are the caller's; disabled channels are not converted
+    // and keep whatever their ring last held
+    void setChannel(uint8_t channel, uint8_t pin, bool enabled);
+    bool isChannelEnabled(uint8_t channel) const { return channel < MAX_CHANNELS && channels[channel].enabled; }
+
+    // (Re)start scanning the enabled channels; applies setChannel() changes
+    bool start(AnalogSource* source, uint32_t periodUs);
+    bool restart() { return source ? start(source, periodUs) : false; }
+    void stop();
+
+    bool isRunning() const { return running; }
+    uint32_t getPeriodUs() const { return periodUs; }
+    uint8_t getActiveCount() const { return slotCount; }
+    AnalogSource* getSource() const { return source; }
+
+    const AnalogRing& ring(uint8_t channel) const { return rings[channel < MAX_CHANNELS ? channel : 0]; }
+    bool latest(uint8_t channel, AnalogSample& out) const { return ring(channel).latest(out); }
+
+    // Channel currently converting this pin, or -1
+    int8_t findPin(uint8_t pin) const;
+
+private:
+    struct Channel {
+        uint8_t pin = 0;
+        bool enabled = false;
+    };
+
+    Channel channels[MAX_CHANNELS];
+    AnalogRing rings[MAX_CHANNELS];
+    uint8_t slotChannel[MAX_CHANNELS] = {};
+    uint8_t slotCount = 0;
+    AnalogSource* source = nullptr;
+    uint32_t periodUs = 1000;
+    bool running = false;
+
+    static void onSample(uint8_t slot, uint16_t value, uint32_t us, void* context);
+};
+
+#endif // ANALOG_SCAN_H
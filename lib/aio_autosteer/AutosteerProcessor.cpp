@@ -17,6 +17,7 @@
 
 // External network function
 extern void sendUDPbytes(uint8_t* data, int len);
+extern void sendUDPbytesBroadcast(uint8_t* data, int len);
 
 // External objects and pointers
 extern ConfigManager configManager;
@@ -86,6 +87,8 @@ bool AutosteerProcessor::init() {
     
     // Load steer settings from EEPROM
     configManager.loadSteerSettings();
+    configManager.publishControlConfig();
+    config = &configManager.getControlConfig();
     
     // Update ADProcessor with loaded values
     adProcessor.setWASOffset(configManager.getWasOffset());
@@ -140,8 +143,11 @@ void AutosteerProcessor::initializeFusion() {
         wheelAngleFusionPtr = new WheelAngleFusion();
     }
     
-    // Initialize with sensor interfaces
-    // Note: We need the Keya driver, GNSS, and IMU processors
+    // Geometry and sensor settings before init, which checks what is usable
+    wheelAngleFusionPtr->setConfig(configManager.getFusionConfig());
+    
+    // Initialize with sensor interfaces - the Keya encoder is optional, the
+    // WAS, GNSS and IMU work with any motor type
     KeyaCANDriver* keyaDriver = nullptr;
     if (motorPTR && motorPTR->getType() == MotorDriverType::KEYA_CAN) {
         keyaDriver = static_cast<KeyaCANDriver*>(motorPTR);
@@ -152,15 +158,10 @@ void AutosteerProcessor::initializeFusion() {
     
     if (wheelAngleFusionPtr->init(keyaDriver, gnssProcessorPtr, &imuProcessor)) {
         LOG_INFO(EventSource::AUTOSTEER, "Virtual WAS (VWAS) initialized successfully");
-        
-        // Load fusion config from saved values
-        WheelAngleFusion::Config fusionConfig = wheelAngleFusionPtr->getConfig();
-        fusionConfig.wheelbase = 2.5f;  // Default wheelbase - not yet configurable
-        fusionConfig.countsPerDegree = 100.0f;  // Default counts - not yet configurable
-        wheelAngleFusionPtr->setConfig(fusionConfig);
     } else {
         LOG_ERROR(EventSource::AUTOSTEER, "Failed to initialize Virtual WAS");
         configManager.setINSUseFusion(false);  // Disable VWAS
+        configManager.publishControlConfig();
         delete wheelAngleFusionPtr;
         wheelAngleFusionPtr = nullptr;
     }
@@ -168,7 +169,160 @@ void AutosteerProcessor::initializeFusion() {
 
 void AutosteerProcessor::process() {
     // === 100Hz AUTOSTEER LOOP (called by SimpleScheduler) ===
+    // Sense, compute and actuate run back to back in this one tick, so the
+    // command sent to the motor is always based on a sample taken this tick
+    uint32_t tickStart = micros();
+    sense();
+    // A kickout disarms on the tick it is seen, not the next 100Hz one
+    checkKickout();
+    uint32_t senseDone = micros();
+    // Engage logic, kickouts, PGN 253 and LEDs stay at 100Hz; the control
+    // law runs every tick
+    if (++supervisoryTick >= ticksPer100Hz) {
+        supervisoryTick = 0;
+        compute();
+    } else {
+        computeControl();
+    }
+    uint32_t computeDone = micros();
+    actuate();
+    uint32_t actuateDone = micros();
+
+    timing.senseUs = senseDone - tickStart;
+    timing.computeUs = computeDone - senseDone;
+    timing.actuateUs = actuateDone - computeDone;
+    timing.latencyUs = actuateDone - tickStart;
+    if (timing.latencyUs > timing.maxLatencyUs) {
+        timing.maxLatencyUs = timing.latencyUs;
+    }
+    timing.ticks++;
+
+    if (timing.latencyUs > PIPELINE_BUDGET_US) {
+        timing.overruns++;
+        static uint32_t lastOverrunLog = 0;
+        if (millis() - lastOverrunLog > 5000) {
+            lastOverrunLog = millis();
+            LOG_WARNING(EventSource::AUTOSTEER, "Control tick took %lu us (sense %lu, compute %lu, actuate %lu)",
+                        timing.latencyUs, timing.senseUs, timing.computeUs, timing.actuateUs);
+        }
+    }
+}
+
+void AutosteerProcessor::poll() {
+    // Called every loop; runs a tick on a fixed micros() grid at the
+    // configured control rate
+    uint32_t now = micros();
+    if (now - lastTickUs < tickPeriodUs) {
+        return;
+    }
+    // Keep the grid unless a whole period was missed, then restart it
+    if (now - lastTickUs < 2 * tickPeriodUs) {
+        lastTickUs += tickPeriodUs;
+    } else {
+        lastTickUs = now;
+    }
+    process();
+}
+
+void AutosteerProcessor::applyControlRate(uint16_t rateHz) {
+    if (rateHz == controlRateHz) {
+        return;
+    }
+    controlRateHz = rateHz;
+    tickPeriodUs = 1000000UL / rateHz;
+    ticksPer100Hz = rateHz / SUPERVISORY_RATE_HZ;
+    motorTxDivider = rateHz / MOTOR_TX_RATE_HZ;
+    supervisoryTick = 0;
+    motorTxTick = 0;
+    controller.reset();
+    LOG_INFO(EventSource::AUTOSTEER, "Control loop at %dHz (motor commands every %d ticks)",
+             controlRateHz, motorTxDivider);
+}
+
+void AutosteerProcessor::sense() {
+    // One coherent copy of the steer settings for this tick; PGN 251/252
+    // publish a new one instead of changing values under us
+    config = &configManager.getControlConfig();
+    if (config->version != configVersion) {
+        LOG_DEBUG(EventSource::AUTOSTEER, "Using control config v%lu", config->version);
+        configVersion = config->version;
+        applyControlRate(config->controller.rateHz);
+    }
     
+    // Pull in motor feedback queued since the last tick (Keya heartbeat, valve ready)
+    if (motorPTR) {
+        motorPTR->processFeedback();
+    }
+    
+    // Fresh WAS sample for this tick
+    adProcessor.sampleWAS();
+    
+    // Update Virtual WAS if enabled
+    if (wheelAngleFusionPtr && config->useFusion) {
+        float dt = tickPeriodUs / 1000000.0f;
+        wheelAngleFusionPtr->update(dt);
+    }
+}
+
+void AutosteerProcessor::actuate() {
+    // setPWM() in compute() already drove PWM outputs; CAN and serial drivers
+    // transmit here at MOTOR_TX_RATE_HZ whatever the loop rate
+    if (motorPTR && ++motorTxTick >= motorTxDivider) {
+        motorTxTick = 0;
+        motorPTR->process();
+    }
+}
+
+void AutosteerProcessor::resetPipelineTiming() {
+    timing = PipelineTiming();
+}
+
+void AutosteerProcessor::printPipelineTiming() const {
+    Serial.print("\r\n=== Autosteer Pipeline ===");
+    Serial.printf("\r\nLast tick: sense %lu us, compute %lu us, actuate %lu us",
+                  timing.senseUs, timing.computeUs, timing.actuateUs);
+    Serial.printf("\r\nSample to command: %lu us (max %lu us, budget %lu us)",
+                  timing.latencyUs, timing.maxLatencyUs, PIPELINE_BUDGET_US);
+    Serial.printf("\r\nTicks: %lu, over budget: %lu", timing.ticks, timing.overruns);
+    Serial.printf("\r\nLoop rate: %d Hz, WAS scanned every %lu us", controlRateHz,
+                  adProcessor.getAnalogScan().getPeriodUs());
+    Serial.printf("\r\nMotor commands sent every %d ticks (%d Hz)", motorTxDivider, MOTOR_TX_RATE_HZ);
+    const SteerController::Terms& t = controller.getTerms();
+    Serial.printf("\r\nController: error %.2f, P %.1f, I %.1f, D %.1f, FF %.1f -> %.1f",
+                  t.error, t.p, t.i, t.d, t.ff, t.output);
+    Serial.print("\r\n=========================\r\n");
+}
+
+void AutosteerProcessor::computeControl() {
+    // Always update current angle reading (needed for PGN253 even when autosteer is off)
+    // Get current steering angle - use VWAS if enabled and available
+    if (config->useFusion && wheelAngleFusionPtr && wheelAngleFusionPtr->isHealthy()) {
+        currentAngle = wheelAngleFusionPtr->getFusedAngle();
+    } else {
+        // Fall back to physical WAS
+        currentAngle = adProcessor.getWASAngle();
+    }
+    
+    // Apply Ackerman fix to current angle if it's negative (left turn)
+    actualAngle = currentAngle;
+    if (actualAngle < 0) {
+        float ackermanFix = config->ackermanFix;
+        actualAngle = actualAngle * ackermanFix;
+        
+        // Log Ackerman fix application periodically
+        static uint32_t lastAckermanLog = 0;
+        if (millis() - lastAckermanLog > 5000 && abs(actualAngle) > 1.0f) {
+            lastAckermanLog = millis();
+            LOG_DEBUG(EventSource::AUTOSTEER, "Ackerman fix applied: %.2f° * %.2f = %.2f°", 
+                     currentAngle, ackermanFix, actualAngle);
+        }
+    }
+    
+    // Update motor control
+    updateMotorControl();
+}
+
+void AutosteerProcessor::compute() {
     // Track link state for down detection
     static bool previousLinkState = true;
     bool currentLinkState = QNetworkBase::isConnected();
@@ -180,12 +334,6 @@ void AutosteerProcessor::process() {
     }
     previousLinkState = currentLinkState;
     
-    // Update Virtual WAS if enabled
-    if (wheelAngleFusionPtr && configManager.getINSUseFusion()) {
-        float dt = 10.0f / 1000.0f;  // 10ms = 0.01 seconds (100Hz from SimpleScheduler)
-        wheelAngleFusionPtr->update(dt);
-    }
-    
     // === BUTTON/SWITCH LOGIC ===
     // Static variable for Massey/Fendt/CaseIH button state tracking (needs to persist across cycles)
     static bool lastMasseyEngageState = false;
@@ -201,11 +349,11 @@ void AutosteerProcessor::process() {
     if (millis() - lastConfigLog > 5000) {
         lastConfigLog = millis();
         LOG_DEBUG(EventSource::AUTOSTEER, "Button config: button=%d, switch=%d",
-                  configManager.getSteerButton(), configManager.getSteerSwitch());
+                  config->steerButton, config->steerSwitch);
     }
 
-    if (configManager.getSteerButton() || configManager.getSteerSwitch()) {
-        if (configManager.getSteerButton()) {
+    if (config->steerButton || config->steerSwitch) {
+        if (config->steerButton) {
             // BUTTON MODE - Toggle on press
             static bool lastButtonReading = HIGH;
             bool buttonReading = adProcessor.isSteerSwitchOn() ? LOW : HIGH;  // Convert to active low
@@ -356,8 +504,8 @@ void AutosteerProcessor::process() {
     // If AgOpenGPS has stopped steering, turn off after delay
     // BUT only if not using a physical switch in switch mode OR button mode
     static int switchCounter = 0;
-    bool physicalSwitchActive = configManager.getSteerSwitch() && adProcessor.isSteerSwitchOn();
-    bool buttonModeActive = configManager.getSteerButton();
+    bool physicalSwitchActive = config->steerSwitch && adProcessor.isSteerSwitchOn();
+    bool buttonModeActive = config->steerButton;
 
     if (steerState == 0 && !guidanceActive && !physicalSwitchActive && !buttonModeActive) {
         if (switchCounter++ > 30) {  // 30 * 10ms = 300ms delay
@@ -380,7 +528,7 @@ void AutosteerProcessor::process() {
     
     // Pressure sensor kickout is now handled by KickoutMonitor
     static bool lastPressureSensorState = false;
-    bool currentPressureSensorState = configManager.getPressureSensor();
+    bool currentPressureSensorState = config->pressureSensor;
     if (currentPressureSensorState != lastPressureSensorState) {
         LOG_INFO(EventSource::AUTOSTEER, "Pressure sensor kickout %s", 
                  currentPressureSensorState ? "ENABLED" : "DISABLED");
@@ -408,28 +556,12 @@ void AutosteerProcessor::process() {
         }
     }
     
-    // Track when button/switch is pressed while in kickout
-    static uint32_t kickoutButtonPressTime = 0;
-    static bool kickoutButtonPressed = false;
-    
     // Process motor driver (for serial communication)
     motorDriver.process();
     
-    // Process kickout monitoring
+    // Kickout monitoring runs in its own every-loop task; process()
+    // disarms through checkKickout() each tick
     if (kickoutMonitor) {
-        kickoutMonitor->process();
-        
-        // Check if kickout is active while steering is armed
-        if (kickoutMonitor->hasKickout() && steerState == 0) {
-            // Disarm steering - this will stop the motor
-            steerState = 1;  // Disarmed
-            emergencyStop();
-            LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s - steering disarmed", kickoutMonitor->getReasonString());
-            kickoutButtonPressTime = millis();  // Start grace period for button clear
-            kickoutButtonPressed = false;
-            // Don't clear kickout here - let KickoutMonitor auto-clear when conditions return to normal
-        }
-        
         // Grace period after kickout - allow button/switch to clear it
         if (kickoutMonitor->hasKickout() && steerState == 0 && !kickoutButtonPressed &&
             millis() - kickoutButtonPressTime < 5000) {  // 5 second grace period
@@ -479,32 +611,8 @@ void AutosteerProcessor::process() {
         }
     }
     
-    // Always update current angle reading (needed for PGN253 even when autosteer is off)
-    // Get current steering angle - use VWAS if enabled and available
-    if (configManager.getINSUseFusion() && wheelAngleFusionPtr && wheelAngleFusionPtr->isHealthy()) {
-        currentAngle = wheelAngleFusionPtr->getFusedAngle();
-    } else {
-        // Fall back to physical WAS
-        currentAngle = adProcessor.getWASAngle();
-    }
-    
-    // Apply Ackerman fix to current angle if it's negative (left turn)
-    actualAngle = currentAngle;
-    if (actualAngle < 0) {
-        float ackermanFix = configManager.getAckermanFix();
-        actualAngle = actualAngle * ackermanFix;
-        
-        // Log Ackerman fix application periodically
-        static uint32_t lastAckermanLog = 0;
-        if (millis() - lastAckermanLog > 5000 && abs(actualAngle) > 1.0f) {
-            lastAckermanLog = millis();
-            LOG_DEBUG(EventSource::AUTOSTEER, "Ackerman fix applied: %.2f° * %.2f = %.2f°", 
-                     currentAngle, ackermanFix, actualAngle);
-        }
-    }
-    
-    // Update motor control
-    updateMotorControl();
+    // Angle and motor command (also run on its own between 100Hz ticks)
+    computeControl();
     
     // Note: LOCK output is handled by motor driver enable pin (dual-purpose)
     
@@ -562,7 +670,7 @@ void AutosteerProcessor::sendHelloReply() {
     };
     
     // Send via UDP
-    sendUDPbytes(helloFromSteer, sizeof(helloFromSteer));
+    sendUDPbytesBroadcast(helloFromSteer, sizeof(helloFromSteer));
 }
 
 void AutosteerProcessor::sendScanReply() {
@@ -594,7 +702,7 @@ void AutosteerProcessor::sendScanReply() {
     scanReply[sizeof(scanReply) - 1] = crc;
     
     // Send via UDP
-    sendUDPbytes(scanReply, sizeof(scanReply));
+    sendUDPbytesBroadcast(scanReply, sizeof(scanReply));
 }
 
 void AutosteerProcessor::handleSteerConfig(uint8_t pgn, const uint8_t* data, size_t len) {
@@ -748,9 +856,10 @@ void AutosteerProcessor::handleSteerConfig(uint8_t pgn, const uint8_t* data, siz
     configManager.setMinSpeed(minSpeed);
     configManager.setMotorDriverConfig(motorDriverConfig);
     configManager.setIsUseYAxis(isUseYAxis);  // Save Y-axis swap setting for IMU
+    configManager.publishControlConfig();
     
-    // Note: Sensor configuration updates would go here if we want dynamic changes
-    // For now, sensor changes require reboot to ensure clean state
+    // Sensor changes take effect at once: KickoutMonitor reads these flags
+    // each cycle. A motor change swaps the driver below
     
     // Check for motor type changes
     bool motorTypeChanged = false;
@@ -801,9 +910,35 @@ void AutosteerProcessor::handleSteerConfig(uint8_t pgn, const uint8_t* data, siz
 
 
     if (motorTypeChanged) {
-        LOG_WARNING(EventSource::AUTOSTEER, "Motor type changed - rebooting in 2 seconds...");
-        delay(2000);
-        SCB_AIRCR = 0x05FA0004; // Teensy Reset
+        reconfigureMotorDriver();
+    }
+}
+
+void AutosteerProcessor::reconfigureMotorDriver() {
+    // Steering off while the driver is swapped; the operator re-engages
+    if (motorState != MotorState::DISABLED) {
+        ledManagerFSM.transitionSteerState(LEDManagerFSM::STEER_READY);
+    }
+    motorState = MotorState::DISABLED;
+    motorPWM = 0;
+    steerState = 1;
+    controller.reset();
+    
+    MotorDriverInterface* previousDriver = motorPTR;
+    motorPTR = MotorDriverManager::getInstance()->reconfigure(
+        motorPTR, HardwareManager::getInstance(), CANManager::getInstance());
+    
+    if (kickoutMonitor) {
+        kickoutMonitor->setMotorDriver(motorPTR);
+    }
+    
+    // Fusion may have held the old driver as its motor encoder
+    if (wheelAngleFusionPtr && motorPTR != previousDriver) {
+        initializeFusion();
+    }
+    
+    if (!motorPTR) {
+        LOG_ERROR(EventSource::AUTOSTEER, "No motor driver after reconfiguration - steering unavailable");
     }
 }
 
@@ -853,6 +988,7 @@ void AutosteerProcessor::handleSteerSettings(uint8_t pgn, const uint8_t* data, s
     configManager.setSteerSensorCounts(steerSensorCounts);
     configManager.setWasOffset(wasOffset);
     configManager.setAckermanFix(ackermanFix);
+    configManager.publishControlConfig();
     configManager.saveSteerSettings();
     LOG_INFO(EventSource::AUTOSTEER, "Steer settings saved to EEPROM");
 
@@ -942,7 +1078,18 @@ void AutosteerProcessor::handleSteerData(uint8_t pgn, const uint8_t* data, size_
     }
     // Extract steer angle
     int16_t angleRaw = (int16_t)(data[4] << 8 | data[3]);
-    targetAngle = angleRaw / 100.0f;
+    float newTargetAngle = angleRaw / 100.0f;
+    
+    // Target rate for feed-forward, from consecutive PGN 254s (10Hz)
+    uint32_t targetTime = millis();
+    uint32_t targetInterval = targetTime - lastTargetTime;
+    if (lastTargetTime != 0 && targetInterval > 0 && targetInterval < 500) {
+        targetAngleRate = (newTargetAngle - targetAngle) * 1000.0f / targetInterval;
+    } else {
+        targetAngleRate = 0.0f;
+    }
+    lastTargetTime = targetTime;
+    targetAngle = newTargetAngle;
     
     // Debug log for AgIO test mode
     if (targetAngle != 0.0f || autosteerEnabled) {
@@ -1109,6 +1256,8 @@ void AutosteerProcessor::updateMotorControl() {
                 LOG_INFO(EventSource::AUTOSTEER, "LOCK output: INACTIVE (motor disabled)");
             }
         }
+        controller.reset();
+        
         // Update LED immediately when motor disabled
         ledManagerFSM.transitionSteerState(LEDManagerFSM::STEER_READY);
         LOG_INFO(EventSource::AUTOSTEER, "LED -> AMBER (motor disabled)");
@@ -1140,10 +1289,10 @@ void AutosteerProcessor::updateMotorControl() {
     float angleError = actualAngle - targetAngle;
     float errorAbs = abs(angleError);
     
-    // Get PWM settings from ConfigManager (cached for performance)
-    uint8_t kp = configManager.getKp();
-    uint8_t highPWM = configManager.getHighPWM();
-    uint8_t minPWM = configManager.getMinPWM();
+    // PWM settings from this tick's config snapshot
+    uint8_t kp = config->kp;
+    uint8_t highPWM = config->highPWM;
+    uint8_t minPWM = config->minPWM;
 
     // Debug log to verify settings are being read
     static uint32_t lastSettingsVerifyLog = 0;
@@ -1156,8 +1305,26 @@ void AutosteerProcessor::updateMotorControl() {
         LOG_INFO(EventSource::AUTOSTEER, "Active PWM settings: Kp=%d, highPWM=%d, minPWM=%d", kp, highPWM, minPWM);
     }
     
-    // Calculate base PWM output (error * Kp)
-    int16_t pValue = kp * angleError;
+    // PID + feed-forward on the angle error, gains scheduled on speed
+    const SteerControllerConfig& cc = config->controller;
+    float gainScale = SteerController::scheduleGain(vehicleSpeed, cc.scheduleSpeedLow, cc.scheduleSpeedHigh,
+                                                    cc.scaleLow, cc.scaleHigh);
+    SteerController::Params params;
+    params.kp = kp * gainScale;
+    params.ki = cc.ki * gainScale;
+    params.kd = cc.kd * gainScale;
+    params.kff = cc.kff;
+    params.integralLimit = cc.integralLimit;
+    params.outputLimit = highPWM;
+    params.dFilterHz = cc.dFilterHz;
+    float dt = tickPeriodUs / 1000000.0f;
+    float output = controller.update(params, targetAngle, targetAngleRate, actualAngle, dt);
+
+    // The controller does not clamp its output - a large error times Kp would
+    // wrap in the int16_t cast, so limit it to the drive range first
+    float outputLimit = (highPWM > 0) ? (float)highPWM : 255.0f;
+    output = constrain(output, -outputLimit, outputLimit);
+    int16_t pValue = (int16_t)output;
     
     // Apply PWM calculation similar to V6
     if (highPWM > 0) {  // Check if we have valid settings
@@ -1216,7 +1383,7 @@ void AutosteerProcessor::updateMotorControl() {
                     float sineRamp = sin(rampProgress * PI / 2.0f);
                     
                     // Calculate soft-start limit based on lowPWM
-                    uint8_t lowPWM = configManager.getLowPWM();
+                    uint8_t lowPWM = config->lowPWM;
                     int16_t softStartLimit = (int16_t)(lowPWM * softStartMaxPWM * sineRamp);
                     
                     // Apply limit in direction of motor PWM
@@ -1244,7 +1411,7 @@ void AutosteerProcessor::updateMotorControl() {
     }
     
     // Apply motor direction from config
-    if (configManager.getMotorDriveDirection()) {
+    if (config->motorDriveDirection) {
         motorPWM = -motorPWM;  // Invert if configured
     }
     
@@ -1253,9 +1420,9 @@ void AutosteerProcessor::updateMotorControl() {
     static uint32_t lastPWMSettingsLog = 0;
     if (millis() - lastPWMSettingsLog > 30000) {  // Log every 30 seconds
         lastPWMSettingsLog = millis();
-        // Note: PWM settings now come from ConfigManager
+        // Note: PWM settings now come from the ControlConfig snapshot
         LOG_DEBUG(EventSource::AUTOSTEER, "PWM Settings: highPWM=%d, lowPWM=%d, minPWM=%d", 
-                  configManager.getHighPWM(), configManager.getLowPWM(), configManager.getMinPWM());
+                  config->highPWM, (uint8_t)config->lowPWM, config->minPWM);
     }
     
     // Motor speed is now properly scaled to respect highPWM limit
@@ -1318,7 +1485,7 @@ bool AutosteerProcessor::shouldSteerBeActive() const {
     // because AgOpenGPS may not set bit 6 until it receives confirmation from us
     bool active = guidanceActive &&           // Guidance line active (bit 0 from PGN 254)
                   (steerState == 0) &&        // Our button/OSB state (0=active)
-                  (vehicleSpeed > (configManager.getMinSpeed() / 10.0f));  // Moving (MinSpeed is in 0.1 km/h units)
+                  (vehicleSpeed > (config->minSpeed / 10.0f));  // Moving (MinSpeed is in 0.1 km/h units)
     
     // Debug logging for test mode
     static uint32_t lastDebugTime = 0;
@@ -1331,6 +1498,20 @@ bool AutosteerProcessor::shouldSteerBeActive() const {
     return active;
 }
 
+void AutosteerProcessor::checkKickout() {
+    if (!kickoutMonitor || !kickoutMonitor->hasKickout() || steerState != 0) {
+        return;
+    }
+    // Disarm steering - this will stop the motor
+    steerState = 1;  // Disarmed
+    emergencyStop();
+    kickoutMonitor->markMotorReleased();  // No-op if the driver already stopped it
+    LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s - steering disarmed", kickoutMonitor->getReasonString());
+    kickoutButtonPressTime = millis();  // Start grace period for button clear
+    kickoutButtonPressed = false;
+    // Don't clear kickout here - let KickoutMonitor auto-clear when conditions return to normal
+}
+
 void AutosteerProcessor::emergencyStop() {
     LOG_WARNING(EventSource::AUTOSTEER, "EMERGENCY STOP");
     
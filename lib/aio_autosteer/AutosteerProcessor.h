@@ -2,6 +2,7 @@
 #define AUTOSTEER_PROCESSOR_H
 
 #include <Arduino.h>
+#include "SteerController.h"
 // PIDController removed - functionality absorbed into AutosteerProcessor
 
 // External pointers
@@ -12,11 +13,24 @@ class MotorDriverInterface;
 extern MotorDriverInterface motorDriver;
 
 class KickoutMonitor;
+struct ControlConfig;
 
 // PGN data is parsed directly to ConfigManager
 // No intermediate structs needed
 
 class AutosteerProcessor {
+public:
+    // Stage durations of the last tick, measured with micros()
+    struct PipelineTiming {
+        uint32_t senseUs = 0;
+        uint32_t computeUs = 0;
+        uint32_t actuateUs = 0;
+        uint32_t latencyUs = 0;         // WAS sample to motor command
+        uint32_t maxLatencyUs = 0;
+        uint32_t ticks = 0;
+        uint32_t overruns = 0;          // Ticks over PIPELINE_BUDGET_US
+    };
+
 private:
     static AutosteerProcessor* instance;
     
@@ -31,6 +45,8 @@ private:
     // State tracking
     bool autosteerEnabled = false;
     float targetAngle = 0.0f;
+    float targetAngleRate = 0.0f;        // deg/s, from consecutive PGN 254s
+    uint32_t lastTargetTime = 0;
     uint32_t lastPGN254Time = 0;
     
     // PGN 254 data
@@ -65,6 +81,8 @@ private:
     uint32_t kickoutTime = 0;            // Time of last kickout
     static constexpr uint32_t KICKOUT_COOLDOWN_MS = 2000; // 2 second cooldown
     KickoutMonitor* kickoutMonitor = nullptr;
+    uint32_t kickoutButtonPressTime = 0; // Start of the button/switch clear grace period
+    bool kickoutButtonPressed = false;
     
     // Soft-start motor control
     enum class MotorState {
@@ -84,6 +102,31 @@ private:
     // Link state tracking
     bool linkWasDown = false;               // Track if link was down
     
+    // Sense-compute-actuate pipeline, run by poll() at the configured rate
+    static constexpr uint16_t SUPERVISORY_RATE_HZ = 100;    // Engage logic, PGN 253, LEDs
+    static constexpr uint16_t MOTOR_TX_RATE_HZ = 50;        // CAN/serial commands, as before
+    static constexpr uint32_t PIPELINE_BUDGET_US = 1000;    // Sample to command, per tick
+    uint16_t controlRateHz = 0;
+    uint32_t tickPeriodUs = 10000;
+    uint32_t lastTickUs = 0;
+    uint8_t ticksPer100Hz = 1;
+    uint8_t supervisoryTick = 0;
+    uint8_t motorTxDivider = 2;
+    uint8_t motorTxTick = 0;
+    PipelineTiming timing;
+    SteerController controller;
+    
+    void applyControlRate(uint16_t rateHz);
+    void sense();           // Motor feedback, WAS sample, fusion
+    void compute();         // 100Hz: engage logic, kickouts, control, PGN 253, LEDs
+    void computeControl();  // Angle, control law, setPWM
+    void checkKickout();    // Every tick: disarm as soon as a kickout trips
+    void actuate();         // Motor driver transmit
+    
+    // Steer settings for the current tick, taken once at the top of process()
+    const ControlConfig* config = nullptr;
+    uint32_t configVersion = 0;             // Last snapshot version seen
+    
     // Motor config change tracking
     uint8_t previousMotorConfig = 0xFF;     // Previous motor config byte
     int8_t previousCytronDriver = -1;       // Previous Cytron bit state
@@ -96,8 +139,10 @@ public:
     
     // Initialization
     bool init();
-    void process();
+    void poll();        // Every loop: runs process() when the next tick is due
+    void process();     // One control tick
     void initializeFusion();  // Initialize sensor fusion separately
+    void reconfigureMotorDriver();  // Swap drivers after a PGN 251 motor change
     
     // PGN handlers
     void handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size_t len);
@@ -138,6 +183,13 @@ public:
         softStartDurationMs = constrain(durationMs, 0, 500); // Max 500ms
     }
     
+    // Pipeline timing
+    const PipelineTiming& getPipelineTiming() const { return timing; }
+    uint16_t getControlRateHz() const { return controlRateHz; }
+    const SteerController::Terms& getControllerTerms() const { return controller.getTerms(); }
+    void resetPipelineTiming();
+    void printPipelineTiming() const;
+    
     float getSoftStartMaxPWM() const { return softStartMaxPWM; }
     void setSoftStartMaxPWM(float maxPWM) { 
         softStartMaxPWM = constrain(maxPWM, 0.0f, 1.0f); // 0-100% of lowPWM
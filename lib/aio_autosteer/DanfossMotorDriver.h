@@ -25,6 +25,10 @@ private:
     // Hardware manager for output control
     HardwareManager* hwMgr;
     
+    // Outputs are put in a known state on the first enable()
+    bool firstCall = true;
+    uint8_t lastPwmValue = 255;  // Invalid initial value to force first update
+    
 public:
     DanfossMotorDriver(HardwareManager* hw) : hwMgr(hw) {
         // Initialize status
@@ -40,6 +44,15 @@ public:
         };
     }
     
+    ~DanfossMotorDriver() {
+        // Leave the valve centred and disabled for whatever drives next
+        if (MachineProcessor::getInstance() && !firstCall) {
+            setOutputPWM(CONTROL_OUTPUT, PWM_CENTER);
+            setOutput(ENABLE_OUTPUT, false);
+            LOG_INFO(EventSource::AUTOSTEER, "Danfoss valve released");
+        }
+    }
+    
     bool init() override {
         LOG_INFO(EventSource::AUTOSTEER, "Initializing Danfoss valve driver...");
         
@@ -59,7 +72,6 @@ public:
         }
         
         // On first call, ensure we're in a known state
-        static bool firstCall = true;
         if (firstCall) {
             firstCall = false;
             // Ensure valve starts centered and disabled
@@ -158,6 +170,10 @@ public:
     }
     
     void handleKickout(KickoutType type, float value) override {
+        // Disable the valve first; the log can wait
+        enable(false);
+        stop();
+        
         // Handle kickout based on configured type
         switch (type) {
             case KickoutType::WHEEL_ENCODER:
@@ -169,10 +185,6 @@ public:
             default:
                 break;
         }
-        
-        // Disable the valve
-        enable(false);
-        stop();
     }
     
     float getCurrentDraw() override { 
@@ -200,8 +212,6 @@ private:
     
     void setOutputPWM(uint8_t output, uint8_t pwmValue) {
         // Output 6 uses PCA9685 pin 9 for PWM control
-        static uint8_t lastPwmValue = 255;  // Invalid initial value to force first update
-        
         if (output == 6) {
             // Only update if value has changed to avoid I2C traffic
             if (pwmValue != lastPwmValue) {
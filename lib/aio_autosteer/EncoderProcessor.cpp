@@ -67,27 +67,37 @@ void EncoderProcessor::updateConfig(EncoderType type, bool enabled) {
 }
 
 void EncoderProcessor::process() {
-    if (!encoderEnabled || !encoder) {
+    if (!encoderEnabled || (!encoder && !pulseISRAttached)) {
         return;
     }
     
     
     if (encoderType == EncoderType::SINGLE) {
-        // Single channel encoder - count pulses
-        // Since we're using the same pin twice, the Encoder library counts both edges
+        // Single channel encoder - the pin interrupt counts both edges
         // Divide by 2 to get actual pulse count
-        int32_t rawCount = encoder->read();
-        pulseCount = abs(rawCount) / 2;
+        uint32_t edges = edgeCount;
+        pulseCount = edges / 2;
         
         // Log changes
         if (pulseCount != lastEncoderValue) {
-            LOG_DEBUG(EventSource::AUTOSTEER, "Encoder pulse count: %d (raw: %d)", pulseCount, rawCount);
+            LOG_DEBUG(EventSource::AUTOSTEER, "Encoder pulse count: %d (edges: %lu)", pulseCount, edges);
             lastEncoderValue = pulseCount;
         }
     } else {
         // Quadrature encoder - use absolute position
         pulseCount = abs(encoder->read());
         
+        // No interrupt of our own here, so first motion and the limit are
+        // timestamped when seen
+        if (pulseCount != 0 && !firstPulseSeen) {
+            firstPulseUs = micros();
+            firstPulseSeen = true;
+        }
+        if ((uint32_t)pulseCount > pulseLimit && !limitCrossed) {
+            limitCrossedUs = micros();
+            limitCrossed = true;
+        }
+        
         // Log changes
         if (pulseCount != lastEncoderValue) {
             LOG_DEBUG(EventSource::AUTOSTEER, "Encoder position: %d", pulseCount);
@@ -98,14 +108,62 @@ void EncoderProcessor::process() {
 
 
 void EncoderProcessor::resetPulseCount() {
-    if (encoder) {
-        encoder->write(0);
+    if (encoder || pulseISRAttached) {
+        noInterrupts();
+        if (encoder) {
+            encoder->write(0);
+        }
+        edgeCount = 0;
+        firstPulseSeen = false;
+        limitCrossed = false;
+        interrupts();
         pulseCount = 0;
         lastEncoderValue = 0;
         LOG_DEBUG(EventSource::AUTOSTEER, "Encoder pulse count reset");
     }
 }
 
+void EncoderProcessor::setPulseLimit(uint32_t limit) {
+    if (limit == pulseLimit) {
+        return;
+    }
+    pulseLimit = limit;
+    // Count over the limit means at least limit + 1 pulses
+    noInterrupts();
+    edgeLimit = (limit + 1) * 2;
+    interrupts();
+}
+
+bool EncoderProcessor::getFirstPulse(uint32_t& us) const {
+    noInterrupts();
+    bool seen = firstPulseSeen;
+    us = firstPulseUs;
+    interrupts();
+    return seen;
+}
+
+bool EncoderProcessor::getLimitCrossing(uint32_t& us) const {
+    noInterrupts();
+    bool crossed = limitCrossed;
+    us = limitCrossedUs;
+    interrupts();
+    return crossed;
+}
+
+void EncoderProcessor::pulseISR() {
+    EncoderProcessor* self = instance;
+    uint32_t edges = self->edgeCount + 1;
+    self->edgeCount = edges;
+    if (!self->firstPulseSeen) {
+        self->firstPulseUs = micros();
+        self->firstPulseSeen = true;
+    }
+    if (edges >= self->edgeLimit && !self->limitCrossed) {
+        self->limitCrossedUs = micros();
+        self->limitCrossed = true;
+    }
+}
+
 void EncoderProcessor::initEncoder() {
     uint8_t pinA = hardwareManager.getKickoutAPin();
     uint8_t pinD = hardwareManager.getKickoutDPin();
@@ -140,7 +198,7 @@ void EncoderProcessor::initEncoder() {
         return;
     }
     
-    // Don't call pinMode() here - the Encoder library will configure the pins as INPUT_PULLUP
+    // Don't call pinMode() for quadrature - the Encoder library will configure the pins as INPUT_PULLUP
     // Just update our internal tracking to reflect what the Encoder library will do
     if (encoderType == EncoderType::QUADRATURE) {
         hwMgr->updatePinMode(pinA, INPUT_PULLUP);
@@ -150,8 +208,10 @@ void EncoderProcessor::initEncoder() {
     }
     
     if (encoderType == EncoderType::SINGLE) {
-        // Single channel encoder uses only digital pin
-        encoder = new Encoder(pinD, pinD);  // Use same pin twice for single channel
+        // Single channel encoder uses only digital pin, counted in pulseISR
+        pinMode(pinD, INPUT_PULLUP);
+        attachInterrupt(digitalPinToInterrupt(pinD), pulseISR, CHANGE);
+        pulseISRAttached = true;
         LOG_INFO(EventSource::AUTOSTEER, "Single channel encoder initialized on pin %d", pinD);
     } else {
         // Quadrature encoder uses both pins - match test sketch order
@@ -164,13 +224,14 @@ void EncoderProcessor::initEncoder() {
 }
 
 void EncoderProcessor::deinitEncoder() {
-    if (encoder) {
+    if (encoder || pulseISRAttached) {
         // Get pin numbers before deleting encoder
         uint8_t pinA = hardwareManager.getKickoutAPin();
         uint8_t pinD = hardwareManager.getKickoutDPin();
         
         delete encoder;
         encoder = nullptr;
+        pulseISRAttached = false;
         pulseCount = 0;
         lastEncoderValue = 0;
         
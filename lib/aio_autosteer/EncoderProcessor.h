@@ -25,6 +25,17 @@ private:
     // Encoder object (created dynamically based on config)
     Encoder* encoder = nullptr;
     
+    // Single channel pulses are counted by our own pin interrupt instead,
+    // which also timestamps the first pulse and the kickout limit crossing
+    bool pulseISRAttached = false;
+    volatile uint32_t edgeCount = 0;
+    volatile uint32_t edgeLimit = UINT32_MAX;   // Edges, two per pulse
+    volatile bool firstPulseSeen = false;
+    volatile uint32_t firstPulseUs = 0;
+    volatile bool limitCrossed = false;
+    volatile uint32_t limitCrossedUs = 0;
+    uint32_t pulseLimit = UINT32_MAX;
+    
     // Encoder readings
     int32_t pulseCount = 0;
     int32_t lastEncoderValue = 0;
@@ -46,6 +57,15 @@ public:
     // Reset pulse count
     void resetPulseCount();
     
+    // Kickout limit in pulses. Single channel: checked on every edge in the
+    // interrupt; quadrature: checked in process()
+    void setPulseLimit(uint32_t limit);
+    
+    // Times (micros) since the last reset of the first pulse and of the count
+    // first passing the limit; false if it has not happened yet
+    bool getFirstPulse(uint32_t& us) const;
+    bool getLimitCrossing(uint32_t& us) const;
+    
     // Getters
     int32_t getPulseCount() const { return pulseCount; }
     bool isEnabled() const { return encoderEnabled; }
@@ -55,6 +75,7 @@ private:
     // Initialize/deinitialize encoder based on configuration
     void initEncoder();
     void deinitEncoder();
+    static void pulseISR();
 };
 
 // Global instance
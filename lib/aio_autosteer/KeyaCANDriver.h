@@ -39,7 +39,9 @@ public:
     KeyaCANDriver() : can3(&globalCAN3) {}
     
     bool init() override {
-        // CAN3 already initialized by global init
+        // CAN3 already initialized by global init - Keya detection polled it at boot,
+        // from here on heartbeats are received by interrupt
+        enableCANRxInterrupts(3);
         LOG_INFO(EventSource::AUTOSTEER, "KeyaCANDriver initialized");
         return true;
     }
@@ -72,6 +74,11 @@ public:
         commandedRPM = 0.0f;  // Make sure commanded speed is also zeroed
     }
     
+    void processFeedback() override {
+        // Called every autosteer tick - consume heartbeats queued by the CAN ISR
+        checkCANMessages();
+    }
+    
     void process() override {
         // Now called by SimpleScheduler at 50Hz (20ms)
 
@@ -96,7 +103,7 @@ public:
                     msg.buf[5] = 0x00;
                     msg.buf[6] = 0x00;
                     msg.buf[7] = 0x00;
-                    can3->write(msg);
+                    writeCANFrame(3, msg);
                     nextCommand = SEND_SPEED;
                     break;
                     
@@ -124,7 +131,7 @@ public:
                         msg.buf[5] = speedValue & 0xFF;          // DATA_L(L) - bits 7-0
                         msg.buf[6] = (speedValue >> 24) & 0xFF;  // DATA_H(H) - bits 31-24 (sign extension)
                         msg.buf[7] = (speedValue >> 16) & 0xFF;  // DATA_H(L) - bits 23-16 (sign extension)
-                        can3->write(msg);
+                        writeCANFrame(3, msg);
                         nextCommand = SEND_ENABLE;
                     }
                     break;
@@ -143,7 +150,7 @@ public:
                     msg.buf[5] = 0x00;
                     msg.buf[6] = 0x00;
                     msg.buf[7] = 0x00;
-                    can3->write(msg);
+                    writeCANFrame(3, msg);
                 } else {
                     // Send zero speed command
                     msg.buf[0] = 0x23;
@@ -154,7 +161,7 @@ public:
                     msg.buf[5] = 0x00;
                     msg.buf[6] = 0x00;
                     msg.buf[7] = 0x00;
-                    can3->write(msg);
+                    writeCANFrame(3, msg);
                 }
                 
                 // Toggle for next time
@@ -269,10 +276,12 @@ public:
     
 private:
     void checkCANMessages() {
-        CAN_message_t rxMsg;
+        CANRxFrame frame;
         
-        // Process only ONE message per call to prevent blocking
-        if (can3->read(rxMsg)) {
+        // Drain everything the ISR queued - frames are already off the bus,
+        // so this is a memory copy per frame and cannot block
+        while (readCANFrame(3, frame)) {
+            const CAN_message_t& rxMsg = frame.msg;
             // Check for heartbeat message from Keya (ID: 0x07000001)
             if (rxMsg.id == 0x07000001 && rxMsg.flags.extended) {
                 // Heartbeat format (from manual - big-endian/MSB first):
@@ -13,6 +13,12 @@ bool KeyaSerialDriver::init() {
     return true;
 }
 
+KeyaSerialDriver::~KeyaSerialDriver() {
+    enabled = false;
+    targetPWM = 0;
+    sendCommand();
+}
+
 void KeyaSerialDriver::enable(bool en) {
     if (enabled != en) {
         LOG_INFO(EventSource::AUTOSTEER, "Keya Serial motor %s", en ? "enabled" : "disabled");
@@ -36,7 +36,7 @@ private:
     
 public:
     KeyaSerialDriver() = default;
-    ~KeyaSerialDriver() = default;
+    ~KeyaSerialDriver();  // Sends a last disable command
     
     // MotorDriverInterface implementation
     bool init() override;
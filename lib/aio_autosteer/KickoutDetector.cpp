@@ -0,0 +1,94 @@
+// KickoutDetector.cpp - Trip decision for one kickout sensor
+#include "KickoutDetector.h"
+
+void KickoutDetector::configure(const KickoutDetectorConfig& cfg) {
+    config = cfg;
+    if (config.hysteresis < 0.0f) {
+        config.hysteresis = 0.0f;
+    }
+    if (config.hysteresis > config.tripLevel) {
+        config.hysteresis = config.tripLevel;
+    }
+    if (config.riseWindowUs == 0) {
+        config.riseWindowUs = 1000;
+    }
+}
+
+void KickoutDetector::reset() {
+    trigger = NONE;
+    onsetUs = 0;
+    tripUs = 0;
+    lastValue = 0.0f;
+    overLevel = false;
+    overSinceUs = 0;
+    started = false;
+    havePrevious = false;
+    windowUs = 0;
+    windowValue = 0.0f;
+    previousUs = 0;
+    previousValue = 0.0f;
+    rate = 0.0f;
+}
+
+bool KickoutDetector::update(float value, uint32_t us) {
+    lastValue = value;
+
+    // Rate over the span since the previous window opened, between one and
+    // two windows long whatever the sample rate
+    if (!started) {
+        started = true;
+        windowUs = us;
+        windowValue = value;
+    } else if (us - windowUs >= config.riseWindowUs) {
+        previousUs = windowUs;
+        previousValue = windowValue;
+        havePrevious = true;
+        windowUs = us;
+        windowValue = value;
+    }
+    if (havePrevious && us != previousUs) {
+        rate = (value - previousValue) * 1000000.0f / (float)(us - previousUs);
+    }
+
+    bool levelOn = config.tripLevel > 0.0f;
+    if (levelOn && value >= config.tripLevel) {
+        if (!overLevel) {
+            overLevel = true;
+            overSinceUs = us;
+        }
+    } else {
+        overLevel = false;
+    }
+
+    if (trigger == NONE) {
+        if (overLevel && us - overSinceUs >= config.debounceUs) {
+            trigger = LEVEL;
+            onsetUs = overSinceUs;
+            tripUs = us;
+        } else if (config.riseRate > 0.0f && havePrevious && rate >= config.riseRate) {
+            trigger = RISE;
+            onsetUs = previousUs;
+            tripUs = us;
+        }
+        return trigger != NONE;
+    }
+
+    // Hold the trip until the value is clearly back down; a rise trip
+    // below the level also holds while the value is still climbing
+    bool holding = trigger == RISE && rate > 0.0f;
+    if (levelOn && value >= config.tripLevel - config.hysteresis) {
+        holding = true;
+    }
+    if (!holding) {
+        trigger = NONE;
+    }
+    return trigger != NONE;
+}
+
+const char* KickoutDetector::triggerName(Trigger t) {
+    switch (t) {
+        case LEVEL: return "level";
+        case RISE: return "rise";
+        default: return "none";
+    }
+}
@@ -0,0 +1,73 @@
+// KickoutDetector.h - Trip decision for one kickout sensor
+// Fed with timestamped samples as they arrive (encoder counts, filtered
+// pressure or current) and trips on either:
+//   level  the value stays at or above the trip level for the debounce
+//          window
+//   rise   the value climbs faster than the rise rate, measured over one to
+//          two rise windows, so a hard grab trips before the level is reached
+// A trip clears once the value falls below the trip level less the
+// hysteresis (and, for a rise trip, has stopped climbing).
+// Each trip keeps the time the operator's input started (first sample over
+// the level, or the start of the rising window) so grab-to-release latency
+// can be measured.
+//
+// Plain C++ with no Arduino dependencies.
+#ifndef KICKOUT_DETECTOR_H
+#define KICKOUT_DETECTOR_H
+
+#include <stdint.h>
+
+struct KickoutDetectorConfig {
+    float tripLevel = 0.0f;         // Sensor units, 0 = level trip off
+    float hysteresis = 0.0f;        // Clears below tripLevel - hysteresis
+    uint32_t debounceUs = 0;        // Time over the level before tripping
+    float riseRate = 0.0f;          // Sensor units per second, 0 = rise trip off
+    uint32_t riseWindowUs = 50000;
+};
+
+class KickoutDetector {
+public:
+    enum Trigger : uint8_t { NONE, LEVEL, RISE };
+
+    KickoutDetector() { reset(); }
+
+    // Keeps a trip in progress; new levels apply from the next sample
+    void configure(const KickoutDetectorConfig& cfg);
+    const KickoutDetectorConfig& getConfig() const { return config; }
+    void reset();
+
+    // Feed one sample; true while tripped
+    bool update(float value, uint32_t us);
+
+    bool isTripped() const { return trigger != NONE; }
+    Trigger getTrigger() const { return trigger; }
+    uint32_t getOnsetUs() const { return onsetUs; }     // Operator input started
+    uint32_t getTripUs() const { return tripUs; }       // Trip decided
+    float getValue() const { return lastValue; }
+    float getRate() const { return rate; }              // Units per second, 0 until one window has passed
+
+    static const char* triggerName(Trigger t);
+
+private:
+    KickoutDetectorConfig config;
+
+    Trigger trigger;
+    uint32_t onsetUs;
+    uint32_t tripUs;
+    float lastValue;
+
+    // Level debounce
+    bool overLevel;
+    uint32_t overSinceUs;
+
+    // Rise rate against the sample that opened the previous window
+    bool started;
+    bool havePrevious;
+    uint32_t windowUs;
+    float windowValue;
+    uint32_t previousUs;
+    float previousValue;
+    float rate;
+};
+
+#endif // KICKOUT_DETECTOR_H
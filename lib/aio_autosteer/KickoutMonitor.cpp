@@ -31,7 +31,13 @@ KickoutMonitor::KickoutMonitor() :
     lastEncoderState(false),
     lastPressureReading(0),
     lastCurrentReading(0),
-    currentHighStartTime(0),
+    detectorPressureMax(0xFFFF),
+    detectorCurrentThreshold(0xFFFF),
+    detectorJDPWM(false),
+    detectorPressureSensor(false),
+    lastJDMotionUs(0),
+    encoderGrabUs(0),
+    encoderTripUs(0),
     kickoutActive(false),
     kickoutReason(NONE),
     kickoutTime(0) {
@@ -75,6 +81,10 @@ bool KickoutMonitor::init(MotorDriverInterface* driver) {
     // Encoder pin initialization is handled by EncoderProcessor
     // KickoutMonitor just reads the processed encoder data
     
+    // Judge pressure and current on each new filter output
+    adProcessor->setFilterOutputHandler(filterOutput, this);
+    applyConfig();
+    
     LOG_INFO(EventSource::AUTOSTEER, "KickoutMonitor initialized successfully");
     return true;
 }
@@ -116,10 +126,14 @@ void KickoutMonitor::process() {
         }
     }
     
+    updatePressureSource();
+    
     // Only read sensors relevant to the motor type
     if (!isKeyaMotor) {
         // Get encoder pulse count from EncoderProcessor (not relevant for Keya)
         if (encoderProc && encoderProc->isEnabled()) {
+            // Limit is checked on every edge in the encoder's pin interrupt
+            encoderProc->setPulseLimit(configMgr->getPulseCountMax());
             int32_t newCount = encoderProc->getPulseCount();
             
             // Log significant changes in encoder count  
@@ -137,8 +151,18 @@ void KickoutMonitor::process() {
         // Get pressure and current readings from ADProcessor (not relevant for Keya)
         lastPressureReading = (uint16_t)adProcessor->getPressureReading();  // Filtered value (0-255)
         lastCurrentReading = adProcessor->getMotorCurrent();
+        
+        // JD PWM motion is worked out from the duty cycle at 100Hz, not
+        // from a filter output, so each new value is fed here
+        uint32_t motionUs = adProcessor->getPressureReadingTime();
+        if (configMgr->getJDPWMEnabled() && motionUs != lastJDMotionUs) {
+            lastJDMotionUs = motionUs;
+            pressureDetector.update(adProcessor->getPressureReading(), motionUs);
+        }
     }
     
+    updateDetectorLevels();
+    
     // PGN250 is now sent by SimpleScheduler at 10Hz via sendPGN250()
     
     // Check kickout conditions based on motor type
@@ -154,75 +178,82 @@ void KickoutMonitor::process() {
         }
         
         // External sensor checks - NOT for Keya motors
+        // The driver is stopped first; logging waits until the motor is released
         if (!isKeyaMotor && configMgr->getShaftEncoder()) {
             // Encoder is enabled for non-Keya motors
             if (checkEncoderKickout()) {
-            kickoutActive = true;
-            kickoutReason = ENCODER_OVERSPEED;
-            kickoutTime = millis();
-            
-            LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
-            
+                trip(ENCODER_OVERSPEED, encoderGrabUs, encoderTripUs);
+                
                 // Notify motor driver
                 if (motorDriver) {
                     motorDriver->handleKickout(KickoutType::WHEEL_ENCODER, encoderPulseCount);
+                    markMotorReleased();
                 }
+                
+                LOG_DEBUG(EventSource::AUTOSTEER, "Encoder kickout: count=%d (max %u)",
+                          encoderPulseCount, configMgr->getPulseCountMax());
+                LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
             }
         }
         else if (!isKeyaMotor && configMgr->getJDPWMEnabled() && checkPressureKickout()) {
             // JD PWM mode uses pressure kickout mechanism since motion is sent as pressure
-            kickoutActive = true;
-            kickoutReason = JD_PWM_MOTION;
-            kickoutTime = millis();
-            
-            LOG_WARNING(EventSource::AUTOSTEER, "JD_PWM_KICKOUT: *** KICKOUT ACTIVATED ***");
-            LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
+            trip(JD_PWM_MOTION, pressureDetector.getOnsetUs(), pressureDetector.getTripUs());
             
             // Notify motor driver using pressure sensor kickout type for compatibility
             if (motorDriver) {
                 motorDriver->handleKickout(KickoutType::PRESSURE_SENSOR, lastPressureReading);
+                markMotorReleased();
             }
-        }
-        else if (!isKeyaMotor && configMgr->getPressureSensor() && !configMgr->getJDPWMEnabled() && checkPressureKickout()) {
-            LOG_DEBUG(EventSource::AUTOSTEER, "PRESSURE_KICKOUT: Regular pressure mode (JD PWM disabled)");
-            kickoutActive = true;
-            kickoutReason = PRESSURE_HIGH;
-            kickoutTime = millis();
             
+            logPressureHigh();
+            LOG_WARNING(EventSource::AUTOSTEER, "JD_PWM_KICKOUT: *** KICKOUT ACTIVATED ***");
             LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
+        }
+        else if (!isKeyaMotor && configMgr->getPressureSensor() && !configMgr->getJDPWMEnabled() && checkPressureKickout()) {
+            trip(PRESSURE_HIGH, pressureDetector.getOnsetUs(), pressureDetector.getTripUs());
             
             // Notify motor driver
             if (motorDriver) {
                 float pressureVolts = (lastPressureReading * 3.3f) / 4095.0f;
                 motorDriver->handleKickout(KickoutType::PRESSURE_SENSOR, pressureVolts);
+                markMotorReleased();
             }
-        }
-        else if (!isKeyaMotor && configMgr->getCurrentSensor() && checkCurrentKickout()) {
-            kickoutActive = true;
-            kickoutReason = CURRENT_HIGH;
-            kickoutTime = millis();
             
+            logPressureHigh();
+            LOG_DEBUG(EventSource::AUTOSTEER, "PRESSURE_KICKOUT: Regular pressure mode (JD PWM disabled)");
             LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
+        }
+        else if (!isKeyaMotor && configMgr->getCurrentSensor() && checkCurrentKickout()) {
+            trip(CURRENT_HIGH, currentDetector.getOnsetUs(), currentDetector.getTripUs());
             
             // Notify motor driver with current in amps
             if (motorDriver) {
                 float currentAmps = motorDriver->getCurrentDraw();
                 motorDriver->handleKickout(KickoutType::CURRENT_SENSOR, currentAmps);
+                markMotorReleased();
             }
+            
+            LOG_INFO(EventSource::AUTOSTEER, "Current kickout (%s) after %lu us: reading=%.0f counts, trip level %.0f counts (config=%.1f%%)", 
+                     KickoutDetector::triggerName(currentDetector.getTrigger()),
+                     currentDetector.getTripUs() - currentDetector.getOnsetUs(),
+                     currentDetector.getValue(), currentDetector.getConfig().tripLevel,
+                     (configMgr->getCurrentThreshold() * 100.0f) / 255.0f);
+            LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
         }
         else if (isKeyaMotor && checkMotorSlipKickout()) {
-            kickoutActive = true;
             // Determine specific reason based on motor type
+            KickoutReason reason = MOTOR_SLIP;
             if (motorDriver->getType() == MotorDriverType::KEYA_CAN) {
-                kickoutReason = KEYA_SLIP;  // checkMotorSlip handles both slip and errors
-            } else {
-                kickoutReason = MOTOR_SLIP;
+                reason = KEYA_SLIP;  // checkMotorSlip handles both slip and errors
             }
-            kickoutTime = millis();
+            // The motor's own slip detection gives no onset time
+            uint32_t nowUs = micros();
+            trip(reason, nowUs, nowUs);
             
             LOG_WARNING(EventSource::AUTOSTEER, "KICKOUT: %s", getReasonString());
             
-            // Motor already knows about its own slip condition
+            // Motor already knows about its own slip condition; released
+            // when AutosteerProcessor disarms
         }
     } else {
         // Currently in kickout - check if conditions have returned to normal
@@ -281,99 +312,59 @@ bool KickoutMonitor::checkEncoderKickout() {
     // encoderPulseCount is int32_t from EncoderProcessor
     uint32_t absoluteCount = abs((int32_t)encoderPulseCount);
     
-    // Check if we exceeded the threshold
-    if (absoluteCount > maxPulses) {
-        // Only log when first detecting kickout (not already active) or every 1 second
-        static uint32_t lastLogTime = 0;
-        uint32_t now = millis();
-        
-        if (!kickoutActive || (now - lastLogTime >= 1000)) {
-            LOG_DEBUG(EventSource::AUTOSTEER, "Encoder kickout: count=%d (max %u)", 
-                          encoderPulseCount, maxPulses);
-            lastLogTime = now;
-        }
-        return true;
+    if (kickoutActive) {
+        // Holding: the count only comes down when it is reset
+        return absoluteCount > maxPulses;
     }
     
-    return false;
+    // The crossing is timestamped where it happened - in the pin interrupt
+    // for single channel encoders - so the count polled here may still lag
+    uint32_t crossedUs;
+    if (!encoderProc || !encoderProc->getLimitCrossing(crossedUs)) {
+        return false;
+    }
+    if (encoderProc->getEncoderType() == EncoderType::QUADRATURE && absoluteCount <= maxPulses) {
+        return false;  // Position came back under the limit
+    }
+    uint32_t debounceUs = configMgr->getKickoutConfig().encoderDebounceMs * 1000UL;
+    uint32_t nowUs = micros();
+    if (nowUs - crossedUs < debounceUs) {
+        return false;
+    }
+    
+    encoderTripUs = debounceUs ? nowUs : crossedUs;
+    if (!encoderProc->getFirstPulse(encoderGrabUs)) {
+        encoderGrabUs = crossedUs;
+    }
+    return true;
 }
 
 bool KickoutMonitor::checkPressureKickout() {
-    // Use the already-read pressure value from process()
-    // This is the filtered/scaled value (0-255 range)
+    // The detector is fed from the pressure filter output (or the JD PWM
+    // motion value) with debounce and hysteresis applied
+    if (!pressureDetector.isTripped()) {
+        return false;
+    }
     
-    // Get pressure threshold from config
-    uint8_t threshold = configMgr->getPulseCountMax();
+    // Log every second while held; the first detection is logged once the
+    // motor has been released
+    static uint32_t lastLogTime = 0;
+    uint32_t now = millis();
     
-    if (lastPressureReading > threshold) {
-        // Only log when first detecting kickout (not already active) or every 1 second
-        static uint32_t lastLogTime = 0;
-        uint32_t now = millis();
-        
-        if (!kickoutActive || (now - lastLogTime >= 1000)) {
-            LOG_DEBUG(EventSource::AUTOSTEER, "Pressure high: %u (threshold %u)", 
-                          lastPressureReading, threshold);
-            lastLogTime = now;
-        }
-        return true;
+    if (kickoutActive && (now - lastLogTime >= 1000)) {
+        logPressureHigh();
+        lastLogTime = now;
     }
-    
-    return false;
+    return true;
 }
 
 bool KickoutMonitor::checkCurrentKickout() {
     // Read current sensor
     lastCurrentReading = adProcessor->getMotorCurrent();
     
-    // Get threshold from config (0-255, same scale as PGN250)
-    uint8_t thresholdPercent = configMgr->getCurrentThreshold();
-    
-    
-    // Convert threshold to raw ADC counts to match what ADProcessor returns
-    // ADProcessor returns counts after baseline subtraction
-    // Use same scale as PGN250 for consistency: 1680 counts = 255 (100%)
-    uint16_t thresholdCounts = (thresholdPercent * 1680) / 255;
-    
-    // Add 10% hysteresis to prevent triggering right at threshold
-    // This helps with direction changes where current briefly spikes
-    uint16_t thresholdWithHysteresis = thresholdCounts + (thresholdCounts / 10);
-    
-    if (lastCurrentReading > thresholdWithHysteresis) {
-        // Current is above threshold - check if it's been high long enough
-        uint32_t now = millis();
-        
-        if (currentHighStartTime == 0) {
-            // First time seeing high current - start timing
-            currentHighStartTime = now;
-            LOG_INFO(EventSource::AUTOSTEER, "Current high detected: %u counts (%.1f%%) - monitoring for %.1f seconds", 
-                      lastCurrentReading, (lastCurrentReading * 100.0f) / 1680.0f, CURRENT_SPIKE_FILTER_MS / 1000.0f);
-            return false; // Don't kickout yet
-        }
-        
-        // Check if current has been high long enough
-        uint32_t highDuration = now - currentHighStartTime;
-        if (highDuration >= CURRENT_SPIKE_FILTER_MS) {
-            // Current has been high for long enough - trigger kickout
-            if (!kickoutActive) {
-                LOG_INFO(EventSource::AUTOSTEER, "Current kickout after %ums: reading=%u counts > threshold=%u counts (+10%% = %u) (config=%.1f%%)", 
-                              highDuration, lastCurrentReading, thresholdCounts, thresholdWithHysteresis, 
-                              (thresholdPercent * 100.0f) / 255.0f);
-            }
-            currentHighStartTime = 0; // Reset for next time
-            return true;
-        }
-        
-        // Still waiting for duration to elapse
-        return false;
-    } else {
-        // Current is below threshold - reset timer if it was running
-        if (currentHighStartTime != 0) {
-            uint32_t duration = millis() - currentHighStartTime;
-            LOG_INFO(EventSource::AUTOSTEER, "Current returned to normal after %ums - no kickout", duration);
-            currentHighStartTime = 0;
-        }
-        return false;
-    }
+    // The detector sees every current filter output: level over the
+    // threshold + 10% for the debounce time, or a fast rise
+    return currentDetector.isTripped();
 }
 
 bool KickoutMonitor::checkMotorSlipKickout() {
@@ -434,9 +425,6 @@ void KickoutMonitor::clearKickout() {
     kickoutReason = NONE;
     kickoutTime = 0;
     
-    // Reset current spike timer
-    currentHighStartTime = 0;
-    
     // Reset encoder count via EncoderProcessor
     if (encoderProc) {
         encoderProc->resetPulseCount();
@@ -446,6 +434,146 @@ void KickoutMonitor::clearKickout() {
 }
 
 
+void KickoutMonitor::logPressureHigh() const {
+    LOG_DEBUG(EventSource::AUTOSTEER, "Pressure high: %.1f (trip level %.0f, %s trip, rate %.0f/s)", 
+              pressureDetector.getValue(), pressureDetector.getConfig().tripLevel,
+              KickoutDetector::triggerName(pressureDetector.getTrigger()), pressureDetector.getRate());
+}
+
+void KickoutMonitor::trip(KickoutReason reason, uint32_t grabUs, uint32_t tripUs) {
+    kickoutActive = true;
+    kickoutReason = reason;
+    kickoutTime = millis();
+    
+    latency.grabUs = grabUs;
+    latency.tripUs = tripUs;
+    latency.released = false;
+}
+
+void KickoutMonitor::markMotorReleased() {
+    if (!kickoutActive || latency.released) {
+        return;
+    }
+    latency.releaseUs = micros();
+    latency.released = true;
+    latency.grabToTripUs = latency.tripUs - latency.grabUs;
+    latency.tripToReleaseUs = latency.releaseUs - latency.tripUs;
+    latency.grabToReleaseUs = latency.releaseUs - latency.grabUs;
+    if (latency.grabToReleaseUs > latency.maxGrabToReleaseUs) {
+        latency.maxGrabToReleaseUs = latency.grabToReleaseUs;
+    }
+    latency.count++;
+    
+    LOG_INFO(EventSource::AUTOSTEER, "KICKOUT latency: grab to trip %lu us, trip to release %lu us (%lu us total)",
+             latency.grabToTripUs, latency.tripToReleaseUs, latency.grabToReleaseUs);
+}
+
+void KickoutMonitor::resetLatencyStats() {
+    latency.maxGrabToReleaseUs = 0;
+    latency.count = 0;
+}
+
+void KickoutMonitor::applyConfig() {
+    // Force the detectors to be rebuilt with the new timing
+    detectorPressureMax = 0xFFFF;
+    detectorCurrentThreshold = 0xFFFF;
+    updateDetectorLevels();
+}
+
+void KickoutMonitor::updatePressureSource() {
+    // The pressure detector follows either the analog sensor or JD PWM
+    // motion; start over on a switch so no rate window spans both signals
+    bool jdPWM = configMgr->getJDPWMEnabled();
+    bool pressureSensor = configMgr->getPressureSensor();
+    if (jdPWM == detectorJDPWM && pressureSensor == detectorPressureSensor) {
+        return;
+    }
+    detectorJDPWM = jdPWM;
+    detectorPressureSensor = pressureSensor;
+    pressureDetector.reset();
+}
+
+void KickoutMonitor::updateDetectorLevels() {
+    uint16_t pressureMax = configMgr->getPulseCountMax();
+    uint8_t currentThreshold = configMgr->getCurrentThreshold();
+    if (pressureMax == detectorPressureMax && currentThreshold == detectorCurrentThreshold) {
+        return;
+    }
+    detectorPressureMax = pressureMax;
+    detectorCurrentThreshold = currentThreshold;
+    
+    const KickoutConfig& cfg = configMgr->getKickoutConfig();
+    float hysteresis = cfg.hysteresisPercent / 100.0f;
+    uint32_t riseWindowUs = cfg.riseWindowMs * 1000UL;
+    
+    // Pressure on the 0-255 PGN 250 scale, tripping above the threshold.
+    // Readings stop at 255, so a higher threshold trips at 255
+    KickoutDetectorConfig pressure;
+    pressure.tripLevel = min(pressureMax, (uint16_t)254) + 1.0f;
+    pressure.hysteresis = pressure.tripLevel * hysteresis;
+    pressure.debounceUs = cfg.pressureDebounceMs * 1000UL;
+    pressure.riseRate = cfg.pressureRiseRate;
+    pressure.riseWindowUs = riseWindowUs;
+    pressureDetector.configure(pressure);
+    
+    // Current in counts. The trip level keeps 10% over the configured
+    // threshold so direction-change spikes ride through
+    KickoutDetectorConfig current;
+    current.tripLevel = max(currentThreshold * CURRENT_FULL_SCALE / 255.0f * 1.1f, 1.0f);
+    current.hysteresis = current.tripLevel * hysteresis;
+    current.debounceUs = cfg.currentDebounceMs * 1000UL;
+    current.riseRate = cfg.currentRiseRate * CURRENT_FULL_SCALE / 100.0f;
+    current.riseWindowUs = riseWindowUs;
+    currentDetector.configure(current);
+    
+    LOG_DEBUG(EventSource::AUTOSTEER, "Kickout levels: pressure %.0f (-%.0f, %ums), current %.0f counts (-%.0f, %ums)",
+              pressure.tripLevel, pressure.hysteresis, cfg.pressureDebounceMs,
+              current.tripLevel, current.hysteresis, cfg.currentDebounceMs);
+}
+
+void KickoutMonitor::filterOutput(uint8_t channel, uint32_t value, uint32_t us, void* context) {
+    KickoutMonitor* self = static_cast<KickoutMonitor*>(context);
+    float counts = value / (float)(1 << AnalogFilter::FRACTION_BITS);
+    if (channel == ADProcessor::SCAN_PRESSURE) {
+        if (self->detectorJDPWM) {
+            return;     // Fed from the JD PWM duty cycle in process()
+        }
+        self->pressureDetector.update(min(counts * ADProcessor::PRESSURE_SCALE, 255.0f), us);
+    } else if (channel == ADProcessor::SCAN_CURRENT) {
+        self->currentDetector.update(counts, us);
+    }
+}
+
+void KickoutMonitor::printStatus() const {
+    if (!configMgr) {
+        Serial.print("\r\nKickout monitor not initialized\r\n");
+        return;
+    }
+    const KickoutConfig& cfg = configMgr->getKickoutConfig();
+    Serial.print("\r\n=== Kickout Detection ===");
+    Serial.printf("\r\nState: %s", kickoutActive ? getReasonString() : "armed");
+    Serial.printf("\r\nEncoder: %lu pulses (limit %u, debounce %ums)",
+                  encoderPulseCount, configMgr->getPulseCountMax(), cfg.encoderDebounceMs);
+    const KickoutDetector* detectors[] = { &pressureDetector, &currentDetector };
+    const char* names[] = { "Pressure", "Current" };
+    for (uint8_t i = 0; i < 2; i++) {
+        const KickoutDetector& d = *detectors[i];
+        const KickoutDetectorConfig& c = d.getConfig();
+        Serial.printf("\r\n%s: %.1f, rate %.0f/s (trip %.0f, clear %.0f, debounce %lums, rise %.0f/s) %s",
+                      names[i], d.getValue(), d.getRate(), c.tripLevel, c.tripLevel - c.hysteresis,
+                      c.debounceUs / 1000, c.riseRate, d.isTripped() ? KickoutDetector::triggerName(d.getTrigger()) : "");
+    }
+    if (latency.count > 0) {
+        Serial.printf("\r\nLast kickout: grab to trip %lu us, trip to release %lu us, total %lu us",
+                      latency.grabToTripUs, latency.tripToReleaseUs, latency.grabToReleaseUs);
+        Serial.printf("\r\nKickouts measured: %lu, worst grab to release %lu us",
+                      latency.count, latency.maxGrabToReleaseUs);
+    } else {
+        Serial.print("\r\nNo kickout measured yet");
+    }
+    Serial.print("\r\n=========================\r\n");
+}
+
 const char* KickoutMonitor::getReasonString() const {
     switch (kickoutReason) {
         case NONE: return "None";
@@ -3,6 +3,7 @@
 
 #include <Arduino.h>
 #include "MotorDriverInterface.h"
+#include "KickoutDetector.h"
 
 class ConfigManager;
 class ADProcessor;
@@ -12,6 +13,21 @@ class EncoderProcessor;
 class KickoutMonitor
 {
 public:
+    // Grab-to-release timing of the last kickout. "Grab" is the first sign of
+    // the operator: the first encoder pulse, the first sample over the
+    // level, or the start of the rising window
+    struct Latency {
+        uint32_t grabUs = 0;
+        uint32_t tripUs = 0;            // Detector decided
+        uint32_t releaseUs = 0;         // Motor disabled
+        bool released = false;
+        uint32_t grabToTripUs = 0;
+        uint32_t tripToReleaseUs = 0;
+        uint32_t grabToReleaseUs = 0;
+        uint32_t maxGrabToReleaseUs = 0;
+        uint32_t count = 0;             // Kickouts measured
+    };
+
     enum KickoutReason
     {
         NONE = 0,
@@ -50,6 +66,19 @@ public:
     // Clear kickout (after steering disabled)
     void clearKickout();
 
+    // Motor is stopped; completes the latency record of the current kickout
+    // (first call only)
+    void markMotorReleased();
+    const Latency& getLatency() const { return latency; }
+    void resetLatencyStats();
+
+    // Re-read debounce, hysteresis and rise settings (also picks up new
+    // thresholds from PGN 251 on the next process())
+    void applyConfig();
+
+    // Diagnostics
+    void printStatus() const;
+
     // Get current sensor value for PGN250 based on active turn sensor type
     uint8_t getTurnSensorReading() const;
 
@@ -80,14 +109,30 @@ private:
     uint16_t lastPressureReading;
     uint16_t lastCurrentReading;
 
-    // Current sensor spike filtering
-    uint32_t currentHighStartTime;
-    static constexpr uint32_t CURRENT_SPIKE_FILTER_MS = 1000; // 1 second - enough time for intentional wheel grab
+    // Pressure and current are judged on every filter output, encoder
+    // limit crossings are timestamped in its pin interrupt
+    KickoutDetector pressureDetector;
+    KickoutDetector currentDetector;
+    uint16_t detectorPressureMax;       // Thresholds the detectors were set up for
+    uint16_t detectorCurrentThreshold;
+    bool detectorJDPWM;                 // Pressure detector fed JD PWM motion, not the sensor
+    bool detectorPressureSensor;
+    uint32_t lastJDMotionUs;            // Last JD PWM motion value fed to the detector
+    uint32_t encoderGrabUs;             // Set by checkEncoderKickout()
+    uint32_t encoderTripUs;
+    static constexpr float CURRENT_FULL_SCALE = 1680.0f;   // Counts, PGN 250 = 255
 
     // Kickout state
     bool kickoutActive;
     KickoutReason kickoutReason;
     uint32_t kickoutTime;
+    Latency latency;
+
+    static void filterOutput(uint8_t channel, uint32_t value, uint32_t us, void* context);
+    void updateDetectorLevels();
+    void updatePressureSource();
+    void trip(KickoutReason reason, uint32_t grabUs, uint32_t tripUs);
+    void logPressureHigh() const;
 
     // Check individual kickout conditions
     bool checkEncoderKickout();
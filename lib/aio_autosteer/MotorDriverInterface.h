@@ -62,6 +62,10 @@ public:
     
     // Process function for drivers that need regular updates
     virtual void process() { }
+
+    // Consume queued feedback (e.g. CAN frames received by ISR) - called at the
+    // start of every autosteer tick so control sees the freshest data
+    virtual void processFeedback() { }
     
     // Detection and identification
     virtual bool isDetected() = 0;
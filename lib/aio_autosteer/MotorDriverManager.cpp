@@ -7,42 +7,18 @@ MotorDriverManager* MotorDriverManager::instance = nullptr;
 
 void MotorDriverManager::init() {
     LOG_INFO(EventSource::AUTOSTEER, "Initializing motor driver manager");
-    detectionStartTime = millis();
+    detectionComplete = false;
     
     // Read motor configuration from EEPROM
     readMotorConfig();
 }
 
 MotorDriverInterface* MotorDriverManager::detectAndCreateMotorDriver(HardwareManager* hwMgr, CANManager* canMgr) {
-    LOG_INFO(EventSource::AUTOSTEER, "Starting motor driver detection...");
-
-    // Initialize detection
-    init();
-
-    // First check if TractorCANDriver is configured
-    extern ConfigManager configManager;
-    CANSteerConfig canConfig = configManager.getCANSteerConfig();
-
-    if (canConfig.brand != 0) {  // 0 = DISABLED
-        // Use TractorCANDriver for all CAN-based steering
-        detectedType = MotorDriverType::TRACTOR_CAN;
-        detectionComplete = true;
-        LOG_INFO(EventSource::AUTOSTEER, "Using TractorCANDriver - Brand: %d", canConfig.brand);
-    } else {
-        // Original detection logic for non-CAN motors
-        // Wait for detection to complete (reduced to 1 second since no Keya auto-detect)
-        uint32_t startTime = millis();
-
-        while (!detectionComplete && (millis() - startTime) < 1100) {
-            performDetection(false);  // No more Keya auto-detection
-            delay(10);
-        }
-
-        // Force detection completion if timeout
-        if (!detectionComplete) {
-            LOG_DEBUG(EventSource::AUTOSTEER, "Detection timeout - using configured/default driver");
-            performDetection(false);
-        }
+    // Normally the probe already ran next to the other boot probes
+    if (!detectionComplete) {
+        DeviceDetector detector;
+        detector.add(getDeviceProbe());
+        detector.run();
     }
     
     const char* driverName = "Unknown";
@@ -98,38 +74,138 @@ MotorDriverInterface* MotorDriverManager::createMotorDriver(MotorDriverType type
     }
 }
 
-bool MotorDriverManager::performDetection(bool keyaHeartbeatDetected) {
-    if (detectionComplete) {
-        return true;
+MotorDriverInterface* MotorDriverManager::reconfigure(MotorDriverInterface* current,
+                                                     HardwareManager* hwMgr,
+                                                     CANManager* canMgr) {
+    uint32_t startUs = micros();
+    MotorDriverType previousType = current ? current->getType() : MotorDriverType::NONE;
+    
+    // Same precedence as the boot probe: CAN steering from config, then a
+    // Keya that answered on RS232 (not probed again - the motor is in use),
+    // then the PGN 251 motor bits
+    extern ConfigManager configManager;
+    if (configManager.getCANSteerConfig().brand != 0) {
+        detectedType = MotorDriverType::TRACTOR_CAN;
+        kickoutType = KickoutType::NONE;
+    } else if (previousType == MotorDriverType::KEYA_SERIAL) {
+        detectedType = MotorDriverType::KEYA_SERIAL;
+        kickoutType = KickoutType::NONE;
+    } else {
+        selectConfiguredDriver();
+    }
+    detectionComplete = true;
+    
+    if (current && detectedType == previousType) {
+        LOG_INFO(EventSource::AUTOSTEER, "Motor driver unchanged (%s)", current->getTypeName());
+        return current;
     }
     
-    // Priority 1: Check for Keya CAN heartbeat - DISABLED, now using TractorCANDriver
-    // if (keyaHeartbeatDetected) {
-    //     detectedType = MotorDriverType::KEYA_CAN;
-    //     kickoutType = KickoutType::NONE;  // Keya uses motor slip detection
-    //     LOG_INFO(EventSource::AUTOSTEER, "Detected Keya CAN motor via heartbeat");
-    //     detectionComplete = true;
-    //     return true;
-    // }
+    // Tear down first so the new driver can claim the same pins and timers
+    if (current) {
+        LOG_INFO(EventSource::AUTOSTEER, "Stopping %s", current->getTypeName());
+        current->setPWM(0);
+        current->enable(false);
+        current->stop();
+        delete current;
+    }
     
-    // Priority 2: Check for Keya Serial (after 1 second, if no CAN)
-    if (millis() - detectionStartTime > 1000 && !keyaSerialChecked) {
-        keyaSerialChecked = true;
-        if (probeKeyaSerial()) {
-            detectedType = MotorDriverType::KEYA_SERIAL;
-            kickoutType = KickoutType::NONE;  // Keya uses motor slip detection
-            LOG_INFO(EventSource::AUTOSTEER, "Detected Keya Serial motor via RS232");
-            detectionComplete = true;
-            return true;
-        }
+    MotorDriverInterface* driver = createMotorDriver(detectedType, hwMgr, canMgr);
+    if (driver && !driver->init()) {
+        LOG_ERROR(EventSource::AUTOSTEER, "%s failed to initialize", driver->getTypeName());
+        delete driver;
+        driver = nullptr;
     }
     
-    // Reduced wait time since Keya is now configured via web
-    if (millis() - detectionStartTime < 1000) {
-        return false;  // Still waiting
+    if (driver) {
+        LOG_INFO(EventSource::AUTOSTEER, "Motor driver switched to %s in %lu us",
+                 driver->getTypeName(), micros() - startUs);
     }
+    return driver;
+}
+
+void MotorDriverManager::DetectProbe::begin() {
+    MotorDriverManager* mgr = MotorDriverManager::getInstance();
+    LOG_INFO(EventSource::AUTOSTEER, "Starting motor driver detection...");
+    mgr->init();
+    responseIndex = 0;
+    startTime = millis();
+    querySent = false;
+
+    // TractorCANDriver handles all CAN-based steering, nothing to probe
+    extern ConfigManager configManager;
+    CANSteerConfig canConfig = configManager.getCANSteerConfig();
+    if (canConfig.brand != 0) {  // 0 = DISABLED
+        mgr->detectedType = MotorDriverType::TRACTOR_CAN;
+        mgr->kickoutType = KickoutType::NONE;
+        mgr->detectionComplete = true;
+        LOG_INFO(EventSource::AUTOSTEER, "Using TractorCANDriver - Brand: %d", canConfig.brand);
+        return;
+    }
+
+    // The query goes out from poll() once the motor has had time to start
+    LOG_INFO(EventSource::AUTOSTEER, "Probing for Keya Serial motor on RS232...");
+}
+
+bool MotorDriverManager::DetectProbe::poll() {
+    if (MotorDriverManager::getInstance()->detectionComplete) {
+        return true;
+    }
+
+    if (!querySent) {
+        if (millis() - startTime < KEYA_PROBE_SETTLE_MS) {
+            return false;
+        }
+        sendQuery();
+        querySent = true;
+        return false;
+    }
+
+    // Motor returns 5 bytes for the query
+    while (SerialRS232.available() && responseIndex < sizeof(response)) {
+        response[responseIndex++] = SerialRS232.read();
+    }
+    return responseIndex >= sizeof(response);
+}
+
+void MotorDriverManager::DetectProbe::sendQuery() {
+    // Keya Serial answers a 0xE2 (query speed) command with an echo
+    uint8_t queryCmd[4];
+    queryCmd[0] = 0xE2;
+    queryCmd[1] = 0x00;
+    queryCmd[2] = 0x00;
+    // Calculate checksum (sum of all bytes & 0xFF)
+    queryCmd[3] = (queryCmd[0] + queryCmd[1] + queryCmd[2]) & 0xFF;
     
-    // Priority 2: Check EEPROM configuration
+    // Clear any pending data
+    while (SerialRS232.available()) {
+        SerialRS232.read();
+    }
+    SerialRS232.write(queryCmd, 4);
+}
+
+void MotorDriverManager::DetectProbe::finish(bool timedOut) {
+    (void)timedOut;
+    MotorDriverManager* mgr = MotorDriverManager::getInstance();
+    if (mgr->detectionComplete) {
+        return;
+    }
+
+    // Valid echo: at least 4 bytes starting with 0xE2
+    if (responseIndex >= 4 && response[0] == 0xE2) {
+        LOG_INFO(EventSource::AUTOSTEER, "Keya Serial probe successful - got %d byte response", responseIndex);
+        mgr->detectedType = MotorDriverType::KEYA_SERIAL;
+        mgr->kickoutType = KickoutType::NONE;  // Keya uses motor slip detection
+        mgr->detectionComplete = true;
+        LOG_INFO(EventSource::AUTOSTEER, "Detected Keya Serial motor via RS232");
+        return;
+    }
+
+    LOG_DEBUG(EventSource::AUTOSTEER, "Keya Serial probe failed - got %d bytes", responseIndex);
+    mgr->selectConfiguredDriver();
+}
+
+void MotorDriverManager::selectConfiguredDriver() {
+    // No Keya on RS232 - use the EEPROM configuration
     switch (static_cast<MotorDriverConfig>(motorConfigByte)) {
         case MotorDriverConfig::DANFOSS_WHEEL_ENCODER:
             detectedType = MotorDriverType::DANFOSS;
@@ -162,7 +238,7 @@ bool MotorDriverManager::performDetection(bool keyaHeartbeatDetected) {
             break;
             
         default:
-            // Priority 3: Default to DRV8701 with wheel encoder
+            // Default to DRV8701 with wheel encoder
             detectedType = MotorDriverType::DRV8701;
             kickoutType = KickoutType::WHEEL_ENCODER;
             LOG_WARNING(EventSource::AUTOSTEER, "Unknown motor config 0x%02X, defaulting to DRV8701 with wheel encoder", motorConfigByte);
@@ -170,7 +246,6 @@ bool MotorDriverManager::performDetection(bool keyaHeartbeatDetected) {
     }
     
     detectionComplete = true;
-    return true;
 }
 
 void MotorDriverManager::updateMotorConfig(uint8_t configByte) {
@@ -180,47 +255,6 @@ void MotorDriverManager::updateMotorConfig(uint8_t configByte) {
     }
 }
 
-bool MotorDriverManager::probeKeyaSerial() {
-    // Send 0xE2 query command and check for echo response
-    LOG_INFO(EventSource::AUTOSTEER, "Probing for Keya Serial motor on RS232...");
-    
-    // Build query command (0xE2 = query speed)
-    uint8_t queryCmd[4];
-    queryCmd[0] = 0xE2;
-    queryCmd[1] = 0x00;
-    queryCmd[2] = 0x00;
-    // Calculate checksum (sum of all bytes & 0xFF)
-    queryCmd[3] = (queryCmd[0] + queryCmd[1] + queryCmd[2]) & 0xFF;
-    
-    // Clear any pending data
-    while (SerialRS232.available()) {
-        SerialRS232.read();
-    }
-    
-    // Send query
-    SerialRS232.write(queryCmd, 4);
-    
-    // Wait for response (up to 100ms)
-    uint32_t probeStart = millis();
-    uint8_t response[5];  // Motor returns 5 bytes for query
-    uint8_t responseIndex = 0;
-    
-    while (millis() - probeStart < 100 && responseIndex < 5) {
-        if (SerialRS232.available()) {
-            response[responseIndex++] = SerialRS232.read();
-        }
-    }
-    
-    // Check if we got a valid echo response (at least 4 bytes starting with 0xE2)
-    if (responseIndex >= 4 && response[0] == 0xE2) {
-        LOG_INFO(EventSource::AUTOSTEER, "Keya Serial probe successful - got %d byte response", responseIndex);
-        return true;
-    }
-    
-    LOG_DEBUG(EventSource::AUTOSTEER, "Keya Serial probe failed - got %d bytes", responseIndex);
-    return false;
-}
-
 void MotorDriverManager::readMotorConfig() {
     // Read from ConfigManager (EEPROM)
     extern ConfigManager configManager;
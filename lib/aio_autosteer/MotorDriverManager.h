@@ -13,6 +13,7 @@
 #include "CANManager.h"
 #include "EventLogger.h"
 #include "ConfigManager.h"
+#include "DeviceDetector.h"
 
 // Motor driver configuration values from PGN251 Byte 8
 enum class MotorDriverConfig : uint8_t {
@@ -31,21 +32,41 @@ private:
     MotorDriverType detectedType = MotorDriverType::NONE;
     KickoutType kickoutType = KickoutType::NONE;
     bool detectionComplete = false;
-    uint32_t detectionStartTime = 0;
-    bool keyaSerialChecked = false;
     
     // Configuration from EEPROM
     uint8_t motorConfigByte = 0x00;  // From PGN251 Byte 8
     
+    // Boot probe: CAN steering from config, else query a Keya on RS232,
+    // else fall back to the EEPROM motor config
+    class DetectProbe : public DeviceProbe {
+    public:
+        const char* getName() const override { return "Motor driver"; }
+        uint32_t getTimeoutMs() const override { return KEYA_PROBE_SETTLE_MS + KEYA_PROBE_TIMEOUT_MS; }
+        void begin() override;
+        bool poll() override;
+        void finish(bool timedOut) override;
+    private:
+        void sendQuery();
+        uint8_t response[5];
+        uint8_t responseIndex = 0;
+        uint32_t startTime = 0;
+        bool querySent = false;
+    };
+    DetectProbe detectProbe;
+    
     // Private constructor for singleton
     MotorDriverManager() {}
     
     // Internal detection methods
     void readMotorConfig();
-    bool performDetection(bool keyaHeartbeatDetected);
-    bool probeKeyaSerial();
+    void selectConfiguredDriver();
     
 public:
+    // A Keya on RS232 powers up with the module and ignores queries for a
+    // while; the old sequential detection queried it 1s after boot
+    static constexpr uint32_t KEYA_PROBE_SETTLE_MS = 1000;
+    static constexpr uint32_t KEYA_PROBE_TIMEOUT_MS = 100;
+
     static MotorDriverManager* getInstance() {
         if (instance == nullptr) {
             instance = new MotorDriverManager();
@@ -56,7 +77,10 @@ public:
     // Initialize detection process
     void init();
     
-    // Detect and create motor driver
+    // Non-blocking detection, for DeviceDetector at boot
+    DeviceProbe* getDeviceProbe() { return &detectProbe; }
+    
+    // Create the detected motor driver (detects first if the probe has not run)
     MotorDriverInterface* detectAndCreateMotorDriver(HardwareManager* hwMgr, CANManager* canMgr);
     
     // Create motor driver based on specific type
@@ -67,6 +91,15 @@ public:
     // Update motor configuration from PGN251
     void updateMotorConfig(uint8_t configByte);
     
+    // Swap the running driver for the one the current config selects,
+    // without a reboot. The old driver is stopped and deleted (releasing its
+    // pins and PWM claims) before the new one is built and initialized.
+    // Returns the driver to use from now on, which is current when the type
+    // is unchanged, or nullptr if the new driver failed to start
+    MotorDriverInterface* reconfigure(MotorDriverInterface* current,
+                                      HardwareManager* hwMgr,
+                                      CANManager* canMgr);
+    
     // Get detection results
     MotorDriverType getDetectedType() const { return detectedType; }
     KickoutType getKickoutType() const { return kickoutType; }
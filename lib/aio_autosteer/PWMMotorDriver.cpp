@@ -4,6 +4,7 @@
 #include "EventLogger.h"
 #include "HardwareManager.h"
 #include "ConfigManager.h"
+#include "ADProcessor.h"
 
 // External objects
 extern ConfigManager configManager;
@@ -31,9 +32,53 @@ PWMMotorDriver::PWMMotorDriver(MotorDriverType type, uint8_t pwm1, uint8_t pwm2,
     }
 }
 
+PWMMotorDriver::~PWMMotorDriver() {
+    HardwareManager* hwMgr = HardwareManager::getInstance();
+    hwMgr->releasePWMFrequency(pwm1Pin, "PWMMotorDriver");
+    hwMgr->releasePWMFrequency(pwm2Pin, "PWMMotorDriver");
+    hwMgr->releasePWMResolution("PWMMotorDriver");
+    
+    if (!pinsClaimed) {
+        return;  // init() never got the pins, leave them to their owner
+    }
+    
+    // Outputs low and the DRV8701 asleep before the pins change hands
+    analogWrite(pwm1Pin, 0);
+    analogWrite(pwm2Pin, 0);
+    hwMgr->releasePinOwnership(pwm1Pin, HardwareManager::OWNER_PWMMOTORDRIVER);
+    hwMgr->releasePinOwnership(pwm2Pin, HardwareManager::OWNER_PWMMOTORDRIVER);
+    if (enablePin != 255) {
+        digitalWrite(enablePin, LOW);
+        hwMgr->releasePinOwnership(enablePin, HardwareManager::OWNER_PWMMOTORDRIVER);
+    }
+    
+    LOG_INFO(EventSource::AUTOSTEER, "DRV8701 driver released pins %d/%d", pwm1Pin, pwm2Pin);
+}
+
 bool PWMMotorDriver::init() {
     LOG_INFO(EventSource::AUTOSTEER, "Initializing DRV8701 motor driver...");
     
+    HardwareManager* hwMgr = HardwareManager::getInstance();
+    
+    // Claim the bridge pins so a driver built at runtime cannot collide
+    // with one that is still being torn down
+    const uint8_t pins[] = {pwm1Pin, pwm2Pin, enablePin};
+    for (uint8_t i = 0; i < 3; i++) {
+        if (pins[i] == 255) {
+            continue;
+        }
+        if (!hwMgr->requestPinOwnership(pins[i], HardwareManager::OWNER_PWMMOTORDRIVER, "PWMMotorDriver")) {
+            while (i-- > 0) {
+                if (pins[i] != 255) {
+                    hwMgr->releasePinOwnership(pins[i], HardwareManager::OWNER_PWMMOTORDRIVER);
+                }
+            }
+            LOG_ERROR(EventSource::AUTOSTEER, "DRV8701 pins in use - motor driver not started");
+            return false;
+        }
+    }
+    pinsClaimed = true;
+    
     // Configure pins
     pinMode(pwm1Pin, OUTPUT);    // PWM1 (pin 5) for LEFT
     pinMode(pwm2Pin, OUTPUT);    // PWM2 (pin 6) for RIGHT
@@ -56,8 +101,6 @@ bool PWMMotorDriver::init() {
     analogWrite(pwm2Pin, 0);
     
     // Configure PWM for DRV8701 through HardwareManager
-    HardwareManager* hwMgr = HardwareManager::getInstance();
-    
     // Request 12-bit resolution to match PWMProcessor
     // We'll scale our 8-bit values to 12-bit
     if (!hwMgr->requestPWMResolution(12, "PWMMotorDriver")) {
@@ -86,11 +129,10 @@ void PWMMotorDriver::enable(bool en) {
         // This also controls the LOCK output through the same MOSFET
         digitalWrite(enablePin, en ? HIGH : LOW);
         
-        static bool lastState = false;
-        if (en != lastState) {
+        if (en != lastEnableLogged) {
             LOG_INFO(EventSource::AUTOSTEER, "Motor driver %s (nSLEEP/LOCK pin %d = %s)", 
                      en ? "ENABLED" : "DISABLED", enablePin, en ? "HIGH" : "LOW");
-            lastState = en;
+            lastEnableLogged = en;
         }
     }
     
@@ -125,29 +167,39 @@ void PWMMotorDriver::setPWM(int16_t pwm) {
     if (abs(pwm) == 255) pwmValue = 4096;
     
     // Check if brake mode is enabled
-    bool brakeMode = configManager.getPWMBrakeMode();
+    bool brakeMode = configManager.getControlConfig().pwmBrakeMode;
+    
+    // Duty written to each pin, kept for the debug log
+    uint16_t duty1 = 0;
+    uint16_t duty2 = 0;
     
     if (pwm < 0) {
         // LEFT direction
         if (brakeMode) {
             // Brake mode: PWM2 at (4096-pwmValue), PWM1 at 4096 (Hi-Z)
-            analogWrite(pwm2Pin, 4096 - pwmValue);  
-            analogWrite(pwm1Pin, 4096);
+            duty2 = 4096 - pwmValue;
+            duty1 = 4096;
+            analogWrite(pwm2Pin, duty2);  
+            analogWrite(pwm1Pin, duty1);
         } else {
             // Coast mode: PWM1 active, PWM2 low
-            analogWrite(pwm1Pin, pwmValue);     
+            duty1 = pwmValue;
+            analogWrite(pwm1Pin, duty1);     
             analogWrite(pwm2Pin, 0);            
         }
     } else if (pwm > 0) {
         // RIGHT direction
         if (brakeMode) {
             // Brake mode: PWM1 at (4096-pwmValue), PWM2 at 4096 (Hi-Z)
-            analogWrite(pwm1Pin, 4096 - pwmValue);  
-            analogWrite(pwm2Pin, 4096);
+            duty1 = 4096 - pwmValue;
+            duty2 = 4096;
+            analogWrite(pwm1Pin, duty1);  
+            analogWrite(pwm2Pin, duty2);
         } else {
             // Coast mode: PWM2 active, PWM1 low
+            duty2 = pwmValue;
             analogWrite(pwm1Pin, 0);            
-            analogWrite(pwm2Pin, pwmValue);     
+            analogWrite(pwm2Pin, duty2);     
         }
     } else {
         // Stop: both outputs LOW (same for both modes)
@@ -163,14 +215,14 @@ void PWMMotorDriver::setPWM(int16_t pwm) {
             LOG_DEBUG(EventSource::AUTOSTEER, "PWM %s mode: %d -> PWM1=%d, PWM2=%d, Current: %.2fA", 
                      brakeMode ? "BRAKE" : "COAST",
                      pwm, 
-                     analogRead(pwm1Pin),
-                     analogRead(pwm2Pin),
+                     duty1,
+                     duty2,
                      getCurrent());
         } else {
             LOG_DEBUG(EventSource::AUTOSTEER, "PWM: %d -> PWM1=%d, PWM2=%d", 
                      pwm, 
-                     pwm < 0 ? pwmValue : 0,
-                     pwm > 0 ? pwmValue : 0);
+                     duty1,
+                     duty2);
         }
     }
     
@@ -192,8 +244,13 @@ void PWMMotorDriver::stop() {
 float PWMMotorDriver::getCurrent() const {
     if (!hasCurrentSense) return 0.0f;
     
-    // Read ADC value (Teensy 4.1 has 12-bit ADC)
-    int adcValue = analogRead(currentPin);
+    // Latest sample from ADProcessor's background scan, which always covers
+    // the current pin. Never analogRead() here - it would fight the scan for
+    // the ADC. Nothing is reported until the scan has a sample (12-bit ADC)
+    uint16_t adcValue;
+    if (!ADProcessor::getInstance()->getScannedRaw(currentPin, adcValue)) {
+        return 0.0f;
+    }
     
     // Convert to voltage (3.3V reference)
     float voltage = (adcValue * 3.3f) / 4095.0f;
@@ -246,6 +303,10 @@ void PWMMotorDriver::setPWMFrequency(uint32_t freq) {
 }
 
 void PWMMotorDriver::handleKickout(KickoutType type, float value) {
+    // Disable the motor first; the log can wait
+    enable(false);
+    stop();
+    
     // Handle kickout based on type
     switch (type) {
         case KickoutType::WHEEL_ENCODER:
@@ -260,8 +321,4 @@ void PWMMotorDriver::handleKickout(KickoutType type, float value) {
         default:
             break;
     }
-    
-    // Disable the motor
-    enable(false);
-    stop();
 }
\ No newline at end of file
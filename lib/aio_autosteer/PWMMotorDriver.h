@@ -26,10 +26,13 @@ private:
     float currentScale;  // ADC to Amps conversion factor
     float currentOffset; // Zero current ADC offset
     
+    bool pinsClaimed = false;        // Output pins held through HardwareManager
+    bool lastEnableLogged = false;
+    
 public:
     PWMMotorDriver(MotorDriverType type, uint8_t pwm1, uint8_t pwm2, 
                    uint8_t enable = 255, uint8_t current = 255);
-    ~PWMMotorDriver() = default;
+    ~PWMMotorDriver();  // Puts the bridge to sleep and releases pins and PWM
     
     // MotorDriverInterface implementation
     bool init() override;
@@ -0,0 +1,71 @@
+// SimAnalogSource.h - AnalogSource driven by simulated time
+// Stands in for TeensyADCSource on the host. Scans are produced by
+// advanceTo() at the configured period, with values from a per-pin table
+// or a value function (e.g. a SteerPlant turned into WAS counts), so code
+// reading AnalogScan sees the same evenly spaced, timestamped samples it
+// gets on the board.
+#ifndef SIM_ANALOG_SOURCE_H
+#define SIM_ANALOG_SOURCE_H
+
+#include "AnalogScan.h"
+
+class SimAnalogSource : public AnalogSource {
+public:
+    typedef uint16_t (*ValueFunction)(uint8_t pin, uint32_t us, void* context);
+
+    const char* getName() const override { return "Simulated"; }
+
+    bool start(const uint8_t* pinList, uint8_t pinCount, uint32_t period,
+               SampleHandler sampleHandler, void* handlerContext) override {
+        if (pinCount > MAX_PINS || period == 0) {
+            return false;
+        }
+        for (uint8_t i = 0; i < pinCount; i++) {
+            pins[i] = pinList[i];
+        }
+        count = pinCount;
+        periodUs = period;
+        handler = sampleHandler;
+        context = handlerContext;
+        nextScanUs = nowUs + periodUs;
+        running = true;
+        return true;
+    }
+
+    void stop() override { running = false; }
+
+    void setValue(uint8_t pin, uint16_t raw) { values[pin] = raw; }
+    void setValueFunction(ValueFunction fn, void* fnContext) {
+        valueFunction = fn;
+        valueContext = fnContext;
+    }
+
+    // Run every scan due up to us, in order
+    void advanceTo(uint32_t us) {
+        while (running && (int32_t)(us - nextScanUs) >= 0) {
+            for (uint8_t i = 0; i < count; i++) {
+                uint16_t v = valueFunction ? valueFunction(pins[i], nextScanUs, valueContext) : values[pins[i]];
+                handler(i, v, nextScanUs, context);
+            }
+            nextScanUs += periodUs;
+        }
+        nowUs = us;
+    }
+
+    uint32_t getTimeUs() const { return nowUs; }
+
+private:
+    uint8_t pins[MAX_PINS] = {};
+    uint8_t count = 0;
+    uint32_t periodUs = 1000;
+    uint32_t nowUs = 0;
+    uint32_t nextScanUs = 0;
+    bool running = false;
+    SampleHandler handler = nullptr;
+    void* context = nullptr;
+    uint16_t values[256] = {};
+    ValueFunction valueFunction = nullptr;
+    void* valueContext = nullptr;
+};
+
+#endif // SIM_ANALOG_SOURCE_H
@@ -0,0 +1,122 @@
+// SimMotorDriver.h - Motor driver backed by a SteerPlant model
+// Stands in for a real driver so the autosteer loop can run closed against
+// a simulated steering system. Commands reach the plant the way the real
+// driver would deliver them: PWM drivers apply setPWM() at once, CAN/serial
+// drivers only on process() (the 50Hz transmit). After each plant step the
+// wheel angle is turned into WAS counts and handed to the WAS sink, normally
+// ADProcessor::injectWASRaw().
+#ifndef SIM_MOTOR_DRIVER_H
+#define SIM_MOTOR_DRIVER_H
+
+#include "MotorDriverInterface.h"
+#include "SteerPlant.h"
+
+class SimMotorDriver : public MotorDriverInterface {
+public:
+    typedef void (*WASSink)(int16_t raw, void* context);
+
+    // emulates: the driver type whose command timing to copy
+    SimMotorDriver(SteerPlant& plant, MotorDriverType emulates = MotorDriverType::GENERIC_PWM)
+        : plant(plant), emulates(emulates) {}
+
+    void setWASSink(WASSink sink, void* context) {
+        wasSink = sink;
+        wasContext = context;
+    }
+
+    // Same calibration ADProcessor uses to turn counts into degrees
+    void setWASCalibration(int16_t offset, float countsPerDegree, bool invert) {
+        wasOffset = offset;
+        wasCountsPerDegree = countsPerDegree;
+        wasInvert = invert;
+    }
+
+    // Step the plant and publish the new WAS reading
+    void advance(float dt) {
+        plant.step(dt);
+        if (wasSink) {
+            wasSink(wasRawFromAngle(plant.getWheelAngle()), wasContext);
+        }
+    }
+
+    // Inverse of ADProcessor::getWASAngle(), clamped to the 12-bit ADC
+    int16_t wasRawFromAngle(float angle) const {
+        if (wasInvert) {
+            angle = -angle;
+        }
+        float raw = 2048.0f + wasOffset + angle * wasCountsPerDegree;
+        if (raw < 0.0f) raw = 0.0f;
+        if (raw > 4095.0f) raw = 4095.0f;
+        return (int16_t)(raw + 0.5f);
+    }
+
+    SteerPlant& getPlant() { return plant; }
+
+    bool init() override { return true; }
+
+    void enable(bool en) override {
+        enabled = en;
+        if (!isTransmitted()) {
+            plant.setDrive(targetPWM, enabled);
+        }
+    }
+
+    void setPWM(int16_t pwm) override {
+        targetPWM = constrain(pwm, -255, 255);
+        if (!isTransmitted()) {
+            plant.setDrive(targetPWM, enabled);
+        }
+    }
+
+    void stop() override {
+        targetPWM = 0;
+        enabled = false;
+        plant.setDrive(0, false);
+    }
+
+    void process() override {
+        if (isTransmitted()) {
+            plant.setDrive(targetPWM, enabled);
+        }
+    }
+
+    MotorStatus getStatus() const override {
+        MotorStatus status = {};
+        status.enabled = enabled;
+        status.targetPWM = targetPWM;
+        status.actualPWM = plant.getMotorRPM() != 0.0f ? (int16_t)(plant.getMotorRPM() * 255.0f / 100.0f)
+                                                       : targetPWM;
+        status.errorMessage[0] = '\0';
+        return status;
+    }
+
+    MotorDriverType getType() const override { return emulates; }
+    const char* getTypeName() const override { return "Simulated"; }
+    bool hasCurrentSensing() const override { return false; }
+    bool hasPositionFeedback() const override { return false; }
+    bool isDetected() override { return true; }
+    void handleKickout(KickoutType, float) override { stop(); }
+    float getCurrentDraw() override { return 0.0f; }
+
+    float getActualRPM() const { return plant.getMotorRPM(); }
+
+private:
+    SteerPlant& plant;
+    MotorDriverType emulates;
+    bool enabled = false;
+    int16_t targetPWM = 0;
+
+    WASSink wasSink = nullptr;
+    void* wasContext = nullptr;
+    int16_t wasOffset = 0;
+    float wasCountsPerDegree = 100.0f;
+    bool wasInvert = false;
+
+    // CAN and serial drivers only send on process()
+    bool isTransmitted() const {
+        return emulates == MotorDriverType::KEYA_CAN || emulates == MotorDriverType::KEYA_SERIAL ||
+               emulates == MotorDriverType::TRACTOR_CAN;
+    }
+};
+
+#endif // SIM_MOTOR_DRIVER_H
@@ -0,0 +1,222 @@
+// SteerAngleEKF.cpp - Extended Kalman filter for the front wheel angle
+#include "SteerAngleEKF.h"
+#include <math.h>
+
+namespace {
+
+constexpr float DEG_PER_RAD = 57.2957795f;
+constexpr float MIN_VARIANCE = 1e-6f;
+constexpr float MAX_VARIANCE = 1e4f;
+constexpr uint16_t MIN_SAMPLES_TO_ADAPT = 10;
+
+// Initial 1-sigma uncertainty per state: angle, rate, encoder bias, yaw bias
+constexpr float INITIAL_SIGMA[SteerAngleEKF::STATE_COUNT] = {10.0f, 10.0f, 10.0f, 1.0f};
+
+} // namespace
+
+void SteerAngleEKF::setParams(const Params& p) {
+    params = p;
+    if (params.innovationWindow < 2) {
+        params.innovationWindow = 2;
+    }
+    for (uint8_t s = 0; s < SENSOR_COUNT; s++) {
+        stats[s].innovation.window = params.innovationWindow;
+        if (stats[s].innovation.count > params.innovationWindow) {
+            stats[s].innovation.count = params.innovationWindow;
+        }
+    }
+}
+
+void SteerAngleEKF::reset(float angle) {
+    for (uint8_t i = 0; i < STATE_COUNT; i++) {
+        x[i] = 0.0f;
+        for (uint8_t j = 0; j < STATE_COUNT; j++) {
+            P[i][j] = 0.0f;
+        }
+        P[i][i] = INITIAL_SIGMA[i] * INITIAL_SIGMA[i];
+    }
+    x[ANGLE] = angle;
+
+    for (uint8_t s = 0; s < SENSOR_COUNT; s++) {
+        stats[s].innovation.window = params.innovationWindow;
+        stats[s].innovation.reset();
+        stats[s].accepted = 0;
+        stats[s].rejected = 0;
+        stats[s].lastInnovation = 0.0f;
+        stats[s].lastFusedUs = 0;
+    }
+
+    nowUs = 0;
+    historyHead = 0;
+    historyCount = 0;
+}
+
+void SteerAngleEKF::predict(float dt, uint32_t timeUs) {
+    nowUs = timeUs;
+    if (dt > 0.0f) {
+        // x' = F x with F = I except angle += rate * dt
+        x[ANGLE] += x[RATE] * dt;
+        if (x[ANGLE] > params.maxAngle) {
+            x[ANGLE] = params.maxAngle;
+        } else if (x[ANGLE] < -params.maxAngle) {
+            x[ANGLE] = -params.maxAngle;
+        }
+
+        // P' = F P F^T, written out for the single off-diagonal term
+        P[ANGLE][ANGLE] += dt * (P[RATE][ANGLE] + P[ANGLE][RATE]) + dt * dt * P[RATE][RATE];
+        for (uint8_t j = RATE; j < STATE_COUNT; j++) {
+            P[ANGLE][j] += dt * P[RATE][j];
+            P[j][ANGLE] = P[ANGLE][j];
+        }
+
+        // Q: white angle acceleration, random-walk biases
+        float q = params.rateNoise;
+        P[ANGLE][ANGLE] += q * dt * dt * dt / 3.0f;
+        P[ANGLE][RATE] += q * dt * dt / 2.0f;
+        P[RATE][ANGLE] = P[ANGLE][RATE];
+        P[RATE][RATE] += q * dt;
+        P[ENCODER_BIAS][ENCODER_BIAS] += params.encoderBiasNoise * dt;
+        P[YAW_BIAS][YAW_BIAS] += params.yawBiasNoise * dt;
+
+        // Unobserved states must not grow without bound
+        for (uint8_t i = 0; i < STATE_COUNT; i++) {
+            if (P[i][i] > MAX_VARIANCE) {
+                P[i][i] = MAX_VARIANCE;
+            }
+        }
+    }
+
+    history[historyHead].us = nowUs;
+    history[historyHead].angle = x[ANGLE];
+    historyHead = (historyHead + 1) % HISTORY_SIZE;
+    if (historyCount < HISTORY_SIZE) {
+        historyCount++;
+    }
+}
+
+float SteerAngleEKF::angleAt(uint16_t latencyMs) const {
+    if (latencyMs == 0 || historyCount == 0) {
+        return x[ANGLE];
+    }
+    uint32_t sampleUs = nowUs - (uint32_t)latencyMs * 1000UL;
+
+    // Newest entry taken at or before the sample time, else the oldest held
+    uint8_t index = historyHead;
+    for (uint8_t n = 0; n < historyCount; n++) {
+        index = (index + HISTORY_SIZE - 1) % HISTORY_SIZE;
+        if ((int32_t)(history[index].us - sampleUs) <= 0) {
+            break;
+        }
+    }
+    return history[index].angle;
+}
+
+float SteerAngleEKF::yawRateFromAngle(float angle, float speed) const {
+    return speed * tanf(angle / DEG_PER_RAD) / params.wheelbase * DEG_PER_RAD;
+}
+
+float SteerAngleEKF::angleFromYawRate(float yawRate, float speed) const {
+    if (speed < params.minSpeed) {
+        return 0.0f;
+    }
+    return atanf(yawRate / DEG_PER_RAD * params.wheelbase / speed) * DEG_PER_RAD;
+}
+
+bool SteerAngleEKF::fuseWAS(float angle) {
+    const float H[STATE_COUNT] = {1.0f, 0.0f, 0.0f, 0.0f};
+    return update(WAS, H, angle - angleAt(params.latencyMs[WAS]));
+}
+
+bool SteerAngleEKF::fuseEncoder(float encoderAngle) {
+    const float H[STATE_COUNT] = {1.0f, 0.0f, 1.0f, 0.0f};
+    float predicted = angleAt(params.latencyMs[ENCODER]) + x[ENCODER_BIAS];
+    return update(ENCODER, H, encoderAngle - predicted);
+}
+
+bool SteerAngleEKF::fuseYawRate(Sensor sensor, float yawRate, float speed) {
+    if (speed < params.minSpeed || (sensor != GNSS_HEADING_RATE && sensor != IMU_YAW_RATE)) {
+        return false;
+    }
+    bool hasBias = sensor == IMU_YAW_RATE;
+
+    // h(x) = v tan(angle) / L (+ bias), linearised at the delayed angle
+    float angle = angleAt(params.latencyMs[sensor]);
+    float t = tanf(angle / DEG_PER_RAD);
+    float predicted = yawRateFromAngle(angle, speed) + (hasBias ? x[YAW_BIAS] : 0.0f);
+    const float H[STATE_COUNT] = {speed / params.wheelbase * (1.0f + t * t), 0.0f, 0.0f, hasBias ? 1.0f : 0.0f};
+    return update(sensor, H, yawRate - predicted);
+}
+
+bool SteerAngleEKF::update(Sensor sensor, const float H[STATE_COUNT], float innovation) {
+    SensorStats& s = stats[sensor];
+    s.lastInnovation = innovation;
+
+    float PHt[STATE_COUNT];
+    for (uint8_t i = 0; i < STATE_COUNT; i++) {
+        PHt[i] = 0.0f;
+        for (uint8_t j = 0; j < STATE_COUNT; j++) {
+            PHt[i] += P[i][j] * H[j];
+        }
+    }
+    float HPHt = 0.0f;
+    for (uint8_t i = 0; i < STATE_COUNT; i++) {
+        HPHt += H[i] * PHt[i];
+    }
+
+    // R from the configured noise, raised to what the innovations show
+    float sigma = params.sensorNoise[sensor];
+    float R = sigma * sigma;
+    if (s.innovation.count >= MIN_SAMPLES_TO_ADAPT) {
+        float observed = s.innovation.variance() - HPHt;
+        if (observed > R) {
+            R = observed;
+        }
+    }
+    float S = HPHt + R;
+    if (S <= MIN_VARIANCE) {
+        return false;
+    }
+
+    if (innovation * innovation > params.gateSigma * params.gateSigma * S) {
+        s.rejected++;
+        return false;
+    }
+
+    float K[STATE_COUNT];
+    for (uint8_t i = 0; i < STATE_COUNT; i++) {
+        K[i] = PHt[i] / S;
+        x[i] += K[i] * innovation;
+    }
+    if (x[ANGLE] > params.maxAngle) {
+        x[ANGLE] = params.maxAngle;
+    } else if (x[ANGLE] < -params.maxAngle) {
+        x[ANGLE] = -params.maxAngle;
+    }
+
+    // P = P - K (HP), kept symmetric and positive on the diagonal
+    for (uint8_t i = 0; i < STATE_COUNT; i++) {
+        for (uint8_t j = i; j < STATE_COUNT; j++) {
+            float value = P[i][j] - K[i] * PHt[j];
+            P[i][j] = value;
+            P[j][i] = value;
+        }
+        if (P[i][i] < MIN_VARIANCE) {
+            P[i][i] = MIN_VARIANCE;
+        }
+    }
+
+    s.innovation.add(innovation);
+    s.accepted++;
+    s.lastFusedUs = nowUs;
+    return true;
+}
+
+const char* SteerAngleEKF::sensorName(Sensor sensor) {
+    switch (sensor) {
+        case WAS: return "WAS";
+        case ENCODER: return "Encoder";
+        case GNSS_HEADING_RATE: return "GNSS heading rate";
+        case IMU_YAW_RATE: return "IMU yaw rate";
+        default: return "Unknown";
+    }
+}
@@ -0,0 +1,172 @@
+// SteerAngleEKF.h - Extended Kalman filter for the front wheel angle
+// State: wheel angle (deg), angle rate (deg/s), encoder bias (deg) and
+// yaw-rate sensor bias (deg/s). Fuses any mix of:
+//   WAS                 angle
+//   motor encoder       angle + encoder bias (relative, accumulated counts)
+//   GNSS heading rate   speed * tan(angle) / wheelbase
+//   IMU yaw rate        speed * tan(angle) / wheelbase + yaw bias
+// The two yaw-rate measurements make it extended: the Jacobian is taken at
+// the current angle every update.
+//
+// Each sensor has a latency. The innovation is formed against the angle
+// the filter had when the sample was taken (a short history ring) and the
+// correction applied to the current state, which is good enough for the
+// 10-150ms delays involved. Measurement noise adapts to the running
+// innovation variance (windowed Welford, O(1)), and innovations outside
+// the gate are rejected.
+//
+// Plain C++ with fixed storage and no Arduino dependencies so host tools
+// can replay logs through the same filter.
+#ifndef STEER_ANGLE_EKF_H
+#define STEER_ANGLE_EKF_H
+
+#include <stdint.h>
+
+// Running mean and variance (Welford). Once count reaches the window the
+// oldest share is forgotten each sample, so it follows slow changes.
+struct RunningVariance {
+    uint16_t window = 50;
+    uint16_t count = 0;
+    float mean = 0.0f;
+    float m2 = 0.0f;
+
+    void reset() {
+        count = 0;
+        mean = 0.0f;
+        m2 = 0.0f;
+    }
+
+    void add(float x) {
+        if (count < window) {
+            count++;
+        } else {
+            m2 -= m2 / count;
+        }
+        float delta = x - mean;
+        mean += delta / count;
+        m2 += delta * (x - mean);
+    }
+
+    float variance() const { return count > 1 ? m2 / (count - 1) : 0.0f; }
+};
+
+// Heading rate from successive GNSS headings. Sentences from the same epoch
+// (closer than minIntervalMs) are skipped; a gap over maxIntervalMs
+// restarts the rate.
+struct HeadingRateTracker {
+    uint32_t minIntervalMs = 50;
+    uint32_t maxIntervalMs = 500;
+    float rate = 0.0f;              // deg/s
+    float lastHeading = 0.0f;
+    uint32_t lastMs = 0;
+    bool started = false;
+
+    void reset() {
+        rate = 0.0f;
+        started = false;
+    }
+
+    // Returns true when a new rate was computed
+    bool update(uint32_t ms, float heading) {
+        uint32_t elapsed = ms - lastMs;
+        if (!started || elapsed > maxIntervalMs) {
+            lastHeading = heading;
+            lastMs = ms;
+            started = true;
+            return false;
+        }
+        if (elapsed < minIntervalMs) {
+            return false;
+        }
+        float delta = heading - lastHeading;
+        // Handle wrap-around at 0/360 degrees
+        if (delta > 180.0f) delta -= 360.0f;
+        if (delta < -180.0f) delta += 360.0f;
+        rate = delta * 1000.0f / elapsed;
+        lastHeading = heading;
+        lastMs = ms;
+        return true;
+    }
+};
+
+class SteerAngleEKF {
+public:
+    enum StateIndex : uint8_t { ANGLE, RATE, ENCODER_BIAS, YAW_BIAS, STATE_COUNT };
+    enum Sensor : uint8_t { WAS, ENCODER, GNSS_HEADING_RATE, IMU_YAW_RATE, SENSOR_COUNT };
+
+    struct Params {
+        float wheelbase = 2.5f;             // m
+        float maxAngle = 40.0f;             // deg
+        float minSpeed = 0.5f;              // m/s, yaw rate carries no angle information below this
+        float rateNoise = 200.0f;           // Angle acceleration noise (deg/s^2)^2 per Hz
+        float encoderBiasNoise = 0.01f;     // deg^2 per s
+        float yawBiasNoise = 0.001f;        // (deg/s)^2 per s
+        float gateSigma = 5.0f;             // Reject innovations beyond this many sigma
+        float sensorNoise[SENSOR_COUNT] = {0.3f, 0.1f, 0.5f, 0.3f};     // 1 sigma, deg or deg/s
+        uint16_t latencyMs[SENSOR_COUNT] = {0, 20, 100, 10};
+        uint16_t innovationWindow = 50;     // Samples in the adaptive noise estimate
+    };
+
+    struct SensorStats {
+        RunningVariance innovation;
+        uint32_t accepted;
+        uint32_t rejected;
+        float lastInnovation;
+        uint32_t lastFusedUs;           // Time of the last accepted sample
+    };
+
+    // Longest latency the history can cover is HISTORY_SIZE ticks
+    static constexpr uint8_t HISTORY_SIZE = 128;
+
+    SteerAngleEKF() { reset(); }
+
+    void setParams(const Params& p);
+    const Params& getParams() const { return params; }
+
+    void reset(float angle = 0.0f);
+
+    // Propagate the state by dt seconds; nowUs timestamps the history
+    void predict(float dt, uint32_t nowUs);
+
+    // Scalar updates, each returns false if gated out or not applicable
+    bool fuseWAS(float angle);
+    bool fuseEncoder(float encoderAngle);
+    bool fuseYawRate(Sensor sensor, float yawRate, float speed);   // GNSS_HEADING_RATE or IMU_YAW_RATE
+
+    float getAngle() const { return x[ANGLE]; }
+    float getRate() const { return x[RATE]; }
+    float getEncoderBias() const { return x[ENCODER_BIAS]; }
+    float getYawBias() const { return x[YAW_BIAS]; }
+    float getAngleVariance() const { return P[ANGLE][ANGLE]; }
+    const SensorStats& getStats(Sensor sensor) const { return stats[sensor]; }
+    uint32_t getTimeUs() const { return nowUs; }
+
+    // Angle the vehicle should be steering at for a yaw rate (Ackermann)
+    float angleFromYawRate(float yawRate, float speed) const;
+
+    static const char* sensorName(Sensor sensor);
+
+private:
+    Params params;
+    float x[STATE_COUNT];
+    float P[STATE_COUNT][STATE_COUNT];
+    SensorStats stats[SENSOR_COUNT];
+    uint32_t nowUs;
+
+    struct HistoryEntry {
+        uint32_t us;
+        float angle;
+    };
+    HistoryEntry history[HISTORY_SIZE];
+    uint8_t historyHead;
+    uint8_t historyCount;
+
+    // Angle estimate latencyMs ago, from the history ring
+    float angleAt(uint16_t latencyMs) const;
+    float yawRateFromAngle(float angle, float speed) const;
+
+    // Generic scalar measurement update with gating and adaptive noise
+    bool update(Sensor sensor, const float H[STATE_COUNT], float innovation);
+};
+
+#endif // STEER_ANGLE_EKF_H
@@ -0,0 +1,77 @@
+// SteerController.cpp - PID steering controller with feed-forward
+#include "SteerController.h"
+#include <math.h>
+
+void SteerController::reset() {
+    integral = 0.0f;
+    lastActual = 0.0f;
+    actualRate = 0.0f;
+    primed = false;
+    terms = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+}
+
+float SteerController::update(const Params& params, float target, float targetRate, float actual, float dt) {
+    if (dt <= 0.0f) {
+        return terms.output;
+    }
+
+    float error = actual - target;
+
+    // Derivative on the measurement so target steps from AgOpenGPS (10Hz)
+    // do not kick the output; the target's motion is covered by feed-forward
+    if (!primed) {
+        lastActual = actual;
+        actualRate = 0.0f;
+        primed = true;
+    }
+    float rawRate = (actual - lastActual) / dt;
+    lastActual = actual;
+    if (params.dFilterHz > 0.0f) {
+        float rc = 1.0f / (2.0f * (float)M_PI * params.dFilterHz);
+        actualRate += (dt / (dt + rc)) * (rawRate - actualRate);
+    } else {
+        actualRate = rawRate;
+    }
+
+    float p = params.kp * error;
+    float d = params.kd * actualRate;
+    float ff = -params.kff * targetRate;    // Positive output lowers the angle
+
+    // Anti-windup: only integrate while the output is not already pushing
+    // past the limit in the direction the error would add to
+    if (params.ki > 0.0f) {
+        float output = p + integral + d + ff;
+        bool windingUp = (output >= params.outputLimit && error > 0.0f) ||
+                         (output <= -params.outputLimit && error < 0.0f);
+        if (!windingUp) {
+            integral += params.ki * error * dt;
+        }
+        if (integral > params.integralLimit) {
+            integral = params.integralLimit;
+        } else if (integral < -params.integralLimit) {
+            integral = -params.integralLimit;
+        }
+    } else {
+        integral = 0.0f;
+    }
+
+    terms.error = error;
+    terms.p = p;
+    terms.i = integral;
+    terms.d = d;
+    terms.ff = ff;
+    terms.output = p + integral + d + ff;
+    return terms.output;
+}
+
+float SteerController::scheduleGain(float speed, float speedLow, float speedHigh,
+                                    float scaleLow, float scaleHigh) {
+    if (speedHigh <= speedLow || speed <= speedLow) {
+        return scaleLow;
+    }
+    if (speed >= speedHigh) {
+        return scaleHigh;
+    }
+    float t = (speed - speedLow) / (speedHigh - speedLow);
+    return scaleLow + t * (scaleHigh - scaleLow);
+}
@@ -0,0 +1,58 @@
+// SteerController.h - PID steering controller with feed-forward
+// Turns wheel angle error into a raw motor drive in PWM units, ahead of the
+// minPWM / highPWM / soft-start shaping in AutosteerProcessor. The sign
+// follows the original P-only loop: error = actual - target.
+//
+// Plain C++ with no Arduino dependencies so tools/steer_bench.cpp can run
+// the same code against a plant model on the host.
+#ifndef STEER_CONTROLLER_H
+#define STEER_CONTROLLER_H
+
+#include <stdint.h>
+
+class SteerController {
+public:
+    struct Params {
+        float kp = 0.0f;                // PWM per degree (PGN 252)
+        float ki = 0.0f;                // PWM per degree-second
+        float kd = 0.0f;                // PWM per degree/s, on the measured angle
+        float kff = 0.0f;               // PWM per degree/s of target change
+        float integralLimit = 50.0f;    // PWM
+        float outputLimit = 255.0f;     // highPWM; integration stops at the limit
+        float dFilterHz = 10.0f;        // Derivative low-pass cutoff, 0 = off
+    };
+
+    // Last update, for diagnostics
+    struct Terms {
+        float error;
+        float p;
+        float i;
+        float d;
+        float ff;
+        float output;
+    };
+
+    SteerController() { reset(); }
+
+    // Clear integral and derivative history (motor disabled)
+    void reset();
+
+    // One control step. targetRate is the target angle change in deg/s.
+    float update(const Params& params, float target, float targetRate, float actual, float dt);
+
+    // Gain multiplier interpolated between (speedLow, scaleLow) and
+    // (speedHigh, scaleHigh), flat outside that range
+    static float scheduleGain(float speed, float speedLow, float speedHigh,
+                              float scaleLow, float scaleHigh);
+
+    const Terms& getTerms() const { return terms; }
+
+private:
+    float integral;
+    float lastActual;
+    float actualRate;               // Filtered d(actual)/dt
+    bool primed;
+    Terms terms;
+};
+
+#endif // STEER_CONTROLLER_H
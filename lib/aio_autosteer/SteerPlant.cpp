@@ -0,0 +1,138 @@
+// SteerPlant.cpp - Steering plant models for closed-loop simulation
+#include "SteerPlant.h"
+#include <math.h>
+
+namespace {
+
+// First-order lag step, stable for any dt
+float lag(float value, float target, float timeConstant, float dt) {
+    if (timeConstant <= 0.0f) {
+        return target;
+    }
+    return value + (target - value) * dt / (timeConstant + dt);
+}
+
+} // namespace
+
+void SteerPlant::reset() {
+    drivePWM = 0.0f;
+    driveEnabled = false;
+    wheelAngle = 0.0f;
+}
+
+void SteerPlant::moveWheels(float delta) {
+    wheelAngle += delta;
+    if (wheelAngle > maxAngle) {
+        wheelAngle = maxAngle;
+    } else if (wheelAngle < -maxAngle) {
+        wheelAngle = -maxAngle;
+    }
+}
+
+void DCMotorPlant::reset() {
+    SteerPlant::reset();
+    rate = 0.0f;
+    motorAngle = 0.0f;
+}
+
+void DCMotorPlant::step(float dt) {
+    float pwm = driveEnabled ? drivePWM : 0.0f;
+    float targetRate = 0.0f;
+    if (fabsf(pwm) > params.stictionPWM) {
+        targetRate = -pwm / 255.0f * params.degPerSecAtFull;
+    }
+    rate = lag(rate, targetRate, params.timeConstant, dt);
+    motorAngle += rate * dt;
+
+    // The wheels only follow once the motor has taken up the free play
+    float halfGap = params.backlashDeg * 0.5f;
+    float offset = motorAngle - wheelAngle;
+    if (offset > halfGap) {
+        moveWheels(offset - halfGap);
+    } else if (offset < -halfGap) {
+        moveWheels(offset + halfGap);
+    }
+    // Motor stays inside the gap around the wheels when they hit a stop
+    if (motorAngle > wheelAngle + halfGap) {
+        motorAngle = wheelAngle + halfGap;
+    } else if (motorAngle < wheelAngle - halfGap) {
+        motorAngle = wheelAngle - halfGap;
+    }
+}
+
+void OrbitalValvePlant::reset() {
+    SteerPlant::reset();
+    for (uint16_t i = 0; i < MAX_DELAY_STEPS; i++) {
+        delayLine[i] = 0.0f;
+    }
+    delayHead = 0;
+    flow = 0.0f;
+}
+
+void OrbitalValvePlant::step(float dt) {
+    // Transport delay as a ring of past commands, one per step
+    uint16_t delaySteps = 0;
+    if (dt > 0.0f) {
+        float steps = params.deadTime / dt;
+        delaySteps = steps >= MAX_DELAY_STEPS - 1 ? MAX_DELAY_STEPS - 1 : (uint16_t)steps;
+    }
+    delayLine[delayHead] = driveEnabled ? drivePWM : 0.0f;
+    uint16_t tail = (delayHead + MAX_DELAY_STEPS - delaySteps) % MAX_DELAY_STEPS;
+    float pwm = delayLine[tail];
+    delayHead = (delayHead + 1) % MAX_DELAY_STEPS;
+
+    float targetFlow = 0.0f;
+    if (fabsf(pwm) > params.deadbandPWM) {
+        // Flow starts at the edge of the overlap
+        float open = pwm > 0.0f ? pwm - params.deadbandPWM : pwm + params.deadbandPWM;
+        targetFlow = -open / (255.0f - params.deadbandPWM) * params.degPerSecAtFull;
+    }
+    flow = lag(flow, targetFlow, params.spoolTimeConstant, dt);
+    moveWheels(flow * dt);
+}
+
+void KeyaPlant::reset() {
+    SteerPlant::reset();
+    rpm = 0.0f;
+}
+
+void KeyaPlant::step(float dt) {
+    // Motor is free (no holding torque) while disabled
+    float commanded = driveEnabled ? drivePWM * params.maxRPM / 255.0f : 0.0f;
+    float maxChange = params.rpmPerSec * dt;
+    float change = commanded - rpm;
+    if (change > maxChange) {
+        change = maxChange;
+    } else if (change < -maxChange) {
+        change = -maxChange;
+    }
+    rpm += change;
+    moveWheels(-rpm / 60.0f * params.degPerRev * dt);
+}
+
+float KeyaPlant::getMotorRPM() const {
+    if (params.rpmResolution <= 0.0f) {
+        return rpm;
+    }
+    return roundf(rpm / params.rpmResolution) * params.rpmResolution;
+}
+
+void VehicleModel::reset(float startX, float startY, float startHeading) {
+    x = startX;
+    y = startY;
+    heading = startHeading;
+    yawRate = 0.0f;
+}
+
+void VehicleModel::step(float speed, float wheelAngleDeg, float dt) {
+    const float degToRad = (float)M_PI / 180.0f;
+    yawRate = speed * tanf(wheelAngleDeg * degToRad) / wheelbase / degToRad;
+    heading += yawRate * dt;
+    if (heading >= 360.0f) {
+        heading -= 360.0f;
+    } else if (heading < 0.0f) {
+        heading += 360.0f;
+    }
+    x += speed * sinf(heading * degToRad) * dt;
+    y += speed * cosf(heading * degToRad) * dt;
+}
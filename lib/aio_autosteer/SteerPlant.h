@@ -0,0 +1,144 @@
+// SteerPlant.h - Steering plant models for closed-loop simulation
+// Each model takes the motor command AutosteerProcessor would send (PWM
+// -255..255) and integrates the front wheel angle. SimMotorDriver wraps
+// one behind MotorDriverInterface; tools/steer_bench.cpp runs them on the
+// host. Sign convention follows the firmware: positive PWM lowers the angle
+// (error = actual - target).
+//
+// Plain C++ with fixed storage and no Arduino dependencies.
+#ifndef STEER_PLANT_H
+#define STEER_PLANT_H
+
+#include <stdint.h>
+
+class SteerPlant {
+public:
+    virtual ~SteerPlant() = default;
+
+    virtual const char* getName() const = 0;
+    virtual void reset();
+
+    // Latest motor command; disabled means no drive (valve closed, motor free)
+    void setDrive(float pwm, bool enabled) {
+        drivePWM = pwm;
+        driveEnabled = enabled;
+    }
+
+    // Advance the model by dt seconds
+    virtual void step(float dt) = 0;
+
+    float getWheelAngle() const { return wheelAngle; }
+    virtual float getMotorRPM() const { return 0.0f; }     // RPM feedback, if the actuator has it
+
+    void setMaxAngle(float degrees) { maxAngle = degrees; }
+
+protected:
+    float drivePWM = 0.0f;
+    bool driveEnabled = false;
+    float wheelAngle = 0.0f;            // Degrees, + right
+    float maxAngle = 40.0f;             // Steering stops
+
+    // Moves the wheels by delta degrees against the stops
+    void moveWheels(float delta);
+};
+
+// Brushed DC motor on the steering wheel (Cytron / IBT-2 / DRV8701 boards)
+// with first-order speed response, stiction and gear backlash
+class DCMotorPlant : public SteerPlant {
+public:
+    struct Params {
+        float degPerSecAtFull = 40.0f;  // Wheel rate at PWM 255
+        float timeConstant = 0.05f;     // Motor speed lag (s)
+        float stictionPWM = 15.0f;      // Below this the motor stalls
+        float backlashDeg = 0.5f;       // Free play between motor and wheels
+    };
+
+    DCMotorPlant() { reset(); }
+    explicit DCMotorPlant(const Params& p) : params(p) { reset(); }
+
+    const char* getName() const override { return "DC motor"; }
+    void reset() override;
+    void step(float dt) override;
+
+private:
+    Params params;
+    float rate = 0.0f;                  // Motor side, deg/s at the wheels
+    float motorAngle = 0.0f;            // Motor side position, deg at the wheels
+};
+
+// Orbital (Danfoss style) steering valve: spool lag, deadband and transport
+// delay from the hydraulics before the cylinder moves
+class OrbitalValvePlant : public SteerPlant {
+public:
+    struct Params {
+        float degPerSecAtFull = 30.0f;  // Cylinder rate at PWM 255
+        float spoolTimeConstant = 0.08f;
+        float deadbandPWM = 25.0f;      // Spool overlap
+        float deadTime = 0.04f;         // Command to flow (s)
+    };
+
+    // Longest dead time at 2kHz steps
+    static constexpr uint16_t MAX_DELAY_STEPS = 512;
+
+    OrbitalValvePlant() { reset(); }
+    explicit OrbitalValvePlant(const Params& p) : params(p) { reset(); }
+
+    const char* getName() const override { return "orbital valve"; }
+    void reset() override;
+    void step(float dt) override;
+
+private:
+    Params params;
+    float delayLine[MAX_DELAY_STEPS];
+    uint16_t delayHead = 0;
+    float flow = 0.0f;                  // deg/s
+};
+
+// Keya CAN motor: PWM maps to an RPM command (255 = 100 RPM, as in
+// KeyaCANDriver), the internal speed loop slews to it and reports RPM back
+class KeyaPlant : public SteerPlant {
+public:
+    struct Params {
+        float maxRPM = 100.0f;          // At PWM 255
+        float rpmPerSec = 600.0f;       // Speed loop acceleration limit
+        float degPerRev = 20.0f;        // Wheel degrees per motor revolution
+        float rpmResolution = 0.1f;     // Heartbeat quantisation
+    };
+
+    KeyaPlant() { reset(); }
+    explicit KeyaPlant(const Params& p) : params(p) { reset(); }
+
+    const char* getName() const override { return "Keya"; }
+    void reset() override;
+    void step(float dt) override;
+    float getMotorRPM() const override;
+
+private:
+    Params params;
+    float rpm = 0.0f;
+};
+
+// Kinematic bicycle model with the wheelbase WheelAngleFusion uses:
+// yaw rate = speed * tan(wheel angle) / wheelbase
+class VehicleModel {
+public:
+    explicit VehicleModel(float wheelbase = 2.5f) : wheelbase(wheelbase) {}
+
+    void reset(float x = 0.0f, float y = 0.0f, float heading = 0.0f);
+    void step(float speed, float wheelAngleDeg, float dt);     // speed in m/s
+
+    float getX() const { return x; }               // m, east
+    float getY() const { return y; }               // m, north
+    float getHeading() const { return heading; }   // Degrees, 0 = north, + clockwise
+    float getYawRate() const { return yawRate; }   // deg/s
+    float getWheelbase() const { return wheelbase; }
+
+private:
+    float wheelbase;
+    float x = 0.0f;
+    float y = 0.0f;
+    float heading = 0.0f;
+    float yawRate = 0.0f;
+};
+
+#endif // STEER_PLANT_H
@@ -0,0 +1,106 @@
+// TeensyADCSource.cpp - AnalogSource on the Teensy 4.1 ADCs
+#include "TeensyADCSource.h"
+#include "EventLogger.h"
+
+TeensyADCSource* TeensyADCSource::active = nullptr;
+
+bool TeensyADCSource::start(const uint8_t* pins, uint8_t count, uint32_t periodUs,
+                            SampleHandler sampleHandler, void* handlerContext) {
+    stop();
+    if (!adc || count > MAX_PINS) {
+        return false;
+    }
+
+    sequences[0].module = adc->adc0;
+    sequences[1].module = adc->adc1;
+    sequences[0].count = 0;
+    sequences[1].count = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        bool on0 = adc->adc0->checkPin(pins[i]);
+        bool on1 = adc->adc1->checkPin(pins[i]);
+        if (!on0 && !on1) {
+            LOG_ERROR(EventSource::AUTOSTEER, "ADC scan: pin %d is not an analog input", pins[i]);
+            return false;
+        }
+        Sequence& seq = (on0 && (!on1 || sequences[0].count <= sequences[1].count)) ? sequences[0] : sequences[1];
+        seq.pins[seq.count] = pins[i];
+        seq.slots[seq.count] = i;
+        seq.count++;
+    }
+
+    handler = sampleHandler;
+    context = handlerContext;
+    overruns = 0;
+    active = this;
+
+    if (sequences[0].count) adc->adc0->enableInterrupts(adc0ISR);
+    if (sequences[1].count) adc->adc1->enableInterrupts(adc1ISR);
+    if (!timer.begin(timerISR, periodUs)) {
+        LOG_ERROR(EventSource::AUTOSTEER, "ADC scan: no IntervalTimer free");
+        stop();
+        return false;
+    }
+
+    LOG_INFO(EventSource::AUTOSTEER, "ADC scan every %luus: %d pins on ADC0, %d on ADC1",
+             periodUs, sequences[0].count, sequences[1].count);
+    return true;
+}
+
+void TeensyADCSource::stop() {
+    if (active != this) {
+        return;
+    }
+    timer.end();
+    adc->adc0->disableInterrupts();
+    adc->adc1->disableInterrupts();
+    sequences[0].busy = false;
+    sequences[1].busy = false;
+    active = nullptr;
+}
+
+void TeensyADCSource::timerISR() {
+    TeensyADCSource* self = active;
+    if (!self) {
+        return;
+    }
+    for (Sequence& seq : self->sequences) {
+        if (seq.count == 0) {
+            continue;
+        }
+        if (seq.busy) {
+            // Last scan still converting - the period is too short for the
+            // averaging/speed settings
+            self->overruns++;
+            continue;
+        }
+        seq.busy = true;
+        seq.index = 0;
+        seq.module->startSingleRead(seq.pins[0]);
+    }
+}
+
+void TeensyADCSource::adc0ISR() {
+    if (active) {
+        active->conversionDone(active->sequences[0]);
+    }
+}
+
+void TeensyADCSource::adc1ISR() {
+    if (active) {
+        active->conversionDone(active->sequences[1]);
+    }
+}
+
+void TeensyADCSource::conversionDone(Sequence& seq) {
+    // Reading the result clears the interrupt
+    uint16_t value = (uint16_t)seq.module->readSingle();
+    if (!seq.busy) {
+        return;
+    }
+    handler(seq.slots[seq.index], value, micros(), context);
+    if (++seq.index < seq.count) {
+        seq.module->startSingleRead(seq.pins[seq.index]);
+    } else {
+        seq.busy = false;
+    }
+}
@@ -0,0 +1,54 @@
+// TeensyADCSource.h - AnalogSource on the Teensy 4.1 ADCs
+// An IntervalTimer starts each scan; every conversion-complete interrupt
+// reads its result and starts the next pin, so the CPU never waits on a
+// conversion. Each pin goes to whichever ADC can convert it, preferring the
+// less loaded one, and the two modules run their sequences in parallel.
+// Averaging and speed are whatever the ADC modules were configured with.
+#ifndef TEENSY_ADC_SOURCE_H
+#define TEENSY_ADC_SOURCE_H
+
+#include <Arduino.h>
+#include <ADC.h>
+#include "AnalogScan.h"
+
+class TeensyADCSource : public AnalogSource {
+public:
+    explicit TeensyADCSource(ADC* adc) : adc(adc) {}
+    ~TeensyADCSource() override { stop(); }
+
+    const char* getName() const override { return "Teensy ADC"; }
+
+    bool start(const uint8_t* pins, uint8_t count, uint32_t periodUs,
+               SampleHandler handler, void* context) override;
+    void stop() override;
+    uint32_t getOverruns() const override { return overruns; }
+
+    // Pins on each module, for diagnostics
+    uint8_t getPinCount(uint8_t module) const { return module < 2 ? sequences[module].count : 0; }
+
+private:
+    struct Sequence {
+        ADC_Module* module = nullptr;
+        uint8_t pins[MAX_PINS];
+        uint8_t slots[MAX_PINS];
+        uint8_t count = 0;
+        volatile uint8_t index = 0;
+        volatile bool busy = false;
+    };
+
+    ADC* adc;
+    Sequence sequences[2];
+    IntervalTimer timer;
+    SampleHandler handler = nullptr;
+    void* context = nullptr;
+    volatile uint32_t overruns = 0;
+
+    // ISRs are static; only one source can run at a time
+    static TeensyADCSource* active;
+    static void timerISR();
+    static void adc0ISR();
+    static void adc1ISR();
+    void conversionDone(Sequence& seq);
+};
+
+#endif // TEENSY_ADC_SOURCE_H
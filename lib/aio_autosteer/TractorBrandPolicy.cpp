@@ -0,0 +1,564 @@
+// TractorBrandPolicy.cpp - Per-brand CAN steering protocols
+#include "TractorBrandPolicy.h"
+#include "EventLogger.h"
+
+// ===== Receive routes =====
+// Every frame a brand consumes is listed here once and programmed into the
+// FlexCAN RX mailboxes, so unrelated tractor traffic is dropped in hardware.
+// Handlers still check the ID themselves and report frames they ignore.
+const TractorRoute KeyaPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x07000001, true  },     // Heartbeat
+};
+const TractorRoute CaseIHPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0CACAA08, true  },
+    { CANBusRole::BUTTON, 0x14FF7706, true  },
+    { CANBusRole::BUTTON, 0x18FE4523, true  },
+};
+const TractorRoute CATMTPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0FFF9880, true  },
+    { CANBusRole::BUTTON, 0x18F00400, true  },
+};
+const TractorRoute ClaasPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0CAC1E13, true  },
+    { CANBusRole::BUTTON, 0x18EF1CD2, true  },
+};
+const TractorRoute FendtPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0CEF2CF0, true  },
+    { CANBusRole::BUTTON, 0x613,      false },
+};
+const TractorRoute JcbPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0CACAB13, true  },
+    { CANBusRole::BUTTON, 0x18EFAB27, true  },
+    { CANBusRole::BUTTON, 0x0CEFAB27, true  },
+};
+const TractorRoute LindnerPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0CACF013, true  },
+    { CANBusRole::BUTTON, 0x0CEFF021, true  },
+};
+// Engage IDs 0x18EF1Cxx are not routed until they are acted on
+const TractorRoute ValtraMasseyPolicy::ROUTES[] = {
+    { CANBusRole::STEER,  0x0CAC1C13, true  },
+    { CANBusRole::BUTTON, 0x0CFF2621, true  },
+};
+
+#define ROUTE_COUNT_OF(Policy) const uint8_t Policy::ROUTE_COUNT = sizeof(Policy::ROUTES) / sizeof(Policy::ROUTES[0])
+ROUTE_COUNT_OF(KeyaPolicy);
+ROUTE_COUNT_OF(CaseIHPolicy);
+ROUTE_COUNT_OF(CATMTPolicy);
+ROUTE_COUNT_OF(ClaasPolicy);
+ROUTE_COUNT_OF(FendtPolicy);
+ROUTE_COUNT_OF(JcbPolicy);
+ROUTE_COUNT_OF(LindnerPolicy);
+ROUTE_COUNT_OF(ValtraMasseyPolicy);
+#undef ROUTE_COUNT_OF
+
+TractorBrandPolicy* TractorBrandPolicy::create(TractorBrand brand, bool keya, TractorCANState& state) {
+    // A Keya bus overrides the brand
+    if (keya) {
+        return new KeyaPolicy(state);
+    }
+
+    switch (brand) {
+        case TractorBrand::CASEIH_NH:     return new CaseIHPolicy(state);
+        case TractorBrand::CAT_MT:        return new CATMTPolicy(state);
+        case TractorBrand::CLAAS:         return new ClaasPolicy(state);
+        case TractorBrand::FENDT:         return new FendtPolicy(state, false);
+        case TractorBrand::FENDT_ONE:     return new FendtPolicy(state, true);
+        case TractorBrand::JCB:           return new JcbPolicy(state);
+        case TractorBrand::LINDNER:       return new LindnerPolicy(state);
+        case TractorBrand::VALTRA_MASSEY: return new ValtraMasseyPolicy(state);
+        default:                          return nullptr;
+    }
+}
+
+void TractorBrandPolicy::recordRx(CANBusRxStats& stats, bool accepted, uint32_t ageUs, uint32_t cycles) {
+    if (!accepted) {
+        stats.filtered++;
+        return;
+    }
+
+    stats.accepted++;
+    stats.latencyLastUs = ageUs;
+    if (ageUs > stats.latencyMaxUs) {
+        stats.latencyMaxUs = ageUs;
+    }
+    stats.handlerCyclesTotal += cycles;
+    if (cycles > stats.handlerCyclesMax) {
+        stats.handlerCyclesMax = cycles;
+    }
+}
+
+void TractorBrandPolicy::setValveReady(bool ready, const char* brandName) {
+    if (ready) {
+        if (!state.steerReady) {
+            LOG_INFO(EventSource::AUTOSTEER, "%s steering valve ready", brandName);
+        }
+        state.steerReady = true;
+        state.lastSteerReadyTime = millis();
+    } else {
+        if (state.steerReady) {
+            LOG_WARNING(EventSource::AUTOSTEER, "%s steering valve not ready", brandName);
+        }
+        state.steerReady = false;
+    }
+}
+
+void TractorBrandPolicy::sendCurveCommand(uint32_t id, uint8_t fill) {
+    // Only send if we have a valid steering bus
+    if (!state.steerBus) return;
+
+    CAN_message_t msg;
+    msg.id = id;
+    msg.flags.extended = 1;  // Extended ID (29-bit)
+    msg.len = 8;
+
+    // Convert PWM to curve value
+    int16_t setCurve = 0;
+    if (state.enabled && state.steerReady) {
+        // Scale PWM to curve value
+        setCurve = (int16_t)(state.targetPWM * 128);  // Scale factor TBD
+    }
+
+    // Build message (little-endian curve)
+    msg.buf[0] = setCurve & 0xFF;        // Curve low byte
+    msg.buf[1] = (setCurve >> 8) & 0xFF; // Curve high byte
+    msg.buf[2] = state.enabled ? 253 : 252;  // 253 = steer intent, 252 = no intent
+    for (uint8_t i = 3; i < 8; i++) {
+        msg.buf[i] = fill;              // 0xFF on Case IH/Claas/JCB/Lindner, 0 on Valtra
+    }
+
+    state.steerBus->writeSteer(0, msg);
+}
+
+// ===== Keya Implementation =====
+bool KeyaPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for heartbeat message (ID: 0x07000001)
+    if (msg.id != 0x07000001 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Heartbeat format (big-endian/MSB first):
+    // Bytes 0-1: Position/Angle (uint16)
+    // Bytes 2-3: Speed/RPM (int16)
+    // Bytes 4-5: Current (int16)
+    // Bytes 6-7: Error code (uint16)
+
+    state.motorPosition = (uint16_t)((msg.buf[0] << 8) | msg.buf[1]);
+
+    int16_t speedRaw = (int16_t)((msg.buf[2] << 8) | msg.buf[3]);
+    state.actualRPM = (float)speedRaw;
+
+    int16_t currentRaw = (int16_t)((msg.buf[4] << 8) | msg.buf[5]);
+    state.motorCurrent = (uint16_t)abs(currentRaw);
+
+    state.motorErrorCode = (uint16_t)((msg.buf[6] << 8) | msg.buf[7]);
+
+    // Update status
+    if (!state.steerReady) {
+        LOG_INFO(EventSource::AUTOSTEER, "Keya motor detected and ready");
+    }
+    state.steerReady = true;
+    state.heartbeatValid = true;
+    state.lastSteerReadyTime = millis();
+    state.lastHeartbeat = millis();
+    return true;
+}
+
+void KeyaPolicy::sendCommands() {
+    if (!state.steerBus) return;
+
+    // Enable (or disable) and speed go out every tick through the two
+    // reserved steering mailboxes - enable first, it has the lower mailbox
+    CAN_message_t msg;
+    msg.id = 0x06000001;
+    msg.flags.extended = 1;
+    msg.len = 8;
+    msg.buf[0] = 0x23;
+    msg.buf[1] = state.enabled ? 0x0D : 0x0C;  // Enable / disable (keeps CAN alive)
+    msg.buf[2] = 0x20;
+    msg.buf[3] = 0x01;
+    msg.buf[4] = 0x00;
+    msg.buf[5] = 0x00;
+    msg.buf[6] = 0x00;
+    msg.buf[7] = 0x00;
+    state.steerBus->writeSteer(0, msg);
+
+    // Speed command, zero while disabled
+    int32_t speedValue = state.enabled ? (int32_t)(state.commandedRPM * 10.0f) : 0;  // -1000 to +1000
+    msg.buf[1] = 0x00;  // Speed command
+    msg.buf[4] = (speedValue >> 8) & 0xFF;   // DATA_L(H)
+    msg.buf[5] = speedValue & 0xFF;          // DATA_L(L)
+    msg.buf[6] = (speedValue >> 24) & 0xFF;  // DATA_H(H)
+    msg.buf[7] = (speedValue >> 16) & 0xFF;  // DATA_H(L)
+    state.steerBus->writeSteer(1, msg);
+}
+
+// ===== Fendt Implementation =====
+bool FendtPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for Fendt valve status message (0x0CEF2CF0)
+    if (msg.id != 0x0CEF2CF0 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Special valve ready detection for Fendt
+    // If message length is 3 and byte 2 is 0, valve is NOT ready
+    if (msg.len == 3 && msg.buf[2] == 0) {
+        setValveReady(false, "Fendt");
+    } else {
+        setValveReady(true, "Fendt");
+
+        // Extract curve value if available (for feedback)
+        if (msg.len >= 2) {
+            // Fendt uses big-endian format
+            int16_t estCurve = (msg.buf[0] << 8) | msg.buf[1];
+            state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+        }
+    }
+    return true;
+}
+
+void FendtPolicy::sendCommands() {
+    if (!state.steerBus) return;
+
+    CAN_message_t msg;
+    msg.id = 0x0CEFF02C;  // Fendt steering command ID
+    msg.flags.extended = 1;
+    msg.len = 6;  // Fendt uses 6-byte messages
+
+    // Fixed bytes
+    msg.buf[0] = 0x05;
+    msg.buf[1] = 0x09;
+    msg.buf[3] = 0x0A;
+
+    if (state.enabled && state.steerReady) {
+        // Active steering
+        msg.buf[2] = 0x03;  // Steer active
+
+        // Calculate Fendt curve value with offset
+        int16_t fendtCurve = state.targetPWM - 32128;
+
+        // Big-endian format (MSB first)
+        msg.buf[4] = (fendtCurve >> 8) & 0xFF;
+        msg.buf[5] = fendtCurve & 0xFF;
+    } else {
+        // Inactive steering
+        msg.buf[2] = 0x02;  // Steer inactive
+        msg.buf[4] = 0x00;
+        msg.buf[5] = 0x00;
+    }
+
+    state.steerBus->writeSteer(0, msg);
+}
+
+bool FendtPolicy::onButtonFrame(const CAN_message_t& msg) {
+    // Check for Fendt armrest buttons (0x613 - Standard ID, not extended!)
+    if (msg.id != 0x613 || msg.flags.extended) {
+        return false;
+    }
+
+    // Check for button state in byte 1
+    bool buttonState = (msg.buf[1] & 0x80) != 0;
+
+    // Check for auto steer active state (disables valve)
+    if (msg.buf[1] == 0x8A && msg.buf[4] == 0x80) {
+        // Auto steer is active on the tractor - set valve not ready
+        if (state.steerReady) {
+            LOG_INFO(EventSource::AUTOSTEER, "Fendt auto steer active - disabling valve");
+        }
+        state.steerReady = false;
+    }
+
+    // Track button state changes for autosteer control
+    if (buttonState != buttonPressed) {
+        buttonPressed = buttonState;
+        LOG_INFO(EventSource::AUTOSTEER, "Fendt armrest button %s",
+                 buttonState ? "pressed" : "released");
+    }
+    return true;
+}
+
+// ===== Case IH/New Holland Implementation =====
+bool CaseIHPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for valve status message (0x0CACAA08)
+    if (msg.id != 0x0CACAA08 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Extract steering curve (little-endian)
+    int16_t estCurve = msg.buf[0] | (msg.buf[1] << 8);
+    state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+
+    // Check valve ready (byte 2)
+    setValveReady(msg.buf[2] != 0, "Case IH");
+    return true;
+}
+
+bool CaseIHPolicy::onButtonFrame(const CAN_message_t& msg) {
+    if (!msg.flags.extended) {
+        return false;
+    }
+
+    // Check for engage message (0x14FF7706)
+    if (msg.id == 0x14FF7706) {
+        // Two possible engage conditions:
+        // 1) Buf[0] == 130 && Buf[1] == 1
+        // 2) Buf[0] == 178 && Buf[4] == 1
+        bool newEngageState = ((msg.buf[0] == 130 && msg.buf[1] == 1) ||
+                               (msg.buf[0] == 178 && msg.buf[4] == 1));
+
+        if (newEngageState != engaged) {
+            engaged = newEngageState;
+            LOG_INFO(EventSource::AUTOSTEER, "Case IH engage %s",
+                     engaged ? "ON" : "OFF");
+        }
+        return true;
+    }
+
+    // Check for rear hitch information (0x18FE4523)
+    if (msg.id == 0x18FE4523) {
+        // Byte 0 contains rear hitch pressure status
+        // Log it for future use
+        if (msg.buf[0] != lastHitchStatus) {
+            lastHitchStatus = msg.buf[0];
+            LOG_DEBUG(EventSource::AUTOSTEER, "Case IH rear hitch status: 0x%02X", msg.buf[0]);
+        }
+        return true;
+    }
+    return false;
+}
+
+// ===== CAT MT Series Implementation =====
+bool CATMTPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for curve data message (0x0FFF9880)
+    if (msg.id != 0x0FFF9880 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Extract steering curve from bytes 4-5 (big-endian)
+    int16_t estCurve = (msg.buf[4] << 8) | msg.buf[5];
+    state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+
+    // Check valve ready - curve value between 15000 and 17000
+    if (estCurve >= 15000 && estCurve <= 17000) {
+        if (!state.steerReady) {
+            LOG_INFO(EventSource::AUTOSTEER, "CAT MT steering valve ready (curve=%d)", estCurve);
+        }
+        state.steerReady = true;
+        state.lastSteerReadyTime = millis();
+    } else {
+        if (state.steerReady) {
+            LOG_WARNING(EventSource::AUTOSTEER, "CAT MT steering valve not ready (curve=%d)", estCurve);
+        }
+        state.steerReady = false;
+    }
+    return true;
+}
+
+void CATMTPolicy::sendCommands() {
+    // Only send if we have a valid steering bus
+    if (!state.steerBus) return;
+
+    CAN_message_t msg;
+    msg.id = 0x0EF87F80;  // CAT MT steering command ID
+    msg.flags.extended = 1;  // Extended ID (29-bit)
+    msg.len = 8;
+
+    // Convert PWM to CAT curve value with special calculation
+    int16_t setCurve = 0;
+    if (state.enabled && state.steerReady) {
+        // Scale PWM to curve value
+        int16_t scaledPWM = (int16_t)(state.targetPWM * 128);  // Scale factor TBD
+
+        // CAT MT special curve calculation: curve = setCurve - 2048
+        // So to send the desired curve, we need: setCurve = curve + 2048
+        // (the guide notes special handling for negatives - not yet known)
+        setCurve = scaledPWM + 2048;
+    }
+
+    // Build message
+    msg.buf[0] = 0x40;  // Fixed values for bytes 0-1
+    msg.buf[1] = 0x01;
+    msg.buf[2] = (setCurve >> 8) & 0xFF;  // Curve high byte (big-endian)
+    msg.buf[3] = setCurve & 0xFF;         // Curve low byte
+    msg.buf[4] = 0xFF;  // Fixed 0xFF for bytes 4-7
+    msg.buf[5] = 0xFF;
+    msg.buf[6] = 0xFF;
+    msg.buf[7] = 0xFF;
+
+    state.steerBus->writeSteer(0, msg);
+}
+
+bool CATMTPolicy::onButtonFrame(const CAN_message_t& msg) {
+    // Check for engage message (0x18F00400)
+    if (msg.id != 0x18F00400 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Engage if (Buf[0] & 0x0F) == 4
+    bool newEngageState = ((msg.buf[0] & 0x0F) == 4);
+
+    if (newEngageState != engaged) {
+        engaged = newEngageState;
+        LOG_INFO(EventSource::AUTOSTEER, "CAT MT engage %s",
+                 engaged ? "ON" : "OFF");
+    }
+    return true;
+}
+
+// ===== CLAAS Implementation =====
+bool ClaasPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for valve status message (0x0CAC1E13)
+    if (msg.id != 0x0CAC1E13 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Extract steering curve (little-endian)
+    int16_t estCurve = msg.buf[0] | (msg.buf[1] << 8);
+    state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+
+    // Check valve ready (byte 2)
+    setValveReady(msg.buf[2] != 0, "Claas");
+    return true;
+}
+
+bool ClaasPolicy::onButtonFrame(const CAN_message_t& msg) {
+    // Check for engage message (0x18EF1CD2)
+    if (msg.id != 0x18EF1CD2 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Engage conditions: Buf[1] == 0x81 OR Buf[1] == 0xF1
+    bool newEngageState = (msg.buf[1] == 0x81 || msg.buf[1] == 0xF1);
+
+    if (newEngageState != engaged) {
+        engaged = newEngageState;
+        LOG_INFO(EventSource::AUTOSTEER, "Claas engage %s",
+                 engaged ? "ON" : "OFF");
+    }
+    return true;
+}
+
+// ===== JCB Implementation =====
+bool JcbPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for valve status message (0x0CACAB13)
+    // Module ID: 0xAB
+    if (msg.id != 0x0CACAB13 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Extract steering curve (little-endian)
+    int16_t estCurve = msg.buf[0] | (msg.buf[1] << 8);
+    state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+
+    // Check valve ready (byte 2)
+    setValveReady(msg.buf[2] != 0, "JCB");
+    return true;
+}
+
+bool JcbPolicy::onButtonFrame(const CAN_message_t& msg) {
+    // Check for engage message (0x18EFAB27 or 0x0CEFAB27)
+    if ((msg.id != 0x18EFAB27 && msg.id != 0x0CEFAB27) || !msg.flags.extended) {
+        return false;
+    }
+
+    // Message received = engaged
+    if (!engaged) {
+        engaged = true;
+        LOG_INFO(EventSource::AUTOSTEER, "JCB engage ON");
+    }
+    return true;
+}
+
+// ===== Lindner Implementation =====
+bool LindnerPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for valve status message (0x0CACF013)
+    // Module ID: 0xF0
+    if (msg.id != 0x0CACF013 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Extract steering curve (little-endian)
+    int16_t estCurve = msg.buf[0] | (msg.buf[1] << 8);
+    state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+
+    // Check valve ready (byte 2)
+    setValveReady(msg.buf[2] != 0, "Lindner");
+    return true;
+}
+
+bool LindnerPolicy::onButtonFrame(const CAN_message_t& msg) {
+    // Check for engage message (0x0CEFF021)
+    if (msg.id != 0x0CEFF021 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Message received = engaged
+    if (!engaged) {
+        engaged = true;
+        LOG_INFO(EventSource::AUTOSTEER, "Lindner engage ON");
+    }
+    return true;
+}
+
+// ===== Valtra/Massey Implementation =====
+bool ValtraMasseyPolicy::onSteerFrame(const CAN_message_t& msg) {
+    // Check for curve data and valve state message
+    if (msg.id != 0x0CAC1C13 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Extract steering curve (little-endian)
+    int16_t estCurve = (msg.buf[1] << 8) | msg.buf[0];
+
+    // Extract valve ready state from byte 2 (not-ready is left to the timeout)
+    if (msg.buf[2] != 0) {
+        setValveReady(true, "Valtra");
+    }
+
+    // Store actual position for feedback (convert to our scale)
+    // Valtra curve range appears to be different from our PWM range
+    state.actualRPM = (float)estCurve / 100.0f;  // Store as scaled value
+    return true;
+}
+
+bool ValtraMasseyPolicy::onButtonFrame(const CAN_message_t& msg) {
+    // Check for K_Bus button status message (0xCFF2621)
+    if (msg.id != 0x0CFF2621 || !msg.flags.extended) {
+        return false;
+    }
+
+    // Store the entire message for rolling counter
+    memcpy(rollingCounter, msg.buf, 8);
+
+    // Check bit 2 of byte 3 for engage button state
+    bool newEngageState = (msg.buf[3] & 0x04) != 0;
+
+    if (newEngageState != engageButtonPressed) {
+        engageButtonPressed = newEngageState;
+        LOG_INFO(EventSource::AUTOSTEER, "Massey K_Bus engage button %s",
+                 engageButtonPressed ? "pressed" : "released");
+    }
+    return true;
+}
+
+void ValtraMasseyPolicy::sendFunctionButton(uint8_t bit, const char* name) {
+    if (!state.buttonBus) return;
+
+    CAN_message_t msg;
+    msg.id = 0x0CFF2621;  // K_Bus button command
+    msg.flags.extended = 1;
+    msg.len = 8;
+
+    // Increment rolling counter in byte 6
+    rollingCounter[6] = (rollingCounter[6] + 1) & 0xFF;
+
+    // Copy the last received message as base
+    memcpy(msg.buf, rollingCounter, 8);
+
+    // Set F1 (bit 4) or F2 (bit 5) of byte 3
+    msg.buf[3] |= bit;
+
+    state.buttonBus->write(msg);
+
+    LOG_INFO(EventSource::AUTOSTEER, "Massey %s button pressed", name);
+}
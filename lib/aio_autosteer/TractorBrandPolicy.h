@@ -0,0 +1,291 @@
+// TractorBrandPolicy.h - Per-brand CAN steering protocols for TractorCANDriver
+// Each brand is one class: its receive routes, frame handlers and command
+// sender. The driver picks the policy once when the CAN config is applied.
+#ifndef TRACTOR_BRAND_POLICY_H
+#define TRACTOR_BRAND_POLICY_H
+
+#include <Arduino.h>
+#include "CANBus.h"
+
+// Tractor brands enumeration (alphabetized except DISABLED)
+enum class TractorBrand : uint8_t {
+    DISABLED = 0,
+    CASEIH_NH = 1,      // Case IH/New Holland
+    CAT_MT = 2,         // CAT MT Series
+    CLAAS = 3,
+    FENDT = 4,          // Fendt SCR/S4/Gen6
+    FENDT_ONE = 5,      // Fendt One
+    GENERIC = 6,        // Generic (Keya)
+    JCB = 7,
+    LINDNER = 8,
+    VALTRA_MASSEY = 9   // Valtra/Massey Ferguson
+};
+
+// Which configured bus a receive route listens on
+enum class CANBusRole : uint8_t {
+    STEER,      // V_Bus (or the Keya bus)
+    BUTTON      // K_Bus
+};
+
+// Per-bus receive statistics
+struct CANBusRxStats {
+    uint32_t accepted;          // Frames consumed by a handler
+    uint32_t filtered;          // Frames read but matching no route (passed a shared mask)
+    float acceptedRate;         // Frames/s over last window
+    float filteredRate;
+    uint8_t routeCount;         // IDs routed on this bus
+    bool hwFiltered;            // Mailbox acceptance filters programmed
+    bool hwExact;               // Every mailbox holds exactly one ID (no software filtering needed)
+    uint32_t latencyLastUs;     // ISR timestamp to handler, last accepted frame
+    uint32_t latencyMaxUs;
+    uint64_t handlerCyclesTotal;    // CPU cost of accepted frames' handlers
+    uint32_t handlerCyclesMax;
+};
+
+// One frame a brand consumes - programmed into the bus acceptance filters
+struct TractorRoute {
+    CANBusRole role;
+    uint32_t id;
+    bool extended;
+};
+
+// State shared by TractorCANDriver and the active policy
+struct TractorCANState {
+    CANBus* steerBus = nullptr;
+    CANBus* buttonBus = nullptr;
+
+    // Set by the driver
+    bool enabled = false;
+    int16_t targetPWM = 0;
+    float commandedRPM = 0.0f;
+
+    // Set by the policy from bus feedback
+    bool steerReady = false;
+    uint32_t lastSteerReadyTime = 0;
+    float actualRPM = 0.0f;             // Keya RPM, or valve curve / 100
+    uint16_t motorPosition = 0;
+    uint16_t motorCurrent = 0;
+    uint16_t motorErrorCode = 0;
+    bool heartbeatValid = false;
+    uint32_t lastHeartbeat = 0;
+};
+
+// Runtime face of a brand. Called once per bus drain or command tick;
+// the per-frame handler calls happen inside drain() and bind statically.
+class TractorBrandPolicy {
+public:
+    virtual ~TractorBrandPolicy() {}
+
+    virtual TractorBrand getBrand() const = 0;
+    virtual const char* getName() const = 0;
+    virtual const TractorRoute* getRoutes(uint8_t& count) const = 0;
+
+    // Consume every queued frame on a bus
+    virtual void drain(CANBus& bus, CANBusRole role, CANBusRxStats& stats) = 0;
+    virtual void sendCommands() = 0;
+
+    // Tractor-side engage switch or armrest button, if the brand reports one
+    virtual bool isEngaged() const { return false; }
+
+    // Policy for a config, nullptr if it has no CAN steering
+    static TractorBrandPolicy* create(TractorBrand brand, bool keya, TractorCANState& state);
+
+protected:
+    explicit TractorBrandPolicy(TractorCANState& s) : state(s) {}
+
+    TractorCANState& state;
+
+    static void recordRx(CANBusRxStats& stats, bool accepted, uint32_t ageUs, uint32_t cycles);
+
+    // Shared by the curve valve protocols (Case IH, Claas, JCB, Lindner, Valtra)
+    void setValveReady(bool ready, const char* brandName);
+    void sendCurveCommand(uint32_t id, uint8_t fill);
+};
+
+// CRTP base - Brand provides ROUTES/ROUTE_COUNT and
+// bool onSteerFrame(const CAN_message_t&) / bool onButtonFrame(const CAN_message_t&)
+template <typename Brand>
+class TractorBrandBase : public TractorBrandPolicy {
+public:
+    const TractorRoute* getRoutes(uint8_t& count) const override {
+        count = Brand::ROUTE_COUNT;
+        return Brand::ROUTES;
+    }
+
+    void drain(CANBus& bus, CANBusRole role, CANBusRxStats& stats) override {
+        Brand& brand = static_cast<Brand&>(*this);
+        CANRxFrame frame;
+        while (bus.read(frame)) {
+            uint32_t ageUs = canFrameAgeMicros(frame);
+            uint32_t start = ARM_DWT_CYCCNT;
+            bool accepted = (role == CANBusRole::STEER) ? brand.onSteerFrame(frame.msg)
+                                                        : brand.onButtonFrame(frame.msg);
+            recordRx(stats, accepted, ageUs, ARM_DWT_CYCCNT - start);
+        }
+    }
+
+protected:
+    explicit TractorBrandBase(TractorCANState& s) : TractorBrandPolicy(s) {}
+};
+
+// ===== Brands =====
+
+class KeyaPolicy : public TractorBrandBase<KeyaPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit KeyaPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::GENERIC; }
+    const char* getName() const override { return "Keya CAN"; }
+    void sendCommands() override;
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t&) { return false; }
+};
+
+class CaseIHPolicy : public TractorBrandBase<CaseIHPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit CaseIHPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::CASEIH_NH; }
+    const char* getName() const override { return "Case IH/NH"; }
+    void sendCommands() override { sendCurveCommand(0x0CAD08AA, 0xFF); }
+    bool isEngaged() const override { return engaged; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+private:
+    bool engaged = false;
+    uint8_t lastHitchStatus = 0xFF;
+};
+
+class CATMTPolicy : public TractorBrandBase<CATMTPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit CATMTPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::CAT_MT; }
+    const char* getName() const override { return "CAT MT"; }
+    void sendCommands() override;
+    bool isEngaged() const override { return engaged; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+private:
+    bool engaged = false;
+};
+
+class ClaasPolicy : public TractorBrandBase<ClaasPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit ClaasPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::CLAAS; }
+    const char* getName() const override { return "Claas"; }
+    void sendCommands() override { sendCurveCommand(0x0CAD131E, 0xFF); }
+    bool isEngaged() const override { return engaged; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+private:
+    bool engaged = false;
+};
+
+// Fendt SCR/S4/Gen6 and Fendt One share the protocol
+class FendtPolicy : public TractorBrandBase<FendtPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    FendtPolicy(TractorCANState& s, bool one) : TractorBrandBase(s), fendtOne(one) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::FENDT; }
+    const char* getName() const override { return fendtOne ? "Fendt One" : "Fendt SCR/S4/Gen6"; }
+    void sendCommands() override;
+    bool isEngaged() const override { return buttonPressed; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+private:
+    const bool fendtOne;
+    bool buttonPressed = false;     // Armrest button
+};
+
+class JcbPolicy : public TractorBrandBase<JcbPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit JcbPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::JCB; }
+    const char* getName() const override { return "JCB"; }
+    void sendCommands() override { sendCurveCommand(0x0CAD13AB, 0xFF); }  // Module 0xAB
+    bool isEngaged() const override { return engaged; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+private:
+    bool engaged = false;
+};
+
+class LindnerPolicy : public TractorBrandBase<LindnerPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit LindnerPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::LINDNER; }
+    const char* getName() const override { return "Lindner"; }
+    void sendCommands() override { sendCurveCommand(0x0CADF013, 0xFF); }  // Module 0xF0
+    bool isEngaged() const override { return engaged; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+private:
+    bool engaged = false;
+};
+
+class ValtraMasseyPolicy : public TractorBrandBase<ValtraMasseyPolicy> {
+public:
+    static const TractorRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
+
+    explicit ValtraMasseyPolicy(TractorCANState& s) : TractorBrandBase(s) {}
+
+    TractorBrand getBrand() const override { return TractorBrand::VALTRA_MASSEY; }
+    const char* getName() const override { return "Valtra/Massey"; }
+    void sendCommands() override { sendCurveCommand(0x0CAD131C, 0x00); }
+    bool isEngaged() const override { return engageButtonPressed; }
+
+    bool onSteerFrame(const CAN_message_t& msg);
+    bool onButtonFrame(const CAN_message_t& msg);
+
+    // Massey K_Bus F1/F2 button presses
+    void sendF1() { sendFunctionButton(0x10, "F1"); }
+    void sendF2() { sendFunctionButton(0x20, "F2"); }
+
+private:
+    uint8_t rollingCounter[8] = {0};    // Last K_Bus button message, replayed for F1/F2
+    bool engageButtonPressed = false;
+
+    void sendFunctionButton(uint8_t bit, const char* name);
+};
+
+#endif // TRACTOR_BRAND_POLICY_H
@@ -7,128 +7,61 @@
 #include "EventLogger.h"
 #include "ConfigManager.h"
 #include "ConfigGlobals.h"
-
-// Tractor brands enumeration (alphabetized except DISABLED)
-enum class TractorBrand : uint8_t {
-    DISABLED = 0,
-    CASEIH_NH = 1,      // Case IH/New Holland
-    CAT_MT = 2,         // CAT MT Series
-    CLAAS = 3,
-    FENDT = 4,          // Fendt SCR/S4/Gen6
-    FENDT_ONE = 5,      // Fendt One
-    GENERIC = 6,        // Generic (Keya)
-    JCB = 7,
-    LINDNER = 8,
-    VALTRA_MASSEY = 9   // Valtra/Massey Ferguson
-};
+#include "TractorBrandPolicy.h"
 
 class TractorCANDriver : public MotorDriverInterface {
+public:
+    static constexpr uint32_t RX_STATS_WINDOW_MS = 1000;
+    static constexpr uint8_t MAX_ROUTES_PER_BUS = 16;
+
 private:
+    CANBusRxStats rxStats[3];
+    uint32_t rxWindowStart = 0;
+    uint32_t rxWindowAccepted[3] = {0};
+    uint32_t rxWindowFiltered[3] = {0};
+
     // Configuration
     CANSteerConfig config;
 
-    // CAN bus pointers (assigned based on config)
-    // Using void* to handle different template instantiations
-    void* steerCAN = nullptr;
-    void* buttonCAN = nullptr;
-    void* hitchCAN = nullptr;
+    // Bus handles, command and feedback state shared with the brand policy
+    TractorCANState state;
+
+    // Active brand protocol, chosen in assignCANBuses() (nullptr = no CAN steering)
+    TractorBrandPolicy* policy = nullptr;
 
     // Track which bus numbers are assigned
     uint8_t steerBusNum = 0;
     uint8_t buttonBusNum = 0;
-    uint8_t hitchBusNum = 0;
-
-    // Common state
-    bool enabled = false;
-    int16_t targetPWM = 0;
-    bool steerReady = false;
-    uint32_t lastSteerReadyTime = 0;
-    uint32_t lastCommandTime = 0;
-
-    // Keya-specific state (used when brand == KEYA)
-    float actualRPM = 0.0f;
-    float commandedRPM = 0.0f;
-    uint16_t motorPosition = 0;
-    uint16_t motorCurrent = 0;
-    uint16_t motorErrorCode = 0;
-    bool heartbeatValid = false;
-    uint32_t lastHeartbeat = 0;
-
-    // Command alternation for Keya
-    enum CommandState {
-        SEND_ENABLE,
-        SEND_SPEED
-    };
-    CommandState nextCommand = SEND_ENABLE;
-
-    // Massey K_Bus tracking
-    uint8_t mfRollingCounter[8] = {0};  // Track last K_Bus message for F1/F2
-    bool engageButtonPressed = false;   // Track K_Bus engage button
 
-    // Fendt K_Bus tracking
-    bool fendtButtonPressed = false;    // Track Fendt armrest button
-
-    // Case IH K_Bus tracking
-    bool caseIHEngaged = false;         // Track Case IH engage state
-
-    // CAT MT tracking
-    bool catMTEngaged = false;          // Track CAT MT engage state
-
-    // CLAAS tracking
-    bool claasEngaged = false;          // Track CLAAS engage state
-
-    // JCB tracking
-    bool jcbEngaged = false;            // Track JCB engage state
-
-    // Lindner tracking
-    bool lindnerEngaged = false;        // Track Lindner engage state
+    bool timeoutLogged = false;
 
     // Helper methods
     void assignCANBuses();
-    void* getBusPointer(uint8_t busNum);
-    bool readCANMessage(uint8_t busNum, CAN_message_t& msg);
-    void writeCANMessage(uint8_t busNum, const CAN_message_t& msg);
     void processIncomingMessages();
-    void sendSteerCommands();
+    void updateRxStats();
+    void applyHardwareFilters();
+    void configureBusFilters(uint8_t busNum, CANBusRole role);
     bool hasKeyaFunction() const;
-
-    // Brand-specific message handlers
-    void processKeyaMessage(const CAN_message_t& msg);
-    void processCaseIHMessage(const CAN_message_t& msg);
-    void processCaseIHKBusMessage(const CAN_message_t& msg);
-    void processFendtMessage(const CAN_message_t& msg);
-    void processFendtKBusMessage(const CAN_message_t& msg);
-    void processValtraMessage(const CAN_message_t& msg);
-    void processMasseyKBusMessage(const CAN_message_t& msg);
-    void processCATMessage(const CAN_message_t& msg);
-    void processCATKBusMessage(const CAN_message_t& msg);
-    void processClaasMessage(const CAN_message_t& msg);
-    void processClaasKBusMessage(const CAN_message_t& msg);
-    void processJcbMessage(const CAN_message_t& msg);
-    void processJcbKBusMessage(const CAN_message_t& msg);
-    void processLindnerMessage(const CAN_message_t& msg);
-    void processLindnerKBusMessage(const CAN_message_t& msg);
-
-    // Brand-specific command senders
-    void sendKeyaCommands();
-    void sendCaseIHCommands();
-    void sendFendtCommands();
-    void sendValtraCommands();
-    void sendCATCommands();
-    void sendClaasCommands();
-    void sendJcbCommands();
-    void sendLindnerCommands();
-    void sendMasseyF1();
-    void sendMasseyF2();
+    bool isBrandEngaged(TractorBrand brand) const {
+        return policy && policy->getBrand() == brand && policy->isEngaged();
+    }
+    ValtraMasseyPolicy* getMasseyPolicy() const {
+        return (policy && policy->getBrand() == TractorBrand::VALTRA_MASSEY) ?
+               static_cast<ValtraMasseyPolicy*>(policy) : nullptr;
+    }
 
 public:
-    TractorCANDriver() {}
+    TractorCANDriver() {
+        memset(rxStats, 0, sizeof(rxStats));
+    }
+    ~TractorCANDriver();
 
     bool init() override;
     void enable(bool en) override;
     void setPWM(int16_t pwm) override;
     void stop() override;
     void process() override;
+    void processFeedback() override { processIncomingMessages(); }
     MotorStatus getStatus() const override;
 
     // Configuration
@@ -144,40 +77,44 @@ public:
     }
 
     // Detection and safety
-    bool isDetected() override { return steerReady; }
+    bool isDetected() override { return state.steerReady; }
     void handleKickout(KickoutType type, float value) override;
     float getCurrentDraw() override { return 0.0f; }
 
     // Keya-specific methods (for compatibility)
-    float getActualRPM() const { return actualRPM; }
-    float getCommandedRPM() const { return commandedRPM; }
-    uint16_t getMotorPosition() const { return motorPosition; }
+    float getActualRPM() const { return state.actualRPM; }
+    float getCommandedRPM() const { return state.commandedRPM; }
+    uint16_t getMotorPosition() const { return state.motorPosition; }
     bool hasRPMFeedback() const {
-        return hasKeyaFunction() && heartbeatValid;
+        return hasKeyaFunction() && state.heartbeatValid;
     }
 
     // Massey-specific methods
-    bool isEngageButtonPressed() const { return engageButtonPressed; }
-    void pressMasseyF1() { sendMasseyF1(); }
-    void pressMasseyF2() { sendMasseyF2(); }
+    bool isEngageButtonPressed() const { return isBrandEngaged(TractorBrand::VALTRA_MASSEY); }
+    void pressMasseyF1() { if (ValtraMasseyPolicy* mf = getMasseyPolicy()) mf->sendF1(); }
+    void pressMasseyF2() { if (ValtraMasseyPolicy* mf = getMasseyPolicy()) mf->sendF2(); }
 
     // Fendt-specific methods
-    bool isFendtButtonPressed() const { return fendtButtonPressed; }
+    bool isFendtButtonPressed() const { return isBrandEngaged(TractorBrand::FENDT); }
 
     // Case IH-specific methods
-    bool isCaseIHEngaged() const { return caseIHEngaged; }
+    bool isCaseIHEngaged() const { return isBrandEngaged(TractorBrand::CASEIH_NH); }
 
     // CAT MT-specific methods
-    bool isCATMTEngaged() const { return catMTEngaged; }
+    bool isCATMTEngaged() const { return isBrandEngaged(TractorBrand::CAT_MT); }
 
     // CLAAS-specific methods
-    bool isClaasEngaged() const { return claasEngaged; }
+    bool isClaasEngaged() const { return isBrandEngaged(TractorBrand::CLAAS); }
 
     // JCB-specific methods
-    bool isJcbEngaged() const { return jcbEngaged; }
+    bool isJcbEngaged() const { return isBrandEngaged(TractorBrand::JCB); }
 
     // Lindner-specific methods
-    bool isLindnerEngaged() const { return lindnerEngaged; }
+    bool isLindnerEngaged() const { return isBrandEngaged(TractorBrand::LINDNER); }
+
+    // Receive diagnostics (busNum 1-3)
+    const CANBusRxStats& getRxStats(uint8_t busNum) const { return rxStats[(busNum >= 1 && busNum <= 3) ? busNum - 1 : 0]; }
+    void printCANStatus() const;
 };
 
 #endif // TRACTOR_CAN_DRIVER_H
\ No newline at end of file
@@ -4,9 +4,8 @@
 
 #include <Arduino.h>
 #include "EventLogger.h"
-
-// Math constants are already defined in Arduino.h
-// DEG_TO_RAD and RAD_TO_DEG
+#include "ConfigManager.h"
+#include "SteerAngleEKF.h"
 
 // Forward declarations
 class KeyaCANDriver;
@@ -15,145 +14,100 @@ class IMUProcessor;
 
 /**
  * WheelAngleFusion - Virtual Wheel Angle Sensor (VWAS)
- * 
- * Creates a virtual WAS by combining multiple sensor inputs to estimate 
- * steering angle. Uses an adaptive Kalman filter to fuse motor encoder 
- * data with GPS/INS heading rate.
- * 
- * This provides a software-based wheel angle sensor using existing hardware.
- * Based on proven algorithm from AOG_Teensy_UM98X project.
+ *
+ * Estimates the steering angle with an extended Kalman filter
+ * (SteerAngleEKF) over angle, angle rate, encoder bias and yaw-rate bias.
+ * Fuses whichever sensors are enabled and present:
+ * - Analog WAS (ADProcessor)
+ * - Keya motor encoder
+ * - GNSS heading rate (dual heading when available)
+ * - IMU yaw rate
+ *
+ * Runs every autosteer tick at the control rate. Without a WAS or encoder
+ * the angle comes from the heading rate alone, so it only converges above
+ * the minimum speed - but it works on every motor type, not just Keya.
  */
 class WheelAngleFusion {
 public:
-    // Configuration structure
-    struct Config {
-        // Vehicle parameters
-        float wheelbase = 2.5f;           // Vehicle wheelbase in meters
-        float trackWidth = 1.8f;          // Vehicle track width in meters
-        
-        // Motor calibration
-        float countsPerDegree = 100.0f;   // Encoder counts per steering degree
-        int32_t centerPosition = 32768;   // Encoder position when wheels straight
-        float maxSteeringAngle = 40.0f;   // Maximum steering angle (degrees)
-        
-        // Kalman filter parameters
-        float processNoise = 0.1f;        // Q - process noise covariance
-        float measurementNoise = 1.0f;    // R - measurement noise covariance
-        float initialUncertainty = 10.0f; // P - initial error covariance
-        
-        // Fusion parameters
-        float minSpeedForGPS = 0.5f;      // Minimum speed for GPS fusion (m/s)
-        float maxHeadingRate = 50.0f;     // Maximum valid heading rate (deg/s)
-        uint16_t varianceBufferSize = 50; // Size of variance calculation buffer
-        
-        // Sensor selection
-        bool useIMUHeadingRate = false;   // Use IMU instead of GPS for heading rate
-        bool enableDriftCompensation = true; // Enable encoder drift compensation
-    };
-    
+    // Health limits
+    static constexpr float MAX_HEALTHY_SIGMA = 2.0f;        // deg, 1 sigma
+    static constexpr uint32_t SENSOR_TIMEOUT_US = 500000;   // No sensor fused for this long = unhealthy
+
     // Constructor
     WheelAngleFusion();
     ~WheelAngleFusion() = default;
-    
-    // Initialization
+
+    // Initialization - any sensor may be null
     bool init(KeyaCANDriver* keya, GNSSProcessor* gnss, IMUProcessor* imu);
-    
-    // Configuration
-    void setConfig(const Config& cfg) { config = cfg; }
-    Config& getConfig() { return config; }
-    const Config& getConfig() const { return config; }
-    
-    // Main update function - call at 100Hz
+
+    // Configuration (geometry, per-sensor noise and latency); takes effect
+    // without a reset
+    void setConfig(const FusionConfig& cfg);
+    const FusionConfig& getConfig() const { return config; }
+
+    // Main update function - call every control tick
     void update(float dt);
-    
+
     // Get fusion results
-    float getFusedAngle() const { return fusedAngle; }
-    float getPredictedAngle() const { return predictedAngle; }
-    float getGPSAngle() const { return gpsAngle; }
+    float getFusedAngle() const { return ekf.getAngle(); }
+    float getAngleRate() const { return ekf.getRate(); }
+    float getWASAngle() const { return wasAngle; }
     float getEncoderAngle() const { return encoderAngle; }
-    
+    float getGPSAngle() const { return gpsAngle; }      // Angle implied by the heading rate
+    float getVehicleSpeed() const { return vehicleSpeed; }
+
     // Get quality metrics
-    float getUncertainty() const { return uncertainty; }
-    float getMeasurementVariance() const { return measurementVariance; }
-    float getKalmanGain() const { return kalmanGain; }
-    
+    float getUncertainty() const { return sqrtf(ekf.getAngleVariance()); }
+    const SteerAngleEKF& getFilter() const { return ekf; }
+
     // Health and status
     bool isHealthy() const;
     bool hasValidGPSAngle() const { return gpsAngleValid; }
     uint32_t getLastUpdateTime() const { return lastUpdateTime; }
-    
+    void printStatus() const;
+
     // Calibration
-    void startCalibration();
-    void stopCalibration();
-    bool isCalibrating() const { return calibrationMode; }
     void setEncoderCenter(); // Set current position as center (0 degrees)
-    
+
     // Reset and recovery
     void reset();
-    void resetDriftCompensation();
-    
+
 private:
     // Sensor interfaces
     KeyaCANDriver* keyaDriver;
     GNSSProcessor* gnssProcessor;
     IMUProcessor* imuProcessor;
-    
+
     // Configuration
-    Config config;
-    
-    // Kalman filter state
-    float fusedAngle;        // X - Current angle estimate
-    float predictedAngle;    // Xp - Predicted angle
-    float uncertainty;       // P - Estimation error covariance
-    float kalmanGain;        // K - Kalman gain
-    
-    // Sensor angles
-    float encoderAngle;      // Angle from motor encoder
-    float gpsAngle;          // Angle from GPS heading rate
-    bool gpsAngleValid;      // Is GPS angle valid this update
-    
-    // Motor position tracking
-    int32_t lastEncoderPosition;
-    int32_t encoderOffset;   // Offset for centering
-    
-    // GPS angle calculation
+    FusionConfig config;
+
+    // Filter
+    SteerAngleEKF ekf;
+
+    // Latest sensor values
+    float wasAngle;          // Angle from the analog WAS
+    float encoderAngle;      // Accumulated angle from the motor encoder (relative)
+    float gpsAngle;          // Angle from GNSS/IMU heading rate
+    bool gpsAngleValid;      // Speed high enough for the heading rate to mean anything
     float vehicleSpeed;      // Current speed (m/s)
-    float headingRate;       // Rate of heading change (deg/s)
-    float lastHeading;       // Previous heading for rate calculation
-    
-    // Adaptive variance calculation
-    float measurementVariance;
-    float* varianceBuffer;   // Circular buffer for variance calculation
-    uint16_t varianceIndex;
-    uint16_t varianceCount;
-    
-    // Drift compensation
-    float encoderDrift;      // Accumulated drift (degrees)
-    float driftRate;         // Drift rate (degrees/second)
-    uint32_t driftStartTime;
-    
+
+    // GNSS heading rate
+    HeadingRateTracker headingRate;
+    uint32_t lastGNSSUpdate;
+
+    // IMU
+    uint32_t lastIMUTimestamp;
+
     // Timing
     uint32_t lastUpdateTime;
-    uint32_t lastGPSTime;
-    
-    // Calibration
-    bool calibrationMode;
-    float calibrationMinAngle;
-    float calibrationMaxAngle;
-    int32_t calibrationMinPosition;
-    int32_t calibrationMaxPosition;
-    
-    // Private methods
-    void updateEncoderAngle();
-    void updateGPSAngle();
-    void updateKalmanFilter(float dt);
-    void updateVariance();
-    void updateDriftCompensation(float dt);
-    float calculateGPSAngleFromHeadingRate(float headingRate, float speed);
-    bool isValidGPSConditions() const;
+
+    void updateWAS();
+    void updateEncoder();
+    void updateGNSS();
+    void updateIMU();
 };
 
 // Global instance pointer for external access
 extern WheelAngleFusion* wheelAngleFusionPtr;
 
-#endif // WHEEL_ANGLE_FUSION_H
\ No newline at end of file
+#endif // WHEEL_ANGLE_FUSION_H
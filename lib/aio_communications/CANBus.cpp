@@ -0,0 +1,118 @@
+// CANBus.cpp - CANBus handles over the global FlexCAN_T4 instances
+#include "CANBus.h"
+
+namespace {
+
+template <typename FlexCAN>
+class FlexCANBus : public CANBus {
+public:
+    FlexCANBus(FlexCAN& c, uint8_t num, uint32_t baseAddr, IRQ_NUMBER_t irqNum)
+        : CANBus(num), can(c), base(baseAddr), irq(irqNum) {}
+
+    bool setRxFilters(const uint32_t* stdIds, uint8_t stdCount,
+                      const uint32_t* extIds, uint8_t extCount) override {
+        can.setMBFilter(REJECT_ALL);
+        rxFiltered = true;
+        bool exactStd = programMailboxes(RX_STD_FIRST_MB, stdIds, stdCount);
+        bool exactExt = programMailboxes(RX_EXT_FIRST_MB, extIds, extCount);
+        return exactStd && exactExt;
+    }
+
+    void acceptAll() override {
+        can.setMBFilter(ACCEPT_ALL);
+        rxFiltered = false;
+    }
+
+    bool isTxMailboxIdle(uint8_t mb) const override {
+        return FLEXCAN_get_code(FLEXCANb_MBn_CS(base, mb)) == FLEXCAN_MB_CODE_TX_INACTIVE;
+    }
+
+    void loadTxMailbox(uint8_t mb, const CAN_message_t& msg) override {
+        can.write((FLEXCAN_MAILBOX)mb, msg);
+    }
+
+    bool abortTxMailbox(uint8_t mb, uint32_t timeoutUs) override {
+        // FlexCAN_T4's ISR ignores TX_ABORT mailboxes and would spin on the
+        // flag, so keep it out until the mailbox is inactive again
+        NVIC_DISABLE_IRQ(irq);
+        uint32_t code = FLEXCAN_get_code(FLEXCANb_MBn_CS(base, mb));
+        bool aborted = false;
+        if (code == FLEXCAN_MB_CODE_TX_ONCE) {
+            FLEXCANb_MBn_CS(base, mb) = FLEXCAN_MB_CS_CODE(FLEXCAN_MB_CODE_TX_ABORT);
+
+            // Takes effect at the end of a frame already on the wire
+            uint32_t start = micros();
+            while (!(FLEXCANb_IFLAG1(base) & (1UL << mb)) && micros() - start < timeoutUs) {
+            }
+            aborted = FLEXCAN_get_code(FLEXCANb_MBn_CS(base, mb)) == FLEXCAN_MB_CODE_TX_ABORT;
+        }
+        FLEXCANb_IFLAG1(base) = (1UL << mb);
+        FLEXCANb_MBn_CS(base, mb) = FLEXCAN_MB_CS_CODE(FLEXCAN_MB_CODE_TX_INACTIVE);
+        NVIC_ENABLE_IRQ(irq);
+        return aborted;
+    }
+
+private:
+    FlexCAN& can;
+    const uint32_t base;
+    const IRQ_NUMBER_t irq;
+
+    // Program one ID type from a list of IDs.
+    // Returns true if every mailbox matches exactly one ID.
+    bool programMailboxes(uint8_t firstMB, const uint32_t* ids, uint8_t count) {
+        const uint8_t mbCount = RX_MB_PER_TYPE;
+        const uint8_t maxIds = MAX_IDS_PER_MB;
+
+        if (count == 0) {
+            return true;  // Mailboxes stay at REJECT_ALL
+        }
+
+        if (count > mbCount * maxIds) {
+            // Too many IDs to express - let this type through and filter in software
+            for (uint8_t i = 0; i < mbCount; i++) {
+                can.setMBFilter((FLEXCAN_MAILBOX)(firstMB + i), ACCEPT_ALL);
+            }
+            return false;
+        }
+
+        if (count <= mbCount) {
+            // One ID per mailbox; spare mailboxes repeat IDs so a burst of one ID can queue
+            for (uint8_t i = 0; i < mbCount; i++) {
+                can.setMBFilter((FLEXCAN_MAILBOX)(firstMB + i), ids[i % count]);
+            }
+            return true;
+        }
+
+        // More IDs than mailboxes - share mailboxes (the combined mask is a superset)
+        uint8_t next = 0;
+        for (uint8_t i = 0; i < mbCount && next < count; i++) {
+            uint8_t n = (count - next + (mbCount - i) - 1) / (mbCount - i);
+            FLEXCAN_MAILBOX mb = (FLEXCAN_MAILBOX)(firstMB + i);
+            const uint32_t* g = &ids[next];
+            switch (n) {
+                case 1: can.setMBFilter(mb, g[0]); break;
+                case 2: can.setMBFilter(mb, g[0], g[1]); break;
+                case 3: can.setMBFilter(mb, g[0], g[1], g[2]); break;
+                case 4: can.setMBFilter(mb, g[0], g[1], g[2], g[3]); break;
+                default: can.setMBFilter(mb, g[0], g[1], g[2], g[3], g[4]); break;
+            }
+            next += n;
+        }
+        return false;
+    }
+};
+
+FlexCANBus<decltype(globalCAN1)> canBus1(globalCAN1, 1, CAN1, IRQ_CAN1);
+FlexCANBus<decltype(globalCAN2)> canBus2(globalCAN2, 2, CAN2, IRQ_CAN2);
+FlexCANBus<decltype(globalCAN3)> canBus3(globalCAN3, 3, CAN3, IRQ_CAN3);
+
+} // namespace
+
+CANBus* getCANBus(uint8_t busNum) {
+    switch (busNum) {
+        case 1: return &canBus1;    // K_Bus
+        case 2: return &canBus2;    // ISO_Bus
+        case 3: return &canBus3;    // V_Bus
+        default: return nullptr;
+    }
+}
@@ -0,0 +1,55 @@
+// CANBus.h - Type-independent handle on one of the three FlexCAN buses
+// The FlexCAN_T4 instances differ in template arguments; this hides that so
+// drivers can hold a plain CANBus* instead of casting void pointers per bus.
+#ifndef CAN_BUS_H
+#define CAN_BUS_H
+
+#include "CANGlobals.h"
+#include "CANTxScheduler.h"
+
+class CANBus {
+public:
+    // FlexCAN_T4 default mailbox layout (FIFO disabled, 16 MBs)
+    static constexpr uint8_t RX_STD_FIRST_MB = 0;
+    static constexpr uint8_t RX_EXT_FIRST_MB = 4;
+    static constexpr uint8_t RX_MB_PER_TYPE = 4;
+    static constexpr uint8_t MAX_IDS_PER_MB = 5;        // setMBFilter() overload limit
+
+    uint8_t getNumber() const { return busNum; }
+
+    // Frame I/O goes through CANGlobals so queues, observers and capture see it
+    bool read(CANRxFrame& frame) { return readCANFrame(busNum, frame); }
+    int write(const CAN_message_t& msg) { return writeCANFrame(busNum, msg); }
+    bool writeSteer(uint8_t slot, const CAN_message_t& msg) { return writeCANSteerFrame(busNum, slot, msg); }
+
+    CANTxScheduler& getTxScheduler() { return txScheduler; }
+
+    // Program the RX mailboxes to accept only these IDs (MB0-3 standard,
+    // MB4-7 extended). Returns true if every mailbox matches exactly one ID.
+    virtual bool setRxFilters(const uint32_t* stdIds, uint8_t stdCount,
+                              const uint32_t* extIds, uint8_t extCount) = 0;
+    virtual void acceptAll() = 0;
+    // True while setRxFilters() is in force - RX counts then cover accepted frames only
+    bool isRxFiltered() const { return rxFiltered; }
+
+    // Transmit mailbox primitives for CANTxScheduler (mb 8-15)
+    virtual bool isTxMailboxIdle(uint8_t mb) const = 0;
+    virtual void loadTxMailbox(uint8_t mb, const CAN_message_t& msg) = 0;
+    // Abort a pending frame. True if it was aborted, false if it went out anyway.
+    virtual bool abortTxMailbox(uint8_t mb, uint32_t timeoutUs) = 0;
+
+protected:
+    explicit CANBus(uint8_t num) : busNum(num), txScheduler(*this) {}
+    ~CANBus() {}
+
+    bool rxFiltered = false;
+
+private:
+    const uint8_t busNum;
+    CANTxScheduler txScheduler;
+};
+
+// Bus 1-3, nullptr for anything else
+CANBus* getCANBus(uint8_t busNum);
+
+#endif // CAN_BUS_H
@@ -0,0 +1,272 @@
+// CANCapture.cpp - RAM ring capture of CAN traffic and timed replay
+#include "CANCapture.h"
+#include "EventLogger.h"
+
+CANCapture* CANCapture::instance = nullptr;
+
+const char CANCapture::BIN_MAGIC[8] = {'A', 'I', 'O', 'C', 'A', 'N', 0, 1};
+
+// Large and only touched from the main loop - keep it out of DTCM
+static CANCaptureRecord captureBuffer[CANCapture::CAPACITY] DMAMEM;
+
+// Write a whole buffer to a client, waiting for TCP send space
+static bool writeAll(Client& client, const uint8_t* data, size_t len) {
+    uint32_t lastProgress = millis();
+    while (len > 0) {
+        size_t written = client.write(data, len);
+        if (written > 0) {
+            data += written;
+            len -= written;
+            lastProgress = millis();
+        } else if (!client.connected() || millis() - lastProgress > 2000) {
+            return false;
+        } else {
+            yield();
+        }
+    }
+    return true;
+}
+
+CANCapture::CANCapture()
+    : mode(Mode::IDLE), busMask(0x07), head(0), count(0), overwritten(0),
+      replayIndex(0), replayStartUs(0), replayBaseUs(0), replayLoop(false),
+      replayInjected(0), replayDropped(0)
+{
+    instance = this;
+}
+
+void CANCapture::init()
+{
+    if (instance == nullptr)
+    {
+        new CANCapture();
+    }
+}
+
+uint16_t CANCapture::indexOf(uint16_t n) const
+{
+    return (uint16_t)((head + CAPACITY - count + n) % CAPACITY);
+}
+
+void CANCapture::start(uint8_t mask)
+{
+    busMask = mask ? mask : 0x07;
+    clear();
+    mode = Mode::CAPTURING;
+    LOG_INFO(EventSource::CAN, "CAN capture started (bus mask 0x%02X, %d records)", busMask, CAPACITY);
+}
+
+void CANCapture::stop()
+{
+    if (mode == Mode::CAPTURING) {
+        LOG_INFO(EventSource::CAN, "CAN capture stopped - %d records, %lu overwritten", count, overwritten);
+    } else if (mode == Mode::REPLAYING) {
+        LOG_INFO(EventSource::CAN, "CAN replay stopped - %lu injected, %lu dropped", replayInjected, replayDropped);
+    }
+    mode = Mode::IDLE;
+}
+
+void CANCapture::clear()
+{
+    head = 0;
+    count = 0;
+    overwritten = 0;
+    replayIndex = 0;
+}
+
+void CANCapture::record(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles, bool tx)
+{
+    if (mode != Mode::CAPTURING || !(busMask & (1 << (busNum - 1)))) {
+        return;
+    }
+
+    // Back-date RX frames to the ISR timestamp
+    uint32_t ageUs = (ARM_DWT_CYCCNT - cycles) / (F_CPU_ACTUAL / 1000000);
+
+    CANCaptureRecord& rec = captureBuffer[head];
+    rec.timeUs = micros() - ageUs;
+    rec.id = msg.id | (msg.flags.extended ? ID_EXTENDED : 0);
+    rec.bus = busNum | (tx ? BUS_TX : 0);
+    rec.len = msg.len > 8 ? 8 : msg.len;
+    memcpy(rec.data, msg.buf, 8);
+    rec.reserved = 0;
+
+    head = (head + 1) % CAPACITY;
+    if (count < CAPACITY) {
+        count++;
+    } else {
+        overwritten++;
+    }
+}
+
+bool CANCapture::startReplay(bool loop)
+{
+    if (count == 0) {
+        return false;
+    }
+    replayIndex = 0;
+    replayLoop = loop;
+    replayInjected = 0;
+    replayDropped = 0;
+    replayBaseUs = captureBuffer[indexOf(0)].timeUs;
+    replayStartUs = micros();
+    mode = Mode::REPLAYING;
+    LOG_WARNING(EventSource::CAN, "CAN replay started - %d records%s (bench use only)",
+                count, loop ? ", looping" : "");
+    return true;
+}
+
+void CANCapture::process()
+{
+    if (mode != Mode::REPLAYING) {
+        return;
+    }
+
+    uint32_t elapsed = micros() - replayStartUs;
+    while (replayIndex < count) {
+        const CANCaptureRecord& rec = captureBuffer[indexOf(replayIndex)];
+        if (rec.timeUs - replayBaseUs > elapsed) {
+            return;  // Not due yet
+        }
+        replayIndex++;
+
+        if (rec.bus & BUS_TX) {
+            continue;  // Our own transmissions - the drivers regenerate these
+        }
+
+        CAN_message_t msg;
+        msg.id = rec.id & ~ID_EXTENDED;
+        msg.flags.extended = (rec.id & ID_EXTENDED) != 0;
+        msg.len = rec.len;
+        memcpy(msg.buf, rec.data, 8);
+
+        if (injectCANFrame(rec.bus & 0x03, msg)) {
+            replayInjected++;
+        } else {
+            replayDropped++;
+        }
+    }
+
+    if (replayLoop) {
+        replayIndex = 0;
+        replayStartUs = micros();
+    } else {
+        stop();
+    }
+}
+
+void CANCapture::writeCandump(Client& client, bool rxOnly) const
+{
+    // candump -l format: (seconds.micros) canN ID#DATA
+    char line[64];
+    uint64_t timeUs = 0;
+    uint32_t lastUs = count ? captureBuffer[indexOf(0)].timeUs : 0;
+
+    for (uint16_t n = 0; n < count; n++) {
+        const CANCaptureRecord& rec = captureBuffer[indexOf(n)];
+        timeUs += (uint32_t)(rec.timeUs - lastUs);  // Unwrap micros() across the ring
+        lastUs = rec.timeUs;
+
+        if (rxOnly && (rec.bus & BUS_TX)) {
+            continue;
+        }
+
+        int pos;
+        if (rec.id & ID_EXTENDED) {
+            pos = snprintf(line, sizeof(line), "(%lu.%06lu) can%d %08lX#",
+                           (uint32_t)(timeUs / 1000000), (uint32_t)(timeUs % 1000000),
+                           rec.bus & 0x03, rec.id & ~ID_EXTENDED);
+        } else {
+            pos = snprintf(line, sizeof(line), "(%lu.%06lu) can%d %03lX#",
+                           (uint32_t)(timeUs / 1000000), (uint32_t)(timeUs % 1000000),
+                           rec.bus & 0x03, rec.id);
+        }
+        for (uint8_t i = 0; i < rec.len; i++) {
+            pos += snprintf(&line[pos], sizeof(line) - pos, "%02X", rec.data[i]);
+        }
+        line[pos++] = '\n';
+
+        if (!writeAll(client, (const uint8_t*)line, pos)) {
+            return;
+        }
+    }
+}
+
+void CANCapture::writeBinary(Client& client) const
+{
+    uint8_t header[BIN_HEADER_SIZE] = {0};
+    memcpy(header, BIN_MAGIC, sizeof(BIN_MAGIC));
+    uint32_t records = count;
+    memcpy(&header[8], &records, sizeof(records));
+
+    if (!writeAll(client, header, sizeof(header))) {
+        return;
+    }
+
+    // The ring may wrap - send it as at most two contiguous runs
+    uint16_t first = indexOf(0);
+    uint16_t run = (count < CAPACITY - first) ? count : CAPACITY - first;
+    if (!writeAll(client, (const uint8_t*)&captureBuffer[first], run * sizeof(CANCaptureRecord))) {
+        return;
+    }
+    if (run < count) {
+        writeAll(client, (const uint8_t*)&captureBuffer[0], (count - run) * sizeof(CANCaptureRecord));
+    }
+}
+
+bool CANCapture::loadBinary(Client& client)
+{
+    uint8_t header[BIN_HEADER_SIZE];
+    size_t got = 0;
+    uint32_t lastData = millis();
+
+    stop();
+    clear();
+
+    while (got < sizeof(header) && millis() - lastData < 1000) {
+        int n = client.read(&header[got], sizeof(header) - got);
+        if (n > 0) {
+            got += n;
+            lastData = millis();
+        }
+    }
+    if (got < sizeof(header) || memcmp(header, BIN_MAGIC, sizeof(BIN_MAGIC)) != 0) {
+        LOG_ERROR(EventSource::CAN, "CAN capture upload: bad header");
+        return false;
+    }
+
+    uint32_t records;
+    memcpy(&records, &header[8], sizeof(records));
+    if (records > CAPACITY) {
+        LOG_WARNING(EventSource::CAN, "CAN capture upload: %lu records, keeping first %d", records, CAPACITY);
+        records = CAPACITY;
+    }
+
+    uint8_t* dest = (uint8_t*)captureBuffer;
+    size_t total = records * sizeof(CANCaptureRecord);
+    got = 0;
+    lastData = millis();
+    while (got < total && millis() - lastData < 1000) {
+        int n = client.read(&dest[got], total - got);
+        if (n > 0) {
+            got += n;
+            lastData = millis();
+        }
+    }
+
+    count = got / sizeof(CANCaptureRecord);
+    head = count % CAPACITY;
+    LOG_INFO(EventSource::CAN, "CAN capture upload: %d records loaded", count);
+    return count > 0;
+}
+
+const char* CANCapture::modeToString(Mode m)
+{
+    switch (m)
+    {
+    case Mode::IDLE:      return "idle";
+    case Mode::CAPTURING: return "capturing";
+    case Mode::REPLAYING: return "replaying";
+    default:              return "unknown";
+    }
+}
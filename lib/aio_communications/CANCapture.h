@@ -0,0 +1,85 @@
+// CANCapture.h - RAM ring capture of CAN traffic and timed replay into the RX queues
+#ifndef CAN_CAPTURE_H
+#define CAN_CAPTURE_H
+
+#include <Arduino.h>
+#include <Client.h>
+#include "CANGlobals.h"
+
+// One captured frame - also the on-wire record of the binary download/upload
+// format (little endian, 20 bytes, after a 16 byte header)
+struct __attribute__((packed)) CANCaptureRecord {
+    uint32_t timeUs;        // micros() when the frame was received/sent
+    uint32_t id;            // Bit 31 set = extended ID
+    uint8_t bus;            // 1-3, bit 7 set = transmitted by this module
+    uint8_t len;
+    uint8_t data[8];
+    uint16_t reserved;
+};
+
+class CANCapture {
+public:
+    enum class Mode : uint8_t {
+        IDLE,
+        CAPTURING,
+        REPLAYING
+    };
+
+    static constexpr uint16_t CAPACITY = 4096;                  // Records (80KB in DMAMEM)
+    static constexpr uint32_t ID_EXTENDED = 0x80000000UL;
+    static constexpr uint8_t BUS_TX = 0x80;
+    static constexpr size_t BIN_HEADER_SIZE = 16;
+    static const char BIN_MAGIC[8];
+
+private:
+    static CANCapture* instance;
+
+    CANCapture();
+
+    Mode mode;
+    uint8_t busMask;            // Bit n = capture bus n+1
+    uint16_t head;              // Next write slot
+    uint16_t count;             // Valid records
+    uint32_t overwritten;       // Records lost to ring wrap
+
+    // Replay state
+    uint16_t replayIndex;
+    uint32_t replayStartUs;     // micros() when replay (or current loop) started
+    uint32_t replayBaseUs;      // timeUs of first record
+    bool replayLoop;
+    uint32_t replayInjected;
+    uint32_t replayDropped;     // RX queue full
+
+    uint16_t indexOf(uint16_t n) const;     // n-th oldest record -> slot
+
+public:
+    static void init();
+    static CANCapture* getInstance() { return instance; }
+
+    // Capture control
+    void start(uint8_t mask = 0x07);
+    void stop();
+    void clear();
+
+    // Feed from CANManager frame observers
+    void record(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles, bool tx);
+
+    // Replay loaded/captured received frames into the bus RX queues with original timing
+    bool startReplay(bool loop);
+    void process();
+
+    // Export - blocks while writing, best done with steering disengaged
+    void writeCandump(Client& client, bool rxOnly) const;
+    void writeBinary(Client& client) const;
+    bool loadBinary(Client& client);
+
+    Mode getMode() const { return mode; }
+    static const char* modeToString(Mode m);
+    uint16_t getCount() const { return count; }
+    uint32_t getOverwritten() const { return overwritten; }
+    uint32_t getReplayInjected() const { return replayInjected; }
+    uint32_t getReplayDropped() const { return replayDropped; }
+    uint16_t getReplayPosition() const { return replayIndex; }
+};
+
+#endif // CAN_CAPTURE_H
@@ -1,5 +1,6 @@
 // CANGlobals.cpp - Global CAN bus instances
 #include "CANGlobals.h"
+#include "CANBus.h"
 #include <Arduino.h>
 #include "EventLogger.h"
 
@@ -8,6 +9,22 @@ FlexCAN_T4<CAN1, RX_SIZE_256, TX_SIZE_16> globalCAN1;
 FlexCAN_T4<CAN2, RX_SIZE_256, TX_SIZE_16> globalCAN2;
 FlexCAN_T4<CAN3, RX_SIZE_256, TX_SIZE_256> globalCAN3;
 
+// ISR receive queues
+CANBusRxQueue canRxQueue1;
+CANBusRxQueue canRxQueue2;
+CANBusRxQueue canRxQueue3;
+
+static bool rxInterruptEnabled[3] = {false, false, false};
+static uint32_t lastReadTime[3] = {0, 0, 0};
+
+static CANFrameObserver rxFrameObserver = nullptr;
+static CANFrameObserver txFrameObserver = nullptr;
+
+// Called from the FlexCAN ISR (events() is never used, so callbacks fire in interrupt context)
+static void can1RxISR(const CAN_message_t& msg) { canRxQueue1.push(msg, ARM_DWT_CYCCNT); }
+static void can2RxISR(const CAN_message_t& msg) { canRxQueue2.push(msg, ARM_DWT_CYCCNT); }
+static void can3RxISR(const CAN_message_t& msg) { canRxQueue3.push(msg, ARM_DWT_CYCCNT); }
+
 // Default speeds
 static uint32_t can1Speed = 250000;
 static uint32_t can2Speed = 250000;
@@ -44,4 +61,141 @@ void initializeGlobalCANBuses() {
     LOG_INFO(EventSource::CAN, "CAN3: %d bps", can3Speed);
 
     LOG_INFO(EventSource::CAN, "Global CAN Buses Ready");
-}
\ No newline at end of file
+}
+
+void enableCANRxInterrupts(uint8_t busNum) {
+    if (busNum < 1 || busNum > 3 || rxInterruptEnabled[busNum - 1]) {
+        return;
+    }
+
+    switch (busNum) {
+        case 1:
+            globalCAN1.onReceive(can1RxISR);
+            globalCAN1.enableMBInterrupts();
+            break;
+        case 2:
+            globalCAN2.onReceive(can2RxISR);
+            globalCAN2.enableMBInterrupts();
+            break;
+        case 3:
+            globalCAN3.onReceive(can3RxISR);
+            globalCAN3.enableMBInterrupts();
+            break;
+    }
+    rxInterruptEnabled[busNum - 1] = true;
+
+    LOG_INFO(EventSource::CAN, "CAN%d: interrupt receive enabled (%d frame queue)", busNum, CAN_RX_QUEUE_SIZE - 1);
+}
+
+bool isCANRxInterruptEnabled(uint8_t busNum) {
+    return busNum >= 1 && busNum <= 3 && rxInterruptEnabled[busNum - 1];
+}
+
+CANBusRxQueue* getCANRxQueue(uint8_t busNum) {
+    switch (busNum) {
+        case 1: return &canRxQueue1;
+        case 2: return &canRxQueue2;
+        case 3: return &canRxQueue3;
+        default: return nullptr;
+    }
+}
+
+bool readCANFrame(uint8_t busNum, CANRxFrame& frame) {
+    if (busNum < 1 || busNum > 3) {
+        return false;
+    }
+    lastReadTime[busNum - 1] = millis();
+
+    bool got = false;
+    if (rxInterruptEnabled[busNum - 1]) {
+        got = getCANRxQueue(busNum)->pop(frame);
+    } else {
+        switch (busNum) {
+            case 1: got = globalCAN1.read(frame.msg); break;
+            case 2: got = globalCAN2.read(frame.msg); break;
+            case 3: got = globalCAN3.read(frame.msg); break;
+        }
+        if (got) {
+            frame.cycles = ARM_DWT_CYCCNT;
+        }
+    }
+
+    if (got && rxFrameObserver) {
+        rxFrameObserver(busNum, frame.msg, frame.cycles);
+    }
+    return got;
+}
+
+bool injectCANFrame(uint8_t busNum, const CAN_message_t& msg) {
+    CANBusRxQueue* queue = getCANRxQueue(busNum);
+    if (!queue) {
+        return false;
+    }
+    enableCANRxInterrupts(busNum);
+
+    // The ISR is the queue's only producer - keep it out while we push
+    __disable_irq();
+    CAN_message_t frame = msg;
+    frame.bus = busNum;
+    bool ok = queue->push(frame, ARM_DWT_CYCCNT);
+    __enable_irq();
+    return ok;
+}
+
+int writeCANFrame(uint8_t busNum, const CAN_message_t& msg) {
+    CANBus* bus = getCANBus(busNum);
+    if (!bus) {
+        return 0;
+    }
+
+    // Only frames the scheduler accepted are counted; a full queue shows up
+    // as txDropped in the scheduler stats instead
+    uint32_t cycles = ARM_DWT_CYCCNT;
+    if (!bus->getTxScheduler().send(msg)) {
+        return 0;
+    }
+    if (txFrameObserver) {
+        txFrameObserver(busNum, msg, cycles);
+    }
+    return 1;
+}
+
+bool writeCANSteerFrame(uint8_t busNum, uint8_t slot, const CAN_message_t& msg) {
+    CANBus* bus = getCANBus(busNum);
+    if (!bus) {
+        return false;
+    }
+
+    uint32_t cycles = ARM_DWT_CYCCNT;
+    if (!bus->getTxScheduler().sendSteer(slot, msg)) {
+        return false;
+    }
+    if (txFrameObserver) {
+        txFrameObserver(busNum, msg, cycles);
+    }
+    return true;
+}
+
+void processCANTransmit() {
+    for (uint8_t busNum = 1; busNum <= 3; busNum++) {
+        getCANBus(busNum)->getTxScheduler().process();
+    }
+}
+
+uint32_t getCANLastReadTime(uint8_t busNum) {
+    return (busNum >= 1 && busNum <= 3) ? lastReadTime[busNum - 1] : 0;
+}
+
+uint32_t getCANSpeed(uint8_t busNum) {
+    switch (busNum) {
+        case 1: return can1Speed;
+        case 2: return can2Speed;
+        case 3: return can3Speed;
+        default: return 0;
+    }
+}
+
+void setCANFrameObservers(CANFrameObserver rxObserver, CANFrameObserver txObserver) {
+    rxFrameObserver = rxObserver;
+    txFrameObserver = txObserver;
+}
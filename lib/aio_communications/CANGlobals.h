@@ -3,15 +3,57 @@
 #define CAN_GLOBALS_H
 
 #include <FlexCAN_T4.h>
+#include "CANRxQueue.h"
 
 // Global CAN instances - defined here, instantiated in CANGlobals.cpp
 extern FlexCAN_T4<CAN1, RX_SIZE_256, TX_SIZE_16> globalCAN1;
 extern FlexCAN_T4<CAN2, RX_SIZE_256, TX_SIZE_16> globalCAN2;
 extern FlexCAN_T4<CAN3, RX_SIZE_256, TX_SIZE_256> globalCAN3;
 
+// Interrupt-driven receive queues (one per bus, filled by the FlexCAN ISR)
+constexpr uint16_t CAN_RX_QUEUE_SIZE = 64;
+typedef CANRxQueue<CAN_RX_QUEUE_SIZE> CANBusRxQueue;
+extern CANBusRxQueue canRxQueue1;
+extern CANBusRxQueue canRxQueue2;
+extern CANBusRxQueue canRxQueue3;
+
 // Initialize all CAN buses
 void initializeGlobalCANBuses();
 
+// Switch a bus (1-3) from polled read() to ISR receive into its queue.
+// Once enabled, read() no longer returns frames for that bus - use readCANFrame().
+void enableCANRxInterrupts(uint8_t busNum);
+bool isCANRxInterruptEnabled(uint8_t busNum);
+CANBusRxQueue* getCANRxQueue(uint8_t busNum);
+
+// Read the next frame from a bus, from its queue if ISR receive is enabled,
+// otherwise by polling. Polled frames are stamped at read time.
+bool readCANFrame(uint8_t busNum, CANRxFrame& frame);
+
+// Queue a frame as if it had been received on a bus (bench replay). Switches the
+// bus to ISR receive so readers take it from the queue. False if the queue is full.
+bool injectCANFrame(uint8_t busNum, const CAN_message_t& msg);
+
+// Transmit on a bus (1-3) through its CANTxScheduler. Returns 1 if the frame
+// was loaded or queued, 0 if the bus is invalid or the queue is full.
+int writeCANFrame(uint8_t busNum, const CAN_message_t& msg);
+
+// Transmit a steering command through one of the bus's reserved mailboxes
+bool writeCANSteerFrame(uint8_t busNum, uint8_t slot, const CAN_message_t& msg);
+
+// Run the transmit schedulers of all buses - call every loop
+void processCANTransmit();
+
+// millis() of the last readCANFrame() call for a bus, 0 if never read
+uint32_t getCANLastReadTime(uint8_t busNum);
+
+// Configured bit rate of a bus (1-3)
+uint32_t getCANSpeed(uint8_t busNum);
+
+// Diagnostics hooks - called from the main loop for every frame read or written
+typedef void (*CANFrameObserver)(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles);
+void setCANFrameObservers(CANFrameObserver rxObserver, CANFrameObserver txObserver);
+
 // Set CAN bus speed (must be called before any CAN usage)
 void setCAN1Speed(uint32_t speed);
 void setCAN2Speed(uint32_t speed);
@@ -1,9 +1,14 @@
 // CANManager.cpp - Simple CAN bus manager
 #include "CANManager.h"
 #include "EventLogger.h"
+#include "CANCapture.h"
+#include "CANBus.h"
+
+CANManager* CANManager::instance = nullptr;
 
 bool CANManager::init() {
     LOG_INFO(EventSource::CAN, "CAN Manager Initialization starting");
+    instance = this;
     
     // Global CAN buses should already be initialized
     LOG_DEBUG(EventSource::CAN, "Using global CAN instances");
@@ -11,30 +16,34 @@ bool CANManager::init() {
     LOG_DEBUG(EventSource::CAN, "CAN2: Ready at 250kbps");
     LOG_DEBUG(EventSource::CAN, "CAN3: Ready at 250kbps");
     
-    // Poll for devices for 1 second
-    LOG_DEBUG(EventSource::CAN, "Polling for CAN devices...");
-    uint32_t startTime = millis();
-    while (millis() - startTime < 1000) {
-        pollForDevices();
-        delay(10);  // Small delay between polls
-    }
-    
-    // Report detected devices
-    if (can1Active) {
+    // Count (and optionally capture) every frame the drivers read or write from here on
+    CANCapture::init();
+    setCANFrameObservers(onFrameRx, onFrameTx);
+    windowStart = millis();
+
+    LOG_INFO(EventSource::CAN, "CAN Manager initialization complete");
+    return true;
+}
+
+bool CANManager::HeartbeatProbe::poll() {
+    manager->pollForDevices();
+    return manager->keyaDetected;
+}
+
+void CANManager::HeartbeatProbe::finish(bool timedOut) {
+    (void)timedOut;
+    if (manager->can1Active) {
         LOG_INFO(EventSource::CAN, "CAN1: Active devices detected");
     }
-    if (can2Active) {
+    if (manager->can2Active) {
         LOG_INFO(EventSource::CAN, "CAN2: Active devices detected");
     }
-    if (can3Active) {
+    if (manager->can3Active) {
         LOG_INFO(EventSource::CAN, "CAN3: Active devices detected");
-        if (keyaDetected) {
+        if (manager->keyaDetected) {
             LOG_INFO(EventSource::CAN, "Keya motor detected on CAN3");
         }
     }
-    
-    LOG_INFO(EventSource::CAN, "CAN Manager initialization complete");
-    return true;
 }
 
 void CANManager::pollForDevices() {
@@ -58,4 +67,211 @@ void CANManager::pollForDevices() {
     
     // Skip CAN1 and CAN2 if not in use
     // CAN polling not currently used - motor drivers handle CAN directly
-}
\ No newline at end of file
+}
+
+// ===== Diagnostics =====
+
+void CANManager::onFrameRx(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles) {
+    if (!instance) return;
+    instance->busDiag[busNum - 1].rxFrames++;
+    instance->windowBits[busNum - 1] += frameBits(msg);
+    instance->recordId(busNum, msg, cycles);
+    CANCapture::getInstance()->record(busNum, msg, cycles, false);
+}
+
+void CANManager::onFrameTx(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles) {
+    if (!instance) return;
+    CANBusDiagnostics& diag = instance->busDiag[busNum - 1];
+    diag.txFrames++;
+    instance->windowBits[busNum - 1] += frameBits(msg);
+    CANCapture::getInstance()->record(busNum, msg, cycles, true);
+
+    diag.txQueueHighWater = getCANBus(busNum)->getTxScheduler().getStats().queueHighWater;
+}
+
+uint16_t CANManager::frameBits(const CAN_message_t& msg) {
+    // Frame length including worst-case bit stuffing and interframe space,
+    // so utilization is an upper bound
+    uint16_t dataBits = 8 * msg.len;
+    if (msg.flags.extended) {
+        return 67 + dataBits + (54 + dataBits - 1) / 4;
+    }
+    return 47 + dataBits + (34 + dataBits - 1) / 4;
+}
+
+void CANManager::recordId(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles) {
+    CANIdStats* entry = nullptr;
+    CANIdStats* victim = nullptr;
+    float victimScore = 0.0f;
+
+    for (uint8_t i = 0; i < MAX_TRACKED_IDS; i++) {
+        CANIdStats& e = idStats[i];
+        if (e.bus == busNum && e.id == msg.id && e.extended == (bool)msg.flags.extended) {
+            entry = &e;
+            break;
+        }
+        // Free slot, otherwise the quietest ID (new entries have no rate yet, use their live count)
+        float score = (e.bus == 0) ? -1.0f : ((e.rateHz > e.windowCount) ? e.rateHz : (float)e.windowCount);
+        if (!victim || score < victimScore) {
+            victim = &e;
+            victimScore = score;
+        }
+    }
+
+    if (!entry) {
+        memset(victim, 0, sizeof(CANIdStats));
+        victim->bus = busNum;
+        victim->id = msg.id;
+        victim->extended = msg.flags.extended;
+        entry = victim;
+    } else {
+        // Inter-arrival time and jitter, smoothed like RFC 3550 (gain 1/16)
+        float interval = (float)(cycles - entry->lastCycles) / (F_CPU_ACTUAL / 1000000);
+        if (entry->intervalUs == 0.0f) {
+            entry->intervalUs = interval;
+        } else {
+            float deviation = interval - entry->intervalUs;
+            entry->intervalUs += deviation / 16.0f;
+            entry->jitterUs += (fabsf(deviation) - entry->jitterUs) / 16.0f;
+        }
+    }
+
+    entry->count++;
+    entry->windowCount++;
+    entry->len = msg.len > 8 ? 8 : msg.len;
+    memcpy(entry->data, msg.buf, entry->len);
+    entry->lastCycles = cycles;
+    entry->lastSeen = millis();
+}
+
+void CANManager::pollErrors(uint8_t busNum) {
+    uint32_t base = (busNum == 1) ? CAN1 : (busNum == 2) ? CAN2 : CAN3;
+    CANBusDiagnostics& diag = busDiag[busNum - 1];
+
+    uint32_t esr = FLEXCANb_ESR1(base);
+    uint32_t ecr = FLEXCANb_ECR(base);
+
+    diag.txErrorCounter = ecr & 0xFF;
+    diag.rxErrorCounter = (ecr >> 8) & 0xFF;
+    diag.faultState = FLEXCAN_ESR_get_fault_code(esr);
+
+    // ERRINT (bit 1) and BOFFINT (bit 2) latch until written with 1
+    uint32_t latched = esr & ((1UL << 1) | (1UL << 2));
+    if (latched) {
+        if (latched & (1UL << 1)) {
+            diag.errorEvents++;
+        }
+        if (latched & (1UL << 2)) {
+            diag.busOffEvents++;
+            LOG_WARNING(EventSource::CAN, "CAN%d bus off (TEC %d)", busNum, diag.txErrorCounter);
+        }
+        FLEXCANb_ESR1(base) = latched;
+    }
+}
+
+void CANManager::drainIdleBus(uint8_t busNum) {
+    // No driver has read this bus recently - read it here so its traffic is still counted
+    CANBusDiagnostics& diag = busDiag[busNum - 1];
+    uint32_t lastRead = getCANLastReadTime(busNum);
+
+    if (diag.monitored) {
+        if (lastRead != monitorReadTime[busNum - 1]) {
+            // Someone else read the bus since our last drain - a driver owns it again
+            diag.monitored = false;
+            return;
+        }
+    } else if (lastRead != 0 && millis() - lastRead < MONITOR_IDLE_MS) {
+        return;
+    }
+
+    if (!diag.monitored) {
+        enableCANRxInterrupts(busNum);
+        diag.monitored = true;
+        LOG_DEBUG(EventSource::CAN, "CAN%d: no driver reading, monitor draining", busNum);
+    }
+
+    CANRxFrame frame;
+    while (readCANFrame(busNum, frame)) {
+        // Counted by the RX observer
+    }
+    monitorReadTime[busNum - 1] = getCANLastReadTime(busNum);
+}
+
+void CANManager::updateRates() {
+    uint32_t now = millis();
+    uint32_t elapsed = now - windowStart;
+    if (elapsed < DIAG_WINDOW_MS) {
+        return;
+    }
+    windowStart = now;
+
+    for (uint8_t i = 0; i < 3; i++) {
+        CANBusDiagnostics& diag = busDiag[i];
+        diag.rxRate = (diag.rxFrames - windowRx[i]) * 1000.0f / elapsed;
+        diag.txRate = (diag.txFrames - windowTx[i]) * 1000.0f / elapsed;
+        windowRx[i] = diag.rxFrames;
+        windowTx[i] = diag.txFrames;
+
+        uint32_t speed = getCANSpeed(i + 1);
+        diag.utilization = speed ? (windowBits[i] * 100.0f * 1000.0f) / ((float)speed * elapsed) : 0.0f;
+        windowBits[i] = 0;
+
+        const CANBusRxQueue* queue = getCANRxQueue(i + 1);
+        diag.rxQueueHighWater = queue->getHighWater();
+        diag.rxQueueDropped = queue->getDropped();
+    }
+
+    for (uint8_t i = 0; i < MAX_TRACKED_IDS; i++) {
+        CANIdStats& e = idStats[i];
+        if (e.bus == 0) continue;
+        e.rateHz = e.windowCount * 1000.0f / elapsed;
+        e.windowCount = 0;
+    }
+}
+
+void CANManager::process() {
+    for (uint8_t busNum = 1; busNum <= 3; busNum++) {
+        pollErrors(busNum);
+        drainIdleBus(busNum);
+    }
+    CANCapture::getInstance()->process();
+    updateRates();
+}
+
+const char* CANManager::faultStateToString(uint8_t state) {
+    switch (state) {
+        case 0:  return "error active";
+        case 1:  return "error passive";
+        default: return "bus off";
+    }
+}
+
+void CANManager::printDiagnostics() const {
+    Serial.print("\r\n=== CAN Bus Diagnostics ===");
+    for (uint8_t i = 0; i < 3; i++) {
+        const CANBusDiagnostics& d = busDiag[i];
+        Serial.printf("\r\nCAN%d %lu bps: load %.1f%%, RX %.0f/s, TX %.0f/s%s%s",
+                      i + 1, getCANSpeed(i + 1), d.utilization, d.rxRate, d.txRate,
+                      getCANBus(i + 1)->isRxFiltered() ? " (RX after filters)" : "",
+                      d.monitored ? " (monitor)" : "");
+        Serial.printf("\r\n  %s, REC %d, TEC %d, error events %lu, bus off %lu",
+                      faultStateToString(d.faultState), d.rxErrorCounter, d.txErrorCounter,
+                      d.errorEvents, d.busOffEvents);
+        Serial.printf("\r\n  RX queue high %d (dropped %lu), TX queue high %d",
+                      d.rxQueueHighWater, d.rxQueueDropped, d.txQueueHighWater);
+        const CANTxStats& tx = getCANBus(i + 1)->getTxScheduler().getStats();
+        Serial.printf("\r\n  TX steer %lu (aborted %lu, latency %lu/%lu us), other %lu (latency %lu/%lu us)",
+                      tx.steerSent, tx.steerAborted, tx.steerLatencyLastUs, tx.steerLatencyMaxUs,
+                      tx.sent, tx.latencyLastUs, tx.latencyMaxUs);
+        Serial.printf("\r\n  TX retries %lu, dropped %lu, deadline misses %lu",
+                      tx.retries, tx.dropped, tx.deadlineMisses);
+    }
+    for (uint8_t i = 0; i < MAX_TRACKED_IDS; i++) {
+        const CANIdStats& e = idStats[i];
+        if (e.bus == 0) continue;
+        Serial.printf("\r\n  CAN%d %0*lX: %6.1f Hz, interval %.1f ms, jitter %.2f ms, len %d",
+                      e.bus, e.extended ? 8 : 3, e.id, e.rateHz,
+                      e.intervalUs / 1000.0f, e.jitterUs / 1000.0f, e.len);
+    }
+    Serial.print("\r\n===========================\r\n");
+}
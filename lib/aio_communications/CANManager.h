@@ -4,15 +4,55 @@
 
 #include <Arduino.h>
 #include "CANGlobals.h"
+#include "DeviceDetector.h"
+
+// Per-bus traffic and error statistics
+struct CANBusDiagnostics {
+    uint32_t rxFrames;
+    uint32_t txFrames;
+    float rxRate;               // Frames/s over last window
+    float txRate;
+    float utilization;          // % of bit time used by frames seen (RX + TX)
+    uint8_t rxErrorCounter;     // REC from ECR
+    uint8_t txErrorCounter;     // TEC from ECR
+    uint8_t faultState;         // 0 = error active, 1 = error passive, 2+ = bus off
+    uint32_t errorEvents;       // ESR1 polls that showed bit/ack/crc/form/stuff errors
+    uint32_t busOffEvents;
+    uint16_t rxQueueHighWater;  // ISR receive queue
+    uint32_t rxQueueDropped;
+    uint16_t txQueueHighWater;  // CANTxScheduler queue
+    bool monitored;             // Drained by the monitor because no driver reads it
+};
+
+// Per-ID statistics (bounded table, lowest-rate entry is evicted when full)
+struct CANIdStats {
+    uint8_t bus;                // 0 = empty slot
+    bool extended;
+    uint32_t id;
+    uint32_t count;
+    uint32_t windowCount;
+    float rateHz;
+    uint8_t len;
+    uint8_t data[8];            // Last payload
+    uint32_t lastCycles;        // DWT stamp of last frame
+    uint32_t lastSeen;          // millis()
+    float intervalUs;           // Smoothed inter-arrival time
+    float jitterUs;             // Smoothed |interval - mean|
+};
 
 class CANManager {
 public:
+    static constexpr uint8_t MAX_TRACKED_IDS = 16;
+    static constexpr uint32_t DIAG_WINDOW_MS = 1000;
+    static constexpr uint32_t MONITOR_IDLE_MS = 200;   // Bus unread this long is drained by the monitor
+    static constexpr uint32_t DETECT_TIMEOUT_MS = 1000; // Listen for device heartbeats at boot
+
     // Use pointers to global CAN instances
     FlexCAN_T4<CAN1, RX_SIZE_256, TX_SIZE_16>* can1;
     FlexCAN_T4<CAN2, RX_SIZE_256, TX_SIZE_16>* can2;
     FlexCAN_T4<CAN3, RX_SIZE_256, TX_SIZE_256>* can3;
     
-    CANManager() : can1(&globalCAN1), can2(&globalCAN2), can3(&globalCAN3) {}
+    CANManager() : can1(&globalCAN1), can2(&globalCAN2), can3(&globalCAN3), heartbeatProbe(this) {}
     ~CANManager() = default;
     
     // Initialize all CAN buses
@@ -21,9 +61,20 @@ public:
     // Poll for device detection (sets flags, doesn't process messages)
     void pollForDevices();
     
-    // Poll for devices for a specific duration (milliseconds)
-    void pollForDevicesWithTimeout(uint32_t timeoutMs);
+    // Boot probe listening for device heartbeats, run by DeviceDetector after init()
+    DeviceProbe* getDeviceProbe() { return &heartbeatProbe; }
     
+    static CANManager* getInstance() { return instance; }
+
+    // Diagnostics - call regularly (100Hz) from the scheduler
+    void process();
+    const CANBusDiagnostics& getBusDiagnostics(uint8_t busNum) const {
+        return busDiag[(busNum >= 1 && busNum <= 3) ? busNum - 1 : 0];
+    }
+    const CANIdStats* getIdStats() const { return idStats; }
+    void printDiagnostics() const;
+    static const char* faultStateToString(uint8_t state);
+
     // Simple detection flags
     bool isKeyaDetected() const { return keyaDetected; }
     bool isCAN1Active() const { return can1Active; }
@@ -31,6 +82,36 @@ public:
     bool isCAN3Active() const { return can3Active; }
     
 private:
+    static CANManager* instance;
+
+    class HeartbeatProbe : public DeviceProbe {
+    public:
+        explicit HeartbeatProbe(CANManager* mgr) : manager(mgr) {}
+        const char* getName() const override { return "CAN heartbeat"; }
+        uint32_t getTimeoutMs() const override { return DETECT_TIMEOUT_MS; }
+        bool poll() override;       // Done early once the Keya heartbeat is seen
+        void finish(bool timedOut) override;
+    private:
+        CANManager* manager;
+    };
+    HeartbeatProbe heartbeatProbe;
+
+    CANBusDiagnostics busDiag[3] = {};
+    CANIdStats idStats[MAX_TRACKED_IDS] = {};
+    uint32_t windowBits[3] = {0};
+    uint32_t windowRx[3] = {0};
+    uint32_t windowTx[3] = {0};
+    uint32_t windowStart = 0;
+    uint32_t monitorReadTime[3] = {0};
+
+    static void onFrameRx(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles);
+    static void onFrameTx(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles);
+    static uint16_t frameBits(const CAN_message_t& msg);
+    void recordId(uint8_t busNum, const CAN_message_t& msg, uint32_t cycles);
+    void pollErrors(uint8_t busNum);
+    void drainIdleBus(uint8_t busNum);
+    void updateRates();
+
     // Detection flags
     bool keyaDetected = false;
     bool can1Active = false;
@@ -0,0 +1,80 @@
+// CANRxQueue.h - Lock-free single-producer/single-consumer CAN receive queue
+// Producer is the FlexCAN receive ISR, consumer is the main loop
+#ifndef CAN_RX_QUEUE_H
+#define CAN_RX_QUEUE_H
+
+#include <Arduino.h>
+#include <FlexCAN_T4.h>
+
+// Received frame plus the DWT cycle count captured in the ISR
+struct CANRxFrame {
+    CAN_message_t msg;
+    uint32_t cycles;
+};
+
+template <uint16_t SIZE>
+class CANRxQueue {
+    static_assert((SIZE & (SIZE - 1)) == 0, "CANRxQueue size must be a power of two");
+
+private:
+    CANRxFrame frames[SIZE];
+    volatile uint16_t head = 0;         // Next write slot, owned by ISR
+    volatile uint16_t tail = 0;         // Next read slot, owned by consumer
+    volatile uint32_t pushed = 0;
+    volatile uint32_t dropped = 0;      // Frames lost because the queue was full
+    volatile uint16_t highWater = 0;
+
+#if defined(__arm__)
+    static inline void barrier() { __asm__ volatile("dmb" ::: "memory"); }
+#else
+    static inline void barrier() { __sync_synchronize(); }   // Host build (tools/host)
+#endif
+
+public:
+    // ISR side
+    bool push(const CAN_message_t& msg, uint32_t cycles) {
+        uint16_t h = head;
+        uint16_t next = (h + 1) & (SIZE - 1);
+        if (next == tail) {
+            dropped++;
+            return false;
+        }
+        frames[h].msg = msg;
+        frames[h].cycles = cycles;
+        barrier();              // Frame visible before the index moves
+        head = next;
+        pushed++;
+
+        uint16_t depth = (next - tail) & (SIZE - 1);
+        if (depth > highWater) {
+            highWater = depth;
+        }
+        return true;
+    }
+
+    // Consumer side
+    bool pop(CANRxFrame& out) {
+        uint16_t t = tail;
+        if (t == head) {
+            return false;
+        }
+        barrier();
+        out = frames[t];
+        barrier();              // Copy complete before the slot is released
+        tail = (t + 1) & (SIZE - 1);
+        return true;
+    }
+
+    uint16_t depth() const { return (head - tail) & (SIZE - 1); }
+    uint16_t capacity() const { return SIZE - 1; }
+    uint16_t getHighWater() const { return highWater; }
+    uint32_t getPushed() const { return pushed; }
+    uint32_t getDropped() const { return dropped; }
+};
+
+// Microseconds since the ISR stamped this frame (valid for ~7s at 600MHz)
+inline uint32_t canFrameAgeMicros(const CANRxFrame& frame) {
+    return (ARM_DWT_CYCCNT - frame.cycles) / (F_CPU_ACTUAL / 1000000);
+}
+
+#endif // CAN_RX_QUEUE_H
@@ -0,0 +1,208 @@
+// CANTxScheduler.cpp - Per-bus CAN transmit scheduling
+#include "CANTxScheduler.h"
+#include "CANBus.h"
+
+static inline uint32_t cyclesToMicros(uint32_t cycles) {
+    return cycles / (F_CPU_ACTUAL / 1000000);
+}
+
+CANTxScheduler::CANTxScheduler(CANBus& owner)
+    : bus(owner), queueHead(0), queueCount(0), periodicCount(0), inFlight(0)
+{
+    memset(&stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < MAX_PERIODIC; i++) {
+        periodic[i].active = false;
+    }
+    memset(submitCycles, 0, sizeof(submitCycles));
+}
+
+bool CANTxScheduler::sendSteer(uint8_t slot, const CAN_message_t& msg) {
+    if (slot >= STEER_SLOTS) {
+        return false;
+    }
+    uint8_t mb = FIRST_STEER_MB + slot;
+    uint8_t bit = 1 << (mb - FIRST_TX_MB);
+
+    pollCompletions();
+    if (!bus.isTxMailboxIdle(mb)) {
+        // A whole command period has passed - the bus is saturated or not acking
+        if (bus.abortTxMailbox(mb, ABORT_TIMEOUT_US)) {
+            stats.steerAborted++;
+        }
+        inFlight &= ~bit;
+    }
+
+    load(mb, msg, ARM_DWT_CYCCNT);
+    stats.steerSent++;
+    return true;
+}
+
+bool CANTxScheduler::send(const CAN_message_t& msg) {
+    uint32_t now = ARM_DWT_CYCCNT;
+
+    // Keep FIFO order - only bypass the queue when it is empty
+    if (queueCount == 0) {
+        pollCompletions();
+        if (isMailboxFree(FIFO_MB)) {
+            load(FIFO_MB, msg, now);
+            stats.sent++;
+            return true;
+        }
+    }
+
+    if (queueCount >= QUEUE_SIZE) {
+        stats.dropped++;
+        return false;
+    }
+
+    QueuedFrame& q = queue[(queueHead + queueCount) % QUEUE_SIZE];
+    q.msg = msg;
+    q.cycles = now;
+    queueCount++;
+    if (queueCount > stats.queueHighWater) {
+        stats.queueHighWater = queueCount;
+    }
+    return true;
+}
+
+int8_t CANTxScheduler::addPeriodic(const CAN_message_t& msg, uint16_t periodMs, uint16_t deadlineMs) {
+    for (uint8_t i = 0; i < MAX_PERIODIC; i++) {
+        PeriodicSlot& p = periodic[i];
+        if (p.active) {
+            continue;
+        }
+        p.msg = msg;
+        p.periodMs = periodMs ? periodMs : 1;
+        p.deadlineMs = deadlineMs;
+        p.releaseMs = millis();
+        p.active = true;
+        periodicCount++;
+        return i;
+    }
+    return -1;
+}
+
+void CANTxScheduler::updatePeriodic(int8_t slot, const CAN_message_t& msg) {
+    if (slot >= 0 && slot < MAX_PERIODIC && periodic[slot].active) {
+        periodic[slot].msg = msg;
+    }
+}
+
+void CANTxScheduler::removePeriodic(int8_t slot) {
+    if (slot >= 0 && slot < MAX_PERIODIC && periodic[slot].active) {
+        periodic[slot].active = false;
+        periodicCount--;
+    }
+}
+
+void CANTxScheduler::process() {
+    if (inFlight == 0 && queueCount == 0 && periodicCount == 0) {
+        return;
+    }
+    pollCompletions();
+    releasePeriodic();
+    drainQueue();
+}
+
+void CANTxScheduler::pollCompletions() {
+    if (inFlight == 0) {
+        return;
+    }
+
+    uint32_t now = ARM_DWT_CYCCNT;
+    for (uint8_t i = 0; i < TX_MB_COUNT; i++) {
+        uint8_t bit = 1 << i;
+        if (!(inFlight & bit) || !bus.isTxMailboxIdle(FIRST_TX_MB + i)) {
+            continue;
+        }
+        inFlight &= ~bit;
+
+        uint32_t us = cyclesToMicros(now - submitCycles[i]);
+        if (FIRST_TX_MB + i >= FIRST_STEER_MB) {
+            stats.steerLatencyLastUs = us;
+            if (us > stats.steerLatencyMaxUs) {
+                stats.steerLatencyMaxUs = us;
+            }
+        } else {
+            stats.latencyLastUs = us;
+            if (us > stats.latencyMaxUs) {
+                stats.latencyMaxUs = us;
+            }
+        }
+    }
+}
+
+void CANTxScheduler::releasePeriodic() {
+    if (periodicCount == 0) {
+        return;
+    }
+
+    uint32_t now = millis();
+    while (true) {
+        // Earliest deadline first among the frames that are due
+        PeriodicSlot* next = nullptr;
+        int32_t nextSlack = 0;
+        for (uint8_t i = 0; i < MAX_PERIODIC; i++) {
+            PeriodicSlot& p = periodic[i];
+            if (!p.active || (int32_t)(now - p.releaseMs) < 0) {
+                continue;
+            }
+            int32_t slack = (int32_t)(p.releaseMs + p.deadlineMs - now);
+            if (!next || slack < nextSlack) {
+                next = &p;
+                nextSlack = slack;
+            }
+        }
+        if (!next) {
+            return;
+        }
+
+        int8_t mb = findFreePeriodicMB();
+        if (mb < 0) {
+            stats.retries++;
+            return;
+        }
+
+        load(mb, next->msg, ARM_DWT_CYCCNT);
+        stats.sent++;
+        if (nextSlack < 0) {
+            stats.deadlineMisses++;
+        }
+
+        next->releaseMs += next->periodMs;
+        if ((int32_t)(now - next->releaseMs) >= 0) {
+            next->releaseMs = now + next->periodMs;  // Fell a whole period behind - don't burst
+        }
+    }
+}
+
+void CANTxScheduler::drainQueue() {
+    // One frame per pass - the next waits until this one is on the wire
+    if (queueCount == 0 || !isMailboxFree(FIFO_MB)) {
+        return;
+    }
+    QueuedFrame& q = queue[queueHead];
+    load(FIFO_MB, q.msg, q.cycles);
+    stats.sent++;
+    queueHead = (queueHead + 1) % QUEUE_SIZE;
+    queueCount--;
+}
+
+bool CANTxScheduler::isMailboxFree(uint8_t mb) const {
+    return !(inFlight & (1 << (mb - FIRST_TX_MB))) && bus.isTxMailboxIdle(mb);
+}
+
+int8_t CANTxScheduler::findFreePeriodicMB() const {
+    for (uint8_t mb = FIFO_MB + 1; mb < FIRST_STEER_MB; mb++) {
+        if (isMailboxFree(mb)) {
+            return mb;
+        }
+    }
+    return -1;
+}
+
+void CANTxScheduler::load(uint8_t mb, const CAN_message_t& msg, uint32_t cycles) {
+    bus.loadTxMailbox(mb, msg);
+    inFlight |= 1 << (mb - FIRST_TX_MB);
+    submitCycles[mb - FIRST_TX_MB] = cycles;
+}
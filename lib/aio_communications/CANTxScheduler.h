@@ -0,0 +1,101 @@
+// CANTxScheduler.h - Per-bus CAN transmit scheduling
+// Owns the FlexCAN transmit mailboxes (MB8-15). The top two are reserved for
+// steering commands so they never wait behind other traffic. MB8 carries the
+// send() queue one frame at a time, so frames leave in the order they were
+// sent; periodic slots share MB9-13, earliest deadline first.
+#ifndef CAN_TX_SCHEDULER_H
+#define CAN_TX_SCHEDULER_H
+
+#include <Arduino.h>
+#include <FlexCAN_T4.h>
+
+class CANBus;
+
+struct CANTxStats {
+    uint32_t steerSent;
+    uint32_t steerAborted;          // Steering frame still pending when its successor arrived
+    uint32_t sent;                  // Queued and periodic frames loaded into a mailbox
+    uint32_t retries;               // Periodic releases that found no free mailbox
+    uint32_t dropped;               // General queue full
+    uint32_t deadlineMisses;        // Periodic frames loaded after their deadline
+    uint16_t queueHighWater;
+    uint32_t steerLatencyLastUs;    // Submit to transmit complete
+    uint32_t steerLatencyMaxUs;
+    uint32_t latencyLastUs;         // Same for general and periodic frames
+    uint32_t latencyMaxUs;
+};
+
+class CANTxScheduler {
+public:
+    static constexpr uint8_t FIRST_TX_MB = 8;
+    static constexpr uint8_t TX_MB_COUNT = 8;
+    static constexpr uint8_t STEER_SLOTS = 2;
+    static constexpr uint8_t FIRST_STEER_MB = FIRST_TX_MB + TX_MB_COUNT - STEER_SLOTS;
+    static constexpr uint8_t FIFO_MB = FIRST_TX_MB;
+    static constexpr uint8_t QUEUE_SIZE = 16;
+    static constexpr uint8_t MAX_PERIODIC = 8;
+    static constexpr uint32_t ABORT_TIMEOUT_US = 1000;     // > one 8 byte frame at 250kbps
+
+    explicit CANTxScheduler(CANBus& owner);
+
+    // Steering command into its reserved mailbox (slot 0..STEER_SLOTS-1). A frame
+    // still pending in that slot is stale by now and is aborted first.
+    // Equal IDs leave in slot order (lower mailbox wins arbitration).
+    bool sendSteer(uint8_t slot, const CAN_message_t& msg);
+
+    // Any other frame - loaded now if the FIFO mailbox is free, else queued.
+    // Frames leave in send() order: with several mailboxes pending, a lower
+    // one refilled later would win arbitration over older frames with the
+    // same ID (J1939 TP.DT packets, for one). This replaces FlexCAN_T4's
+    // msg.seq ordering, which the scheduler does not go through.
+    bool send(const CAN_message_t& msg);
+
+    // Fixed-rate frame sent by the scheduler; the owner updates the payload.
+    // Returns the slot or -1 if none is free.
+    int8_t addPeriodic(const CAN_message_t& msg, uint16_t periodMs, uint16_t deadlineMs);
+    void updatePeriodic(int8_t slot, const CAN_message_t& msg);
+    void removePeriodic(int8_t slot);
+
+    // Track completions, release periodic frames and drain the queue (every loop)
+    void process();
+
+    const CANTxStats& getStats() const { return stats; }
+    uint8_t getQueueDepth() const { return queueCount; }
+
+private:
+    struct QueuedFrame {
+        CAN_message_t msg;
+        uint32_t cycles;            // DWT stamp at submit
+    };
+
+    struct PeriodicSlot {
+        CAN_message_t msg;
+        uint16_t periodMs;
+        uint16_t deadlineMs;
+        uint32_t releaseMs;         // millis() the next frame is due
+        bool active;
+    };
+
+    CANBus& bus;
+    CANTxStats stats;
+
+    QueuedFrame queue[QUEUE_SIZE];
+    uint8_t queueHead;
+    uint8_t queueCount;
+
+    PeriodicSlot periodic[MAX_PERIODIC];
+    uint8_t periodicCount;
+
+    // Frames in flight, for latency (bit n = MB FIRST_TX_MB + n)
+    uint8_t inFlight;
+    uint32_t submitCycles[TX_MB_COUNT];
+
+    void pollCompletions();
+    void releasePeriodic();
+    void drainQueue();
+    bool isMailboxFree(uint8_t mb) const;
+    int8_t findFreePeriodicMB() const;
+    void load(uint8_t mb, const CAN_message_t& msg, uint32_t cycles);
+};
+
+#endif // CAN_TX_SCHEDULER_H
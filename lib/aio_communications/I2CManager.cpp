@@ -3,7 +3,7 @@
 #include "EventLogger.h"
 #include "HardwareManager.h"
 
-I2CManager::I2CManager() {
+I2CManager::I2CManager() : deviceProbe(this) {
     // Initialize bus info structures
     wire0Info = {false, 0, 0, {0}};
     wire1Info = {false, 0, 0, {0}};
@@ -99,84 +99,66 @@ bool I2CManager::initializeBus(TwoWire& wire, uint32_t speed) {
     return (error == 2 || error == 0);
 }
 
+// Addresses the board can have fitted; probing only these avoids poking
+// unknown devices that can hang the bus
+const uint8_t I2CManager::KNOWN_ADDRESSES[KNOWN_ADDRESS_COUNT] = {
+    PCA9685_ADDRESS, PCA9685_SECTION_ADDRESS, BNO08X_DEFAULT_ADDRESS, BNO08X_ALT_ADDRESS,
+    CMPS14_ADDRESS, ADS1115_ADDRESS_GND, ADS1115_ADDRESS_VDD, MCP23017_ADDRESS
+};
+
 bool I2CManager::detectDevices() {
-    bool foundAny = false;
-    
-    if (wire0Info.initialized) {
-        LOG_DEBUG(EventSource::SYSTEM, "Scanning Wire (I2C0)...");
-        if (scanBus(Wire, wire0Info)) {
-            foundAny = true;
-        }
-    }
-    
-    if (wire1Info.initialized) {
-        LOG_DEBUG(EventSource::SYSTEM, "Scanning Wire1 (I2C1)...");
-        if (scanBus(Wire1, wire1Info)) {
-            foundAny = true;
-        }
-    }
+    DeviceDetector detector;
+    detector.add(getDeviceProbe());
+    detector.run();
     
-    if (wire2Info.initialized) {
-        LOG_DEBUG(EventSource::SYSTEM, "Scanning Wire2 (I2C2)...");
-        if (scanBus(Wire2, wire2Info)) {
-            foundAny = true;
-        }
+    return (wire0Info.deviceCount + wire1Info.deviceCount + wire2Info.deviceCount) > 0;
+}
+
+void I2CManager::KnownDeviceProbe::begin() {
+    busIndex = 0;
+    addressIndex = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        I2CBusInfo& info = manager->busInfo(i);
+        info.deviceCount = 0;
+        memset(info.deviceAddresses, 0, sizeof(info.deviceAddresses));
     }
-    
-    return foundAny;
 }
 
-bool I2CManager::scanBus(TwoWire& wire, I2CBusInfo& busInfo) {
-    busInfo.deviceCount = 0;
-    memset(busInfo.deviceAddresses, 0, sizeof(busInfo.deviceAddresses));
+bool I2CManager::KnownDeviceProbe::poll() {
+    // One address per call so the other probes keep running
+    while (busIndex < 3 && !manager->busInfo(busIndex).initialized) {
+        busIndex++;
+    }
+    if (busIndex >= 3) {
+        return true;
+    }
     
-    bool foundAny = false;
-    uint32_t scanStart = millis();
+    TwoWire& wire = manager->busWire(busIndex);
+    I2CBusInfo& info = manager->busInfo(busIndex);
+    uint8_t address = KNOWN_ADDRESSES[addressIndex];
     
-    // Scan all valid I2C addresses (0x08-0x77)
-    for (uint8_t address = 0x08; address <= 0x77; address++) {
-        // Check for timeout - max 2 seconds per bus
-        if (millis() - scanStart > 2000) {
-            LOG_WARNING(EventSource::SYSTEM, "  I2C scan timeout at address 0x%02X", address);
-            break;
-        }
-        
-        wire.beginTransmission(address);
-        uint8_t error = wire.endTransmission();
-        
-        if (error == 0) {
-            // Device found
-            busInfo.deviceAddresses[address] = 1;
-            busInfo.deviceCount++;
-            foundAny = true;
-            
-            // Identify the device
-            I2CDeviceType deviceType = identifyDevice(wire, address);
-            
-            LOG_INFO(EventSource::SYSTEM, "  Found device at 0x%02X: %s", 
-                         address, getDeviceTypeName(deviceType));
-        } else if (error == 2) {
-            // NACK on address - no device present (normal)
-        } else if (error == 3) {
-            // NACK on data - device present but not responding properly
-            LOG_DEBUG(EventSource::SYSTEM, "  Device at 0x%02X not responding properly", address);
-        } else if (error == 4) {
-            // Other error - could indicate bus problem
-            LOG_WARNING(EventSource::SYSTEM, "  I2C error %d at address 0x%02X", error, address);
-            // Don't continue scanning if we get unknown errors
-            break;
-        }
-        
-        delay(1); // Small delay between scans
+    wire.beginTransmission(address);
+    if (wire.endTransmission() == 0) {
+        info.deviceAddresses[address] = 1;
+        info.deviceCount++;
+        LOG_INFO(EventSource::SYSTEM, "  Found device at 0x%02X on Wire%s: %s", address,
+                 busIndex == 0 ? "" : (busIndex == 1 ? "1" : "2"),
+                 manager->getDeviceTypeName(manager->identifyDevice(wire, address)));
     }
     
-    if (!foundAny) {
-        LOG_DEBUG(EventSource::SYSTEM, "  No devices found");
-    } else {
-        LOG_DEBUG(EventSource::SYSTEM, "  Total devices: %d", busInfo.deviceCount);
+    if (++addressIndex >= KNOWN_ADDRESS_COUNT) {
+        addressIndex = 0;
+        busIndex++;
     }
-    
-    return foundAny;
+    return false;
+}
+
+TwoWire& I2CManager::busWire(uint8_t index) {
+    return index == 0 ? Wire : (index == 1 ? Wire1 : Wire2);
+}
+
+I2CManager::I2CBusInfo& I2CManager::busInfo(uint8_t index) {
+    return index == 0 ? wire0Info : (index == 1 ? wire1Info : wire2Info);
 }
 
 bool I2CManager::isDevicePresent(TwoWire& wire, uint8_t address) {
@@ -4,6 +4,7 @@
 
 #include <Arduino.h>
 #include <Wire.h>
+#include "DeviceDetector.h"
 
 // Common I2C device addresses
 #define BNO08X_DEFAULT_ADDRESS  0x4A  // BNO08x IMU default address
@@ -15,6 +16,7 @@
 #define ADS1115_ADDRESS_SCL     0x4B  // ADS1115 ADC with ADDR->SCL
 #define MCP23017_ADDRESS        0x20  // MCP23017 I/O expander base address
 #define PCA9685_ADDRESS         0x70  // PCA9685 PWM LED driver
+#define PCA9685_SECTION_ADDRESS 0x44  // PCA9685 section outputs
 
 // I2C speeds
 #define I2C_SPEED_STANDARD      100000  // 100 kHz
@@ -46,12 +48,34 @@ private:
     I2CBusInfo wire1Info;
     I2CBusInfo wire2Info;
     
+    // Boot probe: checks the known addresses on every initialized bus
+    class KnownDeviceProbe : public DeviceProbe {
+    public:
+        explicit KnownDeviceProbe(I2CManager* mgr) : manager(mgr) {}
+        const char* getName() const override { return "I2C"; }
+        uint32_t getTimeoutMs() const override { return DETECT_TIMEOUT_MS; }
+        void begin() override;
+        bool poll() override;
+    private:
+        I2CManager* manager;
+        uint8_t busIndex = 0;
+        uint8_t addressIndex = 0;
+    };
+    KnownDeviceProbe deviceProbe;
+    
+    static constexpr uint8_t KNOWN_ADDRESS_COUNT = 8;
+    static const uint8_t KNOWN_ADDRESSES[KNOWN_ADDRESS_COUNT];
+    
+    TwoWire& busWire(uint8_t index);
+    I2CBusInfo& busInfo(uint8_t index);
+    
     // Device detection
-    bool scanBus(TwoWire& wire, I2CBusInfo& busInfo);
     I2CDeviceType identifyDevice(TwoWire& wire, uint8_t address);
     const char* getDeviceTypeName(I2CDeviceType type);
     
 public:
+    static constexpr uint32_t DETECT_TIMEOUT_MS = 200;
+    
     I2CManager();
     ~I2CManager() = default;
     
@@ -59,8 +83,9 @@ public:
     bool initializeI2C();
     bool initializeBus(TwoWire& wire, uint32_t speed = I2C_SPEED_FAST);
     
-    // Device detection
+    // Device detection (known addresses only, results in getDeviceCount())
     bool detectDevices();
+    DeviceProbe* getDeviceProbe() { return &deviceProbe; }  // Non-blocking, for DeviceDetector
     bool isDevicePresent(TwoWire& wire, uint8_t address);
     I2CDeviceType getDeviceType(TwoWire& wire, uint8_t address);
     
@@ -0,0 +1,828 @@
+// J1939Stack.cpp - Address claim, TP/ETP sessions and PGN dispatch
+#include "J1939Stack.h"
+#include "ConfigManager.h"
+#include "EventLogger.h"
+
+J1939Stack* J1939Stack::instance = nullptr;
+
+// Reassembly buffers, one per RX session
+static uint8_t rxBuffers[J1939Stack::RX_SESSIONS][J1939Stack::RX_BUFFER_SIZE] DMAMEM;
+
+// Connection management control bytes
+static constexpr uint8_t TP_RTS = 16;
+static constexpr uint8_t TP_CTS = 17;
+static constexpr uint8_t TP_EOMA = 19;
+static constexpr uint8_t TP_BAM = 32;
+static constexpr uint8_t ETP_RTS = 20;
+static constexpr uint8_t ETP_CTS = 21;
+static constexpr uint8_t ETP_DPO = 22;
+static constexpr uint8_t ETP_EOMA = 23;
+static constexpr uint8_t CM_ABORT = 255;
+
+// Abort reasons
+static constexpr uint8_t ABORT_RESOURCES = 2;
+static constexpr uint8_t ABORT_TIMEOUT = 3;
+static constexpr uint8_t ABORT_CTS_WHILE_SENDING = 4;
+static constexpr uint8_t ABORT_BAD_SEQUENCE = 7;
+
+static constexpr uint8_t TP_PRIORITY = 7;
+static constexpr uint8_t CLAIM_PRIORITY = 6;
+
+static inline uint32_t readPGN(const uint8_t* p) {
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16);
+}
+
+static inline void writePGN(uint8_t* p, uint32_t pgn) {
+    p[0] = pgn & 0xFF;
+    p[1] = (pgn >> 8) & 0xFF;
+    p[2] = (pgn >> 16) & 0xFF;
+}
+
+J1939Stack::J1939Stack()
+    : bus(nullptr), name(0), address(NULL_ADDRESS), claimState(ClaimState::DISABLED),
+      claimTime(0), handlerCount(0)
+{
+    instance = this;
+    memset(addressInUse, 0, sizeof(addressInUse));
+    memset(&stats, 0, sizeof(stats));
+    for (uint8_t i = 0; i < RX_SESSIONS; i++) {
+        rxSessions[i] = Session();
+        rxSessions[i].rxBuffer = rxBuffers[i];
+    }
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        txSessions[i] = Session();
+    }
+}
+
+void J1939Stack::init() {
+    if (instance == nullptr) {
+        new J1939Stack();
+    }
+
+    CANSteerConfig config = ConfigManager::getInstance()->getCANSteerConfig();
+    uint8_t isoBus = 0;
+    if (config.can1Function == static_cast<uint8_t>(CANFunction::ISO_BUS)) {
+        isoBus = 1;
+    } else if (config.can2Function == static_cast<uint8_t>(CANFunction::ISO_BUS)) {
+        isoBus = 2;
+    } else if (config.can3Function == static_cast<uint8_t>(CANFunction::ISO_BUS)) {
+        isoBus = 3;
+    }
+
+    if (isoBus == 0) {
+        LOG_DEBUG(EventSource::CAN, "J1939: no ISO_Bus configured");
+        return;
+    }
+    instance->configure(isoBus);
+}
+
+void J1939Stack::configure(uint8_t busNum) {
+    bus = getCANBus(busNum);
+    bus->acceptAll();
+    enableCANRxInterrupts(busNum);
+
+    // Identity number from the board's unique MAC fuses
+    uint32_t identity = HW_OCOTP_MAC0 & 0x1FFFFF;
+    name = (uint64_t)identity |
+           ((uint64_t)MANUFACTURER_CODE << 21) |
+           ((uint64_t)FUNCTION_CODE << 40) |
+           ((uint64_t)DEVICE_CLASS << 49) |
+           ((uint64_t)INDUSTRY_GROUP << 60) |
+           (1ULL << 63);                        // Arbitrary address capable
+
+    // Learn who is already on the bus, then claim
+    address = NULL_ADDRESS;
+    sendRequest(PGN_ADDRESS_CLAIM, GLOBAL_ADDRESS);
+    address = PREFERRED_ADDRESS;
+    claimState = ClaimState::WAIT_CLAIM;
+    claimTime = millis();
+    sendAddressClaim();
+
+    LOG_INFO(EventSource::CAN, "J1939: CAN%d, claiming 0x%02X (NAME %08lX%08lX)", busNum, address,
+             (uint32_t)(name >> 32), (uint32_t)name);
+}
+
+void J1939Stack::process() {
+    if (!bus) {
+        return;
+    }
+
+    CANRxFrame frame;
+    while (bus->read(frame)) {
+        stats.rxFrames++;
+        handleFrame(frame.msg);
+    }
+
+    if (claimState == ClaimState::WAIT_CLAIM && millis() - claimTime >= CLAIM_WAIT_MS) {
+        claimState = ClaimState::CLAIMED;
+        LOG_INFO(EventSource::CAN, "J1939: address 0x%02X claimed", address);
+    }
+
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        pumpTx(txSessions[i]);
+    }
+    checkTimeouts();
+}
+
+bool J1939Stack::onPGN(uint32_t pgn, J1939Handler handler, void* context) {
+    if (handlerCount >= MAX_HANDLERS || !handler) {
+        return false;
+    }
+    handlers[handlerCount++] = {pgn, handler, context};
+    return true;
+}
+
+// ===== Framing =====
+
+bool J1939Stack::sendFrame(uint32_t pgn, uint8_t destination, uint8_t priority,
+                           const uint8_t* data, uint8_t len, uint8_t source) {
+    if (((pgn >> 8) & 0xFF) < 240) {
+        pgn = (pgn & 0x3FF00) | destination;   // PDU1 - destination in PS
+    }
+
+    CAN_message_t msg;
+    msg.id = ((uint32_t)(priority & 0x7) << 26) | (pgn << 8) | source;
+    msg.flags.extended = 1;
+    msg.len = len;
+    memcpy(msg.buf, data, len);
+
+    if (!bus->write(msg)) {
+        stats.txFull++;
+        return false;
+    }
+    return true;
+}
+
+void J1939Stack::handleFrame(const CAN_message_t& msg) {
+    if (!msg.flags.extended) {
+        return;
+    }
+
+    uint8_t priority = (msg.id >> 26) & 0x7;
+    uint32_t pgn = (msg.id >> 8) & 0x3FFFF;
+    uint8_t source = msg.id & 0xFF;
+    uint8_t destination = GLOBAL_ADDRESS;
+    if (((pgn >> 8) & 0xFF) < 240) {
+        destination = pgn & 0xFF;
+        pgn &= 0x3FF00;
+    }
+
+    if (pgn == PGN_ADDRESS_CLAIM) {
+        if (msg.len >= 8) {
+            handleAddressClaim(source, msg.buf);
+        }
+        return;
+    }
+
+    if (destination != GLOBAL_ADDRESS && destination != address) {
+        return;     // Addressed to another node
+    }
+
+    switch (pgn) {
+        case PGN_REQUEST:
+            handleRequest(source, destination, msg.buf, msg.len);
+            return;
+        case PGN_TP_CM:
+        case PGN_ETP_CM:
+            if (msg.len >= 8) {
+                handleConnectionManagement(pgn == PGN_ETP_CM, source, destination, msg.buf);
+            }
+            return;
+        case PGN_TP_DT:
+        case PGN_ETP_DT:
+            if (msg.len >= 8) {
+                handleDataTransfer(pgn == PGN_ETP_DT, source, destination, msg.buf);
+            }
+            return;
+    }
+
+    deliver(pgn, source, destination, priority, msg.buf, msg.len);
+}
+
+bool J1939Stack::deliver(uint32_t pgn, uint8_t source, uint8_t destination, uint8_t priority,
+                         const uint8_t* data, uint32_t length) {
+    J1939Message m = {pgn, source, destination, priority, data, length};
+    bool handled = false;
+    for (uint8_t i = 0; i < handlerCount; i++) {
+        if (handlers[i].pgn == pgn) {
+            handlers[i].handler(m, handlers[i].context);
+            handled = true;
+        }
+    }
+    if (handled) {
+        stats.rxMessages++;
+    }
+    return handled;
+}
+
+bool J1939Stack::send(uint32_t pgn, uint8_t destination, const uint8_t* data, uint32_t length,
+                      uint8_t priority, J1939TxDone done, void* context) {
+    return startSend(pgn, destination, data, nullptr, length, priority, done, context);
+}
+
+bool J1939Stack::send(uint32_t pgn, uint8_t destination, J1939TxSource source, uint32_t length,
+                      uint8_t priority, J1939TxDone done, void* context) {
+    return startSend(pgn, destination, nullptr, source, length, priority, done, context);
+}
+
+bool J1939Stack::startSend(uint32_t pgn, uint8_t destination, const uint8_t* data, J1939TxSource source,
+                           uint32_t length, uint8_t priority, J1939TxDone done, void* context) {
+    if (!bus || claimState != ClaimState::CLAIMED || length == 0) {
+        return false;
+    }
+
+    if (length <= 8) {
+        uint8_t frame[8];
+        if (source) {
+            source(0, frame, length, context);
+            data = frame;
+        }
+        if (!sendFrame(pgn, destination, priority, data, length)) {
+            return false;
+        }
+        stats.txMessages++;
+        return true;
+    }
+
+    bool broadcast = (destination == GLOBAL_ADDRESS);
+    if (length > (broadcast ? TP_MAX_SIZE : ETP_MAX_SIZE) || isTxBusy(destination)) {
+        return false;
+    }
+
+    Session* s = nullptr;
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        if (txSessions[i].state == SessionState::IDLE) {
+            s = &txSessions[i];
+            break;
+        }
+    }
+    if (!s) {
+        return false;
+    }
+
+    s->extended = length > TP_MAX_SIZE;
+    s->pgn = pgn;
+    s->peer = destination;
+    s->priority = priority;
+    s->size = length;
+    s->totalPackets = (length + 6) / 7;
+    s->nextPacket = 1;
+    s->windowEnd = 0;
+    s->dpoOffset = 0;
+    s->maxPerCTS = 0xFF;
+    s->txData = data;
+    s->txSource = source;
+    s->done = done;
+    s->context = context;
+
+    uint8_t d[8];
+    if (s->extended) {
+        d[0] = ETP_RTS;
+        d[1] = length & 0xFF;
+        d[2] = (length >> 8) & 0xFF;
+        d[3] = (length >> 16) & 0xFF;
+        d[4] = (length >> 24) & 0xFF;
+    } else {
+        d[0] = broadcast ? TP_BAM : TP_RTS;
+        d[1] = length & 0xFF;
+        d[2] = (length >> 8) & 0xFF;
+        d[3] = s->totalPackets;
+        d[4] = s->maxPerCTS;
+    }
+    writePGN(&d[5], pgn);
+
+    if (!sendFrame(s->extended ? PGN_ETP_CM : PGN_TP_CM, destination, TP_PRIORITY, d, 8)) {
+        return false;
+    }
+
+    // BAM packets follow at BAM_INTERVAL_MS, RTS waits for the first CTS
+    s->state = broadcast ? SessionState::TX_BAM : SessionState::TX_WAIT_CTS;
+    setTimer(*s, broadcast ? BAM_INTERVAL_MS : T3_MS);
+    return true;
+}
+
+bool J1939Stack::sendRequest(uint32_t pgn, uint8_t destination) {
+    // Only a request for address claim may go out before we have an address
+    if (!bus || (claimState != ClaimState::CLAIMED && pgn != PGN_ADDRESS_CLAIM)) {
+        return false;
+    }
+    uint8_t d[3];
+    writePGN(d, pgn);
+    return sendFrame(PGN_REQUEST, destination, CLAIM_PRIORITY, d, 3);
+}
+
+bool J1939Stack::isTxBusy(uint8_t destination) const {
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        if (txSessions[i].state != SessionState::IDLE && txSessions[i].peer == destination) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===== Address claim =====
+
+void J1939Stack::sendAddressClaim() {
+    uint8_t d[8];
+    for (uint8_t i = 0; i < 8; i++) {
+        d[i] = (name >> (8 * i)) & 0xFF;
+    }
+    sendFrame(PGN_ADDRESS_CLAIM, GLOBAL_ADDRESS, CLAIM_PRIORITY, d, 8, address);
+}
+
+void J1939Stack::handleAddressClaim(uint8_t source, const uint8_t* data) {
+    uint64_t theirName = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        theirName |= (uint64_t)data[i] << (8 * i);
+    }
+    if (source == NULL_ADDRESS || theirName == name) {
+        return;
+    }
+    markAddress(source, true);
+
+    if (source != address || claimState == ClaimState::DISABLED ||
+        claimState == ClaimState::CANNOT_CLAIM) {
+        return;
+    }
+
+    // Lower NAME wins the address
+    if (name < theirName) {
+        sendAddressClaim();
+        return;
+    }
+
+    stats.addressLost++;
+    uint8_t lost = address;
+
+    // Transfers under the old address are dead
+    for (uint8_t i = 0; i < RX_SESSIONS; i++) {
+        rxSessions[i].state = SessionState::IDLE;
+    }
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        if (txSessions[i].state != SessionState::IDLE) {
+            finishTx(txSessions[i], false);
+        }
+    }
+
+    if (pickNextAddress()) {
+        claimState = ClaimState::WAIT_CLAIM;
+        claimTime = millis();
+        LOG_WARNING(EventSource::CAN, "J1939: lost 0x%02X, claiming 0x%02X", lost, address);
+    } else {
+        address = NULL_ADDRESS;
+        claimState = ClaimState::CANNOT_CLAIM;
+        LOG_ERROR(EventSource::CAN, "J1939: lost 0x%02X, no free address", lost);
+    }
+    sendAddressClaim();
+}
+
+void J1939Stack::handleRequest(uint8_t source, uint8_t destination, const uint8_t* data, uint8_t len) {
+    if (len < 3) {
+        return;
+    }
+    uint32_t requested = readPGN(data);
+
+    if (requested == PGN_ADDRESS_CLAIM) {
+        if (claimState != ClaimState::DISABLED) {
+            sendAddressClaim();     // From NULL_ADDRESS when we cannot claim
+        }
+        return;
+    }
+
+    if (deliver(PGN_REQUEST, source, destination, 6, data, len) || destination == GLOBAL_ADDRESS ||
+        claimState != ClaimState::CLAIMED) {
+        return;
+    }
+
+    // Nobody answers this PGN - a destination-specific request must be NACKed
+    uint8_t d[8] = {1, 0xFF, 0xFF, 0xFF, source, 0, 0, 0};
+    writePGN(&d[5], requested);
+    sendFrame(PGN_ACKNOWLEDGEMENT, GLOBAL_ADDRESS, CLAIM_PRIORITY, d, 8);
+}
+
+bool J1939Stack::pickNextAddress() {
+    if (!(name >> 63)) {
+        return false;   // Not arbitrary address capable
+    }
+    uint8_t candidate = address;
+    for (uint8_t i = 0; i <= DYNAMIC_LAST - DYNAMIC_FIRST; i++) {
+        candidate = (candidate >= DYNAMIC_FIRST && candidate < DYNAMIC_LAST) ? candidate + 1 : DYNAMIC_FIRST;
+        if (!isAddressUsed(candidate)) {
+            address = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+void J1939Stack::markAddress(uint8_t addr, bool used) {
+    if (used) {
+        addressInUse[addr >> 5] |= 1UL << (addr & 31);
+    } else {
+        addressInUse[addr >> 5] &= ~(1UL << (addr & 31));
+    }
+}
+
+bool J1939Stack::isAddressUsed(uint8_t addr) const {
+    return addressInUse[addr >> 5] & (1UL << (addr & 31));
+}
+
+// ===== Transport protocol =====
+
+void J1939Stack::handleConnectionManagement(bool extended, uint8_t source, uint8_t destination,
+                                            const uint8_t* data) {
+    bool broadcast = (destination == GLOBAL_ADDRESS);
+    uint8_t control = data[0];
+    uint32_t pgn = readPGN(&data[5]);
+
+    switch (control) {
+        case TP_BAM:
+            if (!extended && broadcast) {
+                startRxSession(false, true, source, pgn, data[1] | (data[2] << 8), data[3], 0xFF, TP_PRIORITY);
+            }
+            return;
+
+        case TP_RTS:
+            if (!extended && !broadcast) {
+                startRxSession(false, false, source, pgn, data[1] | (data[2] << 8), data[3], data[4], TP_PRIORITY);
+            }
+            return;
+
+        case ETP_RTS:
+            if (extended && !broadcast) {
+                uint32_t size = data[1] | (data[2] << 8) | ((uint32_t)data[3] << 16) | ((uint32_t)data[4] << 24);
+                startRxSession(true, false, source, pgn, size, (size + 6) / 7, 0xFF, TP_PRIORITY);
+            }
+            return;
+
+        case ETP_DPO: {
+            Session* s = findRxSession(source, false);
+            if (extended && s && s->extended && s->pgn == pgn) {
+                s->dpoOffset = data[2] | (data[3] << 8) | ((uint32_t)data[4] << 16);
+                setTimer(*s, T1_MS);
+            }
+            return;
+        }
+
+        case TP_CTS:
+        case ETP_CTS: {
+            Session* s = findTxSession(source);
+            if (s && s->extended == extended && s->pgn == pgn) {
+                handleCTS(*s, data);
+            }
+            return;
+        }
+
+        case TP_EOMA:
+        case ETP_EOMA: {
+            Session* s = findTxSession(source);
+            if (s && s->extended == extended && s->pgn == pgn && s->state == SessionState::TX_WAIT_EOMA) {
+                finishTx(*s, true);
+            }
+            return;
+        }
+
+        case CM_ABORT: {
+            stats.abortsReceived++;
+            Session* tx = findTxSession(source);
+            if (tx && tx->pgn == pgn) {
+                finishTx(*tx, false);
+            }
+            Session* rx = findRxSession(source, false);
+            if (rx && rx->pgn == pgn) {
+                rx->state = SessionState::IDLE;
+            }
+            LOG_DEBUG(EventSource::CAN, "J1939: 0x%02X aborted PGN %05lX (reason %d)", source, pgn, data[1]);
+            return;
+        }
+    }
+}
+
+void J1939Stack::startRxSession(bool extended, bool broadcast, uint8_t source, uint32_t pgn,
+                                uint32_t size, uint32_t packets, uint8_t maxPerCTS, uint8_t priority) {
+    bool valid = size > 8 && size <= RX_BUFFER_SIZE && packets == (size + 6) / 7 &&
+                 (extended || size <= TP_MAX_SIZE);
+
+    // A new announcement from the same sender replaces its old transfer
+    Session* s = findRxSession(source, broadcast);
+    if (!s && valid) {
+        for (uint8_t i = 0; i < RX_SESSIONS; i++) {
+            if (rxSessions[i].state == SessionState::IDLE) {
+                s = &rxSessions[i];
+                break;
+            }
+        }
+    }
+
+    if (!s || !valid) {
+        if (s) {
+            s->state = SessionState::IDLE;
+        }
+        stats.rejected++;
+        if (!broadcast) {
+            sendAbort(extended, source, pgn, ABORT_RESOURCES);
+        }
+        return;
+    }
+
+    s->extended = extended;
+    s->pgn = pgn;
+    s->peer = source;
+    s->priority = priority;
+    s->size = size;
+    s->totalPackets = packets;
+    s->nextPacket = 1;
+    s->dpoOffset = 0;
+    s->maxPerCTS = maxPerCTS ? maxPerCTS : 1;
+
+    if (broadcast) {
+        s->state = SessionState::RX_BAM;
+        setTimer(*s, T1_MS);
+    } else {
+        sendCTS(*s);
+    }
+}
+
+void J1939Stack::sendCTS(Session& s) {
+    uint32_t count = s.totalPackets - s.nextPacket + 1;
+    if (count > RX_WINDOW) {
+        count = RX_WINDOW;
+    }
+    if (count > s.maxPerCTS) {
+        count = s.maxPerCTS;
+    }
+    s.windowEnd = s.nextPacket + count - 1;
+
+    uint8_t d[8];
+    d[0] = s.extended ? ETP_CTS : TP_CTS;
+    d[1] = count;
+    d[2] = s.nextPacket & 0xFF;
+    d[3] = s.extended ? (s.nextPacket >> 8) & 0xFF : 0xFF;
+    d[4] = s.extended ? (s.nextPacket >> 16) & 0xFF : 0xFF;
+    writePGN(&d[5], s.pgn);
+    sendFrame(s.extended ? PGN_ETP_CM : PGN_TP_CM, s.peer, TP_PRIORITY, d, 8);
+
+    s.state = SessionState::RX_DATA;
+    setTimer(s, T2_MS);
+}
+
+void J1939Stack::sendEOMA(const Session& s) {
+    uint8_t d[8];
+    if (s.extended) {
+        d[0] = ETP_EOMA;
+        d[1] = s.size & 0xFF;
+        d[2] = (s.size >> 8) & 0xFF;
+        d[3] = (s.size >> 16) & 0xFF;
+        d[4] = (s.size >> 24) & 0xFF;
+    } else {
+        d[0] = TP_EOMA;
+        d[1] = s.size & 0xFF;
+        d[2] = (s.size >> 8) & 0xFF;
+        d[3] = s.totalPackets;
+        d[4] = 0xFF;
+    }
+    writePGN(&d[5], s.pgn);
+    sendFrame(s.extended ? PGN_ETP_CM : PGN_TP_CM, s.peer, TP_PRIORITY, d, 8);
+}
+
+void J1939Stack::sendAbort(bool extended, uint8_t peer, uint32_t pgn, uint8_t reason) {
+    uint8_t d[8] = {CM_ABORT, reason, 0xFF, 0xFF, 0xFF, 0, 0, 0};
+    writePGN(&d[5], pgn);
+    sendFrame(extended ? PGN_ETP_CM : PGN_TP_CM, peer, TP_PRIORITY, d, 8);
+    stats.abortsSent++;
+}
+
+void J1939Stack::handleDataTransfer(bool extended, uint8_t source, uint8_t destination,
+                                    const uint8_t* data) {
+    bool broadcast = (destination == GLOBAL_ADDRESS);
+    Session* s = findRxSession(source, broadcast);
+    if (!s || s->extended != extended) {
+        return;
+    }
+
+    uint32_t packet = s->dpoOffset + data[0];
+    if (packet < s->nextPacket) {
+        return;     // Repeat of a packet we already have
+    }
+    if (packet != s->nextPacket || (!broadcast && packet > s->windowEnd)) {
+        if (!broadcast) {
+            sendAbort(extended, source, s->pgn, ABORT_BAD_SEQUENCE);
+        }
+        s->state = SessionState::IDLE;
+        return;
+    }
+
+    uint32_t offset = (packet - 1) * 7;
+    uint32_t n = s->size - offset;
+    memcpy(s->rxBuffer + offset, &data[1], n > 7 ? 7 : n);
+    s->nextPacket++;
+
+    if (s->nextPacket > s->totalPackets) {
+        if (!broadcast) {
+            sendEOMA(*s);
+        }
+        stats.tpRxCompleted++;
+        deliver(s->pgn, source, destination, s->priority, s->rxBuffer, s->size);
+        s->state = SessionState::IDLE;
+    } else if (!broadcast && s->nextPacket > s->windowEnd) {
+        sendCTS(*s);
+    } else {
+        setTimer(*s, T1_MS);
+    }
+}
+
+void J1939Stack::handleCTS(Session& s, const uint8_t* data) {
+    if (s.state == SessionState::TX_DATA) {
+        sendAbort(s.extended, s.peer, s.pgn, ABORT_CTS_WHILE_SENDING);
+        finishTx(s, false);
+        return;
+    }
+    if (s.state != SessionState::TX_WAIT_CTS && s.state != SessionState::TX_WAIT_EOMA) {
+        return;
+    }
+
+    uint8_t count = data[1];
+    uint32_t next = s.extended ? data[2] | (data[3] << 8) | ((uint32_t)data[4] << 16) : data[2];
+    if (count == 0) {
+        s.state = SessionState::TX_WAIT_CTS;    // Receiver holds the connection open
+        setTimer(s, T4_MS);
+        return;
+    }
+    if (next < 1 || next > s.totalPackets) {
+        sendAbort(s.extended, s.peer, s.pgn, ABORT_BAD_SEQUENCE);
+        finishTx(s, false);
+        return;
+    }
+
+    s.nextPacket = next;
+    s.windowEnd = next + count - 1;
+    if (s.windowEnd > s.totalPackets) {
+        s.windowEnd = s.totalPackets;
+    }
+
+    if (s.extended) {
+        s.dpoOffset = next - 1;
+        uint8_t d[8];
+        d[0] = ETP_DPO;
+        d[1] = s.windowEnd - next + 1;
+        d[2] = s.dpoOffset & 0xFF;
+        d[3] = (s.dpoOffset >> 8) & 0xFF;
+        d[4] = (s.dpoOffset >> 16) & 0xFF;
+        writePGN(&d[5], s.pgn);
+        sendFrame(PGN_ETP_CM, s.peer, TP_PRIORITY, d, 8);
+    }
+
+    s.state = SessionState::TX_DATA;
+    pumpTx(s);
+}
+
+void J1939Stack::pumpTx(Session& s) {
+    if (s.state == SessionState::TX_BAM) {
+        if (millis() - s.timerMs < BAM_INTERVAL_MS || !sendDataPacket(s)) {
+            return;
+        }
+        if (s.nextPacket > s.totalPackets) {
+            finishTx(s, true);
+        } else {
+            s.timerMs = millis();
+        }
+        return;
+    }
+
+    if (s.state != SessionState::TX_DATA) {
+        return;
+    }
+
+    // DT packets share one ID, so a whole window can only be queued because
+    // the scheduler sends its queue through a single mailbox, in order (the
+    // receiver aborts on a sequence gap). Keep a few scheduler slots free so
+    // other senders on this bus are not starved.
+    const CANTxScheduler& tx = bus->getTxScheduler();
+    while (s.nextPacket <= s.windowEnd &&
+           tx.getQueueDepth() < CANTxScheduler::QUEUE_SIZE - TX_QUEUE_RESERVE) {
+        if (!sendDataPacket(s)) {
+            break;
+        }
+    }
+
+    if (s.nextPacket > s.windowEnd) {
+        s.state = (s.nextPacket > s.totalPackets) ? SessionState::TX_WAIT_EOMA : SessionState::TX_WAIT_CTS;
+        setTimer(s, T3_MS);
+    }
+}
+
+bool J1939Stack::sendDataPacket(Session& s) {
+    uint8_t d[8];
+    uint32_t offset = (s.nextPacket - 1) * 7;
+    uint32_t n = s.size - offset;
+    if (n > 7) {
+        n = 7;
+    }
+    d[0] = s.nextPacket - s.dpoOffset;
+    if (s.txSource) {
+        s.txSource(offset, &d[1], n, s.context);
+    } else {
+        memcpy(&d[1], s.txData + offset, n);
+    }
+    memset(&d[1 + n], 0xFF, 7 - n);
+
+    if (!sendFrame(s.extended ? PGN_ETP_DT : PGN_TP_DT, s.peer, TP_PRIORITY, d, 8)) {
+        return false;
+    }
+    s.nextPacket++;
+    return true;
+}
+
+void J1939Stack::finishTx(Session& s, bool ok) {
+    // Free the slot first so the callback can start the next transfer
+    s.state = SessionState::IDLE;
+    if (ok) {
+        stats.tpTxCompleted++;
+        stats.txMessages++;
+    }
+    if (s.done) {
+        s.done(s.pgn, s.peer, ok, s.context);
+    }
+}
+
+J1939Stack::Session* J1939Stack::findRxSession(uint8_t source, bool broadcast) {
+    for (uint8_t i = 0; i < RX_SESSIONS; i++) {
+        Session& s = rxSessions[i];
+        if (s.state != SessionState::IDLE && s.peer == source &&
+            (s.state == SessionState::RX_BAM) == broadcast) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+J1939Stack::Session* J1939Stack::findTxSession(uint8_t destination) {
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        Session& s = txSessions[i];
+        if (s.state != SessionState::IDLE && s.peer == destination) {
+            return &s;
+        }
+    }
+    return nullptr;
+}
+
+void J1939Stack::setTimer(Session& s, uint32_t timeoutMs) {
+    s.timerMs = millis();
+    s.timeoutMs = timeoutMs;
+}
+
+void J1939Stack::checkTimeouts() {
+    uint32_t now = millis();
+
+    for (uint8_t i = 0; i < RX_SESSIONS; i++) {
+        Session& s = rxSessions[i];
+        if (s.state == SessionState::IDLE || now - s.timerMs < s.timeoutMs) {
+            continue;
+        }
+        stats.timeouts++;
+        if (s.state == SessionState::RX_DATA) {
+            sendAbort(s.extended, s.peer, s.pgn, ABORT_TIMEOUT);
+        }
+        s.state = SessionState::IDLE;
+    }
+
+    for (uint8_t i = 0; i < TX_SESSIONS; i++) {
+        Session& s = txSessions[i];
+        if ((s.state != SessionState::TX_WAIT_CTS && s.state != SessionState::TX_WAIT_EOMA) ||
+            now - s.timerMs < s.timeoutMs) {
+            continue;
+        }
+        stats.timeouts++;
+        sendAbort(s.extended, s.peer, s.pgn, ABORT_TIMEOUT);
+        finishTx(s, false);
+    }
+}
+
+// ===== Status =====
+
+const char* J1939Stack::claimStateToString(ClaimState s) {
+    switch (s) {
+        case ClaimState::DISABLED:     return "disabled";
+        case ClaimState::WAIT_CLAIM:   return "claiming";
+        case ClaimState::CLAIMED:      return "claimed";
+        case ClaimState::CANNOT_CLAIM: return "cannot claim";
+        default:                       return "unknown";
+    }
+}
+
+void J1939Stack::printStatus() const {
+    Serial.print("\r\n=== J1939 ===");
+    if (!bus) {
+        Serial.print("\r\nNo ISO_Bus configured\r\n");
+        return;
+    }
+    Serial.printf("\r\nCAN%d address 0x%02X (%s), NAME %08lX%08lX",
+                  bus->getNumber(), address, claimStateToString(claimState),
+                  (uint32_t)(name >> 32), (uint32_t)name);
+    Serial.printf("\r\nRX frames %lu, messages %lu, transfers %lu",
+                  stats.rxFrames, stats.rxMessages, stats.tpRxCompleted);
+    Serial.printf("\r\nTX messages %lu, transfers %lu, scheduler full %lu",
+                  stats.txMessages, stats.tpTxCompleted, stats.txFull);
+    Serial.printf("\r\nAborts sent %lu, received %lu, timeouts %lu, rejected %lu, address lost %lu\r\n",
+                  stats.abortsSent, stats.abortsReceived, stats.timeouts, stats.rejected, stats.addressLost);
+}
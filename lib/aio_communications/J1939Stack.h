@@ -0,0 +1,220 @@
+// J1939Stack.h - Lean J1939/ISOBUS network layer for the ISO_Bus
+// Address claim (J1939-81), TP and ETP multi-packet transfers (J1939-21,
+// ISO 11783-3) and per-PGN receive callbacks. Everything is statically sized:
+// a fixed session pool, receive buffers in DMAMEM, and transmit data that
+// stays with the caller (const tables in flash need no copy).
+#ifndef J1939_STACK_H
+#define J1939_STACK_H
+
+#include <Arduino.h>
+#include "CANBus.h"
+
+// A complete J1939 message - a single frame or a reassembled TP/ETP transfer
+struct J1939Message {
+    uint32_t pgn;
+    uint8_t source;
+    uint8_t destination;        // GLOBAL_ADDRESS for broadcasts
+    uint8_t priority;
+    const uint8_t* data;        // Valid only during the callback
+    uint32_t length;
+};
+
+// Receive callback, registered per PGN
+typedef void (*J1939Handler)(const J1939Message& msg, void* context);
+
+// Fills out with length bytes of a transmit payload starting at offset, for
+// data produced on the fly (e.g. decompressed from flash). Offsets normally
+// increase but can step back when the receiver asks for a retransmit.
+typedef void (*J1939TxSource)(uint32_t offset, uint8_t* out, uint8_t length, void* context);
+
+// Multi-packet transmit finished (ok) or was aborted/timed out
+typedef void (*J1939TxDone)(uint32_t pgn, uint8_t destination, bool ok, void* context);
+
+struct J1939Stats {
+    uint32_t rxFrames;              // Frames read from the bus
+    uint32_t rxMessages;            // Messages delivered to handlers
+    uint32_t txMessages;            // Single frames and completed transfers sent
+    uint32_t tpRxCompleted;         // Reassembled TP/ETP transfers
+    uint32_t tpTxCompleted;
+    uint32_t abortsSent;
+    uint32_t abortsReceived;
+    uint32_t timeouts;
+    uint32_t rejected;              // Transfers refused: pool full or too large
+    uint32_t addressLost;           // Our address taken by a higher priority NAME
+    uint32_t txFull;                // Frames the transmit scheduler would not take
+};
+
+class J1939Stack {
+public:
+    enum class ClaimState : uint8_t {
+        DISABLED,       // No bus configured as ISO_Bus
+        WAIT_CLAIM,     // Claim sent, waiting out contention
+        CLAIMED,
+        CANNOT_CLAIM    // Lost arbitration with no address left
+    };
+
+    static constexpr uint8_t GLOBAL_ADDRESS = 0xFF;
+    static constexpr uint8_t NULL_ADDRESS = 0xFE;
+    static constexpr uint8_t PREFERRED_ADDRESS = 0x80;      // Start of the self-configurable range
+    static constexpr uint8_t DYNAMIC_FIRST = 128;
+    static constexpr uint8_t DYNAMIC_LAST = 247;
+
+    static constexpr uint32_t PGN_ACKNOWLEDGEMENT = 0xE800;
+    static constexpr uint32_t PGN_REQUEST = 0xEA00;
+    static constexpr uint32_t PGN_ADDRESS_CLAIM = 0xEE00;
+    static constexpr uint32_t PGN_TP_CM = 0xEC00;
+    static constexpr uint32_t PGN_TP_DT = 0xEB00;
+    static constexpr uint32_t PGN_ETP_CM = 0xC800;
+    static constexpr uint32_t PGN_ETP_DT = 0xC700;
+
+    // NAME fields (ISO 11783-5)
+    static constexpr uint16_t MANUFACTURER_CODE = 0x7FF;    // Not assigned
+    static constexpr uint8_t INDUSTRY_GROUP = 2;            // Agricultural and forestry
+    static constexpr uint8_t DEVICE_CLASS = 0;              // Non-specific system
+    static constexpr uint8_t FUNCTION_CODE = 134;           // Steering control
+
+    static constexpr uint8_t MAX_HANDLERS = 16;
+    static constexpr uint8_t RX_SESSIONS = 2;
+    static constexpr uint8_t TX_SESSIONS = 2;
+    static constexpr uint16_t RX_BUFFER_SIZE = 2048;        // Per RX session, in DMAMEM
+    static constexpr uint16_t TP_MAX_SIZE = 1785;           // 255 packets x 7 bytes
+    static constexpr uint32_t ETP_MAX_SIZE = 117440505;
+    static constexpr uint8_t RX_WINDOW = 16;                // Packets granted per CTS
+    static constexpr uint8_t TX_QUEUE_RESERVE = 4;          // Scheduler queue slots left to other senders
+
+    // Timing (J1939-21 / J1939-81)
+    static constexpr uint32_t CLAIM_WAIT_MS = 250;
+    static constexpr uint32_t BAM_INTERVAL_MS = 50;
+    static constexpr uint32_t T1_MS = 750;      // Between DT packets
+    static constexpr uint32_t T2_MS = 1250;     // CTS sent, waiting for DT
+    static constexpr uint32_t T3_MS = 1250;     // Last DT sent, waiting for CTS/EOMA
+    static constexpr uint32_t T4_MS = 1050;     // Hold (CTS with 0 packets)
+
+    static void init();
+    static J1939Stack* getInstance() { return instance; }
+
+    // Drain the bus, run sessions and timers (every loop)
+    void process();
+
+    // Call handler for every message with this PGN addressed to us or broadcast
+    bool onPGN(uint32_t pgn, J1939Handler handler, void* context = nullptr);
+
+    // Send a message. Up to 8 bytes goes out as one frame; longer ones use
+    // BAM (broadcast), TP (<= 1785 bytes) or ETP. Multi-packet data must stay
+    // valid until done is called. False if not claimed, busy or unsupported.
+    bool send(uint32_t pgn, uint8_t destination, const uint8_t* data, uint32_t length,
+              uint8_t priority = 6, J1939TxDone done = nullptr, void* context = nullptr);
+    bool send(uint32_t pgn, uint8_t destination, J1939TxSource source, uint32_t length,
+              uint8_t priority = 6, J1939TxDone done = nullptr, void* context = nullptr);
+    bool sendRequest(uint32_t pgn, uint8_t destination);
+    bool isTxBusy(uint8_t destination) const;
+
+    bool isEnabled() const { return bus != nullptr; }
+    bool isAddressClaimed() const { return claimState == ClaimState::CLAIMED; }
+    uint8_t getAddress() const { return address; }
+    uint64_t getName() const { return name; }
+    ClaimState getClaimState() const { return claimState; }
+    static const char* claimStateToString(ClaimState s);
+    const J1939Stats& getStats() const { return stats; }
+    void printStatus() const;
+
+private:
+    static J1939Stack* instance;
+
+    J1939Stack();
+
+    enum class SessionState : uint8_t {
+        IDLE,
+        RX_BAM,         // Receiving broadcast packets
+        RX_DATA,        // CTS sent, receiving packets
+        TX_BAM,         // Sending broadcast packets at BAM_INTERVAL_MS
+        TX_WAIT_CTS,    // RTS or last window sent
+        TX_DATA,        // Sending a CTS window
+        TX_WAIT_EOMA
+    };
+
+    struct Session {
+        SessionState state;
+        bool extended;              // ETP
+        uint32_t pgn;
+        uint8_t peer;               // Source (RX) or destination (TX)
+        uint8_t priority;
+        uint32_t size;
+        uint32_t totalPackets;
+        uint32_t nextPacket;        // Absolute, 1-based
+        uint32_t windowEnd;         // Last packet of the current CTS window
+        uint32_t dpoOffset;         // ETP: packets before the current window
+        uint8_t maxPerCTS;          // TP RTS byte 5 (TX: from us, RX: from the sender)
+        uint32_t timerMs;           // millis() the current timeout started
+        uint32_t timeoutMs;
+        uint8_t* rxBuffer;
+        const uint8_t* txData;
+        J1939TxSource txSource;     // Used instead of txData when set
+        J1939TxDone done;
+        void* context;
+    };
+
+    struct HandlerEntry {
+        uint32_t pgn;
+        J1939Handler handler;
+        void* context;
+    };
+
+    CANBus* bus;
+    uint64_t name;
+    uint8_t address;
+    ClaimState claimState;
+    uint32_t claimTime;
+    uint32_t addressInUse[8];       // Bitmap of addresses claimed by others
+
+    Session rxSessions[RX_SESSIONS];
+    Session txSessions[TX_SESSIONS];
+    HandlerEntry handlers[MAX_HANDLERS];
+    uint8_t handlerCount;
+    J1939Stats stats;
+
+    void configure(uint8_t busNum);
+
+    bool startSend(uint32_t pgn, uint8_t destination, const uint8_t* data, J1939TxSource source,
+                   uint32_t length, uint8_t priority, J1939TxDone done, void* context);
+
+    // Framing
+    bool sendFrame(uint32_t pgn, uint8_t destination, uint8_t priority,
+                   const uint8_t* data, uint8_t len, uint8_t source);
+    bool sendFrame(uint32_t pgn, uint8_t destination, uint8_t priority,
+                   const uint8_t* data, uint8_t len) {
+        return sendFrame(pgn, destination, priority, data, len, address);
+    }
+    void handleFrame(const CAN_message_t& msg);
+    bool deliver(uint32_t pgn, uint8_t source, uint8_t destination, uint8_t priority,
+                 const uint8_t* data, uint32_t length);
+
+    // Address claim
+    void sendAddressClaim();
+    void handleAddressClaim(uint8_t source, const uint8_t* data);
+    void handleRequest(uint8_t source, uint8_t destination, const uint8_t* data, uint8_t len);
+    bool pickNextAddress();
+    void markAddress(uint8_t addr, bool used);
+    bool isAddressUsed(uint8_t addr) const;
+
+    // Transport
+    void handleConnectionManagement(bool extended, uint8_t source, uint8_t destination,
+                                    const uint8_t* data);
+    void handleDataTransfer(bool extended, uint8_t source, uint8_t destination,
+                            const uint8_t* data);
+    void startRxSession(bool extended, bool broadcast, uint8_t source, uint32_t pgn,
+                        uint32_t size, uint32_t packets, uint8_t maxPerCTS, uint8_t priority);
+    void sendCTS(Session& s);
+    void sendEOMA(const Session& s);
+    void sendAbort(bool extended, uint8_t peer, uint32_t pgn, uint8_t reason);
+    void handleCTS(Session& s, const uint8_t* data);
+    void pumpTx(Session& s);
+    bool sendDataPacket(Session& s);
+    void finishTx(Session& s, bool ok);
+    Session* findRxSession(uint8_t source, bool broadcast);
+    Session* findTxSession(uint8_t destination);
+    void checkTimeouts();
+    void setTimer(Session& s, uint32_t timeoutMs);
+};
+
+#endif // J1939_STACK_H
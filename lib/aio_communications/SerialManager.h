@@ -14,16 +14,24 @@
 
 class SerialManager
 {
+public:
+    // Buffer sizes (matching pcb.h values - using existing global buffers)
+    static const uint16_t GPS_BUFFER_SIZE = 128;    // GPS1rxbuffer size from pcb.h
+    static const uint16_t GPS1_TX_BUFFER_SIZE = 2048; // Holds a full RTCM burst so forwarding never blocks
+    static const uint16_t RADIO_BUFFER_SIZE = 512;
+    static const uint16_t RS232_BUFFER_SIZE = 256;
+    static const uint16_t ESP32_BUFFER_SIZE = 256;
+
 private:
     static SerialManager *instance;
     bool isInitialized;
 
     // Private serial buffers (encapsulated, not global)
     uint8_t gps1RxBuffer[128];
-    uint8_t gps1TxBuffer[256];
+    uint8_t gps1TxBuffer[GPS1_TX_BUFFER_SIZE];
     uint8_t gps2RxBuffer[128];
     uint8_t gps2TxBuffer[256];
-    uint8_t radioRxBuffer[64];
+    uint8_t radioRxBuffer[512];  // ~44ms of radio RTCM at 115200 baud
     uint8_t rs232TxBuffer[256];
     uint8_t esp32RxBuffer[256];
     uint8_t esp32TxBuffer[256];
@@ -36,13 +44,6 @@ private:
     bool prevUSB2DTR;
 
 public:
-    // Buffer sizes (matching pcb.h values - using existing global buffers)
-    static const uint16_t GPS_BUFFER_SIZE = 128;    // GPS1rxbuffer size from pcb.h
-    static const uint16_t GPS_TX_BUFFER_SIZE = 256; // GPS1txbuffer size from pcb.h
-    static const uint16_t RADIO_BUFFER_SIZE = 64;
-    static const uint16_t RS232_BUFFER_SIZE = 256;
-    static const uint16_t ESP32_BUFFER_SIZE = 256;
-
     // Baud rates (matching pcb.h values)
     static const int32_t BAUD_GPS = 460800;
     static const int32_t BAUD_RADIO = 115200;
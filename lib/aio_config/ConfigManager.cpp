@@ -15,6 +15,9 @@ ConfigManager::ConfigManager()
 {
     instance = this;
     initialized = false;
+    memset(controlConfigs, 0, sizeof(controlConfigs));
+    activeControlConfig = 0;
+    controlConfigVersion = 0;
     // Defer actual initialization until Serial is ready
 }
 
@@ -35,6 +38,7 @@ void ConfigManager::init()
         saveAllConfigs();
         updateVersion();
     }
+    publishControlConfig();
     initialized = true;
 }
 
@@ -54,6 +58,34 @@ ConfigManager *ConfigManager::getInstance()
 
 // Static init method removed - use instance init() instead
 
+void ConfigManager::publishControlConfig()
+{
+    uint8_t next = activeControlConfig ^ 1;
+    ControlConfig& c = controlConfigs[next];
+
+    c.version = ++controlConfigVersion;
+    c.kp = kp;
+    c.lowPWM = lowPWM;
+    c.ackermanFix = ackermanFix;
+    c.highPWM = highPWM;
+    c.minPWM = minPWM;
+    c.minSpeed = minSpeed;
+    c.motorDriveDirection = motorDriveDirection;
+    c.steerSwitch = steerSwitch;
+    c.steerButton = steerButton;
+    c.pressureSensor = pressureSensor;
+    c.useFusion = insUseFusion;
+    c.pwmBrakeMode = pwmBrakeMode;
+    c.controller = steerControllerConfig;
+
+    // Snapshot complete before readers can switch to it
+    __asm__ volatile("dmb" ::: "memory");
+    activeControlConfig = next;
+
+    LOG_DEBUG(EventSource::CONFIG, "Control config v%lu: Kp=%.0f PWM=%d-%.0f-%d MinSpeed=%d",
+              c.version, c.kp, c.minPWM, c.lowPWM, c.highPWM, c.minSpeed);
+}
+
 // EEPROM operations
 void ConfigManager::saveSteerConfig()
 {
@@ -391,6 +423,10 @@ void ConfigManager::loadAllConfigs()
     loadAnalogWorkSwitchConfig();
     loadMiscConfig();
     loadCANSteerConfig();  // Load CAN configuration
+    loadNTRIPConfig();
+    loadSteerControllerConfig();
+    loadFusionConfig();
+    loadKickoutConfig();
 }
 
 void ConfigManager::saveAllConfigs()
@@ -406,6 +442,10 @@ void ConfigManager::saveAllConfigs()
     saveAnalogWorkSwitchConfig();
     saveMiscConfig();
     saveCANSteerConfig();  // Save CAN configuration
+    saveNTRIPConfig();
+    saveSteerControllerConfig();
+    saveFusionConfig();
+    saveKickoutConfig();
 }
 
 void ConfigManager::resetToDefaults()
@@ -510,6 +550,7 @@ void ConfigManager::resetToDefaults()
     dns[0] = 8; dns[1] = 8; dns[2] = 8; dns[3] = 8;
     destIP[0] = 192; destIP[1] = 168; destIP[2] = 5; destIP[3] = 255;  // Broadcast
     destPort = 9999;
+    udpUnicast = true;
 
     // CAN steering defaults
     canSteerConfig.brand = 0;       // Disabled
@@ -522,6 +563,18 @@ void ConfigManager::resetToDefaults()
     canSteerConfig.moduleID = 0x1C; // Default Keya module ID
     canSteerConfig.reserved[0] = 0;
 
+    // NTRIP defaults (disabled, no caster)
+    ntripConfig = NTRIPConfig();
+
+    // Steer controller defaults (P-only at 100Hz)
+    steerControllerConfig = SteerControllerConfig();
+
+    // Virtual WAS defaults (encoder + heading rate, no WAS)
+    fusionConfig = FusionConfig();
+
+    // Kickout timing defaults (1s current debounce, as before)
+    kickoutConfig = KickoutConfig();
+
     eeVersion = CURRENT_EE_VERSION;
 }
 
@@ -717,6 +770,8 @@ void ConfigManager::saveNetworkConfig()
         addr += sizeof(uint8_t);
     }
     EEPROM.put(addr, destPort);
+    addr += sizeof(destPort);
+    EEPROM.put(addr, (uint8_t)(udpUnicast ? 1 : 0));
     
     LOG_INFO(EventSource::CONFIG, "Saved network config - IP: %d.%d.%d.%d",
              ipAddress[0], ipAddress[1], ipAddress[2], ipAddress[3]);
@@ -758,6 +813,12 @@ void ConfigManager::loadNetworkConfig()
         addr += sizeof(uint8_t);
     }
     EEPROM.get(addr, destPort);
+    addr += sizeof(destPort);
+    
+    // Older layouts end at destPort - anything but 0 means unicast enabled
+    uint8_t unicastRaw;
+    EEPROM.get(addr, unicastRaw);
+    udpUnicast = (unicastRaw != 0);
     
     LOG_INFO(EventSource::CONFIG, "Loaded network config - IP: %d.%d.%d.%d",
              ipAddress[0], ipAddress[1], ipAddress[2], ipAddress[3]);
@@ -808,4 +869,232 @@ void ConfigManager::loadCANSteerConfig() {
 
     LOG_INFO(EventSource::CONFIG, "Loaded CAN Steer config - Brand: %d",
              canSteerConfig.brand);
-}
\ No newline at end of file
+}
+
+// NTRIP client configuration methods
+void ConfigManager::setNTRIPConfig(const NTRIPConfig& config) {
+    ntripConfig = config;
+
+    // Strings come from the web UI - make sure they stay terminated
+    ntripConfig.host[sizeof(ntripConfig.host) - 1] = '\0';
+    ntripConfig.mountpoint[sizeof(ntripConfig.mountpoint) - 1] = '\0';
+    ntripConfig.username[sizeof(ntripConfig.username) - 1] = '\0';
+    ntripConfig.password[sizeof(ntripConfig.password) - 1] = '\0';
+}
+
+void ConfigManager::saveNTRIPConfig() {
+    int addr = NTRIP_CONFIG_ADDR;
+
+    // Write a marker byte to indicate valid config
+    uint8_t marker = 0x4E;  // 'N' for NTRIP
+    EEPROM.put(addr, marker);
+    addr += sizeof(marker);
+
+    // Save the entire struct
+    EEPROM.put(addr, ntripConfig);
+
+    LOG_INFO(EventSource::CONFIG, "Saved NTRIP config - %s %s:%u/%s",
+             ntripConfig.enabled ? "enabled" : "disabled",
+             ntripConfig.host, ntripConfig.port, ntripConfig.mountpoint);
+}
+
+void ConfigManager::loadNTRIPConfig() {
+    int addr = NTRIP_CONFIG_ADDR;
+
+    // Check for valid config marker
+    uint8_t marker;
+    EEPROM.get(addr, marker);
+    addr += sizeof(marker);
+
+    if (marker != 0x4E) {
+        LOG_INFO(EventSource::CONFIG, "No valid NTRIP config found, using defaults");
+        ntripConfig = NTRIPConfig();
+        return;
+    }
+
+    // Load the entire struct
+    NTRIPConfig loaded;
+    EEPROM.get(addr, loaded);
+    setNTRIPConfig(loaded);
+
+    if (ntripConfig.version != 1 && ntripConfig.version != 2) {
+        ntripConfig.version = 2;
+    }
+    if (ntripConfig.ggaIntervalSec == 0) {
+        ntripConfig.ggaIntervalSec = 10;
+    }
+
+    LOG_INFO(EventSource::CONFIG, "Loaded NTRIP config - %s %s:%u/%s",
+             ntripConfig.enabled ? "enabled" : "disabled",
+             ntripConfig.host, ntripConfig.port, ntripConfig.mountpoint);
+}
+
+// Steer controller configuration methods
+void ConfigManager::setSteerControllerConfig(const SteerControllerConfig& config) {
+    steerControllerConfig = config;
+
+    // Only rates the loop pacing and motor TX divider are built for
+    SteerControllerConfig& c = steerControllerConfig;
+    if (c.rateHz != 100 && c.rateHz != 200 && c.rateHz != 500) {
+        c.rateHz = 100;
+    }
+    c.ki = constrain(c.ki, 0.0f, 1000.0f);
+    c.kd = constrain(c.kd, 0.0f, 100.0f);
+    c.kff = constrain(c.kff, 0.0f, 100.0f);
+    c.integralLimit = constrain(c.integralLimit, 0.0f, 255.0f);
+    c.dFilterHz = constrain(c.dFilterHz, 0.0f, 100.0f);
+    c.scaleLow = constrain(c.scaleLow, 0.1f, 4.0f);
+    c.scaleHigh = constrain(c.scaleHigh, 0.1f, 4.0f);
+}
+
+void ConfigManager::saveSteerControllerConfig() {
+    int addr = STEER_CONTROLLER_ADDR;
+
+    // Write a marker byte to indicate valid config
+    uint8_t marker = 0x50;  // 'P' for PID
+    EEPROM.put(addr, marker);
+    addr += sizeof(marker);
+
+    // Save the entire struct
+    EEPROM.put(addr, steerControllerConfig);
+
+    LOG_INFO(EventSource::CONFIG, "Saved steer controller config - %dHz Ki=%.2f Kd=%.2f Kff=%.2f",
+             steerControllerConfig.rateHz, steerControllerConfig.ki,
+             steerControllerConfig.kd, steerControllerConfig.kff);
+}
+
+void ConfigManager::loadSteerControllerConfig() {
+    int addr = STEER_CONTROLLER_ADDR;
+
+    // Check for valid config marker
+    uint8_t marker;
+    EEPROM.get(addr, marker);
+    addr += sizeof(marker);
+
+    if (marker != 0x50) {
+        LOG_INFO(EventSource::CONFIG, "No valid steer controller config found, using defaults");
+        steerControllerConfig = SteerControllerConfig();
+        return;
+    }
+
+    // Load the entire struct
+    SteerControllerConfig loaded;
+    EEPROM.get(addr, loaded);
+    setSteerControllerConfig(loaded);
+
+    LOG_INFO(EventSource::CONFIG, "Loaded steer controller config - %dHz Ki=%.2f Kd=%.2f Kff=%.2f",
+             steerControllerConfig.rateHz, steerControllerConfig.ki,
+             steerControllerConfig.kd, steerControllerConfig.kff);
+}
+
+// Virtual WAS (fusion) configuration methods
+void ConfigManager::setFusionConfig(const FusionConfig& config) {
+    fusionConfig = config;
+
+    FusionConfig& c = fusionConfig;
+    c.wheelbase = constrain(c.wheelbase, 0.5f, 10.0f);
+    if (c.encoderCountsPerDegree == 0.0f) {
+        c.encoderCountsPerDegree = 100.0f;
+    }
+    c.maxSteeringAngle = constrain(c.maxSteeringAngle, 10.0f, 60.0f);
+    c.minSpeed = constrain(c.minSpeed, 0.1f, 5.0f);
+    c.wasNoise = constrain(c.wasNoise, 0.01f, 10.0f);
+    c.encoderNoise = constrain(c.encoderNoise, 0.01f, 10.0f);
+    c.gnssRateNoise = constrain(c.gnssRateNoise, 0.01f, 10.0f);
+    c.imuRateNoise = constrain(c.imuRateNoise, 0.01f, 10.0f);
+    // The fusion history covers at most 250ms at the fastest loop rate
+    c.wasLatencyMs = min(c.wasLatencyMs, (uint16_t)250);
+    c.encoderLatencyMs = min(c.encoderLatencyMs, (uint16_t)250);
+    c.gnssLatencyMs = min(c.gnssLatencyMs, (uint16_t)250);
+    c.imuLatencyMs = min(c.imuLatencyMs, (uint16_t)250);
+}
+
+void ConfigManager::saveFusionConfig() {
+    int addr = FUSION_CONFIG_ADDR;
+
+    // Write a marker byte to indicate valid config
+    uint8_t marker = 0x46;  // 'F' for fusion
+    EEPROM.put(addr, marker);
+    addr += sizeof(marker);
+
+    // Save the entire struct
+    EEPROM.put(addr, fusionConfig);
+
+    LOG_INFO(EventSource::CONFIG, "Saved fusion config - wheelbase %.2fm, %.1f counts/deg",
+             fusionConfig.wheelbase, fusionConfig.encoderCountsPerDegree);
+}
+
+void ConfigManager::loadFusionConfig() {
+    int addr = FUSION_CONFIG_ADDR;
+
+    // Check for valid config marker
+    uint8_t marker;
+    EEPROM.get(addr, marker);
+    addr += sizeof(marker);
+
+    if (marker != 0x46) {
+        LOG_INFO(EventSource::CONFIG, "No valid fusion config found, using defaults");
+        fusionConfig = FusionConfig();
+        return;
+    }
+
+    // Load the entire struct
+    FusionConfig loaded;
+    EEPROM.get(addr, loaded);
+    setFusionConfig(loaded);
+
+    LOG_INFO(EventSource::CONFIG, "Loaded fusion config - wheelbase %.2fm, %.1f counts/deg",
+             fusionConfig.wheelbase, fusionConfig.encoderCountsPerDegree);
+}
+
+// Kickout detection timing methods
+void ConfigManager::setKickoutConfig(const KickoutConfig& config) {
+    kickoutConfig = config;
+
+    KickoutConfig& c = kickoutConfig;
+    c.encoderDebounceMs = min(c.encoderDebounceMs, (uint16_t)2000);
+    c.pressureDebounceMs = min(c.pressureDebounceMs, (uint16_t)2000);
+    c.currentDebounceMs = min(c.currentDebounceMs, (uint16_t)2000);
+    c.hysteresisPercent = min(c.hysteresisPercent, (uint8_t)50);
+    c.riseWindowMs = constrain(c.riseWindowMs, (uint16_t)10, (uint16_t)500);
+}
+
+void ConfigManager::saveKickoutConfig() {
+    int addr = KICKOUT_CONFIG_ADDR;
+
+    // Write a marker byte to indicate valid config
+    uint8_t marker = 0x4B;  // 'K' for kickout
+    EEPROM.put(addr, marker);
+    addr += sizeof(marker);
+
+    // Save the entire struct
+    EEPROM.put(addr, kickoutConfig);
+
+    LOG_INFO(EventSource::CONFIG, "Saved kickout config - debounce %u/%u/%ums, hysteresis %u%%",
+             kickoutConfig.encoderDebounceMs, kickoutConfig.pressureDebounceMs,
+             kickoutConfig.currentDebounceMs, kickoutConfig.hysteresisPercent);
+}
+
+void ConfigManager::loadKickoutConfig() {
+    int addr = KICKOUT_CONFIG_ADDR;
+
+    // Check for valid config marker
+    uint8_t marker;
+    EEPROM.get(addr, marker);
+    addr += sizeof(marker);
+
+    if (marker != 0x4B) {
+        LOG_INFO(EventSource::CONFIG, "No valid kickout config found, using defaults");
+        kickoutConfig = KickoutConfig();
+        return;
+    }
+
+    // Load the entire struct
+    KickoutConfig loaded;
+    EEPROM.get(addr, loaded);
+    setKickoutConfig(loaded);
+
+    LOG_INFO(EventSource::CONFIG, "Loaded kickout config - debounce %u/%u/%ums, hysteresis %u%%",
+             kickoutConfig.encoderDebounceMs, kickoutConfig.pressureDebounceMs,
+             kickoutConfig.currentDebounceMs, kickoutConfig.hysteresisPercent);
+}
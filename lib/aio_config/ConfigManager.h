@@ -45,6 +45,90 @@ struct CANSteerConfig {
     uint8_t reserved[1];        // Future expansion
 };
 
+// NTRIP client configuration structure
+struct NTRIPConfig {
+    uint8_t enabled = 0;            // 0=Off, 1=On
+    uint8_t version = 2;            // 1=NTRIP v1 (ICY), 2=NTRIP v2 (HTTP/1.1)
+    uint8_t ggaUpload = 1;          // Send GGA to caster (needed for VRS/nearest base)
+    uint8_t ggaIntervalSec = 10;    // GGA upload interval
+    uint16_t port = 2101;
+    char host[64] = "";
+    char mountpoint[48] = "";
+    char username[32] = "";
+    char password[32] = "";
+};
+
+// Steer controller configuration structure. Kp and the PWM limits come from
+// AgOpenGPS (PGN 252); the rest is set through /api/steer/controller.
+// Defaults reproduce the original P-only loop at 100Hz.
+struct SteerControllerConfig {
+    uint16_t rateHz = 100;              // Control loop rate: 100, 200 or 500
+    float ki = 0.0f;                    // PWM per degree-second
+    float kd = 0.0f;                    // PWM per degree/s
+    float kff = 0.0f;                   // PWM per degree/s of target change
+    float integralLimit = 50.0f;        // PWM
+    float dFilterHz = 10.0f;            // Derivative low-pass cutoff
+    float scheduleSpeedLow = 0.0f;      // km/h, gains scaled by scaleLow at or below
+    float scheduleSpeedHigh = 0.0f;     // km/h, gains scaled by scaleHigh at or above
+    float scaleLow = 1.0f;
+    float scaleHigh = 1.0f;
+};
+
+// Virtual WAS (sensor fusion) configuration: vehicle geometry and, per
+// sensor, whether to fuse it, its noise (1 sigma) and its latency.
+// Set through /api/fusion/config.
+struct FusionConfig {
+    float wheelbase = 2.5f;             // m
+    float encoderCountsPerDegree = 100.0f;  // Keya position counts per wheel degree
+    float maxSteeringAngle = 40.0f;     // deg
+    float minSpeed = 0.5f;              // m/s, heading rate is not used below this
+    bool useWAS = false;                // Off by default: VWAS usually means no WAS is fitted
+    bool useEncoder = true;
+    bool useGNSSHeadingRate = true;
+    bool useIMUYawRate = true;
+    float wasNoise = 0.3f;              // deg
+    float encoderNoise = 0.1f;          // deg
+    float gnssRateNoise = 0.5f;         // deg/s
+    float imuRateNoise = 0.3f;          // deg/s
+    uint16_t wasLatencyMs = 0;
+    uint16_t encoderLatencyMs = 20;
+    uint16_t gnssLatencyMs = 100;
+    uint16_t imuLatencyMs = 10;
+};
+
+// Kickout detection timing: debounce and hysteresis for the level trips and
+// the rate-of-rise trips. Trip levels still come from AgOpenGPS (PGN 251).
+// Set through /api/kickout/config.
+struct KickoutConfig {
+    uint16_t encoderDebounceMs = 0;     // Count over the limit this long
+    uint16_t pressureDebounceMs = 0;    // Pressure over the threshold this long
+    uint16_t currentDebounceMs = 1000;  // Current over the threshold this long
+    uint8_t hysteresisPercent = 10;     // Of the trip level, before a trip clears
+    uint16_t pressureRiseRate = 0;      // PGN 250 units (0-255) per second, 0 = off
+    uint16_t currentRiseRate = 0;       // Percent of full scale per second, 0 = off
+    uint16_t riseWindowMs = 50;         // Span the rise rates are measured over
+};
+
+// Settings read by the steering loop every tick, copied out of ConfigManager
+// as one coherent snapshot. Rebuilt by publishControlConfig() whenever PGN
+// 251/252 or the web UI change steer settings.
+struct ControlConfig {
+    uint32_t version;           // Incremented on every publish
+    float kp;
+    float lowPWM;
+    float ackermanFix;
+    uint8_t highPWM;
+    uint8_t minPWM;
+    uint8_t minSpeed;           // 0.1 km/h units
+    bool motorDriveDirection;
+    bool steerSwitch;
+    bool steerButton;
+    bool pressureSensor;
+    bool useFusion;             // INS sensor fusion (VWAS)
+    bool pwmBrakeMode;
+    SteerControllerConfig controller;
+};
+
 // ConfigManager Pattern for PGN Settings Access
 // ============================================
 // All runtime access to PGN settings should go through ConfigManager methods.
@@ -159,6 +243,7 @@ private:
     uint8_t dns[4];
     uint8_t destIP[4];
     uint16_t destPort;
+    bool udpUnicast;             // Send high-rate streams to the discovered AgIO instead of destIP
     
     // Version control
     uint16_t eeVersion;
@@ -166,6 +251,24 @@ private:
     // CAN Steer configuration
     CANSteerConfig canSteerConfig;
 
+    // NTRIP client configuration
+    NTRIPConfig ntripConfig;
+
+    // Steer controller configuration
+    SteerControllerConfig steerControllerConfig;
+
+    // Virtual WAS (fusion) configuration
+    FusionConfig fusionConfig;
+
+    // Kickout detection timing
+    KickoutConfig kickoutConfig;
+
+    // Control loop snapshot, double buffered: publish fills the inactive copy
+    // and then flips the index, so a reader never sees a half-written one
+    ControlConfig controlConfigs[2];
+    volatile uint8_t activeControlConfig;
+    uint32_t controlConfigVersion;
+
     // Initialization tracking
     bool initialized;
 
@@ -227,6 +330,11 @@ public:
     float getAckermanFix() const { return ackermanFix; }
     void setAckermanFix(float value) { ackermanFix = value; }
 
+    // Control loop snapshot. Take the reference once per tick; it stays valid
+    // until the next publish, which only happens outside the control tasks.
+    const ControlConfig& getControlConfig() const { return controlConfigs[activeControlConfig]; }
+    void publishControlConfig();
+
     // LED configuration
     uint8_t getLEDBrightness() const { return ledBrightness; }
     void setLEDBrightness(uint8_t value) { 
@@ -350,6 +458,8 @@ public:
     void setDestIP(const uint8_t* dest) { memcpy(destIP, dest, 4); }
     uint16_t getDestPort() const { return destPort; }
     void setDestPort(uint16_t port) { destPort = port; }
+    bool getUDPUnicast() const { return udpUnicast; }
+    void setUDPUnicast(bool value) { udpUnicast = value; }
 
     // EEPROM operations
     void saveSteerConfig();
@@ -383,6 +493,30 @@ public:
     void setCANSteerConfig(const CANSteerConfig& config);
     void saveCANSteerConfig();
     void loadCANSteerConfig();
+
+    // NTRIP client configuration methods
+    const NTRIPConfig& getNTRIPConfig() const { return ntripConfig; }
+    void setNTRIPConfig(const NTRIPConfig& config);
+    void saveNTRIPConfig();
+    void loadNTRIPConfig();
+
+    // Steer controller configuration methods
+    const SteerControllerConfig& getSteerControllerConfig() const { return steerControllerConfig; }
+    void setSteerControllerConfig(const SteerControllerConfig& config);
+    void saveSteerControllerConfig();
+    void loadSteerControllerConfig();
+
+    // Virtual WAS (fusion) configuration methods
+    const FusionConfig& getFusionConfig() const { return fusionConfig; }
+    void setFusionConfig(const FusionConfig& config);
+    void saveFusionConfig();
+    void loadFusionConfig();
+
+    // Kickout detection timing methods
+    const KickoutConfig& getKickoutConfig() const { return kickoutConfig; }
+    void setKickoutConfig(const KickoutConfig& config);
+    void saveKickoutConfig();
+    void loadKickoutConfig();
 };
 
 #endif // CONFIGMANAGER_H_
\ No newline at end of file
@@ -18,5 +18,9 @@
 #define TURN_SENSOR_CONFIG_ADDR 1000 // Turn sensor configuration (1000-1099)
 #define ANALOG_WORK_SWITCH_ADDR 1100 // Analog work switch configuration (1100-1199)
 #define MISC_CONFIG_ADDR        1200 // Miscellaneous settings (1200-1299)
+#define NTRIP_CONFIG_ADDR       1300 // NTRIP client configuration (1300-1499)
+#define STEER_CONTROLLER_ADDR   1500 // Steer controller (PID) configuration (1500-1599)
+#define FUSION_CONFIG_ADDR      1600 // Virtual WAS (fusion) configuration (1600-1699)
+#define KICKOUT_CONFIG_ADDR     1700 // Kickout detection timing (1700-1749)
 
 #endif // EEPROM_LAYOUT_H
\ No newline at end of file
@@ -158,36 +158,58 @@ void HardwareManager::disableBuzzer()
 
 void HardwareManager::performBuzzerTest()
 {
+    startBuzzerTest();
+    while (!updateBuzzerTest()) {
+    }
+}
+
+void HardwareManager::startBuzzerTest()
+{
+    // Loud mode for field use plays ascending then descending tones,
+    // quiet mode for development is a cricket-like click
+    static const BuzzerNote LOUD_TEST[] = {
+        {1000, 200, 250}, {1500, 200, 250}, {2000, 300, 350}, {1500, 200, 250}, {1000, 300, 350}
+    };
+    static const BuzzerNote QUIET_TEST[] = {
+        {4000, 5, 10}
+    };
+
     // Get buzzer volume setting from ConfigManager
     extern ConfigManager configManager;
-    bool loudMode = configManager.getBuzzerLoudMode();
-    
-    if (loudMode) {
-        // Loud mode for field use - play multiple tones
+    if (configManager.getBuzzerLoudMode()) {
         LOG_INFO(EventSource::SYSTEM, "Playing LOUD buzzer test");
-        
-        // Play ascending tones
-        tone(getBuzzerPin(), 1000, 200);  // 1kHz for 200ms
-        delay(250);
-        tone(getBuzzerPin(), 1500, 200);  // 1.5kHz for 200ms
-        delay(250);
-        tone(getBuzzerPin(), 2000, 300);  // 2kHz for 300ms
-        delay(350);
-        
-        // Play descending tones
-        tone(getBuzzerPin(), 1500, 200);  // 1.5kHz for 200ms
-        delay(250);
-        tone(getBuzzerPin(), 1000, 300);  // 1kHz for 300ms
-        delay(350);
+        buzzerNotes = LOUD_TEST;
+        buzzerNoteCount = sizeof(LOUD_TEST) / sizeof(LOUD_TEST[0]);
     } else {
-        // Quiet mode for development - cricket-like click
         LOG_INFO(EventSource::SYSTEM, "Playing quiet buzzer test");
-        tone(getBuzzerPin(), 4000, 5);  // 4kHz for 5ms - very quick click
-        delay(10);
+        buzzerNotes = QUIET_TEST;
+        buzzerNoteCount = sizeof(QUIET_TEST) / sizeof(QUIET_TEST[0]);
     }
-    
-    // Make sure buzzer is off
-    noTone(getBuzzerPin());
+
+    buzzerNoteIndex = 0;
+    buzzerNoteTime = millis();
+    tone(getBuzzerPin(), buzzerNotes[0].frequency, buzzerNotes[0].durationMs);
+}
+
+bool HardwareManager::updateBuzzerTest()
+{
+    if (!buzzerNotes) {
+        return true;
+    }
+    if (millis() - buzzerNoteTime < buzzerNotes[buzzerNoteIndex].stepMs) {
+        return false;
+    }
+
+    if (++buzzerNoteIndex >= buzzerNoteCount) {
+        // Make sure buzzer is off
+        noTone(getBuzzerPin());
+        buzzerNotes = nullptr;
+        return true;
+    }
+
+    buzzerNoteTime = millis();
+    tone(getBuzzerPin(), buzzerNotes[buzzerNoteIndex].frequency, buzzerNotes[buzzerNoteIndex].durationMs);
+    return false;
 }
 
 void HardwareManager::enableSteerMotor()
@@ -411,6 +433,39 @@ bool HardwareManager::requestPWMResolution(uint8_t resolution, const char* owner
     return true;
 }
 
+bool HardwareManager::releasePWMFrequency(uint8_t pin, const char* owner)
+{
+    PWMTimerGroup group = getPWMTimerGroup(pin);
+    auto it = pwmConfigs.find(group);
+    if (it == pwmConfigs.end()) {
+        // Pins sharing a timer group release it once
+        return true;
+    }
+
+    if (strcmp(it->second.owner, owner) != 0) {
+        LOG_ERROR(EventSource::SYSTEM, "PWM timer group %d owned by %s, cannot be released by %s",
+                 group, it->second.owner, owner);
+        return false;
+    }
+
+    // The timer keeps running at its frequency until the next owner sets one
+    pwmConfigs.erase(it);
+    LOG_DEBUG(EventSource::SYSTEM, "PWM timer group %d released by %s", group, owner);
+    return true;
+}
+
+bool HardwareManager::releasePWMResolution(const char* owner)
+{
+    if (strcmp(pwmResolutionOwner, owner) != 0) {
+        return false;
+    }
+
+    // Resolution stays as is for other users; the next request may change it
+    pwmResolutionOwner = "default";
+    LOG_DEBUG(EventSource::SYSTEM, "PWM resolution released by %s", owner);
+    return true;
+}
+
 uint32_t HardwareManager::getPWMFrequency(PWMTimerGroup group)
 {
     auto it = pwmConfigs.find(group);
@@ -127,6 +127,17 @@ private:
     uint8_t globalPWMResolution;
     const char* pwmResolutionOwner;
 
+    // Buzzer test sequence (played by updateBuzzerTest)
+    struct BuzzerNote {
+        uint16_t frequency;
+        uint16_t durationMs;
+        uint16_t stepMs;        // Until the next note starts
+    };
+    const BuzzerNote* buzzerNotes = nullptr;
+    uint8_t buzzerNoteCount = 0;
+    uint8_t buzzerNoteIndex = 0;
+    uint32_t buzzerNoteTime = 0;
+
 public:
     HardwareManager();
     ~HardwareManager();
@@ -161,7 +172,9 @@ public:
     // Hardware control methods
     void enableBuzzer();
     void disableBuzzer();
-    void performBuzzerTest();  // Play a test tone with current volume setting
+    void performBuzzerTest();  // Play a test tone with current volume setting (blocking)
+    void startBuzzerTest();    // Same, without blocking: call updateBuzzerTest() until it returns true
+    bool updateBuzzerTest();
     void enableSteerMotor();
     void disableSteerMotor();
 
@@ -184,6 +197,8 @@ public:
     // PWM resource management
     bool requestPWMFrequency(uint8_t pin, uint32_t frequency, const char* owner);
     bool requestPWMResolution(uint8_t resolution, const char* owner);
+    bool releasePWMFrequency(uint8_t pin, const char* owner);
+    bool releasePWMResolution(const char* owner);
     uint32_t getPWMFrequency(PWMTimerGroup group);
     uint8_t getPWMResolution() const;
     PWMTimerGroup getPWMTimerGroup(uint8_t pin);
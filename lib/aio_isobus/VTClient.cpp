@@ -0,0 +1,478 @@
+// VTClient.cpp - VT connection state machine, pool streaming and live values
+#include "VTClient.h"
+#include "VTObjectPool.h"
+#include "ADProcessor.h"
+#include "GNSSProcessor.h"
+#include "MachineProcessor.h"
+#include "EventLogger.h"
+
+VTClient* VTClient::instance = nullptr;
+
+// VT function codes (ISO 11783-6 Annex F)
+static constexpr uint8_t VT_OBJECT_POOL_TRANSFER = 0x11;
+static constexpr uint8_t VT_END_OF_POOL = 0x12;
+static constexpr uint8_t VT_CHANGE_NUMERIC_VALUE = 0xA8;
+static constexpr uint8_t VT_CHANGE_ATTRIBUTE = 0xAF;
+static constexpr uint8_t VT_GET_MEMORY = 0xC0;
+static constexpr uint8_t VT_STORE_VERSION = 0xD0;
+static constexpr uint8_t VT_LOAD_VERSION = 0xD1;
+static constexpr uint8_t VT_GET_VERSIONS = 0xDF;
+static constexpr uint8_t VT_GET_VERSIONS_RESPONSE = 0xE0;
+static constexpr uint8_t VT_STATUS = 0xFE;
+static constexpr uint8_t VT_WORKING_SET_MAINTENANCE = 0xFF;
+
+static constexpr uint8_t FILL_COLOUR_ATTRIBUTE = 2;
+
+VTClient::VTClient()
+    : j1939(nullptr), state(State::DISABLED), stateTime(0),
+      vtAddress(J1939Stack::NULL_ADDRESS), vtVersion(0), lastVTStatus(0), lastMaintenance(0),
+      maintenanceStarted(false), liveCount(0), nextLive(0), pendingLive(-1), pendingTime(0),
+      uploadStart(0)
+{
+    instance = this;
+    memset(&stats, 0, sizeof(stats));
+    memset(liveValues, 0, sizeof(liveValues));
+    resetReader();
+
+    // Version label from the packed pool, so any pool change forces an upload
+    uint32_t hash = 2166136261UL;
+    for (uint32_t i = 0; i < VT_POOL_PACKED_SIZE; i++) {
+        hash = (hash ^ VT_POOL_PACKED[i]) * 16777619UL;
+    }
+    snprintf(versionLabel, sizeof(versionLabel), "%07lX", (unsigned long)(hash & 0x0FFFFFFF));
+}
+
+void VTClient::init() {
+    if (instance == nullptr) {
+        new VTClient();
+    }
+
+    J1939Stack* stack = J1939Stack::getInstance();
+    if (!stack || !stack->isEnabled() || instance->j1939) {
+        return;
+    }
+    instance->j1939 = stack;
+    stack->onPGN(PGN_VT_TO_ECU, onVTMessage, instance);
+    instance->setState(State::WAIT_VT_STATUS);
+
+    LOG_INFO(EventSource::CAN, "VT client: pool %lu bytes (%lu in flash), version %s",
+             VT_POOL_SIZE, VT_POOL_PACKED_SIZE, instance->versionLabel);
+}
+
+void VTClient::setState(State newState) {
+    state = newState;
+    stateTime = millis();
+}
+
+void VTClient::restart(const char* reason) {
+    LOG_WARNING(EventSource::CAN, "VT client: %s, retrying", reason);
+    pendingLive = -1;
+    setState(State::WAIT_RETRY);
+}
+
+void VTClient::process() {
+    if (!j1939) {
+        return;
+    }
+
+    uint32_t now = millis();
+    bool vtPresent = (vtAddress != J1939Stack::NULL_ADDRESS) && (now - lastVTStatus < VT_STATUS_TIMEOUT_MS);
+
+    if (state != State::WAIT_VT_STATUS && state != State::WAIT_RETRY && !vtPresent) {
+        LOG_WARNING(EventSource::CAN, "VT client: VT 0x%02X lost", vtAddress);
+        vtAddress = J1939Stack::NULL_ADDRESS;
+        maintenanceStarted = false;
+        pendingLive = -1;
+        setState(State::WAIT_VT_STATUS);
+        return;
+    }
+
+    if (maintenanceStarted && now - lastMaintenance >= MAINTENANCE_INTERVAL_MS) {
+        sendMaintenance();
+    }
+
+    uint32_t elapsed = now - stateTime;
+    switch (state) {
+        case State::WAIT_VT_STATUS:
+        case State::DISABLED:
+            break;
+
+        case State::WAIT_RETRY:
+            if (elapsed >= RETRY_DELAY_MS) {
+                setState(State::WAIT_VT_STATUS);
+            }
+            break;
+
+        case State::WAIT_MEMORY:
+        case State::WAIT_VERSIONS:
+        case State::WAIT_LOAD_VERSION:
+        case State::WAIT_STORE_VERSION:
+            if (elapsed >= RESPONSE_TIMEOUT_MS) {
+                restart("no response from VT");
+            }
+            break;
+
+        case State::WAIT_END_OF_POOL:
+            if (elapsed >= END_OF_POOL_TIMEOUT_MS) {
+                restart("no end of object pool response");
+            }
+            break;
+
+        case State::UPLOADING:
+            break;      // Ends in onUploadDone()
+
+        case State::CONNECTED:
+            updateLiveData();
+            if (pendingLive >= 0 && now - pendingTime >= RESPONSE_TIMEOUT_MS) {
+                stats.commandTimeouts++;
+                pendingLive = -1;
+            }
+            sendNextLiveValue();
+            break;
+    }
+}
+
+// ===== Commands =====
+
+bool VTClient::sendCommand(const uint8_t* data) {
+    return j1939->send(PGN_ECU_TO_VT, vtAddress, data, 8, PRIORITY);
+}
+
+bool VTClient::sendCommand(uint8_t function) {
+    uint8_t d[8] = {function, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    return sendCommand(d);
+}
+
+void VTClient::sendMaintenance() {
+    // First message after connecting carries the initiating bit
+    uint8_t d[8] = {VT_WORKING_SET_MAINTENANCE, (uint8_t)(maintenanceStarted ? 0 : 1), VT_VERSION,
+                    0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    sendCommand(d);
+    maintenanceStarted = true;
+    lastMaintenance = millis();
+}
+
+void VTClient::startUpload() {
+    // Payload is the transfer function byte followed by the pool, decoded from flash per packet
+    resetReader();
+    if (!j1939->send(PGN_ECU_TO_VT, vtAddress, poolSource, VT_POOL_SIZE + 1, 7, onUploadDone, this)) {
+        restart("object pool transfer not started");
+        return;
+    }
+    uploadStart = millis();
+    setState(State::UPLOADING);
+    LOG_INFO(EventSource::CAN, "VT client: uploading pool %s to VT 0x%02X", versionLabel, vtAddress);
+}
+
+void VTClient::onUploadDone(uint32_t, uint8_t, bool ok, void* context) {
+    VTClient* self = static_cast<VTClient*>(context);
+    if (self->state != State::UPLOADING) {
+        return;
+    }
+    if (!ok) {
+        self->restart("object pool transfer aborted");
+        return;
+    }
+    self->stats.uploadMs = millis() - self->uploadStart;
+    self->sendCommand(VT_END_OF_POOL);
+    self->setState(State::WAIT_END_OF_POOL);
+}
+
+// ===== VT messages =====
+
+void VTClient::onVTMessage(const J1939Message& msg, void* context) {
+    static_cast<VTClient*>(context)->handleVTMessage(msg);
+}
+
+void VTClient::handleVTMessage(const J1939Message& msg) {
+    if (msg.length < 8) {
+        return;
+    }
+    const uint8_t* d = msg.data;
+
+    if (d[0] == VT_STATUS) {
+        if (vtAddress == J1939Stack::NULL_ADDRESS && state == State::WAIT_VT_STATUS &&
+            j1939->isAddressClaimed()) {
+            vtAddress = msg.source;
+            LOG_INFO(EventSource::CAN, "VT client: VT found at 0x%02X", vtAddress);
+        }
+        if (msg.source != vtAddress) {
+            return;
+        }
+        lastVTStatus = millis();
+
+        if (state == State::WAIT_VT_STATUS) {
+            // Announce a one-member working set, start maintenance and ask for memory
+            uint8_t master[8] = {1, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+            j1939->send(PGN_WORKING_SET_MASTER, J1939Stack::GLOBAL_ADDRESS, master, 8, 7);
+            sendMaintenance();
+
+            uint8_t mem[8] = {VT_GET_MEMORY, 0xFF,
+                              (uint8_t)(VT_POOL_SIZE & 0xFF), (uint8_t)((VT_POOL_SIZE >> 8) & 0xFF),
+                              (uint8_t)((VT_POOL_SIZE >> 16) & 0xFF), (uint8_t)((VT_POOL_SIZE >> 24) & 0xFF),
+                              0xFF, 0xFF};
+            sendCommand(mem);
+            setState(State::WAIT_MEMORY);
+        }
+        return;
+    }
+
+    if (msg.source != vtAddress || msg.destination != j1939->getAddress()) {
+        return;
+    }
+
+    switch (d[0]) {
+        case VT_GET_MEMORY:
+            if (state != State::WAIT_MEMORY) {
+                break;
+            }
+            vtVersion = d[1];
+            if (d[2] != 0) {
+                restart("not enough VT memory");
+                break;
+            }
+            sendCommand(VT_GET_VERSIONS);
+            setState(State::WAIT_VERSIONS);
+            break;
+
+        case VT_GET_VERSIONS_RESPONSE: {
+            if (state != State::WAIT_VERSIONS) {
+                break;
+            }
+            uint8_t count = d[1];
+            for (uint8_t i = 0; i < count && 2u + (i + 1) * VERSION_LABEL_LENGTH <= msg.length; i++) {
+                if (memcmp(&d[2 + i * VERSION_LABEL_LENGTH], versionLabel, VERSION_LABEL_LENGTH) == 0) {
+                    uint8_t load[8] = {VT_LOAD_VERSION};
+                    memcpy(&load[1], versionLabel, VERSION_LABEL_LENGTH);
+                    sendCommand(load);
+                    setState(State::WAIT_LOAD_VERSION);
+                    return;
+                }
+            }
+            startUpload();
+            break;
+        }
+
+        case VT_LOAD_VERSION:
+            if (state != State::WAIT_LOAD_VERSION) {
+                break;
+            }
+            if (d[5] != 0) {
+                startUpload();      // Stored copy missing or unreadable
+                break;
+            }
+            stats.versionLoads++;
+            LOG_INFO(EventSource::CAN, "VT client: pool %s loaded from VT storage", versionLabel);
+            for (uint8_t i = 0; i < liveCount; i++) {
+                liveValues[i].dirty = true;
+            }
+            setState(State::CONNECTED);
+            break;
+
+        case VT_END_OF_POOL:
+            if (state != State::WAIT_END_OF_POOL) {
+                break;
+            }
+            if (d[1] != 0) {
+                LOG_ERROR(EventSource::CAN, "VT client: pool rejected (error 0x%02X, object %u)",
+                          d[1], d[4] | (d[5] << 8));
+                restart("object pool rejected");
+                break;
+            }
+            stats.uploads++;
+            {
+                uint8_t store[8] = {VT_STORE_VERSION};
+                memcpy(&store[1], versionLabel, VERSION_LABEL_LENGTH);
+                sendCommand(store);
+            }
+            setState(State::WAIT_STORE_VERSION);
+            break;
+
+        case VT_STORE_VERSION:
+            if (state != State::WAIT_STORE_VERSION) {
+                break;
+            }
+            if (d[5] != 0) {
+                LOG_WARNING(EventSource::CAN, "VT client: store version failed (0x%02X)", d[5]);
+            }
+            LOG_INFO(EventSource::CAN, "VT client: connected, pool uploaded in %lu ms", stats.uploadMs);
+            for (uint8_t i = 0; i < liveCount; i++) {
+                liveValues[i].dirty = true;
+            }
+            setState(State::CONNECTED);
+            break;
+
+        case VT_CHANGE_NUMERIC_VALUE:
+        case VT_CHANGE_ATTRIBUTE: {
+            // Error code is byte 3 for numeric value, byte 4 for attribute
+            uint8_t error = (d[0] == VT_CHANGE_NUMERIC_VALUE) ? d[3] : d[4];
+            if (error != 0) {
+                stats.commandErrors++;
+            }
+            pendingLive = -1;
+            sendNextLiveValue();
+            break;
+        }
+    }
+}
+
+// ===== Live values =====
+
+void VTClient::setNumericValue(uint16_t objectId, uint32_t value) {
+    queueValue(objectId, 0, value);
+}
+
+void VTClient::setAttribute(uint16_t objectId, uint8_t attributeId, uint32_t value) {
+    queueValue(objectId, attributeId, value);
+}
+
+void VTClient::queueValue(uint16_t objectId, uint8_t attributeId, uint32_t value) {
+    for (uint8_t i = 0; i < liveCount; i++) {
+        LiveValue& v = liveValues[i];
+        if (v.objectId == objectId && v.attributeId == attributeId) {
+            if (v.value != value) {
+                v.value = value;
+                v.dirty = true;
+            }
+            return;
+        }
+    }
+    if (liveCount < MAX_LIVE_VALUES) {
+        liveValues[liveCount++] = {objectId, attributeId, true, value};
+    }
+}
+
+void VTClient::sendNextLiveValue() {
+    // One command in flight at a time, oldest change first
+    if (state != State::CONNECTED || pendingLive >= 0) {
+        return;
+    }
+
+    for (uint8_t n = 0; n < liveCount; n++) {
+        uint8_t i = (nextLive + n) % liveCount;
+        LiveValue& v = liveValues[i];
+        if (!v.dirty) {
+            continue;
+        }
+
+        uint8_t d[8];
+        d[0] = v.attributeId ? VT_CHANGE_ATTRIBUTE : VT_CHANGE_NUMERIC_VALUE;
+        d[1] = v.objectId & 0xFF;
+        d[2] = v.objectId >> 8;
+        d[3] = v.attributeId ? v.attributeId : 0xFF;
+        d[4] = v.value & 0xFF;
+        d[5] = (v.value >> 8) & 0xFF;
+        d[6] = (v.value >> 16) & 0xFF;
+        d[7] = (v.value >> 24) & 0xFF;
+        if (!sendCommand(d)) {
+            return;
+        }
+
+        v.dirty = false;
+        pendingLive = i;
+        pendingTime = millis();
+        nextLive = i + 1;
+        stats.commandsSent++;
+        return;
+    }
+}
+
+void VTClient::updateLiveData() {
+    ADProcessor* ad = ADProcessor::getInstance();
+    if (ad) {
+        int32_t value = (int32_t)lroundf(ad->getWASAngle() * 10.0f) + VT_STEER_ANGLE_OFFSET;
+        setNumericValue(VT_OBJ_STEER_ANGLE, value < 0 ? 0 : value);
+    }
+
+    setNumericValue(VT_OBJ_FIX_QUALITY, gnssProcessor.getData().fixQuality);
+
+    MachineProcessor* machine = MachineProcessor::getInstance();
+    if (machine) {
+        uint16_t sections = machine->getSectionStates();
+        for (uint8_t n = 0; n < VT_SECTION_COUNT; n++) {
+            setAttribute(VT_OBJ_SECTION_FILL_FIRST + n, FILL_COLOUR_ATTRIBUTE,
+                         (sections & (1 << n)) ? VT_COLOUR_SECTION_ON : VT_COLOUR_SECTION_OFF);
+        }
+    }
+}
+
+// ===== Pool streaming =====
+
+void VTClient::poolSource(uint32_t offset, uint8_t* out, uint8_t length, void* context) {
+    static_cast<VTClient*>(context)->readPool(offset, out, length);
+}
+
+void VTClient::resetReader() {
+    memset(&reader, 0, sizeof(reader));
+}
+
+void VTClient::readPool(uint32_t offset, uint8_t* out, uint8_t length) {
+    // Payload byte 0 is the transfer function, the pool follows
+    if (offset == 0) {
+        *out++ = VT_OBJECT_POOL_TRANSFER;
+        length--;
+    } else {
+        offset--;
+    }
+
+    // Packets arrive in order; a retransmit request means decoding again from the start
+    if (offset < reader.outPos) {
+        resetReader();
+    }
+
+    while (length > 0) {
+        uint8_t b;
+        if (reader.repeat > 0) {
+            b = reader.repeatByte;
+            reader.repeat--;
+        } else if (reader.literal > 0) {
+            b = VT_POOL_PACKED[reader.inPos++];
+            reader.literal--;
+        } else if (reader.inPos < VT_POOL_PACKED_SIZE) {
+            uint8_t n = VT_POOL_PACKED[reader.inPos++];
+            if (n < 128) {
+                reader.literal = n + 1;
+            } else if (n > 128) {
+                reader.repeat = 257 - n;
+                reader.repeatByte = VT_POOL_PACKED[reader.inPos++];
+            }
+            continue;
+        } else {
+            b = 0xFF;   // Past the end - cannot happen with a consistent header
+        }
+
+        if (reader.outPos++ >= offset) {
+            *out++ = b;
+            length--;
+        }
+    }
+}
+
+// ===== Status =====
+
+const char* VTClient::stateToString(State s) {
+    switch (s) {
+        case State::DISABLED:           return "disabled";
+        case State::WAIT_VT_STATUS:     return "waiting for VT";
+        case State::WAIT_MEMORY:        return "get memory";
+        case State::WAIT_VERSIONS:      return "get versions";
+        case State::WAIT_LOAD_VERSION:  return "load version";
+        case State::UPLOADING:          return "uploading";
+        case State::WAIT_END_OF_POOL:   return "end of pool";
+        case State::WAIT_STORE_VERSION: return "store version";
+        case State::CONNECTED:          return "connected";
+        case State::WAIT_RETRY:         return "retry wait";
+        default:                        return "unknown";
+    }
+}
+
+void VTClient::printStatus() const {
+    Serial.print("\r\n=== VT Client ===");
+    Serial.printf("\r\nState %s, VT 0x%02X (version %d), pool %s (%lu bytes, %lu packed)",
+                  stateToString(state), vtAddress, vtVersion, versionLabel,
+                  VT_POOL_SIZE, VT_POOL_PACKED_SIZE);
+    Serial.printf("\r\nUploads %lu (last %lu ms), version loads %lu",
+                  stats.uploads, stats.uploadMs, stats.versionLoads);
+    Serial.printf("\r\nCommands %lu, errors %lu, timeouts %lu, live values %d\r\n",
+                  stats.commandsSent, stats.commandErrors, stats.commandTimeouts, liveCount);
+}
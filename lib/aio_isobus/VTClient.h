@@ -0,0 +1,127 @@
+// VTClient.h - ISOBUS Virtual Terminal working set on top of J1939Stack
+// Connects to the VT, loads the stored object pool by version label or
+// uploads it from flash, then keeps a few live values on the VT current
+// (steer angle, fix quality, section states).
+#ifndef VT_CLIENT_H
+#define VT_CLIENT_H
+
+#include <Arduino.h>
+#include "J1939Stack.h"
+
+class VTClient {
+public:
+    enum class State : uint8_t {
+        DISABLED,               // No J1939 stack on an ISO_Bus
+        WAIT_VT_STATUS,         // Listening for a VT
+        WAIT_MEMORY,            // Get Memory sent
+        WAIT_VERSIONS,          // Get Versions sent
+        WAIT_LOAD_VERSION,      // Load Version sent
+        UPLOADING,              // Object pool transfer running
+        WAIT_END_OF_POOL,
+        WAIT_STORE_VERSION,
+        CONNECTED,
+        WAIT_RETRY              // Something failed, back off before starting over
+    };
+
+    struct Stats {
+        uint32_t uploads;
+        uint32_t versionLoads;      // Connections that skipped the upload
+        uint32_t commandsSent;
+        uint32_t commandErrors;     // Responses with error codes set
+        uint32_t commandTimeouts;
+        uint32_t uploadMs;          // Duration of the last upload
+    };
+
+    static constexpr uint32_t PGN_VT_TO_ECU = 0xE600;
+    static constexpr uint32_t PGN_ECU_TO_VT = 0xE700;
+    static constexpr uint32_t PGN_WORKING_SET_MASTER = 0xFE0D;
+
+    static constexpr uint8_t VT_VERSION = 3;                // Objects used by the pool
+    static constexpr uint8_t PRIORITY = 5;
+    static constexpr uint8_t VERSION_LABEL_LENGTH = 7;
+    static constexpr uint8_t MAX_LIVE_VALUES = 20;
+
+    static constexpr uint32_t MAINTENANCE_INTERVAL_MS = 1000;
+    static constexpr uint32_t VT_STATUS_TIMEOUT_MS = 3000;
+    static constexpr uint32_t RESPONSE_TIMEOUT_MS = 2000;
+    static constexpr uint32_t END_OF_POOL_TIMEOUT_MS = 10000;  // VT parses the whole pool
+    static constexpr uint32_t RETRY_DELAY_MS = 5000;
+
+    static void init();
+    static VTClient* getInstance() { return instance; }
+
+    // Drive the connection and refresh live data (10Hz)
+    void process();
+
+    // Queue an update; sent once connected and only when the value changed
+    void setNumericValue(uint16_t objectId, uint32_t value);
+    void setAttribute(uint16_t objectId, uint8_t attributeId, uint32_t value);
+
+    State getState() const { return state; }
+    static const char* stateToString(State s);
+    bool isConnected() const { return state == State::CONNECTED; }
+    const char* getVersionLabel() const { return versionLabel; }
+    const Stats& getStats() const { return stats; }
+    void printStatus() const;
+
+private:
+    static VTClient* instance;
+
+    VTClient();
+
+    struct LiveValue {
+        uint16_t objectId;
+        uint8_t attributeId;        // 0 = numeric value
+        bool dirty;
+        uint32_t value;
+    };
+
+    // Streaming PackBits decoder over the pool in flash
+    struct PoolReader {
+        uint32_t inPos;
+        uint32_t outPos;
+        uint8_t literal;            // Literal bytes left in the current block
+        uint16_t repeat;            // Repeats left in the current run
+        uint8_t repeatByte;
+    };
+
+    J1939Stack* j1939;
+    State state;
+    uint32_t stateTime;
+    uint8_t vtAddress;
+    uint8_t vtVersion;
+    uint32_t lastVTStatus;
+    uint32_t lastMaintenance;
+    bool maintenanceStarted;
+    char versionLabel[VERSION_LABEL_LENGTH + 1];
+
+    LiveValue liveValues[MAX_LIVE_VALUES];
+    uint8_t liveCount;
+    uint8_t nextLive;               // Round-robin position
+    int8_t pendingLive;             // Entry waiting for its response, -1 if none
+    uint32_t pendingTime;
+
+    PoolReader reader;
+    uint32_t uploadStart;
+    Stats stats;
+
+    void setState(State newState);
+    void restart(const char* reason);
+    bool sendCommand(const uint8_t* data);
+    bool sendCommand(uint8_t function);
+    void sendMaintenance();
+    void startUpload();
+    void updateLiveData();
+    void queueValue(uint16_t objectId, uint8_t attributeId, uint32_t value);
+    void sendNextLiveValue();
+    void handleVTMessage(const J1939Message& msg);
+
+    void readPool(uint32_t offset, uint8_t* out, uint8_t length);
+    void resetReader();
+
+    static void onVTMessage(const J1939Message& msg, void* context);
+    static void onUploadDone(uint32_t pgn, uint8_t destination, bool ok, void* context);
+    static void poolSource(uint32_t offset, uint8_t* out, uint8_t length, void* context);
+};
+
+#endif // VT_CLIENT_H
@@ -0,0 +1,66 @@
+// VTObjectPool.h - Generated by tools/vt_pool.py, do not edit
+// ISOBUS VT object pool (version 3 objects, 200x200 data mask), PackBits-compressed
+#ifndef VT_OBJECT_POOL_H
+#define VT_OBJECT_POOL_H
+
+#include <Arduino.h>
+
+constexpr uint32_t VT_POOL_SIZE = 692;
+constexpr uint32_t VT_POOL_PACKED_SIZE = 686;
+
+static const uint8_t VT_POOL_PACKED[VT_POOL_PACKED_SIZE] PROGMEM = {
+    0xFD, 0x00, 0x07, 0x01, 0xE8, 0x03, 0x01, 0x00, 0x01, 0xD4, 0x07, 0xFD, 0x00, 0x0B, 0x65, 0x6E,
+    0xE8, 0x03, 0x01, 0x00, 0xFF, 0xFF, 0x16, 0x00, 0xD0, 0x07, 0xFD, 0x00, 0x7F, 0xD1, 0x07, 0x04,
+    0x00, 0x20, 0x00, 0xB8, 0x0B, 0x5A, 0x00, 0x18, 0x00, 0xD2, 0x07, 0x04, 0x00, 0x48, 0x00, 0xB9,
+    0x0B, 0x5A, 0x00, 0x40, 0x00, 0xD3, 0x07, 0x04, 0x00, 0x6C, 0x00, 0xA0, 0x0F, 0x04, 0x00, 0x80,
+    0x00, 0xA1, 0x0F, 0x10, 0x00, 0x80, 0x00, 0xA2, 0x0F, 0x1C, 0x00, 0x80, 0x00, 0xA3, 0x0F, 0x28,
+    0x00, 0x80, 0x00, 0xA4, 0x0F, 0x34, 0x00, 0x80, 0x00, 0xA5, 0x0F, 0x40, 0x00, 0x80, 0x00, 0xA6,
+    0x0F, 0x4C, 0x00, 0x80, 0x00, 0xA7, 0x0F, 0x58, 0x00, 0x80, 0x00, 0xA8, 0x0F, 0x64, 0x00, 0x80,
+    0x00, 0xA9, 0x0F, 0x70, 0x00, 0x80, 0x00, 0xAA, 0x0F, 0x7C, 0x00, 0x80, 0x00, 0xAB, 0x0F, 0x88,
+    0x00, 0x80, 0x00, 0xAC, 0x0F, 0x94, 0x00, 0x80, 0x00, 0xAD, 0x0F, 0xA0, 0x00, 0x80, 0x00, 0xAE,
+    0x0F, 0xAC, 0x00, 0x80, 0x00, 0xAF, 0x0F, 0xB8, 0x00, 0x80, 0x00, 0xD4, 0x07, 0x7F, 0x0B, 0x3C,
+    0x00, 0x18, 0x00, 0x00, 0x88, 0x13, 0x00, 0xFF, 0xFF, 0x00, 0x03, 0x00, 0x41, 0x69, 0x4F, 0x00,
+    0xD0, 0x07, 0x0B, 0xC8, 0x00, 0x10, 0x00, 0x00, 0x88, 0x13, 0x00, 0xFF, 0xFF, 0x00, 0x0C, 0x00,
+    0x41, 0x69, 0x4F, 0x20, 0x4E, 0x65, 0x77, 0x20, 0x44, 0x61, 0x77, 0x6E, 0x00, 0xD1, 0x07, 0x0B,
+    0x50, 0x00, 0x10, 0x00, 0x00, 0x88, 0x13, 0x00, 0xFF, 0xFF, 0x00, 0x05, 0x00, 0x53, 0x74, 0x65,
+    0x65, 0x72, 0x00, 0xD2, 0x07, 0x0B, 0x50, 0x00, 0x10, 0x00, 0x00, 0x88, 0x13, 0x00, 0xFF, 0xFF,
+    0x00, 0x03, 0x00, 0x46, 0x69, 0x78, 0x00, 0xD3, 0x07, 0x0B, 0xC0, 0x00, 0x10, 0x00, 0x00, 0x88,
+    0x13, 0x00, 0xFF, 0xFF, 0x00, 0x08, 0x00, 0x53, 0x65, 0x63, 0x74, 0x69, 0x6F, 0x6E, 0x73, 0x00,
+    0xB8, 0x0B, 0x0C, 0x6A, 0x00, 0x20, 0x00, 0x00, 0x89, 0x13, 0x00, 0xFF, 0xFF, 0xE8, 0x1B, 0x03,
+    0x00, 0x00, 0x18, 0xFC, 0xFF, 0xFF, 0xCD, 0xCC, 0xCC, 0x3D, 0x01, 0x00, 0x02, 0x00, 0xB9, 0x0B,
+    0x0C, 0x6A, 0x00, 0x20, 0x00, 0x00, 0x89, 0x13, 0x00, 0xFF, 0xFF, 0xF7, 0x00, 0x0A, 0x80, 0x3F,
+    0x00, 0x00, 0x02, 0x00, 0x88, 0x13, 0x17, 0x01, 0x02, 0xFE, 0x00, 0x04, 0x89, 0x13, 0x17, 0x0E,
+    0x05, 0xFE, 0x00, 0x7F, 0x70, 0x17, 0x18, 0x01, 0x01, 0xFF, 0xFF, 0x00, 0xA0, 0x0F, 0x0E, 0x70,
+    0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x04, 0x10, 0x00, 0x04, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF,
+    0x00, 0xA1, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x05, 0x10, 0x00, 0x05, 0x10,
+    0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xA2, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00,
+    0x06, 0x10, 0x00, 0x06, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xA3, 0x0F, 0x0E, 0x70, 0x17,
+    0x0A, 0x00, 0x28, 0x00, 0x00, 0x07, 0x10, 0x00, 0x07, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00,
+    0xA4, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x08, 0x10, 0x00, 0x08, 0x10, 0x19,
+    0x02, 0x08, 0xFF, 0xFF, 0x00, 0xA5, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x09,
+    0x10, 0x00, 0x09, 0x10, 0x7F, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xA6, 0x0F, 0x0E, 0x70, 0x17,
+    0x0A, 0x00, 0x28, 0x00, 0x00, 0x0A, 0x10, 0x00, 0x0A, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00,
+    0xA7, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x0B, 0x10, 0x00, 0x0B, 0x10, 0x19,
+    0x02, 0x08, 0xFF, 0xFF, 0x00, 0xA8, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x0C,
+    0x10, 0x00, 0x0C, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xA9, 0x0F, 0x0E, 0x70, 0x17, 0x0A,
+    0x00, 0x28, 0x00, 0x00, 0x0D, 0x10, 0x00, 0x0D, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xAA,
+    0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x0E, 0x10, 0x00, 0x0E, 0x10, 0x19, 0x02,
+    0x08, 0xFF, 0xFF, 0x00, 0xAB, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x0F, 0x10,
+    0x00, 0x0F, 0x10, 0x19, 0x02, 0x57, 0x08, 0xFF, 0xFF, 0x00, 0xAC, 0x0F, 0x0E, 0x70, 0x17, 0x0A,
+    0x00, 0x28, 0x00, 0x00, 0x10, 0x10, 0x00, 0x10, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xAD,
+    0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x11, 0x10, 0x00, 0x11, 0x10, 0x19, 0x02,
+    0x08, 0xFF, 0xFF, 0x00, 0xAE, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00, 0x28, 0x00, 0x00, 0x12, 0x10,
+    0x00, 0x12, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00, 0xAF, 0x0F, 0x0E, 0x70, 0x17, 0x0A, 0x00,
+    0x28, 0x00, 0x00, 0x13, 0x10, 0x00, 0x13, 0x10, 0x19, 0x02, 0x08, 0xFF, 0xFF, 0x00,
+};
+
+// Objects updated at runtime
+constexpr uint16_t VT_OBJ_STEER_ANGLE = 3000;       // Value = angle * 10 + VT_STEER_ANGLE_OFFSET
+constexpr uint16_t VT_OBJ_FIX_QUALITY = 3001;
+constexpr uint16_t VT_OBJ_SECTION_FILL_FIRST = 4100;
+constexpr uint8_t VT_SECTION_COUNT = 16;
+constexpr int32_t VT_STEER_ANGLE_OFFSET = 1000;
+constexpr uint8_t VT_COLOUR_SECTION_ON = 2;
+constexpr uint8_t VT_COLOUR_SECTION_OFF = 8;
+
+#endif // VT_OBJECT_POOL_H
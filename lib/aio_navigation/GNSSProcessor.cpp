@@ -1235,6 +1235,7 @@ bool GNSSProcessor::parseINSPVAXA()
 
 // External reference to NetworkBase send function
 extern void sendUDPbytes(uint8_t *message, int msgLen);
+extern void sendUDPbytesBroadcast(uint8_t *message, int msgLen);
 
 // Get ConfigManager instance
 extern ConfigManager configManager;
@@ -1257,7 +1258,7 @@ void GNSSProcessor::handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size_t
         calculateAndSetCRC(helloFromGPS, sizeof(helloFromGPS));
         
         // Send the reply
-        sendUDPbytes(helloFromGPS, sizeof(helloFromGPS));
+        sendUDPbytesBroadcast(helloFromGPS, sizeof(helloFromGPS));
     }
     // Check if this is a Scan Request PGN
     else if (pgn == 202)
@@ -1288,7 +1289,7 @@ void GNSSProcessor::handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size_t
         calculateAndSetCRC(subnetReply, sizeof(subnetReply));
         
         // Send the reply
-        sendUDPbytes(subnetReply, sizeof(subnetReply));
+        sendUDPbytesBroadcast(subnetReply, sizeof(subnetReply));
     }
 }
 
@@ -12,7 +12,7 @@ IMUProcessor *IMUProcessor::instance = nullptr;
 IMUProcessor::IMUProcessor()
     : serialMgr(nullptr), detectedType(IMUType::NONE), isInitialized(false),
       bnoParser(nullptr), imuSerial(&Serial4), tm171Parser(nullptr),
-      timeSinceLastPacket(0)
+      timeSinceLastPacket(0), detectProbe(this)
 {
     instance = this;
 
@@ -48,134 +48,87 @@ void IMUProcessor::init()
     }
 }
 
-bool IMUProcessor::initialize()
+void IMUProcessor::DetectProbe::begin()
 {
     LOG_INFO(EventSource::IMU, "IMU Processor Initialization starting");
 
-    // Get SerialManager instance
-    serialMgr = SerialManager::getInstance();
-    if (!serialMgr)
+    imu->serialMgr = SerialManager::getInstance();
+    if (!imu->serialMgr || !imu->imuSerial)
     {
-        LOG_ERROR(EventSource::IMU, "SerialManager not available");
-        return false;
+        LOG_ERROR(EventSource::IMU, "SerialManager or IMU serial port not available");
+        return;
     }
 
-    // Try to detect IMU type by attempting initialization
+    // Both IMUs stream on their own, so sniff for either with one parser each
     LOG_INFO(EventSource::IMU, "Detecting IMU type...");
-    
-    // Try BNO085 first
-    if (initBNO085()) {
-        detectedType = IMUType::BNO085;
-        isInitialized = true;
-        LOG_INFO(EventSource::IMU, "BNO085 detected");
-        return true;
-    }
-    
-    // Try TM171
-    if (initTM171()) {
-        detectedType = IMUType::TM171;
-        isInitialized = true;
-        LOG_INFO(EventSource::IMU, "TM171 detected");
-        return true;
+    imu->imuSerial->begin(115200);  // BNO085 RVC uses 115200 baud
+    imu->bnoParser = new BNOAiOParser();
+    imu->tm171Parser = new TM171AiOParser();
+
+    while (imu->imuSerial->available())
+    {
+        imu->imuSerial->read();
     }
-    
-    // No IMU detected
-    detectedType = IMUType::NONE;
-    isInitialized = false;
-    LOG_WARNING(EventSource::IMU, "No IMU detected");
-    return false;
 }
 
-bool IMUProcessor::initBNO085()
+bool IMUProcessor::DetectProbe::poll()
 {
-    LOG_DEBUG(EventSource::IMU, "Initializing BNO085 RVC mode");
-
-    // Initialize serial port for BNO085 RVC mode
-    imuSerial->begin(115200);  // BNO085 RVC uses 115200 baud
-    
-    // Create parser
-    bnoParser = new BNOAiOParser();
-    
-    // Clear any existing data in serial buffer
-    while (imuSerial->available())
+    if (!imu->bnoParser || !imu->tm171Parser)
     {
-        imuSerial->read();
+        return true;    // Nothing to listen on
     }
-    
-    // Wait for valid data to confirm BNO is present
-    uint32_t startTime = millis();
-    
-    while (millis() - startTime < 100)  // Wait up to 100ms
+
+    while (imu->imuSerial->available())
     {
-        while (imuSerial->available())
+        uint8_t byte = imu->imuSerial->read();
+        imu->bnoParser->processByte(byte);
+        imu->tm171Parser->processByte(byte);
+
+        if (imu->bnoParser->isDataValid())
         {
-            uint8_t byte = imuSerial->read();
-            bnoParser->processByte(byte);
-            
-            if (bnoParser->isDataValid())
-            {
-                LOG_INFO(EventSource::IMU, "BNO085 communication established");
-                LOG_DEBUG(EventSource::IMU, "Initial data: Yaw=%.1f, Pitch=%.1f, Roll=%.1f",
-                          bnoParser->getYaw(), bnoParser->getPitch(), bnoParser->getRoll());
-                return true;
-            }
+            delete imu->tm171Parser;
+            imu->tm171Parser = nullptr;
+            imu->detectedType = IMUType::BNO085;
+            LOG_DEBUG(EventSource::IMU, "Initial data: Yaw=%.1f, Pitch=%.1f, Roll=%.1f",
+                      imu->bnoParser->getYaw(), imu->bnoParser->getPitch(), imu->bnoParser->getRoll());
+            return true;
+        }
+        if (imu->tm171Parser->isDataValid())
+        {
+            delete imu->bnoParser;
+            imu->bnoParser = nullptr;
+            imu->detectedType = IMUType::TM171;
+            LOG_DEBUG(EventSource::IMU, "Initial data: Yaw=%.1f, Pitch=%.1f, Roll=%.1f",
+                      imu->tm171Parser->getYaw(), imu->tm171Parser->getPitch(), imu->tm171Parser->getRoll());
+            return true;
         }
-        delay(5);
     }
-
-    // No valid data received
-    delete bnoParser;
-    bnoParser = nullptr;
     return false;
 }
 
-bool IMUProcessor::initTM171()
+void IMUProcessor::DetectProbe::finish(bool timedOut)
 {
-    LOG_DEBUG(EventSource::IMU, "Initializing TM171");
-
-    // Create TM171 parser
-    tm171Parser = new TM171AiOParser();
-    LOG_DEBUG(EventSource::IMU, "TM171 AiO parser created");
-
-    // Make sure serial port is properly initialized
-    if (!imuSerial)
+    (void)timedOut;
+    if (imu->detectedType == IMUType::BNO085)
     {
-        LOG_ERROR(EventSource::IMU, "IMU serial port is NULL!");
-        delete tm171Parser;
-        tm171Parser = nullptr;
-        return false;
+        imu->isInitialized = true;
+        LOG_INFO(EventSource::IMU, "BNO085 detected");
+        return;
     }
-
-    // Clear serial buffer
-    while (imuSerial->available())
+    if (imu->detectedType == IMUType::TM171)
     {
-        imuSerial->read();
+        imu->isInitialized = true;
+        LOG_INFO(EventSource::IMU, "TM171 detected");
+        return;
     }
 
-    // Wait for valid TM171 data
-    LOG_DEBUG(EventSource::IMU, "Waiting for TM171 data...");
-    uint32_t startTime = millis();
-    
-    while (millis() - startTime < 500) {  // Wait up to 500ms
-        while (imuSerial->available()) {
-            uint8_t byte = imuSerial->read();
-            tm171Parser->processByte(byte);
-            
-            if (tm171Parser->isDataValid()) {
-                LOG_INFO(EventSource::IMU, "TM171 valid data detected!");
-                LOG_DEBUG(EventSource::IMU, "Initial data: Yaw=%.1f, Pitch=%.1f, Roll=%.1f",
-                          tm171Parser->getYaw(), tm171Parser->getPitch(), tm171Parser->getRoll());
-                return true;
-            }
-        }
-        delay(10);
-    }
-    
-    // No valid TM171 data received
-    LOG_DEBUG(EventSource::IMU, "No valid TM171 data received");
-    delete tm171Parser;
-    tm171Parser = nullptr;
-    return false;
+    // No valid data from either IMU
+    delete imu->bnoParser;
+    imu->bnoParser = nullptr;
+    delete imu->tm171Parser;
+    imu->tm171Parser = nullptr;
+    imu->isInitialized = false;
+    LOG_WARNING(EventSource::IMU, "No IMU detected");
 }
 
 void IMUProcessor::process()
@@ -365,6 +318,7 @@ void IMUProcessor::printCurrentData()
 
 // External reference to NetworkBase send function
 extern void sendUDPbytes(uint8_t *message, int msgLen);
+extern void sendUDPbytesBroadcast(uint8_t *message, int msgLen);
 
 // Get ConfigManager instance
 extern ConfigManager configManager;
@@ -405,7 +359,7 @@ void IMUProcessor::handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size_t l
         uint8_t helloFromIMU[] = {128, 129, 121, 121, 5, 0, 0, 0, 0, 0, 71};
         
         // Send the reply
-        sendUDPbytes(helloFromIMU, sizeof(helloFromIMU));
+        sendUDPbytesBroadcast(helloFromIMU, sizeof(helloFromIMU));
     }
     // Check if this is a Scan Request PGN
     else if (pgn == 202)
@@ -436,7 +390,7 @@ void IMUProcessor::handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size_t l
         calculateAndSetCRC(subnetReply, sizeof(subnetReply));
         
         // Send the reply
-        sendUDPbytes(subnetReply, sizeof(subnetReply));
+        sendUDPbytesBroadcast(subnetReply, sizeof(subnetReply));
         LOG_DEBUG(EventSource::IMU, "Scan reply sent: %d.%d.%d.%d / Subnet: %d.%d.%d", 
                   ip[0], ip[1], ip[2], ip[3],
                   ip[0], ip[1], ip[2]);
@@ -8,6 +8,7 @@
 #include "elapsedMillis.h"
 #include "PGNProcessor.h"
 #include "NavigationTypes.h"
+#include "DeviceDetector.h"
 
 // PGN Constants for IMU module
 constexpr uint8_t IMU_SOURCE_ID = 0x79;     // 121 decimal - IMU source address
@@ -52,9 +53,23 @@ private:
     uint32_t lastSerialDataTime = 0;
     bool serialDataReceived = false;
 
+    // Boot probe: feeds the IMU port to both parsers until one sees valid data
+    class DetectProbe : public DeviceProbe
+    {
+    public:
+        explicit DetectProbe(IMUProcessor *owner) : imu(owner) {}
+        const char *getName() const override { return "IMU"; }
+        uint32_t getTimeoutMs() const override { return DETECT_TIMEOUT_MS; }
+        void begin() override;
+        bool poll() override;
+        void finish(bool timedOut) override;
+
+    private:
+        IMUProcessor *imu;
+    };
+    DetectProbe detectProbe;
+
     // Private methods
-    bool initBNO085();
-    bool initTM171();
     void processBNO085Data();
     void processTM171Data();
 
@@ -66,8 +81,10 @@ public:
     static IMUProcessor *getInstance();
     static void init();
 
+    static constexpr uint32_t DETECT_TIMEOUT_MS = 500;    // TM171 is the slower to show valid data
+
     // Main interface
-    bool initialize();
+    DeviceProbe *getDeviceProbe() { return &detectProbe; }  // Non-blocking, for DeviceDetector
     void process();
     bool isActive() const { return isInitialized && timeSinceLastPacket < 100; }
     bool isIMUInitialized() const { return isInitialized; }
@@ -0,0 +1,93 @@
+// BootSequence.cpp - Staged boot and boot timeline
+#include "BootSequence.h"
+#include "EventLogger.h"
+
+BootSequence bootSequence;
+
+BootSequence::BootSequence()
+    : stageCount(0), openStage(-1), stepCount(0), nextStep(0), stepStage(-1),
+      controlReadyUs(0), completeUs(0) {
+}
+
+int8_t BootSequence::addStage(const char* name, bool background) {
+    if (stageCount >= MAX_STAGES) {
+        return -1;
+    }
+    stages[stageCount] = {name, micros(), 0, background};
+    return stageCount++;
+}
+
+void BootSequence::beginStage(const char* name) {
+    endStage();
+    openStage = addStage(name, false);
+}
+
+void BootSequence::endStage() {
+    if (openStage < 0) {
+        return;
+    }
+    Stage& s = stages[openStage];
+    s.durationUs = micros() - s.startUs;
+    LOG_DEBUG(EventSource::SYSTEM, "Boot stage %s: %lu us", s.name, s.durationUs);
+    openStage = -1;
+}
+
+void BootSequence::setControlReady() {
+    endStage();
+    controlReadyUs = micros();
+    LOG_INFO(EventSource::SYSTEM, "Control path ready %lu ms after reset", controlReadyUs / 1000);
+    if (stepCount == 0) {
+        completeUs = controlReadyUs;
+    }
+}
+
+bool BootSequence::addBackgroundStep(const char* name, BootStep step) {
+    if (step == nullptr || stepCount >= MAX_STEPS) {
+        return false;
+    }
+    steps[stepCount++] = {name, step};
+    completeUs = 0;
+    return true;
+}
+
+void BootSequence::process() {
+    if (!isControlReady() || nextStep >= stepCount) {
+        return;
+    }
+
+    if (stepStage < 0) {
+        stepStage = addStage(steps[nextStep].name, true);
+    }
+
+    if (!steps[nextStep].step()) {
+        return;
+    }
+
+    if (stepStage >= 0) {
+        Stage& s = stages[stepStage];
+        s.durationUs = micros() - s.startUs;
+    }
+    stepStage = -1;
+    nextStep++;
+
+    if (nextStep >= stepCount) {
+        completeUs = micros();
+        LOG_INFO(EventSource::SYSTEM, "Boot complete %lu ms after reset (control ready at %lu ms)",
+                 completeUs / 1000, controlReadyUs / 1000);
+    }
+}
+
+void BootSequence::printTimeline() const {
+    Serial.print("\r\n=== Boot Timeline ===");
+    for (uint8_t i = 0; i < stageCount; i++) {
+        const Stage& s = stages[i];
+        Serial.printf("\r\n%-16s %s start %8lu us  took %8lu us", s.name,
+                      s.background ? "bg" : "  ", s.startUs, s.durationUs);
+    }
+    Serial.printf("\r\nControl ready: %lu us", controlReadyUs);
+    if (isComplete()) {
+        Serial.printf("\r\nBoot complete: %lu us\r\n", completeUs);
+    } else {
+        Serial.print("\r\nBoot complete: pending\r\n");
+    }
+}
@@ -0,0 +1,72 @@
+// BootSequence.h - Staged boot with a boot-time profiler
+// setup() runs only what the control path needs (config, hardware, sensors,
+// control) and records how long each stage took. Slower work - web server,
+// buzzer, waiting for the Ethernet link - is queued as background steps the
+// scheduler advances one call at a time, so steering is up before the network.
+#ifndef BOOT_SEQUENCE_H
+#define BOOT_SEQUENCE_H
+
+#include <Arduino.h>
+
+class BootSequence {
+public:
+    // Background step: called repeatedly until it returns true
+    typedef bool (*BootStep)();
+
+    static constexpr uint8_t MAX_STAGES = 16;
+    static constexpr uint8_t MAX_STEPS = 8;
+
+    struct Stage {
+        const char* name;
+        uint32_t startUs;           // micros() since reset
+        uint32_t durationUs;
+        bool background;
+    };
+
+    BootSequence();
+
+    // Foreground stages, timed back to back
+    void beginStage(const char* name);
+    void endStage();
+
+    // Foreground done; the scheduler takes over from here
+    void setControlReady();
+
+    // Queue work to run after setup(), in the order added
+    bool addBackgroundStep(const char* name, BootStep step);
+
+    // Advance the current background step (scheduler task)
+    void process();
+
+    bool isControlReady() const { return controlReadyUs != 0; }
+    bool isComplete() const { return completeUs != 0; }
+    uint32_t getControlReadyUs() const { return controlReadyUs; }
+    uint32_t getCompleteUs() const { return completeUs; }
+    uint8_t getStageCount() const { return stageCount; }
+    const Stage& getStage(uint8_t index) const { return stages[index]; }
+    void printTimeline() const;
+
+private:
+    struct Step {
+        const char* name;
+        BootStep step;
+    };
+
+    Stage stages[MAX_STAGES];
+    uint8_t stageCount;
+    int8_t openStage;               // Foreground stage being timed, -1 if none
+
+    Step steps[MAX_STEPS];
+    uint8_t stepCount;
+    uint8_t nextStep;
+    int8_t stepStage;               // Stage entry of the running step, -1 if not started
+
+    uint32_t controlReadyUs;
+    uint32_t completeUs;
+
+    int8_t addStage(const char* name, bool background);
+};
+
+extern BootSequence bootSequence;
+
+#endif // BOOT_SEQUENCE_H
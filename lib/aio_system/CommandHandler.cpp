@@ -2,6 +2,15 @@
 #include "ConfigManager.h"
 #include "HardwareManager.h"
 #include "SimpleScheduler/SimpleScheduler.h"
+#include "RTCMProcessor.h"
+#include "TractorCANDriver.h"
+#include "CANManager.h"
+#include "J1939Stack.h"
+#include "VTClient.h"
+#include "BootSequence.h"
+#include "AutosteerProcessor.h"
+#include "WheelAngleFusion.h"
+#include "KickoutMonitor.h"
 
 // External function declarations
 extern void toggleLoopTiming();
@@ -162,6 +171,58 @@ void CommandHandler::handleCommand(char cmd) {
             }
             break;
 
+        case 'a':  // Show autosteer pipeline timing
+        case 'A':
+            AutosteerProcessor::getInstance()->printPipelineTiming();
+            AutosteerProcessor::getInstance()->resetPipelineTiming();
+            break;
+
+        case 'f':  // Show Virtual WAS (fusion) status
+        case 'F':
+            if (wheelAngleFusionPtr) {
+                wheelAngleFusionPtr->printStatus();
+            } else {
+                Serial.print("\r\nVirtual WAS not enabled\r\n");
+            }
+            break;
+
+        case 'k':  // Show kickout detection and latency
+        case 'K':
+            KickoutMonitor::getInstance()->printStatus();
+            KickoutMonitor::getInstance()->resetLatencyStats();
+            break;
+
+        case 'i':  // Show boot timeline
+        case 'I':
+            bootSequence.printTimeline();
+            break;
+
+        case 'g':  // Show RTCM correction status
+        case 'G':
+            if (RTCMProcessor::getInstance()) {
+                RTCMProcessor::getInstance()->printStatus();
+            }
+            break;
+
+        case 'n':  // Show CAN bus and tractor CAN receive status
+        case 'N':
+            {
+                if (CANManager::getInstance()) {
+                    CANManager::getInstance()->printDiagnostics();
+                }
+                extern MotorDriverInterface* motorPTR;
+                if (motorPTR && motorPTR->getType() == MotorDriverType::TRACTOR_CAN) {
+                    static_cast<TractorCANDriver*>(motorPTR)->printCANStatus();
+                }
+                if (J1939Stack::getInstance()->isEnabled()) {
+                    J1939Stack::getInstance()->printStatus();
+                }
+                if (VTClient::getInstance()->getState() != VTClient::State::DISABLED) {
+                    VTClient::getInstance()->printStatus();
+                }
+            }
+            break;
+
         case '?':
         case 'h':
         case 'H':
@@ -191,6 +252,12 @@ void CommandHandler::showMenu() {
     Serial.print("\r\nB - Test buzzer");
     Serial.print("\r\nV - Toggle buzzer volume (loud/quiet)");
     Serial.print("\r\nC - Show scheduler status");
+    Serial.print("\r\nI - Show boot timeline");
+    Serial.print("\r\nA - Show autosteer pipeline timing");
+    Serial.print("\r\nF - Show Virtual WAS (fusion) status");
+    Serial.print("\r\nK - Show kickout detection and latency");
+    Serial.print("\r\nG - Show RTCM correction status");
+    Serial.print("\r\nN - Show CAN bus diagnostics");
     Serial.print("\r\n? - Show this menu");
     Serial.print("\r\n=========================\r\n");
 }
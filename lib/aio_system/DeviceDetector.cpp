@@ -0,0 +1,65 @@
+// DeviceDetector.cpp - Concurrent boot-time device probing
+#include "DeviceDetector.h"
+#include "EventLogger.h"
+
+DeviceDetector::DeviceDetector() : count(0), pending(0), startTime(0), durationMs(0) {
+}
+
+bool DeviceDetector::add(DeviceProbe* probe) {
+    if (probe == nullptr || count >= MAX_PROBES) {
+        return false;
+    }
+    entries[count++] = {probe, false, 0};
+    return true;
+}
+
+void DeviceDetector::start() {
+    startTime = millis();
+    pending = count;
+    for (uint8_t i = 0; i < count; i++) {
+        entries[i].done = false;
+        entries[i].probe->begin();
+    }
+}
+
+bool DeviceDetector::process() {
+    if (pending == 0) {
+        return true;
+    }
+
+    uint32_t elapsed = millis() - startTime;
+    for (uint8_t i = 0; i < count; i++) {
+        Entry& e = entries[i];
+        if (e.done) {
+            continue;
+        }
+        if (e.probe->poll()) {
+            complete(e, false);
+        } else if (elapsed >= e.probe->getTimeoutMs()) {
+            complete(e, true);
+        }
+    }
+
+    if (pending == 0) {
+        durationMs = millis() - startTime;
+        LOG_INFO(EventSource::SYSTEM, "Device detection complete in %lu ms (%d probes)", durationMs, count);
+        return true;
+    }
+    return false;
+}
+
+void DeviceDetector::run() {
+    start();
+    while (!process()) {
+        yield();    // Let serial events fill the receive buffers
+    }
+}
+
+void DeviceDetector::complete(Entry& e, bool timedOut) {
+    e.done = true;
+    e.elapsedMs = millis() - startTime;
+    pending--;
+    e.probe->finish(timedOut);
+    LOG_DEBUG(EventSource::SYSTEM, "Probe %s %s after %lu ms", e.probe->getName(),
+              timedOut ? "timed out" : "finished", e.elapsedMs);
+}
@@ -0,0 +1,64 @@
+// DeviceDetector.h - Runs boot-time device probes side by side
+// Each probe is a small state machine: begin() sends its query or clears its
+// buffer, poll() advances it without blocking and returns true once it has an
+// answer. All probes are polled round-robin until they finish or time out, so
+// boot waits for the slowest probe instead of the sum of them.
+#ifndef DEVICE_DETECTOR_H
+#define DEVICE_DETECTOR_H
+
+#include <Arduino.h>
+
+class DeviceProbe {
+public:
+    virtual ~DeviceProbe() = default;
+
+    virtual const char* getName() const = 0;
+    virtual uint32_t getTimeoutMs() const = 0;
+
+    // Start the probe (send a query, reset parsers)
+    virtual void begin() {}
+
+    // Advance without blocking; true when the probe has its answer
+    virtual bool poll() = 0;
+
+    // Called once, after poll() returned true or the timeout expired
+    virtual void finish(bool timedOut) { (void)timedOut; }
+};
+
+class DeviceDetector {
+public:
+    static constexpr uint8_t MAX_PROBES = 8;
+
+    DeviceDetector();
+
+    bool add(DeviceProbe* probe);
+
+    // Begin all probes added so far
+    void start();
+
+    // One polling sweep; true when every probe has finished
+    bool process();
+
+    // start() and process() until done
+    void run();
+
+    bool isDone() const { return pending == 0; }
+    uint32_t getDurationMs() const { return durationMs; }
+
+private:
+    struct Entry {
+        DeviceProbe* probe;
+        bool done;
+        uint32_t elapsedMs;
+    };
+
+    Entry entries[MAX_PROBES];
+    uint8_t count;
+    uint8_t pending;
+    uint32_t startTime;
+    uint32_t durationMs;
+
+    void complete(Entry& e, bool timedOut);
+};
+
+#endif // DEVICE_DETECTOR_H
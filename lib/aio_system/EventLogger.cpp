@@ -3,6 +3,7 @@
 #include "EEPROMLayout.h"
 #include "EEPROM.h"
 #include "QNetworkBase.h"
+#include "QNEthernetUDPHandler.h"
 #include <QNEthernet.h>
 #include <QNEthernetUDP.h>
 #include <cstdio>
@@ -129,19 +130,22 @@ void EventLogger::outputUDP(EventSeverity severity, EventSource source, const ch
              eventCounter,
              message);
     
-    // Send via UDP broadcast to syslog port
+    // Send via UDP to syslog port - unicast to AgIO's host once discovered
     if (QNetworkBase::isConnected()) {
-        // Get current IP for broadcast address
-        IPAddress currentIP = QNetworkBase::getIP();
-        
-        // Create broadcast address (xxx.xxx.xxx.255)
-        IPAddress broadcastIP(currentIP[0], currentIP[1], currentIP[2], 255);
+        IPAddress destIP;
+        if (QNEthernetUDPHandler::isUnicastActive()) {
+            destIP = QNEthernetUDPHandler::getStreamDestination();
+        } else {
+            // Create broadcast address (xxx.xxx.xxx.255)
+            IPAddress currentIP = QNetworkBase::getIP();
+            destIP = IPAddress(currentIP[0], currentIP[1], currentIP[2], 255);
+        }
         
         // Get syslog port from config
         uint16_t port = (config.syslogPort[0] << 8) | config.syslogPort[1];
         
         // Send using QNEthernet UDP
-        udpSyslog.beginPacket(broadcastIP, port);
+        udpSyslog.beginPacket(destIP, port);
         udpSyslog.write((const uint8_t*)syslogMsg, strlen(syslogMsg));
         udpSyslog.endPacket();
     }
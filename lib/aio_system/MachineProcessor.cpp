@@ -12,6 +12,7 @@
 #include "ConfigManager.h"
 
 extern void sendUDPbytes(uint8_t *message, int msgLen);
+extern void sendUDPbytesBroadcast(uint8_t *message, int msgLen);
 
 // Network configuration now handled by ConfigManager
 
@@ -106,6 +107,7 @@ bool MachineProcessor::initialize() {
     }
     
     machineState.lastPGN239Time = 0;
+    machineState.outputStates = 0;
     
     // Initialize hardware
     if (!initializeSectionOutputs()) {
@@ -338,17 +340,21 @@ void MachineProcessor::handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size
 
     if (pgn == 200) {
         
+        // Report driven outputs as relayLo/relayHi like the stock machine module,
+        // so AgIO (and tools/agio_sim.py) can see when a PGN 239 took effect
         uint8_t helloReply[] = {
             0x80, 0x81,               // Header
             MACHINE_HELLO_REPLY,      // Source: Machine module (123)
             MACHINE_HELLO_REPLY,      // PGN: Machine reply (123)
             5,                        // Length
-            0, 0, 0, 0, 0,           // Data
+            instance->machineState.outputStates,  // relayLo
+            0,                        // relayHi - only 6 outputs
+            0, 0, 0,                  // Data
             0                         // CRC placeholder
         };
         
         calculateAndSetCRC(helloReply, sizeof(helloReply));
-        sendUDPbytes(helloReply, sizeof(helloReply));
+        sendUDPbytesBroadcast(helloReply, sizeof(helloReply));
         
     }
     else if (pgn == 202) {
@@ -372,7 +378,7 @@ void MachineProcessor::handleBroadcastPGN(uint8_t pgn, const uint8_t* data, size
         };
         
         calculateAndSetCRC(scanReply, sizeof(scanReply));
-        sendUDPbytes(scanReply, sizeof(scanReply));
+        sendUDPbytesBroadcast(scanReply, sizeof(scanReply));
         
     }
 }
@@ -702,6 +708,7 @@ void MachineProcessor::updateMachineOutputs() {
     uint8_t motorConfig = configManager.getMotorDriverConfig();
     // 0x01 = Danfoss + Wheel Encoder, 0x03 = Danfoss + Pressure Sensor
     bool isDanfossConfigured = (motorConfig == 0x01 || motorConfig == 0x03);
+    uint8_t drivenOutputs = 0;
     
     // Loop through our 6 physical outputs
     for (int outputNum = 1; outputNum <= 6; outputNum++) {
@@ -743,6 +750,11 @@ void MachineProcessor::updateMachineOutputs() {
         
         // Get the actual PCA9685 pin number for this output
         uint8_t pcaPin = SECTION_PINS[outputNum - 1];
+
+        // Track logical on/off independent of active high/low wiring
+        if (functionState) {
+            drivenOutputs |= (1 << (outputNum - 1));
+        }
         
         // Set the output (INVERTED to fix tester feedback)
         if (outputState) {
@@ -752,6 +764,8 @@ void MachineProcessor::updateMachineOutputs() {
         }
         
     }
+
+    machineState.outputStates = drivenOutputs;
 }
 
 
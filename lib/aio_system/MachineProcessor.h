@@ -44,6 +44,9 @@ private:
         // Hydraulic timing
         uint32_t hydStartTime;       // When hydraulic movement started
         uint8_t lastHydLift;         // Previous hydraulic state
+
+        // Outputs currently driven on (bit 0 = output 1), reported as relayLo in hello reply
+        uint8_t outputStates;
     } machineState;
     
     // Machine configuration from PGN 238 is stored directly in ConfigManager
@@ -92,6 +95,9 @@ public:
 
     // Section control sleep mode detection
     bool isOnboardSectionControlActive() const;  // Returns true if onboard SC should respond
+
+    // Section states from the last PGN 239 (bit n = section n+1)
+    uint16_t getSectionStates() const { return machineState.sectionStates; }
 };
 
 extern MachineProcessor machineProcessor;
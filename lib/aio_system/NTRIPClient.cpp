@@ -0,0 +1,545 @@
+// NTRIPClient.cpp
+// Non-blocking NTRIP v1/v2 client state machine
+
+#include "NTRIPClient.h"
+#include <QNDNSClient.h>
+#include "QNetworkBase.h"
+#include "RTCMProcessor.h"
+#include "GNSSProcessor.h"
+#include "EventLogger.h"
+#include "Version.h"
+#include "base64_simple.h"
+
+using namespace qindesign::network;
+
+// Static instance pointer
+NTRIPClient* NTRIPClient::instance = nullptr;
+
+NTRIPClient::NTRIPClient()
+    : state(State::DISABLED), stateTime(0),
+      backoffMs(BACKOFF_MIN_MS), retryDelayMs(0),
+      dnsDone(false), dnsOk(false), dnsGeneration(0),
+      lineLength(0), statusLineSeen(false), chunked(false),
+      chunkState(ChunkState::SIZE), chunkRemaining(0),
+      lastGGATime(0), rateWindowStart(0), rateWindowBytes(0)
+{
+    instance = this;
+    memset(&stats, 0, sizeof(stats));
+    lastError[0] = '\0';
+}
+
+NTRIPClient::~NTRIPClient()
+{
+    instance = nullptr;
+}
+
+void NTRIPClient::init()
+{
+    if (instance == nullptr)
+    {
+        new NTRIPClient();
+    }
+    instance->reconfigure(ConfigManager::getInstance()->getNTRIPConfig());
+}
+
+void NTRIPClient::reconfigure(const NTRIPConfig& newConfig)
+{
+    client.close();
+    config = newConfig;
+    backoffMs = BACKOFF_MIN_MS;
+    dnsGeneration++;  // Ignore any DNS answer still in flight
+    lastError[0] = '\0';
+
+    if (config.enabled && config.host[0] != '\0' && config.mountpoint[0] != '\0')
+    {
+        LOG_INFO(EventSource::NETWORK, "NTRIP: caster %s:%u mount %s (v%u, GGA %s)",
+                 config.host, config.port, config.mountpoint, config.version,
+                 config.ggaUpload ? "on" : "off");
+        retryDelayMs = 0;
+        setState(State::WAIT_RETRY);
+    }
+    else
+    {
+        if (config.enabled) {
+            LOG_WARNING(EventSource::NETWORK, "NTRIP: enabled but host or mountpoint missing");
+        }
+        setState(State::DISABLED);
+    }
+}
+
+void NTRIPClient::setState(State newState)
+{
+    state = newState;
+    stateTime = millis();
+}
+
+void NTRIPClient::scheduleRetry(const char* reason, uint32_t delayMs)
+{
+    if (state == State::STREAMING) {
+        stats.reconnects++;
+    }
+
+    client.close();
+
+    if (delayMs == 0) {
+        delayMs = backoffMs;
+        backoffMs *= 2;
+        if (backoffMs > BACKOFF_MAX_MS) {
+            backoffMs = BACKOFF_MAX_MS;
+        }
+    }
+    retryDelayMs = delayMs;
+
+    strncpy(lastError, reason, sizeof(lastError) - 1);
+    lastError[sizeof(lastError) - 1] = '\0';
+
+    LOG_WARNING(EventSource::NETWORK, "NTRIP: %s - retry in %lu s", reason, delayMs / 1000);
+    setState(State::WAIT_RETRY);
+}
+
+void NTRIPClient::startConnect()
+{
+    stats.connectAttempts++;
+
+    // Dotted-quad hosts skip DNS entirely
+    if (casterIP.fromString(config.host))
+    {
+        dnsOk = true;
+        dnsDone = true;
+        setState(State::RESOLVING);
+        return;
+    }
+
+    // Static IP setup does not configure a DNS server - fall back to ours
+    if (DNSClient::getServer(0) == INADDR_NONE)
+    {
+        uint8_t dns[4];
+        ConfigManager::getInstance()->getDNS(dns);
+        DNSClient::setServer(0, IPAddress(dns[0], dns[1], dns[2], dns[3]));
+    }
+
+    dnsDone = false;
+    dnsOk = false;
+    uint32_t generation = ++dnsGeneration;
+
+    bool started = DNSClient::getHostByName(config.host, [this, generation](const ip_addr_t* addr) {
+        if (generation != dnsGeneration) {
+            return;  // Stale lookup from a previous configuration
+        }
+        if (addr != nullptr) {
+            casterIP = IPAddress(ip_addr_get_ip4_u32(addr));
+            dnsOk = true;
+        }
+        dnsDone = true;
+    }, DNS_TIMEOUT_MS);
+
+    if (!started)
+    {
+        scheduleRetry("DNS lookup could not start");
+        return;
+    }
+
+    setState(State::RESOLVING);
+}
+
+bool NTRIPClient::sendRequest()
+{
+    // Basic auth credentials
+    char credentials[sizeof(config.username) + sizeof(config.password) + 1];
+    snprintf(credentials, sizeof(credentials), "%s:%s", config.username, config.password);
+    String auth = base64::encode((const uint8_t*)credentials, strlen(credentials));
+
+    char request[512];
+    int len;
+
+    if (config.version == 1)
+    {
+        len = snprintf(request, sizeof(request),
+                       "GET /%s HTTP/1.0\r\n"
+                       "User-Agent: NTRIP AiO-NewDawn/%s\r\n"
+                       "Accept: */*\r\n"
+                       "%s%s%s"
+                       "\r\n",
+                       config.mountpoint, FIRMWARE_VERSION,
+                       config.username[0] ? "Authorization: Basic " : "",
+                       config.username[0] ? auth.c_str() : "",
+                       config.username[0] ? "\r\n" : "");
+    }
+    else
+    {
+        // NTRIP v2 lets us hand the caster our position up front
+        char gga[100];
+        bool haveGGA = config.ggaUpload && buildGGA(gga, sizeof(gga));
+        if (haveGGA) {
+            gga[strcspn(gga, "\r\n")] = '\0';
+        }
+
+        len = snprintf(request, sizeof(request),
+                       "GET /%s HTTP/1.1\r\n"
+                       "Host: %s:%u\r\n"
+                       "Ntrip-Version: Ntrip/2.0\r\n"
+                       "User-Agent: NTRIP AiO-NewDawn/%s\r\n"
+                       "Connection: close\r\n"
+                       "%s%s%s"
+                       "%s%s%s"
+                       "\r\n",
+                       config.mountpoint, config.host, config.port, FIRMWARE_VERSION,
+                       config.username[0] ? "Authorization: Basic " : "",
+                       config.username[0] ? auth.c_str() : "",
+                       config.username[0] ? "\r\n" : "",
+                       haveGGA ? "Ntrip-GGA: " : "",
+                       haveGGA ? gga : "",
+                       haveGGA ? "\r\n" : "");
+    }
+
+    if (len <= 0 || len >= (int)sizeof(request)) {
+        return false;
+    }
+
+    // Request is far below the TCP send buffer, so this does not block
+    return client.write((const uint8_t*)request, len) == (size_t)len;
+}
+
+void NTRIPClient::process()
+{
+    if (state == State::DISABLED) {
+        return;
+    }
+
+    uint32_t now = millis();
+    uint32_t inState = now - stateTime;
+
+    switch (state)
+    {
+    case State::WAIT_RETRY:
+        if (QNetworkBase::isConnected() && inState >= retryDelayMs) {
+            startConnect();
+        }
+        break;
+
+    case State::RESOLVING:
+        if (dnsDone)
+        {
+            if (!dnsOk) {
+                scheduleRetry("DNS lookup failed");
+            } else if (!client.connectNoWait(casterIP, config.port)) {
+                scheduleRetry("TCP connect failed");
+            } else {
+                setState(State::CONNECTING);
+            }
+        }
+        else if (inState > DNS_TIMEOUT_MS)
+        {
+            dnsGeneration++;
+            scheduleRetry("DNS lookup timed out");
+        }
+        break;
+
+    case State::CONNECTING:
+        if (client.connected())
+        {
+            if (!sendRequest()) {
+                scheduleRetry("request send failed");
+                break;
+            }
+            lineLength = 0;
+            statusLineSeen = false;
+            chunked = false;
+            chunkState = ChunkState::SIZE;
+            chunkRemaining = 0;
+            setState(State::WAIT_RESPONSE);
+        }
+        else if (inState > CONNECT_TIMEOUT_MS)
+        {
+            scheduleRetry("TCP connect timed out");
+        }
+        break;
+
+    case State::WAIT_RESPONSE:
+        processResponse();
+        if (state == State::WAIT_RESPONSE && millis() - stateTime > RESPONSE_TIMEOUT_MS) {
+            scheduleRetry("no response from caster");
+        }
+        break;
+
+    case State::STREAMING:
+        processStream();
+        break;
+
+    default:
+        break;
+    }
+
+    // Byte rate
+    if (now - rateWindowStart >= RATE_WINDOW_MS)
+    {
+        stats.byteRate = rateWindowBytes * 1000.0f / (now - rateWindowStart);
+        rateWindowBytes = 0;
+        rateWindowStart = now;
+    }
+}
+
+void NTRIPClient::processResponse()
+{
+    while (client.available() > 0)
+    {
+        char c = client.read();
+
+        if (c == '\n')
+        {
+            lineBuffer[lineLength] = '\0';
+            if (lineLength > 0 && lineBuffer[lineLength - 1] == '\r') {
+                lineBuffer[--lineLength] = '\0';
+            }
+
+            bool keepReading = handleHeaderLine();
+            lineLength = 0;
+            if (!keepReading) {
+                break;
+            }
+        }
+        else if (lineLength < sizeof(lineBuffer) - 1)
+        {
+            lineBuffer[lineLength++] = c;
+        }
+    }
+
+    // Anything left after the headers is already RTCM
+    if (state == State::STREAMING) {
+        processStream();
+    }
+}
+
+bool NTRIPClient::handleHeaderLine()
+{
+    if (!statusLineSeen)
+    {
+        statusLineSeen = true;
+
+        if (strncmp(lineBuffer, "ICY 200", 7) == 0)
+        {
+            // NTRIP v1 - no headers follow, data starts immediately
+            setState(State::STREAMING);
+            stats.connectedSince = millis();
+            stats.bytesReceived = 0;
+            stats.lastDataTime = millis();
+            LOG_INFO(EventSource::NETWORK, "NTRIP: connected to %s (v1)", config.mountpoint);
+            return false;
+        }
+        if (strncmp(lineBuffer, "HTTP/1.", 7) == 0 && strncmp(lineBuffer + 8, " 200", 4) == 0)
+        {
+            return true;  // NTRIP v2 - read headers
+        }
+        if (strncmp(lineBuffer, "SOURCETABLE 200", 15) == 0)
+        {
+            scheduleRetry("mountpoint not found", BACKOFF_MAX_MS);
+            return false;
+        }
+        if (strstr(lineBuffer, " 401") != nullptr)
+        {
+            scheduleRetry("authorization failed", AUTH_FAIL_BACKOFF_MS);
+            return false;
+        }
+
+        LOG_WARNING(EventSource::NETWORK, "NTRIP: unexpected response '%s'", lineBuffer);
+        scheduleRetry("unexpected caster response");
+        return false;
+    }
+
+    // Blank line ends the header block
+    if (lineLength == 0)
+    {
+        setState(State::STREAMING);
+        stats.connectedSince = millis();
+        stats.bytesReceived = 0;
+        stats.lastDataTime = millis();
+        LOG_INFO(EventSource::NETWORK, "NTRIP: connected to %s (v2%s)",
+                 config.mountpoint, chunked ? ", chunked" : "");
+        return false;
+    }
+
+    if (strncasecmp(lineBuffer, "Transfer-Encoding:", 18) == 0 && strstr(lineBuffer + 18, "chunked") != nullptr)
+    {
+        chunked = true;
+    }
+    return true;
+}
+
+void NTRIPClient::processStream()
+{
+    uint8_t buffer[READ_CHUNK_SIZE];
+
+    // Bound the work per call so a backlog cannot stall the control loop
+    for (int i = 0; i < 4; i++)
+    {
+        int available = client.available();
+        if (available <= 0) {
+            break;
+        }
+
+        int count = client.read(buffer, min((size_t)available, sizeof(buffer)));
+        if (count <= 0) {
+            break;
+        }
+
+        size_t payload = chunked ? decodeChunked(buffer, count) : (size_t)count;
+        if (payload > 0) {
+            deliver(buffer, payload);
+        }
+    }
+
+    if (state != State::STREAMING) {
+        return;  // decodeChunked hit end of stream
+    }
+
+    if (!client.connected())
+    {
+        scheduleRetry("caster closed connection");
+        return;
+    }
+
+    if (millis() - stats.lastDataTime > DATA_TIMEOUT_MS)
+    {
+        scheduleRetry("no data from caster");
+        return;
+    }
+
+    sendGGA();
+}
+
+void NTRIPClient::deliver(const uint8_t* data, size_t len)
+{
+    // A session that delivers data has proven the configuration works
+    backoffMs = BACKOFF_MIN_MS;
+
+    stats.bytesReceived += len;
+    stats.totalBytes += len;
+    stats.lastDataTime = millis();
+    rateWindowBytes += len;
+
+    if (RTCMProcessor::getInstance()) {
+        RTCMProcessor::getInstance()->processNTRIPRTCM(data, len);
+    }
+}
+
+size_t NTRIPClient::decodeChunked(uint8_t* data, size_t len)
+{
+    // Strip HTTP/1.1 chunk framing in place, returns payload length
+    size_t out = 0;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        uint8_t c = data[i];
+
+        switch (chunkState)
+        {
+        case ChunkState::SIZE:
+            if (isxdigit(c)) {
+                chunkRemaining = (chunkRemaining << 4) | (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+            } else if (c == ';') {
+                chunkState = ChunkState::EXTENSION;
+            } else if (c == '\r') {
+                chunkState = ChunkState::SIZE_LF;
+            }
+            break;
+
+        case ChunkState::EXTENSION:
+            if (c == '\r') {
+                chunkState = ChunkState::SIZE_LF;
+            }
+            break;
+
+        case ChunkState::SIZE_LF:
+            if (chunkRemaining == 0)
+            {
+                // Zero-length chunk - caster ended the stream
+                scheduleRetry("caster ended stream");
+                return out;
+            }
+            chunkState = ChunkState::DATA;
+            break;
+
+        case ChunkState::DATA:
+            data[out++] = c;
+            if (--chunkRemaining == 0) {
+                chunkState = ChunkState::DATA_CR;
+            }
+            break;
+
+        case ChunkState::DATA_CR:
+            chunkState = ChunkState::DATA_LF;
+            break;
+
+        case ChunkState::DATA_LF:
+            chunkState = ChunkState::SIZE;
+            chunkRemaining = 0;
+            break;
+        }
+    }
+
+    return out;
+}
+
+void NTRIPClient::sendGGA()
+{
+    if (!config.ggaUpload) {
+        return;
+    }
+
+    uint32_t now = millis();
+    if (now - lastGGATime < (uint32_t)config.ggaIntervalSec * 1000) {
+        return;
+    }
+    lastGGATime = now;
+
+    char gga[100];
+    if (!buildGGA(gga, sizeof(gga))) {
+        return;
+    }
+
+    size_t len = strlen(gga);
+    if (client.availableForWrite() >= (int)len && client.write((const uint8_t*)gga, len) == len) {
+        stats.ggaSent++;
+    }
+}
+
+bool NTRIPClient::buildGGA(char* buffer, size_t size)
+{
+    const GNSSProcessor::GNSSData& d = gnssProcessor.getData();
+    if (!d.hasPosition) {
+        return false;
+    }
+
+    uint32_t t = d.fixTime;
+    unsigned int centis = (unsigned int)(d.fixTimeFractional * 100.0f) % 100;
+
+    int len = snprintf(buffer, size,
+                       "$GPGGA,%02lu%02lu%02lu.%02u,%012.7f,%c,%013.7f,%c,%u,%02u,%.1f,%.2f,M,0.0,M,,",
+                       t / 10000, (t / 100) % 100, t % 100, centis,
+                       d.latitudeNMEA, d.latDir, d.longitudeNMEA, d.lonDir,
+                       d.fixQuality, d.numSatellites, d.hdop, d.altitude);
+    if (len <= 0 || (size_t)len + 6 > size) {
+        return false;
+    }
+
+    uint8_t checksum = 0;
+    for (int i = 1; i < len; i++) {
+        checksum ^= buffer[i];
+    }
+    snprintf(buffer + len, size - len, "*%02X\r\n", checksum);
+    return true;
+}
+
+const char* NTRIPClient::stateToString(State s)
+{
+    switch (s)
+    {
+    case State::DISABLED:      return "disabled";
+    case State::WAIT_RETRY:    return "waiting";
+    case State::RESOLVING:     return "resolving";
+    case State::CONNECTING:    return "connecting";
+    case State::WAIT_RESPONSE: return "authenticating";
+    case State::STREAMING:     return "streaming";
+    default:                   return "unknown";
+    }
+}
@@ -0,0 +1,119 @@
+// NTRIPClient.h
+// On-board NTRIP v1/v2 client - streams corrections from a caster straight
+// into RTCMProcessor, removing AgIO from the correction path
+
+#ifndef NTRIPCLIENT_H_
+#define NTRIPCLIENT_H_
+
+#include "Arduino.h"
+#include <QNEthernet.h>
+#include "ConfigManager.h"
+
+using namespace qindesign::network;
+
+class NTRIPClient
+{
+public:
+    enum class State : uint8_t {
+        DISABLED,       // Not configured or switched off
+        WAIT_RETRY,     // Backing off before the next attempt
+        RESOLVING,      // Async DNS lookup of caster host
+        CONNECTING,     // TCP connect in progress
+        WAIT_RESPONSE,  // Request sent, reading status line and headers
+        STREAMING       // Receiving RTCM
+    };
+
+    // Connection statistics
+    struct Stats {
+        uint32_t bytesReceived;     // RTCM payload bytes this session
+        uint32_t totalBytes;        // RTCM payload bytes since boot
+        float byteRate;             // Bytes/s over last rate window
+        uint32_t connectAttempts;
+        uint32_t reconnects;        // Sessions that dropped after streaming
+        uint32_t ggaSent;
+        uint32_t connectedSince;    // millis() when streaming started
+        uint32_t lastDataTime;      // millis() of last payload byte
+    };
+
+    static constexpr uint32_t CONNECT_TIMEOUT_MS = 5000;
+    static constexpr uint32_t DNS_TIMEOUT_MS = 5000;
+    static constexpr uint32_t RESPONSE_TIMEOUT_MS = 10000;
+    static constexpr uint32_t DATA_TIMEOUT_MS = 15000;     // Silent stream -> reconnect
+    static constexpr uint32_t BACKOFF_MIN_MS = 1000;
+    static constexpr uint32_t BACKOFF_MAX_MS = 60000;
+    static constexpr uint32_t AUTH_FAIL_BACKOFF_MS = 300000; // Don't hammer a caster with bad credentials
+    static constexpr uint32_t RATE_WINDOW_MS = 5000;
+    static constexpr size_t READ_CHUNK_SIZE = 256;
+
+private:
+    static NTRIPClient* instance;
+
+    NTRIPClient();
+    ~NTRIPClient();
+
+    EthernetClient client;
+    NTRIPConfig config;
+    State state;
+    uint32_t stateTime;             // millis() when current state was entered
+
+    // Reconnect backoff
+    uint32_t backoffMs;
+    uint32_t retryDelayMs;
+
+    // Async DNS result (written from lwIP callback)
+    volatile bool dnsDone;
+    volatile bool dnsOk;
+    volatile uint32_t dnsGeneration;
+    IPAddress casterIP;
+
+    // Response header parsing
+    char lineBuffer[128];
+    uint8_t lineLength;
+    bool statusLineSeen;
+    bool chunked;                   // NTRIP v2 Transfer-Encoding: chunked
+
+    // Chunked transfer decoding
+    enum class ChunkState : uint8_t { SIZE, EXTENSION, SIZE_LF, DATA, DATA_CR, DATA_LF };
+    ChunkState chunkState;
+    uint32_t chunkRemaining;
+
+    // GGA upload
+    uint32_t lastGGATime;
+
+    Stats stats;
+    uint32_t rateWindowStart;
+    uint32_t rateWindowBytes;
+
+    char lastError[48];
+
+    void setState(State newState);
+    void scheduleRetry(const char* reason, uint32_t delayMs = 0);
+    void startConnect();
+    bool sendRequest();
+    void processResponse();
+    bool handleHeaderLine();
+    void processStream();
+    void deliver(const uint8_t* data, size_t len);
+    size_t decodeChunked(uint8_t* data, size_t len);
+    void sendGGA();
+    bool buildGGA(char* buffer, size_t size);
+
+public:
+    static void init();
+    static NTRIPClient* getInstance() { return instance; }
+
+    // Call from main loop
+    void process();
+
+    // Apply new configuration (drops and restarts the connection)
+    void reconfigure(const NTRIPConfig& newConfig);
+
+    // Status
+    State getState() const { return state; }
+    static const char* stateToString(State s);
+    const Stats& getStats() const { return stats; }
+    const char* getLastError() const { return lastError; }
+    bool isStreaming() const { return state == State::STREAMING; }
+};
+
+#endif // NTRIPCLIENT_H_
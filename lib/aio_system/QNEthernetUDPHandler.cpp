@@ -20,6 +20,10 @@ EthernetUDP QNEthernetUDPHandler::udpDHCP;
 EthernetUDP QNEthernetUDPHandler::udpSend;
 bool QNEthernetUDPHandler::dhcpServerEnabled = false;
 uint8_t QNEthernetUDPHandler::packetBuffer[512];
+IPAddress QNEthernetUDPHandler::agioIP;
+uint32_t QNEthernetUDPHandler::lastAgIOTime = 0;
+bool QNEthernetUDPHandler::agioSeen = false;
+bool QNEthernetUDPHandler::unicastActive = false;
 
 // External ConfigManager
 extern ConfigManager configManager;
@@ -27,10 +31,9 @@ extern ConfigManager configManager;
 void QNEthernetUDPHandler::init() {
     LOG_INFO(EventSource::NETWORK, "Initializing QNEthernet UDP handlers");
     
-    // Check Ethernet link status first
+    // Sockets can be bound before the link is up; packets flow once it is
     if (!Ethernet.linkState()) {
-        LOG_ERROR(EventSource::NETWORK, "No Ethernet link detected!");
-        return;
+        LOG_INFO(EventSource::NETWORK, "No Ethernet link yet, listening anyway");
     }
     
     // Log network configuration
@@ -51,9 +54,6 @@ void QNEthernetUDPHandler::init() {
         LOG_ERROR(EventSource::NETWORK, "Failed to start UDP on port 8888");
     }
     
-    // Add delay between UDP listeners to avoid conflicts
-    delay(100);
-    
     // Set up RTCM listener on port 2233
     if (udpRTCM.begin(2233)) {
         LOG_INFO(EventSource::NETWORK, "UDP listening on port 2233 for RTCM");
@@ -61,9 +61,6 @@ void QNEthernetUDPHandler::init() {
         LOG_ERROR(EventSource::NETWORK, "Failed to start UDP on port 2233");
     }
     
-    // Add delay between UDP listeners
-    delay(100);
-    
     // Initialize send socket (no specific port binding needed)
     if (udpSend.begin(0)) {  // 0 = let system choose port
         LOG_INFO(EventSource::NETWORK, "UDP send socket initialized");
@@ -155,6 +152,7 @@ void QNEthernetUDPHandler::poll() {
 void QNEthernetUDPHandler::handlePGNPacket(const uint8_t* data, size_t len, 
                                            const IPAddress& remoteIP, uint16_t remotePort) {
     // Process PGN packet
+    learnAgIO(data, len, remoteIP, remotePort);
     
     // Forward to ESP32 if detected
     if (esp32Interface.isDetected()) {
@@ -175,6 +173,70 @@ void QNEthernetUDPHandler::handleRTCMPacket(const uint8_t* data, size_t len,
     }
 }
 
+void QNEthernetUDPHandler::learnAgIO(const uint8_t* data, size_t len,
+                                     const IPAddress& remoteIP, uint16_t remotePort) {
+    // Only AgIO/AgOpenGPS traffic: source port 9999 and source byte 0x7F
+    if (remotePort != 9999 || len < 6 || data[0] != 0x80 || data[1] != 0x81 || data[2] != 0x7F) {
+        return;
+    }
+    
+    // Must be directly reachable - never unicast through the gateway
+    IPAddress localIP = Ethernet.localIP();
+    IPAddress mask = Ethernet.subnetMask();
+    for (int i = 0; i < 4; i++) {
+        if ((remoteIP[i] & mask[i]) != (localIP[i] & mask[i])) {
+            return;
+        }
+    }
+    
+    if (!agioSeen || !(agioIP == remoteIP)) {
+        LOG_INFO(EventSource::NETWORK, "AgIO discovered at %d.%d.%d.%d",
+                 remoteIP[0], remoteIP[1], remoteIP[2], remoteIP[3]);
+        agioIP = remoteIP;
+        agioSeen = true;
+    }
+    lastAgIOTime = millis();
+    
+    if (!unicastActive && configManager.getUDPUnicast()) {
+        unicastActive = true;
+        LOG_INFO(EventSource::NETWORK, "UDP streams switched to unicast -> %d.%d.%d.%d",
+                 agioIP[0], agioIP[1], agioIP[2], agioIP[3]);
+    }
+}
+
+IPAddress QNEthernetUDPHandler::getBroadcastIP() {
+    uint8_t destIP[4];
+    configManager.getDestIP(destIP);
+    return IPAddress(destIP[0], destIP[1], destIP[2], destIP[3]);
+}
+
+bool QNEthernetUDPHandler::isUnicastActive() {
+    if (!unicastActive) {
+        return false;
+    }
+    
+    // Fall back to broadcast if AgIO went quiet or the option was switched off
+    if (!configManager.getUDPUnicast() || millis() - lastAgIOTime > AGIO_TIMEOUT_MS) {
+        unicastActive = false;
+        LOG_WARNING(EventSource::NETWORK, "AgIO silent for %lu ms - UDP streams back to broadcast",
+                    millis() - lastAgIOTime);
+    }
+    return unicastActive;
+}
+
+IPAddress QNEthernetUDPHandler::getStreamDestination() {
+    return isUnicastActive() ? agioIP : getBroadcastIP();
+}
+
+bool QNEthernetUDPHandler::getAgIOAddress(IPAddress& ip) {
+    ip = agioIP;
+    return agioSeen;
+}
+
+uint32_t QNEthernetUDPHandler::getAgIOAge() {
+    return agioSeen ? millis() - lastAgIOTime : UINT32_MAX;
+}
+
 void QNEthernetUDPHandler::sendUDPPacket(uint8_t* data, int length) {
     // Check Ethernet link status
     if (!Ethernet.linkState()) {
@@ -182,13 +244,24 @@ void QNEthernetUDPHandler::sendUDPPacket(uint8_t* data, int length) {
         return;
     }
     
-    // Use the broadcast address from ConfigManager
-    uint8_t destIP[4];
-    configManager.getDestIP(destIP);
-    IPAddress broadcastIP(destIP[0], destIP[1], destIP[2], destIP[3]);
+    // Unicast to AgIO once discovered so other modules don't have to
+    // receive and discard 100Hz PGN 253, PANDA etc.
+    udpSend.beginPacket(getStreamDestination(), configManager.getDestPort());
+    udpSend.write(data, length);
+    if (!udpSend.endPacket()) {
+        LOG_ERROR(EventSource::NETWORK, "Failed to send UDP packet");
+    }
+}
+
+void QNEthernetUDPHandler::sendUDPBroadcast(uint8_t* data, int length) {
+    // Check Ethernet link status
+    if (!Ethernet.linkState()) {
+        LOG_ERROR(EventSource::NETWORK, "Cannot send UDP - no Ethernet link");
+        return;
+    }
     
     // Send packet
-    udpSend.beginPacket(broadcastIP, configManager.getDestPort());
+    udpSend.beginPacket(getBroadcastIP(), configManager.getDestPort());
     udpSend.write(data, length);
     if (!udpSend.endPacket()) {
         LOG_ERROR(EventSource::NETWORK, "Failed to send UDP packet");
@@ -200,6 +273,10 @@ void sendUDPbytes(uint8_t* data, int length) {
     QNEthernetUDPHandler::sendUDPPacket(data, length);
 }
 
+void sendUDPbytesBroadcast(uint8_t* data, int length) {
+    QNEthernetUDPHandler::sendUDPBroadcast(data, length);
+}
+
 // Send packet on port 9999 (for ESP32 bridge)
 void QNEthernetUDPHandler::sendUDP9999Packet(uint8_t* data, int length) {
     // Check Ethernet link status
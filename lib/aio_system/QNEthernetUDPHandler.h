@@ -12,7 +12,8 @@
 class QNEthernetUDPHandler {
 public:
     static void init();
-    static void sendUDPPacket(uint8_t* data, int length);
+    static void sendUDPPacket(uint8_t* data, int length);      // To AgIO (unicast when discovered)
+    static void sendUDPBroadcast(uint8_t* data, int length);   // Always to destIP (hello/scan replies)
     static void poll();  // Check for incoming packets and network status
     
     // DHCP Server control
@@ -22,6 +23,13 @@ public:
     // ESP32 bridge support
     static void sendUDP9999Packet(uint8_t* data, int length);
     
+    // Unicast to discovered AgIO
+    static constexpr uint32_t AGIO_TIMEOUT_MS = 3000;  // No AgIO traffic this long -> broadcast
+    static IPAddress getStreamDestination();            // AgIO when unicast is active, else destIP
+    static bool isUnicastActive();
+    static bool getAgIOAddress(IPAddress& ip);          // false if AgIO never seen
+    static uint32_t getAgIOAge();                       // ms since last AgIO packet
+    
 private:
     static qindesign::network::EthernetUDP udpPGN;   // For PGN traffic on port 8888
     static qindesign::network::EthernetUDP udpRTCM;  // For RTCM traffic on port 2233
@@ -31,6 +39,16 @@ private:
     static bool dhcpServerEnabled;
     static uint8_t packetBuffer[512];  // Buffer for receiving packets
     
+    // AgIO discovery (learned from source address of incoming PGNs)
+    static IPAddress agioIP;
+    static uint32_t lastAgIOTime;
+    static bool agioSeen;
+    static bool unicastActive;
+    
+    static void learnAgIO(const uint8_t* data, size_t len,
+                          const IPAddress& remoteIP, uint16_t remotePort);
+    static IPAddress getBroadcastIP();
+    
     // Packet handlers
     static void handlePGNPacket(const uint8_t* data, size_t len, 
                                const IPAddress& remoteIP, uint16_t remotePort);
@@ -42,5 +60,7 @@ private:
 
 // Global function to maintain compatibility
 void sendUDPbytes(uint8_t* data, int length);
+// Hello/scan replies must reach every AgIO instance - never unicast
+void sendUDPbytesBroadcast(uint8_t* data, int length);
 
 #endif // QNETHERNETUDPHANDLER_H
\ No newline at end of file
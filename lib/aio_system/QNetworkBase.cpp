@@ -71,20 +71,9 @@ void QNetworkBase::init() {
         return;
     }
     
-    // Wait for link
-    LOG_INFO(EventSource::NETWORK, "Waiting for Ethernet link...");
-    if (!Ethernet.waitForLink(5000)) {  // 5 second timeout
-        LOG_WARNING(EventSource::NETWORK, "Link timeout, continuing anyway");
-    }
-    
-    if (Ethernet.linkStatus()) {
-        LOG_INFO(EventSource::NETWORK, "Link UP! IP: %d.%d.%d.%d, Speed: %d Mbps, Full Duplex: %s", 
-                 ip[0], ip[1], ip[2], ip[3], 
-                 Ethernet.linkSpeed(),
-                 Ethernet.linkIsFullDuplex() ? "Yes" : "No");
-    } else {
-        LOG_ERROR(EventSource::NETWORK, "No Ethernet link detected!");
-    }
+    // Link negotiation continues in the background; onLinkStateChanged() reports it
+    LOG_INFO(EventSource::NETWORK, "Ethernet started, IP: %d.%d.%d.%d (waiting for link)",
+             ip[0], ip[1], ip[2], ip[3]);
     
     // Register PGN 201 handler for subnet changes
     if (PGNProcessor::instance) {
@@ -0,0 +1,281 @@
+#include "RTCMFramer.h"
+
+// CRC24Q lookup table (polynomial 0x1864CFB), kept in flash
+static const uint32_t crc24qTable[256] PROGMEM = {
+    0x000000UL, 0x864CFBUL, 0x8AD50DUL, 0x0C99F6UL, 0x93E6E1UL, 0x15AA1AUL, 0x1933ECUL, 0x9F7F17UL,
+    0xA18139UL, 0x27CDC2UL, 0x2B5434UL, 0xAD18CFUL, 0x3267D8UL, 0xB42B23UL, 0xB8B2D5UL, 0x3EFE2EUL,
+    0xC54E89UL, 0x430272UL, 0x4F9B84UL, 0xC9D77FUL, 0x56A868UL, 0xD0E493UL, 0xDC7D65UL, 0x5A319EUL,
+    0x64CFB0UL, 0xE2834BUL, 0xEE1ABDUL, 0x685646UL, 0xF72951UL, 0x7165AAUL, 0x7DFC5CUL, 0xFBB0A7UL,
+    0x0CD1E9UL, 0x8A9D12UL, 0x8604E4UL, 0x00481FUL, 0x9F3708UL, 0x197BF3UL, 0x15E205UL, 0x93AEFEUL,
+    0xAD50D0UL, 0x2B1C2BUL, 0x2785DDUL, 0xA1C926UL, 0x3EB631UL, 0xB8FACAUL, 0xB4633CUL, 0x322FC7UL,
+    0xC99F60UL, 0x4FD39BUL, 0x434A6DUL, 0xC50696UL, 0x5A7981UL, 0xDC357AUL, 0xD0AC8CUL, 0x56E077UL,
+    0x681E59UL, 0xEE52A2UL, 0xE2CB54UL, 0x6487AFUL, 0xFBF8B8UL, 0x7DB443UL, 0x712DB5UL, 0xF7614EUL,
+    0x19A3D2UL, 0x9FEF29UL, 0x9376DFUL, 0x153A24UL, 0x8A4533UL, 0x0C09C8UL, 0x00903EUL, 0x86DCC5UL,
+    0xB822EBUL, 0x3E6E10UL, 0x32F7E6UL, 0xB4BB1DUL, 0x2BC40AUL, 0xAD88F1UL, 0xA11107UL, 0x275DFCUL,
+    0xDCED5BUL, 0x5AA1A0UL, 0x563856UL, 0xD074ADUL, 0x4F0BBAUL, 0xC94741UL, 0xC5DEB7UL, 0x43924CUL,
+    0x7D6C62UL, 0xFB2099UL, 0xF7B96FUL, 0x71F594UL, 0xEE8A83UL, 0x68C678UL, 0x645F8EUL, 0xE21375UL,
+    0x15723BUL, 0x933EC0UL, 0x9FA736UL, 0x19EBCDUL, 0x8694DAUL, 0x00D821UL, 0x0C41D7UL, 0x8A0D2CUL,
+    0xB4F302UL, 0x32BFF9UL, 0x3E260FUL, 0xB86AF4UL, 0x2715E3UL, 0xA15918UL, 0xADC0EEUL, 0x2B8C15UL,
+    0xD03CB2UL, 0x567049UL, 0x5AE9BFUL, 0xDCA544UL, 0x43DA53UL, 0xC596A8UL, 0xC90F5EUL, 0x4F43A5UL,
+    0x71BD8BUL, 0xF7F170UL, 0xFB6886UL, 0x7D247DUL, 0xE25B6AUL, 0x641791UL, 0x688E67UL, 0xEEC29CUL,
+    0x3347A4UL, 0xB50B5FUL, 0xB992A9UL, 0x3FDE52UL, 0xA0A145UL, 0x26EDBEUL, 0x2A7448UL, 0xAC38B3UL,
+    0x92C69DUL, 0x148A66UL, 0x181390UL, 0x9E5F6BUL, 0x01207CUL, 0x876C87UL, 0x8BF571UL, 0x0DB98AUL,
+    0xF6092DUL, 0x7045D6UL, 0x7CDC20UL, 0xFA90DBUL, 0x65EFCCUL, 0xE3A337UL, 0xEF3AC1UL, 0x69763AUL,
+    0x578814UL, 0xD1C4EFUL, 0xDD5D19UL, 0x5B11E2UL, 0xC46EF5UL, 0x42220EUL, 0x4EBBF8UL, 0xC8F703UL,
+    0x3F964DUL, 0xB9DAB6UL, 0xB54340UL, 0x330FBBUL, 0xAC70ACUL, 0x2A3C57UL, 0x26A5A1UL, 0xA0E95AUL,
+    0x9E1774UL, 0x185B8FUL, 0x14C279UL, 0x928E82UL, 0x0DF195UL, 0x8BBD6EUL, 0x872498UL, 0x016863UL,
+    0xFAD8C4UL, 0x7C943FUL, 0x700DC9UL, 0xF64132UL, 0x693E25UL, 0xEF72DEUL, 0xE3EB28UL, 0x65A7D3UL,
+    0x5B59FDUL, 0xDD1506UL, 0xD18CF0UL, 0x57C00BUL, 0xC8BF1CUL, 0x4EF3E7UL, 0x426A11UL, 0xC426EAUL,
+    0x2AE476UL, 0xACA88DUL, 0xA0317BUL, 0x267D80UL, 0xB90297UL, 0x3F4E6CUL, 0x33D79AUL, 0xB59B61UL,
+    0x8B654FUL, 0x0D29B4UL, 0x01B042UL, 0x87FCB9UL, 0x1883AEUL, 0x9ECF55UL, 0x9256A3UL, 0x141A58UL,
+    0xEFAAFFUL, 0x69E604UL, 0x657FF2UL, 0xE33309UL, 0x7C4C1EUL, 0xFA00E5UL, 0xF69913UL, 0x70D5E8UL,
+    0x4E2BC6UL, 0xC8673DUL, 0xC4FECBUL, 0x42B230UL, 0xDDCD27UL, 0x5B81DCUL, 0x57182AUL, 0xD154D1UL,
+    0x26359FUL, 0xA07964UL, 0xACE092UL, 0x2AAC69UL, 0xB5D37EUL, 0x339F85UL, 0x3F0673UL, 0xB94A88UL,
+    0x87B4A6UL, 0x01F85DUL, 0x0D61ABUL, 0x8B2D50UL, 0x145247UL, 0x921EBCUL, 0x9E874AUL, 0x18CBB1UL,
+    0xE37B16UL, 0x6537EDUL, 0x69AE1BUL, 0xEFE2E0UL, 0x709DF7UL, 0xF6D10CUL, 0xFA48FAUL, 0x7C0401UL,
+    0x42FA2FUL, 0xC4B6D4UL, 0xC82F22UL, 0x4E63D9UL, 0xD11CCEUL, 0x575035UL, 0x5BC9C3UL, 0xDD8538UL
+};
+
+RTCMFramer::RTCMFramer()
+{
+    replayPos = 0;
+    replayEnd = 0;
+    resetParser();
+    resetStats();
+}
+
+void RTCMFramer::resetParser()
+{
+    state = WAIT_PREAMBLE;
+    bufferIndex = 0;
+    payloadLength = 0;
+    frameReady = false;
+    innerStart = 0;
+    innerScan = 1;
+}
+
+void RTCMFramer::resetStats()
+{
+    framesValid = 0;
+    crcErrors = 0;
+    bytesDiscarded = 0;
+}
+
+bool RTCMFramer::processByte(uint8_t byte)
+{
+    if (replayPos < replayEnd)
+    {
+        // Queue behind the bytes still waiting from a resync
+        if (replayEnd < MAX_FRAME_SIZE)
+        {
+            buffer[replayEnd++] = byte;
+        }
+        else
+        {
+            bytesDiscarded++;
+        }
+        return processPending();
+    }
+
+    if (step(byte))
+    {
+        return true;
+    }
+    return processPending();
+}
+
+bool RTCMFramer::processPending()
+{
+    // Parsed in place: the frame being collected never grows past the
+    // byte being read, and a resync restarts the replay from buffer[0]
+    while (replayPos < replayEnd)
+    {
+        if (step(buffer[replayPos++]))
+        {
+            return true;
+        }
+    }
+    replayPos = 0;
+    replayEnd = 0;
+    return false;
+}
+
+bool RTCMFramer::step(uint8_t byte)
+{
+    // Previous frame has been consumed by the caller
+    if (frameReady)
+    {
+        resetParser();
+    }
+
+    switch (state)
+    {
+    case WAIT_PREAMBLE:
+        if (byte == PREAMBLE)
+        {
+            buffer[0] = byte;
+            bufferIndex = 1;
+            state = WAIT_LENGTH1;
+        }
+        else
+        {
+            bytesDiscarded++;
+        }
+        break;
+
+    case WAIT_LENGTH1:
+        buffer[bufferIndex++] = byte;
+        // Upper 6 bits are reserved and must be zero
+        if (byte & 0xFC)
+        {
+            resync();
+            break;
+        }
+        state = WAIT_LENGTH2;
+        break;
+
+    case WAIT_LENGTH2:
+        buffer[bufferIndex++] = byte;
+        payloadLength = ((uint16_t)(buffer[1] & 0x03) << 8) | byte;
+        state = COLLECT_PAYLOAD;
+        break;
+
+    case COLLECT_PAYLOAD:
+        buffer[bufferIndex++] = byte;
+        if (bufferIndex >= HEADER_SIZE + payloadLength + CRC_SIZE)
+        {
+            uint16_t crcOffset = HEADER_SIZE + payloadLength;
+            uint32_t received = ((uint32_t)buffer[crcOffset] << 16) |
+                                ((uint32_t)buffer[crcOffset + 1] << 8) |
+                                buffer[crcOffset + 2];
+
+            if (crc24q(buffer, crcOffset) == received)
+            {
+                framesValid++;
+                frameReady = true;
+                return true;
+            }
+
+            crcErrors++;
+            resync();
+        }
+        else if (checkInnerFrame())
+        {
+            return true;
+        }
+        break;
+    }
+
+    return false;
+}
+
+bool RTCMFramer::checkInnerFrame()
+{
+    // A frame that starts and ends inside the candidate means the candidate
+    // is false (a real payload containing a CRC-valid frame is a 2^-24 case)
+    uint16_t candidateEnd = HEADER_SIZE + payloadLength + CRC_SIZE;
+    while (true)
+    {
+        if (innerStart == 0)
+        {
+            while (innerScan < bufferIndex && buffer[innerScan] != PREAMBLE)
+            {
+                innerScan++;
+            }
+            if (innerScan >= bufferIndex)
+            {
+                return false;
+            }
+            innerStart = innerScan++;
+        }
+
+        if (bufferIndex < innerStart + HEADER_SIZE)
+        {
+            return false;
+        }
+        uint16_t length = ((uint16_t)(buffer[innerStart + 1] & 0x03) << 8) | buffer[innerStart + 2];
+        uint16_t end = innerStart + HEADER_SIZE + length + CRC_SIZE;
+        if ((buffer[innerStart + 1] & 0xFC) || end >= candidateEnd)
+        {
+            // Bad header, or the candidate's own CRC decides first
+            innerStart = 0;
+            continue;
+        }
+        if (bufferIndex < end)
+        {
+            return false;
+        }
+
+        uint16_t crcOffset = end - CRC_SIZE;
+        uint32_t received = ((uint32_t)buffer[crcOffset] << 16) |
+                            ((uint32_t)buffer[crcOffset + 1] << 8) |
+                            buffer[crcOffset + 2];
+        if (crc24q(buffer + innerStart, crcOffset - innerStart) == received)
+        {
+            crcErrors++;        // The candidate it was found in
+            framesValid++;
+            adoptInnerFrame(innerStart, end);
+            return true;
+        }
+        innerStart = 0;
+    }
+}
+
+void RTCMFramer::resync()
+{
+    // The rejected frame's bytes after its preamble, then any bytes still
+    // waiting, become one run to parse again
+    uint16_t waiting = replayEnd - replayPos;
+    memmove(buffer + bufferIndex, buffer + replayPos, waiting);
+    uint16_t end = bufferIndex + waiting;
+
+    // Only the false preamble and what precedes the next 0xD3 are lost
+    uint16_t next = 1;
+    while (next < end && buffer[next] != PREAMBLE)
+    {
+        next++;
+    }
+    bytesDiscarded += next;
+
+    memmove(buffer, buffer + next, end - next);
+    replayPos = 0;
+    replayEnd = end - next;
+    resetParser();
+}
+
+void RTCMFramer::adoptInnerFrame(uint16_t start, uint16_t end)
+{
+    // The frame moves to the front; the candidate bytes after it, then any
+    // bytes still waiting, are parsed again once the caller has taken it
+    uint16_t waiting = replayEnd - replayPos;
+    memmove(buffer + bufferIndex, buffer + replayPos, waiting);
+    uint16_t total = bufferIndex + waiting;
+    bytesDiscarded += start;
+
+    memmove(buffer, buffer + start, total - start);
+    payloadLength = end - start - HEADER_SIZE - CRC_SIZE;
+    bufferIndex = end - start;
+    replayPos = bufferIndex;
+    replayEnd = total - start;
+    frameReady = true;
+}
+
+uint16_t RTCMFramer::getMessageType() const
+{
+    // Message number is the first 12 bits of the payload
+    if (!frameReady || payloadLength < 2)
+    {
+        return 0;
+    }
+    return ((uint16_t)buffer[HEADER_SIZE] << 4) | (buffer[HEADER_SIZE + 1] >> 4);
+}
+
+uint32_t RTCMFramer::crc24q(const uint8_t* data, size_t len)
+{
+    uint32_t crc = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        crc = ((crc << 8) & 0xFFFFFF) ^ crc24qTable[((crc >> 16) ^ data[i]) & 0xFF];
+    }
+    return crc;
+}
@@ -0,0 +1,91 @@
+#ifndef RTCMFRAMER_H_
+#define RTCMFRAMER_H_
+
+#include <Arduino.h>
+
+// RTCM3 frame reassembler
+// Byte-fed state machine that finds 0xD3 preambles, reads the 10-bit length,
+// collects the payload and validates the CRC24Q. Frames may be split across
+// any number of UDP datagrams or serial reads - state is kept between calls.
+// A rejected header or CRC only drops bytes up to the next 0xD3 after the
+// false preamble; everything from there is parsed again, so a stray 0xD3
+// cannot swallow the real frames that follow it. Frames that start inside
+// a candidate are checked as soon as their last byte arrives, so a false
+// preamble with a long plausible length does not hold them back either.
+class RTCMFramer
+{
+public:
+    // RTCM3 framing constants
+    static const uint8_t PREAMBLE = 0xD3;
+    static const uint16_t HEADER_SIZE = 3;        // Preamble + 6 reserved bits + 10-bit length
+    static const uint16_t CRC_SIZE = 3;           // CRC24Q
+    static const uint16_t MAX_PAYLOAD = 1023;     // 10-bit length field
+    static const uint16_t MAX_FRAME_SIZE = HEADER_SIZE + MAX_PAYLOAD + CRC_SIZE;
+
+private:
+    enum State
+    {
+        WAIT_PREAMBLE,
+        WAIT_LENGTH1,
+        WAIT_LENGTH2,
+        COLLECT_PAYLOAD
+    };
+
+    State state;
+    uint8_t buffer[MAX_FRAME_SIZE];
+    uint16_t bufferIndex;
+    uint16_t payloadLength;
+    bool frameReady;
+
+    // Bytes waiting to be parsed again after a resync, kept in buffer
+    // behind the frame being collected
+    uint16_t replayPos;
+    uint16_t replayEnd;
+
+    // Next 0xD3 inside the candidate frame (0 = none found yet) and where
+    // the search for one continues
+    uint16_t innerStart;
+    uint16_t innerScan;
+
+    // Statistics
+    uint32_t framesValid;
+    uint32_t crcErrors;
+    uint32_t bytesDiscarded;
+
+    void resetParser();
+    bool step(uint8_t byte);
+    bool checkInnerFrame();
+    void resync();
+    void adoptInnerFrame(uint16_t start, uint16_t end);
+
+public:
+    RTCMFramer();
+
+    // Feed one byte. Returns true when a complete CRC-valid frame is available
+    // through getFrame()/getFrameLength(). The frame stays valid until the
+    // next call to processByte().
+    bool processByte(uint8_t byte);
+
+    // Continue with bytes held back by a resync. Call after every frame
+    // until it returns false - a resync may leave more complete frames
+    bool processPending();
+
+    // Completed frame access
+    const uint8_t* getFrame() const { return buffer; }
+    uint16_t getFrameLength() const { return frameReady ? (HEADER_SIZE + payloadLength + CRC_SIZE) : 0; }
+    uint16_t getMessageType() const;
+
+    // True while a frame is partially collected
+    bool isInFrame() const { return state != WAIT_PREAMBLE; }
+
+    // Statistics
+    uint32_t getFramesValid() const { return framesValid; }
+    uint32_t getCRCErrors() const { return crcErrors; }
+    uint32_t getBytesDiscarded() const { return bytesDiscarded; }
+    void resetStats();
+
+    // CRC24Q as used by RTCM3 (polynomial 0x1864CFB)
+    static uint32_t crc24q(const uint8_t* data, size_t len);
+};
+
+#endif // RTCMFRAMER_H_
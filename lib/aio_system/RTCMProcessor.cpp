@@ -4,15 +4,9 @@
 #include "SerialManager.h"
 #include "EventLogger.h"
 
-// Just declare what we need, don't include pcb.h
-#define SerialGPS1 Serial5 // From pcb.h
-
 // External LED manager
 extern LEDManagerFSM ledManagerFSM;
 
-// External UDP instances from QNetworkBase
-extern EthernetUDP udpRTCM;
-
 // QNEthernet namespace
 using namespace qindesign::network;
 
@@ -20,8 +14,15 @@ using namespace qindesign::network;
 RTCMProcessor *RTCMProcessor::instance = nullptr;
 
 RTCMProcessor::RTCMProcessor()
+    : hasActiveSource(false), activeSource(RTCMSource::NETWORK),
+      messageTypeCount(0), lastRateUpdate(0), lastForwardTime(0)
 {
     instance = this;
+    memset(sourceStats, 0, sizeof(sourceStats));
+    memset(frameStartMicros, 0, sizeof(frameStartMicros));
+    memset(&txStats, 0, sizeof(txStats));
+    txStats.minFreeSpace = UINT32_MAX;
+    memset(messageStats, 0, sizeof(messageStats));
 }
 
 RTCMProcessor::~RTCMProcessor()
@@ -37,50 +38,39 @@ void RTCMProcessor::init()
     }
 }
 
-// Remove static callback - QNEthernet uses a different approach
-
 void RTCMProcessor::processRTCM(const uint8_t* data, size_t len, const IPAddress& remoteIP, uint16_t remotePort)
 {
-    // Match the original code logic exactly
     if (!QNetworkBase::isConnected())
         return;
 
-    // We receive RTCM on port 2233, regardless of source port
-    // Just check that we have valid RTCM data (min 5 bytes)
-    if (len >= 5)
-    {
-        // Write directly to serial port
-        SerialGPS1.write(data, len);
-        
-        // Pulse GPS LED blue for RTCM packet
-        ledManagerFSM.pulseRTCM();
-        
-        // Log RTCM activity periodically
-        static uint32_t lastRTCMLog = 0;
-        static uint32_t rtcmPacketCount = 0;
-        rtcmPacketCount++;
-        
-        if (millis() - lastRTCMLog > 5000) {
-            lastRTCMLog = millis();
-            LOG_DEBUG(EventSource::NETWORK, "RTCM: %lu packets from %d.%d.%d.%d:%d",
-                      rtcmPacketCount, remoteIP[0], remoteIP[1], remoteIP[2], remoteIP[3], remotePort);
-            rtcmPacketCount = 0;
-        }
+    // We receive RTCM on port 2233, regardless of source port.
+    // Datagrams are not guaranteed to hold whole frames - the framer
+    // reassembles across packets.
+    feedSource(RTCMSource::NETWORK, data, len);
+
+    // Log RTCM activity periodically
+    static uint32_t lastRTCMLog = 0;
+    static uint32_t rtcmPacketCount = 0;
+    rtcmPacketCount++;
+
+    if (millis() - lastRTCMLog > 5000) {
+        lastRTCMLog = millis();
+        LOG_DEBUG(EventSource::NETWORK, "RTCM: %lu packets from %d.%d.%d.%d:%d",
+                  rtcmPacketCount, remoteIP[0], remoteIP[1], remoteIP[2], remoteIP[3], remotePort);
+        rtcmPacketCount = 0;
     }
-    // No need to delete buffer - QNEthernet handles memory management
 }
 
 void RTCMProcessor::processRadioRTCM()
 {
     // Static variables for diagnostic tracking
-    static uint32_t radioByteCount = 0;
-    static uint32_t forwardedByteCount = 0;
-    static uint32_t lastRadioLog = 0;
     static uint32_t lastDataTime = 0;
     static bool radioDataActive = false;
 
-    // Simple direct forwarding - exactly like the working test code
-    if (SerialRadio.available())
+    // Move everything the radio UART has buffered in one call so a busy
+    // loop does not stretch a 1-2KB RTCM burst over thousands of iterations
+    int available = SerialRadio.available();
+    if (available > 0)
     {
         // Track activity
         if (!radioDataActive) {
@@ -90,48 +80,257 @@ void RTCMProcessor::processRadioRTCM()
 
         lastDataTime = millis();
 
-        // Forward one byte per call - exactly like tester's working code
-        SerialGPS1.write(SerialRadio.read());
-        radioByteCount++;
-        forwardedByteCount++;
+        uint8_t chunk[RADIO_CHUNK_SIZE];
+        while (available > 0)
+        {
+            size_t count = 0;
+            while (count < RADIO_CHUNK_SIZE && available > 0)
+            {
+                chunk[count++] = SerialRadio.read();
+                available--;
+            }
+            feedSource(RTCMSource::RADIO, chunk, count);
+        }
+    }
+
+    // Detect when radio data stream stops
+    if (radioDataActive && millis() - lastDataTime > 10000) {
+        radioDataActive = false;
+        LOG_INFO(EventSource::NETWORK, "Radio RTCM data stream stopped");
+    }
+}
+
+void RTCMProcessor::processNTRIPRTCM(const uint8_t* data, size_t len)
+{
+    // NTRIP is a TCP byte stream - frame boundaries are recovered by the framer
+    feedSource(RTCMSource::NTRIP, data, len);
+}
 
-        // Pulse LED periodically to show radio RTCM activity
-        static uint32_t lastPulse = 0;
-        if (millis() - lastPulse > 1000) // Pulse every second when receiving
+void RTCMProcessor::feedSource(RTCMSource source, const uint8_t* data, size_t len)
+{
+    size_t idx = static_cast<size_t>(source);
+    RTCMFramer& framer = framers[idx];
+
+    sourceStats[idx].bytesIn += len;
+
+    for (size_t i = 0; i < len; i++)
+    {
+        bool wasInFrame = framer.isInFrame();
+        if (framer.processByte(data[i]))
+        {
+            // A resync can leave more complete frames behind this one
+            do
+            {
+                handleFrame(source);
+            } while (framer.processPending());
+        }
+        else if (!wasInFrame && framer.isInFrame())
         {
-            ledManagerFSM.pulseRTCM();
-            lastPulse = millis();
+            // Preamble seen - start of frame latency measurement
+            frameStartMicros[idx] = micros();
         }
     }
 
-    // Log radio RTCM statistics periodically
-    if (radioByteCount > 0 && millis() - lastRadioLog > 5000) {
-        lastRadioLog = millis();
-        LOG_INFO(EventSource::NETWORK, "Radio RTCM: %lu bytes received, %lu forwarded to GPS1",
-                 radioByteCount, forwardedByteCount);
+    sourceStats[idx].framesValid = framer.getFramesValid();
+    sourceStats[idx].crcErrors = framer.getCRCErrors();
+    sourceStats[idx].bytesDiscarded = framer.getBytesDiscarded();
+}
+
+void RTCMProcessor::handleFrame(RTCMSource source)
+{
+    size_t idx = static_cast<size_t>(source);
+    RTCMFramer& framer = framers[idx];
+    uint32_t now = millis();
+
+    sourceStats[idx].lastFrameTime = now;
 
-        // Check for data loss
-        if (forwardedByteCount < radioByteCount) {
-            LOG_WARNING(EventSource::NETWORK, "Radio RTCM data loss: %lu bytes dropped",
-                        radioByteCount - forwardedByteCount);
+    // Arbitrate at frame granularity: the active source keeps the GPS port
+    // until it has been silent for SOURCE_TIMEOUT_MS. Mixing corrections from
+    // two base stations would be worse than losing one of them.
+    if (!hasActiveSource || activeSource != source)
+    {
+        size_t activeIdx = static_cast<size_t>(activeSource);
+        if (hasActiveSource && now - sourceStats[activeIdx].lastFrameTime < SOURCE_TIMEOUT_MS)
+        {
+            sourceStats[idx].framesBlocked++;
+            return;
         }
 
-        // Reset counters
-        radioByteCount = 0;
-        forwardedByteCount = 0;
+        if (hasActiveSource) {
+            LOG_WARNING(EventSource::NETWORK, "RTCM source switched: %s -> %s",
+                        sourceToString(activeSource), sourceToString(source));
+        } else {
+            LOG_INFO(EventSource::NETWORK, "RTCM source active: %s", sourceToString(source));
+        }
+        activeSource = source;
+        hasActiveSource = true;
     }
 
-    // Detect when radio data stream stops
-    if (radioDataActive && millis() - lastDataTime > 10000) {
-        radioDataActive = false;
-        LOG_INFO(EventSource::NETWORK, "Radio RTCM data stream stopped");
+    if (forwardFrame(framer.getFrame(), framer.getFrameLength(), framer.getMessageType()))
+    {
+        RTCMSourceStats& s = sourceStats[idx];
+        s.framesForwarded++;
+
+        uint32_t latency = micros() - frameStartMicros[idx];
+        s.latencyLastUs = latency;
+        s.latencySumUs += latency;
+        s.latencyCount++;
+        if (latency > s.latencyMaxUs) {
+            s.latencyMaxUs = latency;
+        }
     }
 }
 
+bool RTCMProcessor::forwardFrame(const uint8_t* frame, uint16_t len, uint16_t messageType)
+{
+    // Never block the main loop on a full GPS1 FIFO - a late correction is
+    // worth less than a late control tick, so drop the frame instead
+    int freeSpace = SerialGPS1.availableForWrite();
+    if (freeSpace < len)
+    {
+        txStats.framesDropped++;
+
+        static uint32_t lastDropLog = 0;
+        if (millis() - lastDropLog > 5000) {
+            lastDropLog = millis();
+            LOG_WARNING(EventSource::NETWORK, "RTCM: GPS1 TX full (%d free, %u needed), %lu frames dropped",
+                        freeSpace, len, txStats.framesDropped);
+        }
+        return false;
+    }
+
+    SerialGPS1.write(frame, len);
+    txStats.bytesWritten += len;
+
+    uint32_t remaining = (uint32_t)(freeSpace - len);
+    if (remaining < txStats.minFreeSpace) {
+        txStats.minFreeSpace = remaining;
+    }
+
+    lastForwardTime = millis();
+
+    recordMessageType(messageType);
+
+    // Pulse GPS LED blue for RTCM frame
+    ledManagerFSM.pulseRTCM();
+    return true;
+}
+
+void RTCMProcessor::recordMessageType(uint16_t messageType)
+{
+    RTCMMessageStats* entry = nullptr;
+
+    for (size_t i = 0; i < messageTypeCount; i++)
+    {
+        if (messageStats[i].type == messageType)
+        {
+            entry = &messageStats[i];
+            break;
+        }
+    }
+
+    if (entry == nullptr)
+    {
+        if (messageTypeCount >= MAX_MESSAGE_TYPES)
+        {
+            return;  // Table full - frame is still forwarded, just not counted
+        }
+        entry = &messageStats[messageTypeCount++];
+        entry->type = messageType;
+    }
+
+    entry->count++;
+    entry->windowCount++;
+    entry->lastSeen = lastForwardTime;
+}
+
+void RTCMProcessor::updateRates()
+{
+    uint32_t now = millis();
+    uint32_t elapsed = now - lastRateUpdate;
+    if (elapsed < RATE_WINDOW_MS)
+    {
+        return;
+    }
+    lastRateUpdate = now;
+
+    for (size_t i = 0; i < messageTypeCount; i++)
+    {
+        messageStats[i].rateHz = messageStats[i].windowCount * 1000.0f / elapsed;
+        messageStats[i].windowCount = 0;
+    }
+
+    if (hasActiveSource)
+    {
+        const RTCMSourceStats& s = sourceStats[static_cast<size_t>(activeSource)];
+        LOG_DEBUG(EventSource::NETWORK, "RTCM %s: %lu frames fwd, %lu CRC err, %lu blocked, age %lu ms",
+                  sourceToString(activeSource), s.framesForwarded, s.crcErrors,
+                  s.framesBlocked, getCorrectionAge());
+    }
+}
+
+uint32_t RTCMProcessor::getCorrectionAge() const
+{
+    if (lastForwardTime == 0)
+    {
+        return UINT32_MAX;
+    }
+    return millis() - lastForwardTime;
+}
+
+const char* RTCMProcessor::sourceToString(RTCMSource source)
+{
+    switch (source)
+    {
+    case RTCMSource::NETWORK: return "Network";
+    case RTCMSource::RADIO:   return "Radio";
+    case RTCMSource::NTRIP:   return "NTRIP";
+    default:                  return "Unknown";
+    }
+}
+
+void RTCMProcessor::printStatus()
+{
+    Serial.print("\r\n=== RTCM Status ===");
+    Serial.printf("\r\nActive source: %s", hasActiveSource ? sourceToString(activeSource) : "none");
+    uint32_t age = getCorrectionAge();
+    if (age == UINT32_MAX) {
+        Serial.print("\r\nCorrection age: n/a");
+    } else {
+        Serial.printf("\r\nCorrection age: %lu ms", age);
+    }
+
+    for (size_t i = 0; i < RTCM_SOURCE_COUNT; i++)
+    {
+        const RTCMSourceStats& s = sourceStats[i];
+        Serial.printf("\r\n%-8s in=%lu B, valid=%lu, fwd=%lu, blocked=%lu, crcErr=%lu, discarded=%lu B",
+                      sourceToString(static_cast<RTCMSource>(i)), s.bytesIn, s.framesValid,
+                      s.framesForwarded, s.framesBlocked, s.crcErrors, s.bytesDiscarded);
+        if (s.latencyCount > 0) {
+            Serial.printf("\r\n         latency last=%lu us, avg=%lu us, max=%lu us",
+                          s.latencyLastUs, s.latencySumUs / s.latencyCount, s.latencyMaxUs);
+        }
+    }
+
+    Serial.printf("\r\nGPS1 TX: %lu B written, %lu frames dropped (buffer full), min free %ld B",
+                  txStats.bytesWritten, txStats.framesDropped,
+                  txStats.minFreeSpace == UINT32_MAX ? -1L : (long)txStats.minFreeSpace);
+
+    for (size_t i = 0; i < messageTypeCount; i++)
+    {
+        Serial.printf("\r\n  Type %4u: %6lu frames, %.1f Hz, last %lu ms ago",
+                      messageStats[i].type, messageStats[i].count, messageStats[i].rateHz,
+                      millis() - messageStats[i].lastSeen);
+    }
+    Serial.print("\r\n===================\r\n");
+}
+
 void RTCMProcessor::process()
 {
     // Process all RTCM sources
     // Network RTCM is handled via UDP callback
     // Process radio RTCM here
     processRadioRTCM();
-}
\ No newline at end of file
+
+    updateRates();
+}
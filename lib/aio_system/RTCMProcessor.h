@@ -3,6 +3,7 @@
 
 #include "Arduino.h"
 #include "QNetworkBase.h"
+#include "RTCMFramer.h"
 #include <QNEthernet.h>
 #include <QNEthernetUDP.h>
 
@@ -11,8 +12,42 @@ using namespace qindesign::network;
 
 // RTCM data sources
 enum class RTCMSource {
-    NETWORK,    // From UDP port 9999
-    RADIO       // From SerialRadio (Xbee)
+    NETWORK,    // From UDP port 2233
+    RADIO,      // From SerialRadio (Xbee)
+    NTRIP       // From the on-board NTRIP client
+};
+
+static constexpr size_t RTCM_SOURCE_COUNT = 3;
+
+// Per-source framing and arbitration statistics
+struct RTCMSourceStats {
+    uint32_t bytesIn;           // Raw bytes received
+    uint32_t framesValid;       // CRC-valid frames reassembled
+    uint32_t crcErrors;         // Frames dropped on CRC mismatch
+    uint32_t bytesDiscarded;    // Bytes outside any valid frame
+    uint32_t framesForwarded;   // Frames written to GPS1
+    uint32_t framesBlocked;     // Valid frames dropped because another source was active
+    uint32_t lastFrameTime;     // millis() of last valid frame
+    uint32_t latencyLastUs;     // First byte received -> frame queued on GPS1
+    uint32_t latencyMaxUs;
+    uint32_t latencySumUs;
+    uint32_t latencyCount;
+};
+
+// GPS1 transmit backpressure accounting
+struct RTCMTxStats {
+    uint32_t bytesWritten;      // Bytes queued on GPS1
+    uint32_t framesDropped;     // Frames dropped because the TX buffer was full
+    uint32_t minFreeSpace;      // Lowest availableForWrite() seen after a write
+};
+
+// Per-message-type rate tracking
+struct RTCMMessageStats {
+    uint16_t type;              // RTCM message number (e.g. 1005, 1077)
+    uint32_t count;             // Total frames forwarded
+    uint32_t windowCount;       // Frames in current rate window
+    float rateHz;               // Rate over last window
+    uint32_t lastSeen;          // millis() of last frame
 };
 
 class RTCMProcessor
@@ -20,25 +55,72 @@ class RTCMProcessor
 public:
     static RTCMProcessor *instance;
 
+    // A source that has been silent this long loses arbitration
+    static constexpr uint32_t SOURCE_TIMEOUT_MS = 3000;
+    // Message rate window
+    static constexpr uint32_t RATE_WINDOW_MS = 5000;
+    // Distinct message types tracked
+    static constexpr size_t MAX_MESSAGE_TYPES = 16;
+    // Radio bytes moved per read burst
+    static constexpr size_t RADIO_CHUNK_SIZE = 128;
+
 private:
     RTCMProcessor();
     ~RTCMProcessor();
 
+    // One framer per source so partial frames never interleave
+    RTCMFramer framers[RTCM_SOURCE_COUNT];
+    RTCMSourceStats sourceStats[RTCM_SOURCE_COUNT];
+    uint32_t frameStartMicros[RTCM_SOURCE_COUNT];
+    RTCMTxStats txStats;
+
+    // Source arbitration
+    bool hasActiveSource;
+    RTCMSource activeSource;
+
+    // Message type statistics
+    RTCMMessageStats messageStats[MAX_MESSAGE_TYPES];
+    size_t messageTypeCount;
+    uint32_t lastRateUpdate;
+
+    // Time of last frame written to GPS1 (correction age)
+    uint32_t lastForwardTime;
+
+    // Feed raw bytes from a source through its framer
+    void feedSource(RTCMSource source, const uint8_t* data, size_t len);
+    void handleFrame(RTCMSource source);
+    bool forwardFrame(const uint8_t* frame, uint16_t len, uint16_t messageType);
+    void recordMessageType(uint16_t messageType);
+    void updateRates();
+
 public:
     // Get singleton instance
     static RTCMProcessor* getInstance() { return instance; }
-    
+
     // Process incoming RTCM data from network
     void processRTCM(const uint8_t* data, size_t len, const IPAddress& remoteIP, uint16_t remotePort);
-    
+
     // Process incoming RTCM data from radio
     void processRadioRTCM();
-    
+
+    // Process RTCM stream bytes from the NTRIP client
+    void processNTRIPRTCM(const uint8_t* data, size_t len);
+
     // Process all RTCM sources (called from main loop)
     void process();
 
+    // Statistics
+    const RTCMSourceStats& getSourceStats(RTCMSource source) const { return sourceStats[static_cast<size_t>(source)]; }
+    const RTCMTxStats& getTxStats() const { return txStats; }
+    const RTCMMessageStats* getMessageStats() const { return messageStats; }
+    size_t getMessageTypeCount() const { return messageTypeCount; }
+    bool getActiveSource(RTCMSource& source) const { source = activeSource; return hasActiveSource; }
+    uint32_t getCorrectionAge() const;  // ms since last forwarded frame, UINT32_MAX if none
+    static const char* sourceToString(RTCMSource source);
+    void printStatus();
+
     // Initialize the handler
     static void init();
 };
 
-#endif // RTCMProcessor_H_
\ No newline at end of file
+#endif // RTCMProcessor_H_
@@ -49,6 +49,14 @@ bool SimpleScheduler::addTask(uint8_t groupIndex, TaskFunction function, const c
     return true;
 }
 
+uint8_t SimpleScheduler::getTaskCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < NUM_GROUPS; i++) {
+        count += groups[i].taskCount;
+    }
+    return count;
+}
+
 void SimpleScheduler::run() {
     uint32_t now = millis();
     loopCount++;
@@ -10,7 +10,7 @@
 class SimpleScheduler {
 public:
     // Configuration constants
-    static constexpr uint8_t MAX_TASKS_PER_GROUP = 8;
+    static constexpr uint8_t MAX_TASKS_PER_GROUP = 20;
     static constexpr uint8_t NUM_GROUPS = 7;
 
     // Group indices for direct access
@@ -45,6 +45,7 @@ public:
     // Debug and statistics
     void printStatus();
     uint32_t getLoopCount() const { return loopCount; }
+    uint8_t getTaskCount() const;
 
 #ifdef SCHEDULER_TIMING_STATS
     struct TaskStats {
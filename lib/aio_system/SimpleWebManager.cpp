@@ -12,6 +12,8 @@
 #include "SimpleOTAHandler.h"
 #include "TelemetryWebSocket.h"
 #include "AutosteerProcessor.h"
+#include "WheelAngleFusion.h"
+#include "KickoutMonitor.h"
 #include "NAVProcessor.h"
 #include "GNSSProcessor.h"
 #include "web_pages/CommonStyles.h"  // Common CSS
@@ -27,10 +29,19 @@
 #include "web_pages/TouchFriendlyNetworkPage.h"  // Touch-friendly network settings
 #include "web_pages/TouchFriendlyAnalogWorkSwitchPage.h"  // Touch-friendly analog work switch
 #include "web_pages/TouchFriendlyCANConfigPage.h"  // Touch-friendly CAN configuration
+#include "web_pages/TouchFriendlyCANMonitorPage.h"  // Touch-friendly CAN bus monitor
 #include <ArduinoJson.h>
 #include <QNEthernet.h>
 #include "ESP32Interface.h"
 #include "UM98xManager.h"
+#include "RTCMProcessor.h"
+#include "NTRIPClient.h"
+#include "SerialManager.h"
+#include "QNEthernetUDPHandler.h"
+#include "CANManager.h"
+#include "CANCapture.h"
+#include "CANBus.h"
+#include "BootSequence.h"
 
 using namespace qindesign::network;
 
@@ -125,6 +136,10 @@ void SimpleWebManager::setupRoutes() {
     httpServer.on("/api/status", [this](EthernetClient& client, const String& method, const String& query) {
         handleApiStatus(client);
     });
+
+    httpServer.on("/api/boot", [this](EthernetClient& client, const String& method, const String& query) {
+        handleBootTimeline(client);
+    });
     
     // EventLogger page
     httpServer.on("/eventlogger", [this](EthernetClient& client, const String& method, const String& query) {
@@ -161,6 +176,11 @@ void SimpleWebManager::setupRoutes() {
         sendCANConfigPage(client);
     });
 
+    // CAN bus monitor page
+    httpServer.on("/can/monitor", [this](EthernetClient& client, const String& method, const String& query) {
+        sendCANMonitorPage(client);
+    });
+
     // WAS Demo page removed - using WebSocket telemetry instead
     
     // Language selection
@@ -233,6 +253,61 @@ void SimpleWebManager::setupRoutes() {
         handleCANConfig(client, method);
     });
 
+    // CAN bus diagnostics API
+    httpServer.on("/api/can/diagnostics", [this](EthernetClient& client, const String& method, const String& query) {
+        handleCANDiagnostics(client);
+    });
+
+    // CAN capture/replay API
+    httpServer.on("/api/can/capture", [this](EthernetClient& client, const String& method, const String& query) {
+        handleCANCapture(client, method);
+    });
+
+    httpServer.on("/api/can/capture/log", [this](EthernetClient& client, const String& method, const String& query) {
+        handleCANCaptureDownload(client, query, false);
+    });
+
+    httpServer.on("/api/can/capture/bin", [this](EthernetClient& client, const String& method, const String& query) {
+        handleCANCaptureDownload(client, query, true);
+    });
+
+    httpServer.on("/api/can/capture/upload", [this](EthernetClient& client, const String& method, const String& query) {
+        if (method == "POST") {
+            handleCANCaptureUpload(client);
+        } else {
+            SimpleHTTPServer::send(client, 405, "text/plain", "Method Not Allowed");
+        }
+    });
+
+    // RTCM correction status API
+    httpServer.on("/api/rtcm/status", [this](EthernetClient& client, const String& method, const String& query) {
+        handleRTCMStatus(client);
+    });
+
+    // NTRIP client API
+    httpServer.on("/api/ntrip/config", [this](EthernetClient& client, const String& method, const String& query) {
+        handleNTRIPConfig(client, method);
+    });
+
+    httpServer.on("/api/ntrip/status", [this](EthernetClient& client, const String& method, const String& query) {
+        handleNTRIPStatus(client);
+    });
+
+    // Steer controller (PID gains, loop rate) API
+    httpServer.on("/api/steer/controller", [this](EthernetClient& client, const String& method, const String& query) {
+        handleSteerController(client, method);
+    });
+
+    // Virtual WAS (fusion) geometry and sensor API
+    httpServer.on("/api/fusion/config", [this](EthernetClient& client, const String& method, const String& query) {
+        handleFusionConfig(client, method);
+    });
+
+    // Kickout debounce, hysteresis and latency API
+    httpServer.on("/api/kickout/config", [this](EthernetClient& client, const String& method, const String& query) {
+        handleKickoutConfig(client, method);
+    });
+
     // OTA upload endpoint
     httpServer.on("/api/ota/upload", [this](EthernetClient& client, const String& method, const String& query) {
         if (method == "POST") {
@@ -332,6 +407,11 @@ void SimpleWebManager::sendCANConfigPage(EthernetClient& client) {
     SimpleHTTPServer::sendP(client, 200, "text/html", TOUCH_FRIENDLY_CAN_CONFIG_PAGE);
 }
 
+void SimpleWebManager::sendCANMonitorPage(EthernetClient& client) {
+    extern const char TOUCH_FRIENDLY_CAN_MONITOR_PAGE[];
+    SimpleHTTPServer::sendP(client, 200, "text/html", TOUCH_FRIENDLY_CAN_MONITOR_PAGE);
+}
+
 // WAS Demo page removed - using WebSocket telemetry instead
 
 // API handlers
@@ -374,6 +454,31 @@ void SimpleWebManager::handleApiStatus(EthernetClient& client) {
     SimpleHTTPServer::sendJSON(client, json);
 }
 
+void SimpleWebManager::handleBootTimeline(EthernetClient& client) {
+    StaticJsonDocument<1536> doc;
+
+    doc["controlReadyUs"] = bootSequence.getControlReadyUs();
+    if (bootSequence.isComplete()) {
+        doc["completeUs"] = bootSequence.getCompleteUs();
+    } else {
+        doc["completeUs"] = nullptr;
+    }
+
+    JsonArray stages = doc.createNestedArray("stages");
+    for (uint8_t i = 0; i < bootSequence.getStageCount(); i++) {
+        const BootSequence::Stage& stage = bootSequence.getStage(i);
+        JsonObject obj = stages.createNestedObject();
+        obj["name"] = stage.name;
+        obj["startUs"] = stage.startUs;
+        obj["durationUs"] = stage.durationUs;
+        obj["background"] = stage.background;
+    }
+
+    String json;
+    serializeJson(doc, json);
+    SimpleHTTPServer::sendJSON(client, json);
+}
+
 void SimpleWebManager::handleEventLoggerConfig(EthernetClient& client, const String& method) {
     EventLogger* logger = EventLogger::getInstance();
     
@@ -527,13 +632,24 @@ void SimpleWebManager::handleNetworkConfig(EthernetClient& client, const String&
         // Return current IP as array
         IPAddress ip = Ethernet.localIP();
         
-        StaticJsonDocument<128> doc;
+        StaticJsonDocument<256> doc;
         JsonArray ipArray = doc.createNestedArray("ip");
         ipArray.add(ip[0]);
         ipArray.add(ip[1]);
         ipArray.add(ip[2]);
         ipArray.add(ip[3]);
         
+        // Unicast-to-AgIO state
+        doc["unicast"] = ConfigManager::getInstance()->getUDPUnicast();
+        doc["unicastActive"] = QNEthernetUDPHandler::isUnicastActive();
+        IPAddress agio;
+        if (QNEthernetUDPHandler::getAgIOAddress(agio)) {
+            char agioStr[16];
+            snprintf(agioStr, sizeof(agioStr), "%d.%d.%d.%d", agio[0], agio[1], agio[2], agio[3]);
+            doc["agio"] = agioStr;
+            doc["agioAge"] = QNEthernetUDPHandler::getAgIOAge();
+        }
+        
         String json;
         serializeJson(doc, json);
         SimpleHTTPServer::sendJSON(client, json);
@@ -551,6 +667,19 @@ void SimpleWebManager::handleNetworkConfig(EthernetClient& client, const String&
             return;
         }
         
+        // Unicast option applies immediately, no reboot needed
+        if (doc.containsKey("unicast")) {
+            ConfigManager* config = ConfigManager::getInstance();
+            config->setUDPUnicast(doc["unicast"].as<bool>());
+            config->saveNetworkConfig();
+            LOG_INFO(EventSource::NETWORK, "UDP unicast to AgIO %s",
+                     config->getUDPUnicast() ? "enabled" : "disabled");
+            if (!doc.containsKey("ip")) {
+                SimpleHTTPServer::sendJSON(client, "{\"status\":\"ok\"}");
+                return;
+            }
+        }
+        
         // Get IP array
         JsonArray ipArray = doc["ip"];
         if (ipArray.size() >= 3) {
@@ -637,6 +766,7 @@ void SimpleWebManager::handleDeviceSettings(EthernetClient& client, const String
         config->setJDPWMEnabled(jdPWMEnabled);
         config->setJDPWMSensitivity(jdPWMSensitivity);
         // Sensor fusion configuration not implemented yet
+        config->publishControlConfig();    // Brake mode is read by the motor driver every tick
         
         // Save to EEPROM
         config->saveTurnSensorConfig();  // This saves encoder type and JD PWM settings
@@ -1226,4 +1356,566 @@ void SimpleWebManager::handleCANConfig(EthernetClient& client, const String& met
     } else {
         SimpleHTTPServer::send(client, 405, "text/plain", "Method Not Allowed");
     }
-}
\ No newline at end of file
+}
+
+void SimpleWebManager::handleCANDiagnostics(EthernetClient& client) {
+    CANManager* can = CANManager::getInstance();
+    if (!can) {
+        SimpleHTTPServer::send(client, 503, "application/json", "{\"error\":\"CANManager not available\"}");
+        return;
+    }
+
+    StaticJsonDocument<4096> doc;
+
+    JsonArray buses = doc.createNestedArray("buses");
+    for (uint8_t busNum = 1; busNum <= 3; busNum++) {
+        const CANBusDiagnostics& d = can->getBusDiagnostics(busNum);
+        JsonObject obj = buses.createNestedObject();
+        obj["bus"] = busNum;
+        obj["speed"] = getCANSpeed(busNum);
+        obj["load"] = d.utilization;
+        obj["rxFrames"] = d.rxFrames;
+        obj["txFrames"] = d.txFrames;
+        obj["rxRate"] = d.rxRate;
+        obj["txRate"] = d.txRate;
+        obj["state"] = CANManager::faultStateToString(d.faultState);
+        obj["rec"] = d.rxErrorCounter;
+        obj["tec"] = d.txErrorCounter;
+        obj["errorEvents"] = d.errorEvents;
+        obj["busOff"] = d.busOffEvents;
+        obj["rxQueueHigh"] = d.rxQueueHighWater;
+        obj["rxQueueDropped"] = d.rxQueueDropped;
+        obj["txQueueHigh"] = d.txQueueHighWater;
+        const CANTxStats& tx = getCANBus(busNum)->getTxScheduler().getStats();
+        obj["steerSent"] = tx.steerSent;
+        obj["steerAborted"] = tx.steerAborted;
+        obj["steerLatencyMax"] = tx.steerLatencyMaxUs;
+        obj["txRetries"] = tx.retries;
+        obj["txDropped"] = tx.dropped;
+        obj["deadlineMisses"] = tx.deadlineMisses;
+        obj["monitored"] = d.monitored;
+        // Load, rxRate and the ID table only see frames the RX mailboxes accepted
+        obj["rxFiltered"] = getCANBus(busNum)->isRxFiltered();
+    }
+
+    JsonArray ids = doc.createNestedArray("ids");
+    const CANIdStats* stats = can->getIdStats();
+    uint32_t now = millis();
+    for (uint8_t i = 0; i < CANManager::MAX_TRACKED_IDS; i++) {
+        const CANIdStats& e = stats[i];
+        if (e.bus == 0) continue;
+
+        char data[17];
+        for (uint8_t b = 0; b < e.len; b++) {
+            snprintf(&data[b * 2], 3, "%02X", e.data[b]);
+        }
+        data[e.len * 2] = '\0';
+
+        JsonObject obj = ids.createNestedObject();
+        obj["bus"] = e.bus;
+        obj["id"] = e.id;
+        obj["ext"] = e.extended;
+        obj["count"] = e.count;
+        obj["rateHz"] = e.rateHz;
+        obj["intervalMs"] = e.intervalUs / 1000.0f;
+        obj["jitterMs"] = e.jitterUs / 1000.0f;
+        obj["data"] = data;
+        obj["age"] = now - e.lastSeen;
+    }
+
+    String json;
+    serializeJson(doc, json);
+    SimpleHTTPServer::sendJSON(client, json);
+}
+
+void SimpleWebManager::handleCANCapture(EthernetClient& client, const String& method) {
+    CANCapture* capture = CANCapture::getInstance();
+    if (!capture) {
+        SimpleHTTPServer::send(client, 503, "application/json", "{\"error\":\"CANCapture not available\"}");
+        return;
+    }
+
+    if (method == "POST") {
+        String body = readPostBody(client);
+
+        StaticJsonDocument<256> doc;
+        DeserializationError error = deserializeJson(doc, body);
+        if (error || !doc.containsKey("action")) {
+            SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Invalid JSON\"}");
+            return;
+        }
+
+        String action = doc["action"].as<String>();
+        if (action == "start") {
+            capture->start(doc["busMask"] | 0x07);
+        } else if (action == "stop") {
+            capture->stop();
+        } else if (action == "clear") {
+            capture->stop();
+            capture->clear();
+        } else if (action == "replay") {
+            if (!capture->startReplay(doc["loop"] | false)) {
+                SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Nothing to replay\"}");
+                return;
+            }
+        } else {
+            SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Unknown action\"}");
+            return;
+        }
+    }
+
+    StaticJsonDocument<256> doc;
+    doc["status"] = "ok";
+    doc["mode"] = CANCapture::modeToString(capture->getMode());
+    doc["records"] = capture->getCount();
+    doc["capacity"] = CANCapture::CAPACITY;
+    doc["overwritten"] = capture->getOverwritten();
+    doc["replayPosition"] = capture->getReplayPosition();
+    doc["replayInjected"] = capture->getReplayInjected();
+    doc["replayDropped"] = capture->getReplayDropped();
+
+    String json;
+    serializeJson(doc, json);
+    SimpleHTTPServer::sendJSON(client, json);
+}
+
+void SimpleWebManager::handleCANCaptureDownload(EthernetClient& client, const String& query, bool binary) {
+    CANCapture* capture = CANCapture::getInstance();
+    if (!capture) {
+        SimpleHTTPServer::send(client, 503, "text/plain", "CANCapture not available");
+        return;
+    }
+
+    // Streams straight from the capture ring
+    client.println("HTTP/1.1 200 OK");
+    client.println(binary ? "Content-Type: application/octet-stream" : "Content-Type: text/plain");
+    client.println(binary ? "Content-Disposition: attachment; filename=\"aio-can.bin\""
+                          : "Content-Disposition: attachment; filename=\"aio-can.log\"");
+    client.println("Connection: close");
+    client.println();
+
+    if (binary) {
+        capture->writeBinary(client);
+    } else {
+        capture->writeCandump(client, query.indexOf("rx=1") >= 0);
+    }
+    client.flush();
+}
+
+void SimpleWebManager::handleCANCaptureUpload(EthernetClient& client) {
+    CANCapture* capture = CANCapture::getInstance();
+    if (!capture) {
+        SimpleHTTPServer::send(client, 503, "application/json", "{\"error\":\"CANCapture not available\"}");
+        return;
+    }
+
+    if (capture->loadBinary(client)) {
+        String json = "{\"status\":\"ok\",\"records\":" + String(capture->getCount()) + "}";
+        SimpleHTTPServer::sendJSON(client, json);
+    } else {
+        SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Invalid capture file\"}");
+    }
+}
+
+void SimpleWebManager::handleRTCMStatus(EthernetClient& client) {
+    RTCMProcessor* rtcm = RTCMProcessor::getInstance();
+    if (!rtcm) {
+        SimpleHTTPServer::send(client, 503, "application/json", "{\"error\":\"RTCMProcessor not available\"}");
+        return;
+    }
+
+    StaticJsonDocument<2048> doc;
+
+    RTCMSource active;
+    doc["activeSource"] = rtcm->getActiveSource(active) ? RTCMProcessor::sourceToString(active) : "none";
+    uint32_t age = rtcm->getCorrectionAge();
+    if (age == UINT32_MAX) {
+        doc["correctionAge"] = nullptr;
+    } else {
+        doc["correctionAge"] = age;
+    }
+
+    JsonArray sources = doc.createNestedArray("sources");
+    for (size_t i = 0; i < RTCM_SOURCE_COUNT; i++) {
+        RTCMSource src = static_cast<RTCMSource>(i);
+        const RTCMSourceStats& s = rtcm->getSourceStats(src);
+        JsonObject obj = sources.createNestedObject();
+        obj["name"] = RTCMProcessor::sourceToString(src);
+        obj["bytesIn"] = s.bytesIn;
+        obj["framesValid"] = s.framesValid;
+        obj["framesForwarded"] = s.framesForwarded;
+        obj["framesBlocked"] = s.framesBlocked;
+        obj["crcErrors"] = s.crcErrors;
+        obj["bytesDiscarded"] = s.bytesDiscarded;
+        obj["latencyLastUs"] = s.latencyLastUs;
+        obj["latencyAvgUs"] = s.latencyCount ? s.latencySumUs / s.latencyCount : 0;
+        obj["latencyMaxUs"] = s.latencyMaxUs;
+    }
+
+    const RTCMTxStats& tx = rtcm->getTxStats();
+    JsonObject txObj = doc.createNestedObject("gps1Tx");
+    txObj["bytesWritten"] = tx.bytesWritten;
+    txObj["framesDropped"] = tx.framesDropped;
+    txObj["bufferSize"] = SerialManager::GPS1_TX_BUFFER_SIZE;
+    if (tx.minFreeSpace != UINT32_MAX) {
+        txObj["minFree"] = tx.minFreeSpace;
+    }
+
+    JsonArray messages = doc.createNestedArray("messages");
+    const RTCMMessageStats* stats = rtcm->getMessageStats();
+    for (size_t i = 0; i < rtcm->getMessageTypeCount(); i++) {
+        JsonObject obj = messages.createNestedObject();
+        obj["type"] = stats[i].type;
+        obj["count"] = stats[i].count;
+        obj["rateHz"] = stats[i].rateHz;
+        obj["age"] = millis() - stats[i].lastSeen;
+    }
+
+    String json;
+    serializeJson(doc, json);
+    SimpleHTTPServer::sendJSON(client, json);
+}
+
+void SimpleWebManager::handleNTRIPConfig(EthernetClient& client, const String& method) {
+    extern ConfigManager configManager;
+
+    if (method == "GET") {
+        const NTRIPConfig& config = configManager.getNTRIPConfig();
+
+        StaticJsonDocument<512> doc;
+        doc["enabled"] = config.enabled != 0;
+        doc["version"] = config.version;
+        doc["ggaUpload"] = config.ggaUpload != 0;
+        doc["ggaInterval"] = config.ggaIntervalSec;
+        doc["host"] = config.host;
+        doc["port"] = config.port;
+        doc["mountpoint"] = config.mountpoint;
+        doc["username"] = config.username;
+        doc["passwordSet"] = config.password[0] != '\0';  // Never send the password back
+
+        String json;
+        serializeJson(doc, json);
+        SimpleHTTPServer::sendJSON(client, json);
+
+    } else if (method == "POST") {
+        String body = readPostBody(client);
+
+        StaticJsonDocument<512> doc;
+        DeserializationError error = deserializeJson(doc, body);
+
+        if (error) {
+            LOG_ERROR(EventSource::NETWORK, "NTRIP config JSON parse error: %s", error.c_str());
+            SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Invalid JSON\"}");
+            return;
+        }
+
+        NTRIPConfig config = configManager.getNTRIPConfig();
+
+        if (doc.containsKey("enabled")) {
+            config.enabled = doc["enabled"] ? 1 : 0;
+        }
+        if (doc.containsKey("version")) {
+            uint8_t version = doc["version"];
+            config.version = (version == 1) ? 1 : 2;
+        }
+        if (doc.containsKey("ggaUpload")) {
+            config.ggaUpload = doc["ggaUpload"] ? 1 : 0;
+        }
+        if (doc.containsKey("ggaInterval")) {
+            config.ggaIntervalSec = constrain((int)doc["ggaInterval"], 1, 60);
+        }
+        if (doc.containsKey("host")) {
+            strlcpy(config.host, doc["host"] | "", sizeof(config.host));
+        }
+        if (doc.containsKey("port")) {
+            config.port = doc["port"];
+        }
+        if (doc.containsKey("mountpoint")) {
+            strlcpy(config.mountpoint, doc["mountpoint"] | "", sizeof(config.mountpoint));
+        }
+        if (doc.containsKey("username")) {
+            strlcpy(config.username, doc["username"] | "", sizeof(config.username));
+        }
+        if (doc.containsKey("password")) {
+            strlcpy(config.password, doc["password"] | "", sizeof(config.password));
+        }
+
+        configManager.setNTRIPConfig(config);
+        configManager.saveNTRIPConfig();
+
+        // Takes effect immediately - no restart needed
+        if (NTRIPClient::getInstance()) {
+            NTRIPClient::getInstance()->reconfigure(configManager.getNTRIPConfig());
+        }
+
+        SimpleHTTPServer::sendJSON(client, "{\"status\":\"ok\",\"message\":\"NTRIP configuration saved\"}");
+    } else {
+        SimpleHTTPServer::send(client, 405, "text/plain", "Method Not Allowed");
+    }
+}
+
+void SimpleWebManager::handleSteerController(EthernetClient& client, const String& method) {
+    extern ConfigManager configManager;
+
+    if (method == "GET") {
+        const SteerControllerConfig& config = configManager.getSteerControllerConfig();
+
+        StaticJsonDocument<512> doc;
+        doc["rateHz"] = config.rateHz;
+        doc["kp"] = configManager.getKp();   // From AgOpenGPS (PGN 252), read only here
+        doc["ki"] = config.ki;
+        doc["kd"] = config.kd;
+        doc["kff"] = config.kff;
+        doc["integralLimit"] = config.integralLimit;
+        doc["dFilterHz"] = config.dFilterHz;
+        doc["scheduleSpeedLow"] = config.scheduleSpeedLow;
+        doc["scheduleSpeedHigh"] = config.scheduleSpeedHigh;
+        doc["scaleLow"] = config.scaleLow;
+        doc["scaleHigh"] = config.scaleHigh;
+
+        AutosteerProcessor* autosteer = AutosteerProcessor::getInstance();
+        if (autosteer) {
+            const SteerController::Terms& terms = autosteer->getControllerTerms();
+            JsonObject live = doc.createNestedObject("live");
+            live["rateHz"] = autosteer->getControlRateHz();
+            live["error"] = terms.error;
+            live["p"] = terms.p;
+            live["i"] = terms.i;
+            live["d"] = terms.d;
+            live["ff"] = terms.ff;
+            live["output"] = terms.output;
+        }
+
+        String json;
+        serializeJson(doc, json);
+        SimpleHTTPServer::sendJSON(client, json);
+
+    } else if (method == "POST") {
+        String body = readPostBody(client);
+
+        StaticJsonDocument<512> doc;
+        DeserializationError error = deserializeJson(doc, body);
+
+        if (error) {
+            LOG_ERROR(EventSource::NETWORK, "Steer controller JSON parse error: %s", error.c_str());
+            SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Invalid JSON\"}");
+            return;
+        }
+
+        SteerControllerConfig config = configManager.getSteerControllerConfig();
+
+        if (doc.containsKey("rateHz")) config.rateHz = doc["rateHz"];
+        if (doc.containsKey("ki")) config.ki = doc["ki"];
+        if (doc.containsKey("kd")) config.kd = doc["kd"];
+        if (doc.containsKey("kff")) config.kff = doc["kff"];
+        if (doc.containsKey("integralLimit")) config.integralLimit = doc["integralLimit"];
+        if (doc.containsKey("dFilterHz")) config.dFilterHz = doc["dFilterHz"];
+        if (doc.containsKey("scheduleSpeedLow")) config.scheduleSpeedLow = doc["scheduleSpeedLow"];
+        if (doc.containsKey("scheduleSpeedHigh")) config.scheduleSpeedHigh = doc["scheduleSpeedHigh"];
+        if (doc.containsKey("scaleLow")) config.scaleLow = doc["scaleLow"];
+        if (doc.containsKey("scaleHigh")) config.scaleHigh = doc["scaleHigh"];
+
+        configManager.setSteerControllerConfig(config);    // Sanitizes rate and limits
+        configManager.saveSteerControllerConfig();
+        configManager.publishControlConfig();              // Picked up on the next tick
+
+        SimpleHTTPServer::sendJSON(client, "{\"status\":\"ok\",\"message\":\"Steer controller saved\"}");
+    } else {
+        SimpleHTTPServer::send(client, 405, "text/plain", "Method Not Allowed");
+    }
+}
+
+void SimpleWebManager::handleFusionConfig(EthernetClient& client, const String& method) {
+    extern ConfigManager configManager;
+
+    if (method == "GET") {
+        const FusionConfig& config = configManager.getFusionConfig();
+
+        StaticJsonDocument<1024> doc;
+        doc["wheelbase"] = config.wheelbase;
+        doc["encoderCountsPerDegree"] = config.encoderCountsPerDegree;
+        doc["maxSteeringAngle"] = config.maxSteeringAngle;
+        doc["minSpeed"] = config.minSpeed;
+        doc["useWAS"] = config.useWAS;
+        doc["useEncoder"] = config.useEncoder;
+        doc["useGNSSHeadingRate"] = config.useGNSSHeadingRate;
+        doc["useIMUYawRate"] = config.useIMUYawRate;
+        doc["wasNoise"] = config.wasNoise;
+        doc["encoderNoise"] = config.encoderNoise;
+        doc["gnssRateNoise"] = config.gnssRateNoise;
+        doc["imuRateNoise"] = config.imuRateNoise;
+        doc["wasLatencyMs"] = config.wasLatencyMs;
+        doc["encoderLatencyMs"] = config.encoderLatencyMs;
+        doc["gnssLatencyMs"] = config.gnssLatencyMs;
+        doc["imuLatencyMs"] = config.imuLatencyMs;
+
+        if (wheelAngleFusionPtr) {
+            const SteerAngleEKF& ekf = wheelAngleFusionPtr->getFilter();
+            JsonObject live = doc.createNestedObject("live");
+            live["angle"] = wheelAngleFusionPtr->getFusedAngle();
+            live["sigma"] = wheelAngleFusionPtr->getUncertainty();
+            live["rate"] = wheelAngleFusionPtr->getAngleRate();
+            live["encoderBias"] = ekf.getEncoderBias();
+            live["yawBias"] = ekf.getYawBias();
+            live["healthy"] = wheelAngleFusionPtr->isHealthy();
+            JsonArray sensors = live.createNestedArray("sensors");
+            for (uint8_t s = 0; s < SteerAngleEKF::SENSOR_COUNT; s++) {
+                const SteerAngleEKF::SensorStats& stats = ekf.getStats((SteerAngleEKF::Sensor)s);
+                JsonObject sensor = sensors.createNestedObject();
+                sensor["name"] = SteerAngleEKF::sensorName((SteerAngleEKF::Sensor)s);
+                sensor["accepted"] = stats.accepted;
+                sensor["rejected"] = stats.rejected;
+                sensor["innovationSd"] = sqrtf(stats.innovation.variance());
+            }
+        }
+
+        String json;
+        serializeJson(doc, json);
+        SimpleHTTPServer::sendJSON(client, json);
+
+    } else if (method == "POST") {
+        String body = readPostBody(client);
+
+        StaticJsonDocument<768> doc;
+        DeserializationError error = deserializeJson(doc, body);
+
+        if (error) {
+            LOG_ERROR(EventSource::NETWORK, "Fusion config JSON parse error: %s", error.c_str());
+            SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Invalid JSON\"}");
+            return;
+        }
+
+        FusionConfig config = configManager.getFusionConfig();
+
+        if (doc.containsKey("wheelbase")) config.wheelbase = doc["wheelbase"];
+        if (doc.containsKey("encoderCountsPerDegree")) config.encoderCountsPerDegree = doc["encoderCountsPerDegree"];
+        if (doc.containsKey("maxSteeringAngle")) config.maxSteeringAngle = doc["maxSteeringAngle"];
+        if (doc.containsKey("minSpeed")) config.minSpeed = doc["minSpeed"];
+        if (doc.containsKey("useWAS")) config.useWAS = doc["useWAS"];
+        if (doc.containsKey("useEncoder")) config.useEncoder = doc["useEncoder"];
+        if (doc.containsKey("useGNSSHeadingRate")) config.useGNSSHeadingRate = doc["useGNSSHeadingRate"];
+        if (doc.containsKey("useIMUYawRate")) config.useIMUYawRate = doc["useIMUYawRate"];
+        if (doc.containsKey("wasNoise")) config.wasNoise = doc["wasNoise"];
+        if (doc.containsKey("encoderNoise")) config.encoderNoise = doc["encoderNoise"];
+        if (doc.containsKey("gnssRateNoise")) config.gnssRateNoise = doc["gnssRateNoise"];
+        if (doc.containsKey("imuRateNoise")) config.imuRateNoise = doc["imuRateNoise"];
+        if (doc.containsKey("wasLatencyMs")) config.wasLatencyMs = doc["wasLatencyMs"];
+        if (doc.containsKey("encoderLatencyMs")) config.encoderLatencyMs = doc["encoderLatencyMs"];
+        if (doc.containsKey("gnssLatencyMs")) config.gnssLatencyMs = doc["gnssLatencyMs"];
+        if (doc.containsKey("imuLatencyMs")) config.imuLatencyMs = doc["imuLatencyMs"];
+
+        configManager.setFusionConfig(config);    // Sanitizes ranges
+        configManager.saveFusionConfig();
+
+        // Takes effect immediately - no restart needed
+        if (wheelAngleFusionPtr) {
+            wheelAngleFusionPtr->setConfig(configManager.getFusionConfig());
+        }
+
+        SimpleHTTPServer::sendJSON(client, "{\"status\":\"ok\",\"message\":\"Fusion configuration saved\"}");
+    } else {
+        SimpleHTTPServer::send(client, 405, "text/plain", "Method Not Allowed");
+    }
+}
+
+void SimpleWebManager::handleKickoutConfig(EthernetClient& client, const String& method) {
+    extern ConfigManager configManager;
+
+    if (method == "GET") {
+        const KickoutConfig& config = configManager.getKickoutConfig();
+
+        StaticJsonDocument<768> doc;
+        doc["encoderDebounceMs"] = config.encoderDebounceMs;
+        doc["pressureDebounceMs"] = config.pressureDebounceMs;
+        doc["currentDebounceMs"] = config.currentDebounceMs;
+        doc["hysteresisPercent"] = config.hysteresisPercent;
+        doc["pressureRiseRate"] = config.pressureRiseRate;
+        doc["currentRiseRate"] = config.currentRiseRate;
+        doc["riseWindowMs"] = config.riseWindowMs;
+
+        KickoutMonitor* monitor = KickoutMonitor::getInstance();
+        const KickoutMonitor::Latency& latency = monitor->getLatency();
+        JsonObject live = doc.createNestedObject("live");
+        live["active"] = monitor->hasKickout();
+        live["reason"] = monitor->getReasonString();
+        live["kickouts"] = latency.count;
+        live["grabToTripUs"] = latency.grabToTripUs;
+        live["tripToReleaseUs"] = latency.tripToReleaseUs;
+        live["grabToReleaseUs"] = latency.grabToReleaseUs;
+        live["maxGrabToReleaseUs"] = latency.maxGrabToReleaseUs;
+
+        String json;
+        serializeJson(doc, json);
+        SimpleHTTPServer::sendJSON(client, json);
+
+    } else if (method == "POST") {
+        String body = readPostBody(client);
+
+        StaticJsonDocument<384> doc;
+        DeserializationError error = deserializeJson(doc, body);
+
+        if (error) {
+            LOG_ERROR(EventSource::NETWORK, "Kickout config JSON parse error: %s", error.c_str());
+            SimpleHTTPServer::sendJSON(client, "{\"status\":\"error\",\"message\":\"Invalid JSON\"}");
+            return;
+        }
+
+        KickoutConfig config = configManager.getKickoutConfig();
+
+        if (doc.containsKey("encoderDebounceMs")) config.encoderDebounceMs = doc["encoderDebounceMs"];
+        if (doc.containsKey("pressureDebounceMs")) config.pressureDebounceMs = doc["pressureDebounceMs"];
+        if (doc.containsKey("currentDebounceMs")) config.currentDebounceMs = doc["currentDebounceMs"];
+        if (doc.containsKey("hysteresisPercent")) config.hysteresisPercent = doc["hysteresisPercent"];
+        if (doc.containsKey("pressureRiseRate")) config.pressureRiseRate = doc["pressureRiseRate"];
+        if (doc.containsKey("currentRiseRate")) config.currentRiseRate = doc["currentRiseRate"];
+        if (doc.containsKey("riseWindowMs")) config.riseWindowMs = doc["riseWindowMs"];
+
+        configManager.setKickoutConfig(config);    // Sanitizes ranges
+        configManager.saveKickoutConfig();
+
+        // Takes effect immediately - no restart needed
+        KickoutMonitor::getInstance()->applyConfig();
+
+        SimpleHTTPServer::sendJSON(client, "{\"status\":\"ok\",\"message\":\"Kickout configuration saved\"}");
+    } else {
+        SimpleHTTPServer::send(client, 405, "text/plain", "Method Not Allowed");
+    }
+}
+
+void SimpleWebManager::handleNTRIPStatus(EthernetClient& client) {
+    NTRIPClient* ntrip = NTRIPClient::getInstance();
+    if (!ntrip) {
+        SimpleHTTPServer::send(client, 503, "application/json", "{\"error\":\"NTRIPClient not available\"}");
+        return;
+    }
+
+    const NTRIPClient::Stats& stats = ntrip->getStats();
+
+    StaticJsonDocument<512> doc;
+    doc["state"] = NTRIPClient::stateToString(ntrip->getState());
+    doc["lastError"] = ntrip->getLastError();
+    doc["byteRate"] = stats.byteRate;
+    doc["bytesReceived"] = stats.bytesReceived;
+    doc["totalBytes"] = stats.totalBytes;
+    doc["connectAttempts"] = stats.connectAttempts;
+    doc["reconnects"] = stats.reconnects;
+    doc["ggaSent"] = stats.ggaSent;
+    if (ntrip->isStreaming()) {
+        doc["connectedFor"] = (millis() - stats.connectedSince) / 1000;
+    }
+
+    // Correction age as seen by the RTCM router for this source
+    RTCMProcessor* rtcm = RTCMProcessor::getInstance();
+    if (rtcm) {
+        const RTCMSourceStats& src = rtcm->getSourceStats(RTCMSource::NTRIP);
+        doc["framesValid"] = src.framesValid;
+        doc["crcErrors"] = src.crcErrors;
+        if (src.lastFrameTime != 0) {
+            doc["correctionAge"] = millis() - src.lastFrameTime;
+        }
+    }
+
+    String json;
+    serializeJson(doc, json);
+    SimpleHTTPServer::sendJSON(client, json);
+}
@@ -61,9 +61,11 @@ private:
     void sendDeviceSettingsPage(EthernetClient& client);
     void sendAnalogWorkSwitchPage(EthernetClient& client);
     void sendCANConfigPage(EthernetClient& client);
+    void sendCANMonitorPage(EthernetClient& client);
     
     // API handlers
     void handleApiStatus(EthernetClient& client);
+    void handleBootTimeline(EthernetClient& client);
     void handleApiRestart(EthernetClient& client);
     void handleEventLoggerConfig(EthernetClient& client, const String& method);
     void handleLogViewerData(EthernetClient& client);
@@ -74,6 +76,16 @@ private:
     void handleAnalogWorkSwitchSetpoint(EthernetClient& client);
     void handleOTAUpload(EthernetClient& client);
     void handleCANConfig(EthernetClient& client, const String& method);
+    void handleCANDiagnostics(EthernetClient& client);
+    void handleCANCapture(EthernetClient& client, const String& method);
+    void handleCANCaptureDownload(EthernetClient& client, const String& query, bool binary);
+    void handleCANCaptureUpload(EthernetClient& client);
+    void handleRTCMStatus(EthernetClient& client);
+    void handleNTRIPConfig(EthernetClient& client, const String& method);
+    void handleNTRIPStatus(EthernetClient& client);
+    void handleSteerController(EthernetClient& client, const String& method);
+    void handleFusionConfig(EthernetClient& client, const String& method);
+    void handleKickoutConfig(EthernetClient& client, const String& method);
     
     // UM98x GPS configuration handlers
     void sendUM98xConfigPage(EthernetClient& client);
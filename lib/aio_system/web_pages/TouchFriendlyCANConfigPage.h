@@ -48,7 +48,7 @@ const char TOUCH_FRIENDLY_CAN_CONFIG_PAGE[] PROGMEM = R"rawliteral(
 
         .nav-buttons {
             display: grid;
-            grid-template-columns: 1fr 1fr 1fr;
+            grid-template-columns: 1fr 1fr 1fr 1fr;
             gap: 15px;
             margin-bottom: 20px;
         }
@@ -142,6 +142,10 @@ const char TOUCH_FRIENDLY_CAN_CONFIG_PAGE[] PROGMEM = R"rawliteral(
                     onclick="window.location.href='/'">
                 Home
             </button>
+            <button type="button" class="touch-button" style="background: #3498db;"
+                    onclick="window.location.href='/can/monitor'">
+                Monitor
+            </button>
             <button type="button" class="touch-button" style="background: #e74c3c;"
                     onclick="confirmRestart()">
                 Restart
@@ -0,0 +1,200 @@
+// TouchFriendlyCANMonitorPage.h
+// Live CAN bus load, error and per-ID statistics for touch-friendly interface
+
+#ifndef TOUCH_FRIENDLY_CAN_MONITOR_PAGE_H
+#define TOUCH_FRIENDLY_CAN_MONITOR_PAGE_H
+
+#include <Arduino.h>
+
+const char TOUCH_FRIENDLY_CAN_MONITOR_PAGE[] PROGMEM = R"rawliteral(
+<!DOCTYPE html>
+<html>
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0, maximum-scale=1.0, user-scalable=no">
+    <meta name="apple-mobile-web-app-capable" content="yes">
+    <title>CAN Monitor</title>
+    <link rel="stylesheet" href="/touch.css">
+    <style>
+        .nav-buttons {
+            display: grid;
+            grid-template-columns: 1fr 1fr;
+            gap: 15px;
+            margin-bottom: 20px;
+        }
+
+        .bus-grid {
+            display: grid;
+            gap: 15px;
+            margin-bottom: 20px;
+        }
+
+        .bus-card {
+            padding: 15px;
+            background-color: #2c2c2c;
+            border-radius: 10px;
+            color: white;
+        }
+
+        .bus-card h3 {
+            margin: 0 0 10px 0;
+            color: white;
+        }
+
+        .bus-stats {
+            display: grid;
+            grid-template-columns: repeat(auto-fit, minmax(140px, 1fr));
+            gap: 8px;
+            font-size: 15px;
+        }
+
+        .load-bar {
+            height: 14px;
+            background-color: #444;
+            border-radius: 7px;
+            overflow: hidden;
+            margin-bottom: 10px;
+        }
+
+        .load-fill {
+            height: 100%;
+            width: 0%;
+            background-color: #4CAF50;
+        }
+
+        .state-ok { color: #4CAF50; font-weight: bold; }
+        .state-warn { color: #ff9800; font-weight: bold; }
+        .state-bad { color: #f44336; font-weight: bold; }
+
+        table {
+            width: 100%;
+            border-collapse: collapse;
+            background-color: #2c2c2c;
+            border-radius: 10px;
+            color: white;
+            font-size: 14px;
+        }
+
+        th, td {
+            padding: 8px;
+            text-align: right;
+            border-bottom: 1px solid #444;
+        }
+
+        th:first-child, td:first-child,
+        th:nth-child(2), td:nth-child(2),
+        td.payload {
+            text-align: left;
+        }
+
+        td.payload {
+            font-family: monospace;
+        }
+
+        .note {
+            margin-top: 15px;
+            color: #aaa;
+            font-size: 13px;
+        }
+    </style>
+</head>
+<body>
+    <div class="container">
+        <h1>CAN Monitor</h1>
+
+        <div class="nav-buttons">
+            <button type="button" class="touch-button" style="background: #7f8c8d;"
+                    onclick="window.location.href='/'">
+                Home
+            </button>
+            <button type="button" class="touch-button"
+                    onclick="window.location.href='/can'">
+                CAN Config
+            </button>
+        </div>
+
+        <div id="buses" class="bus-grid"></div>
+
+        <table>
+            <thead>
+                <tr><th>Bus</th><th>ID</th><th>Rate</th><th>Interval</th><th>Jitter</th><th>Age</th><th style="text-align:left">Last data</th></tr>
+            </thead>
+            <tbody id="ids"></tbody>
+        </table>
+
+        <p class="note">Counts cover frames this module reads or sends. On buses marked
+        "RX after filters" the hardware acceptance filters drop other IDs before they are
+        seen, so load, RX rate and the ID table understate the real bus traffic. Load
+        assumes worst-case bit stuffing; TX counts only frames the scheduler accepted.</p>
+    </div>
+
+    <script>
+        function stateClass(bus) {
+            if (bus.state === 'bus off' || bus.busOff > 0) return 'state-bad';
+            if (bus.state === 'error passive' || bus.rxQueueDropped > 0) return 'state-warn';
+            return 'state-ok';
+        }
+
+        function renderBuses(buses) {
+            let html = '';
+            buses.forEach(b => {
+                const load = Math.min(b.load, 100);
+                const color = load > 70 ? '#f44336' : (load > 40 ? '#ff9800' : '#4CAF50');
+                html += '<div class="bus-card">' +
+                    '<h3>CAN' + b.bus + ' <small>' + (b.speed / 1000) + ' kbps' +
+                    (b.monitored ? ' &bull; monitor' : '') +
+                    (b.rxFiltered ? ' &bull; RX after filters' : '') + '</small></h3>' +
+                    '<div class="load-bar"><div class="load-fill" style="width:' + load +
+                    '%;background-color:' + color + '"></div></div>' +
+                    '<div class="bus-stats">' +
+                    '<div>Load' + (b.rxFiltered ? ' (seen)' : '') + ': <b>' + b.load.toFixed(1) + '%</b></div>' +
+                    '<div>RX' + (b.rxFiltered ? ' (accepted)' : '') + ': ' + b.rxRate.toFixed(0) + '/s</div>' +
+                    '<div>TX: ' + b.txRate.toFixed(0) + '/s</div>' +
+                    '<div>State: <span class="' + stateClass(b) + '">' + b.state + '</span></div>' +
+                    '<div>REC/TEC: ' + b.rec + '/' + b.tec + '</div>' +
+                    '<div>Errors: ' + b.errorEvents + '</div>' +
+                    '<div>Bus off: ' + b.busOff + '</div>' +
+                    '<div>RX queue: ' + b.rxQueueHigh + ' (drop ' + b.rxQueueDropped + ')</div>' +
+                    '<div>TX queue: ' + b.txQueueHigh + ' (drop ' + b.txDropped + ')</div>' +
+                    '<div>Steer TX: ' + b.steerSent + ' (abort ' + b.steerAborted + ')</div>' +
+                    '<div>Steer latency: ' + b.steerLatencyMax + ' us</div>' +
+                    '<div>Deadline miss: ' + b.deadlineMisses + '</div>' +
+                    '</div></div>';
+            });
+            document.getElementById('buses').innerHTML = html;
+        }
+
+        function renderIds(ids) {
+            ids.sort((a, b) => b.rateHz - a.rateHz);
+            let html = '';
+            ids.forEach(e => {
+                const id = e.id.toString(16).toUpperCase().padStart(e.ext ? 8 : 3, '0');
+                html += '<tr><td>CAN' + e.bus + '</td><td>' + id + '</td>' +
+                    '<td>' + e.rateHz.toFixed(1) + ' Hz</td>' +
+                    '<td>' + e.intervalMs.toFixed(1) + ' ms</td>' +
+                    '<td>' + e.jitterMs.toFixed(2) + ' ms</td>' +
+                    '<td>' + (e.age > 2000 ? (e.age / 1000).toFixed(0) + ' s' : e.age + ' ms') + '</td>' +
+                    '<td class="payload">' + e.data.replace(/(..)/g, '$1 ') + '</td></tr>';
+            });
+            document.getElementById('ids').innerHTML = html;
+        }
+
+        async function refresh() {
+            try {
+                const response = await fetch('/api/can/diagnostics');
+                const data = await response.json();
+                renderBuses(data.buses);
+                renderIds(data.ids);
+            } catch (e) {
+                console.error('CAN diagnostics fetch failed', e);
+            }
+        }
+
+        refresh();
+        setInterval(refresh, 1000);
+    </script>
+</body>
+</html>
+)rawliteral";
+
+#endif // TOUCH_FRIENDLY_CAN_MONITOR_PAGE_H
@@ -79,6 +79,7 @@ const char TOUCH_FRIENDLY_HOME_PAGE[] PROGMEM = R"rawliteral(
         <div class="info">
             <p>Firmware: <span id="firmwareVersion">Loading...</span></p>
             <p>WebSocket: <span id="wsStatus">Disconnected</span> | <span id="telemetryRate">0</span> Hz</p>
+            <p>Boot: steer ready <span id="bootControl">-</span> ms | complete <span id="bootComplete">-</span> ms</p>
         </div>
     </div>
     
@@ -163,6 +164,17 @@ const char TOUCH_FRIENDLY_HOME_PAGE[] PROGMEM = R"rawliteral(
                 document.getElementById('firmwareVersion').textContent = 'Unknown';
             });
         
+        // Fetch boot timeline (background steps may still be running)
+        fetch('/api/boot')
+            .then(response => response.json())
+            .then(data => {
+                document.getElementById('bootControl').textContent = (data.controlReadyUs / 1000).toFixed(0);
+                if (data.completeUs !== null) {
+                    document.getElementById('bootComplete').textContent = (data.completeUs / 1000).toFixed(0);
+                }
+            })
+            .catch(err => {});
+        
         // Prevent zoom on double tap
         document.addEventListener('touchstart', function(event) {
             if (event.touches.length > 1) {
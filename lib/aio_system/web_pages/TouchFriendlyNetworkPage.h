@@ -195,6 +195,26 @@ const char TOUCH_FRIENDLY_NETWORK_PAGE[] PROGMEM = R"rawliteral(
             }
         }
         
+        function saveUnicast() {
+            const enabled = document.getElementById('unicast').checked;
+            fetch('/api/network/config', {
+                method: 'POST',
+                headers: {
+                    'Content-Type': 'application/json',
+                },
+                body: JSON.stringify({ unicast: enabled })
+            })
+            .then(response => response.json())
+            .then(data => {
+                document.getElementById('status').innerHTML = data.status === 'ok' ?
+                    '<div class="status success">Unicast ' + (enabled ? 'enabled' : 'disabled') + '</div>' :
+                    '<div class="status error">Error saving settings</div>';
+                setTimeout(() => {
+                    document.getElementById('status').innerHTML = '';
+                }, 3000);
+            });
+        }
+        
         function loadSettings() {
             // Load IP configuration
             fetch('/api/network/config')
@@ -205,6 +225,9 @@ const char TOUCH_FRIENDLY_NETWORK_PAGE[] PROGMEM = R"rawliteral(
                     document.getElementById('octet2').value = data.ip[1];
                     document.getElementById('octet3').value = data.ip[2];
                 }
+                document.getElementById('unicast').checked = !!data.unicast;
+                document.getElementById('agioTarget').textContent = data.agio ?
+                    data.agio + (data.unicastActive ? ' (unicast)' : ' (broadcast)') : 'Not seen';
             })
             .catch((error) => {
                 console.error('Error loading settings:', error);
@@ -275,6 +298,26 @@ const char TOUCH_FRIENDLY_NETWORK_PAGE[] PROGMEM = R"rawliteral(
             </form>
         </div>
         
+        <div class="card">
+            <div class="toggle-container">
+                <div class="toggle-info">
+                    <label for="unicast" class="toggle-label">Unicast to AgIO</label>
+                    <div class="help-text">
+                        Send PGN 253, PANDA and other streams only to the AgIO that talks to this module.
+                        Hello/scan replies stay broadcast. Falls back to broadcast if AgIO goes quiet.
+                    </div>
+                </div>
+                <label class="toggle-switch">
+                    <input type="checkbox" id="unicast" onchange="saveUnicast()">
+                    <span class="toggle-slider"></span>
+                </label>
+            </div>
+            <div class="status-row">
+                <span>AgIO</span>
+                <span id="agioTarget">--</span>
+            </div>
+        </div>
+        
         <div class="help-box">
             <p><strong>Note:</strong> After saving, you must reboot for the new IP to take effect.</p>
             <p>The network will be briefly unavailable during reboot.</p>
@@ -12,11 +12,14 @@
 #include "NAVProcessor.h"
 #include "I2CManager.h"
 #include "CANManager.h"
+#include "DeviceDetector.h"
 #include "ADProcessor.h"
 #include "PWMProcessor.h"
 #include "MotorDriverInterface.h"
 #include "MotorDriverManager.h"
 #include "CANGlobals.h"
+#include "J1939Stack.h"
+#include "VTClient.h"
 #include "AutosteerProcessor.h"
 #include "EncoderProcessor.h"
 #include "KeyaCANDriver.h"
@@ -28,10 +31,19 @@
 #include "CommandHandler.h"
 #include "PGNProcessor.h"
 #include "RTCMProcessor.h"
+#include "NTRIPClient.h"
 #include "SimpleWebManager.h"
 #include "Version.h"
 #include "ESP32Interface.h"
 #include "SimpleScheduler/SimpleScheduler.h"
+#include "BootSequence.h"
+
+// Wait this long for a USB serial monitor before booting (add
+// -D BOOT_MONITOR_WAIT_MS=5000 to build_flags to catch the first messages).
+// Zero in the field so a brown-out reset gets steering back quickly.
+#ifndef BOOT_MONITOR_WAIT_MS
+#define BOOT_MONITOR_WAIT_MS 0
+#endif
 
 // Flash ID for OTA verification - must match FLASH_ID in FlashTxx.h
 const char* flash_id = "fw_teensy41";
@@ -152,6 +164,14 @@ void toggleProcessTiming() {
 // SimpleScheduler Task Wrapper Functions
 // ============================================
 
+// Register a task; a full group drops it, so say which one
+void addSchedulerTask(uint8_t group, SimpleScheduler::TaskFunction function, const char* name) {
+  if (!scheduler.addTask(group, function, name)) {
+    LOG_ERROR(EventSource::SYSTEM, "Scheduler group %d full (%d tasks) - '%s' not registered",
+              group, SimpleScheduler::MAX_TASKS_PER_GROUP, name);
+  }
+}
+
 // Every Loop Tasks (no timing check)
 void taskEthernetLoop() {
   Ethernet.loop();  // REQUIRED for QNEthernet!
@@ -179,11 +199,14 @@ void taskGPS2Serial() {
   }
 }
 
-// 100Hz Tasks (10ms)
+// Autosteer runs every loop and paces itself on micros() at the configured
+// control rate (100/200/500Hz); motor commands still go out at 50Hz
 void taskAutosteer() {
-  AutosteerProcessor::getInstance()->process();
+  AutosteerProcessor::getInstance()->poll();
 }
 
+// 100Hz Tasks (10ms)
+
 void taskWebHandleClient() {
   webManager.handleClient();
 }
@@ -192,13 +215,6 @@ void taskWebBroadcastTelemetry() {
   webManager.broadcastTelemetry();
 }
 
-// 50Hz Tasks (20ms)
-void taskMotorDriver() {
-  if (motorPTR) {
-    motorPTR->process();
-  }
-}
-
 // 10Hz Tasks (100ms)
 void taskLEDUpdate() {
   ledManagerFSM.updateAll();
@@ -222,10 +238,49 @@ void taskKickoutSendPGN250() {
 // 0.2Hz Tasks (5000ms)
 // Reserved for very slow status checks
 
+// Background boot steps (run by BootSequence after setup(), see below)
+bool bootStepWebServer() {
+  if (webManager.begin()) {
+    LOG_INFO(EventSource::SYSTEM, "WebManager initialized");
+  } else {
+    LOG_ERROR(EventSource::SYSTEM, "WebManager FAILED");
+  }
+
+  // Mark web manager as ready for SSE updates
+  webManager.setSystemReady(true);
+  return true;
+}
+
+bool bootStepBuzzer() {
+  return hardwareManager.updateBuzzerTest();
+}
+
+bool bootStepEthernetLink() {
+  if (!Ethernet.linkState()) {
+    return false;
+  }
+
+  // Display access information
+  IPAddress localIP = Ethernet.localIP();
+  Serial.println("\r\n");
+  Serial.println("========================================");
+  Serial.println("=== AiO New Dawn - System Ready ===");
+  Serial.println("========================================");
+  Serial.printf("IP Address: %d.%d.%d.%d\r\n", localIP[0], localIP[1], localIP[2], localIP[3]);
+  Serial.printf("Web Interface: http://%d.%d.%d.%d\r\n", localIP[0], localIP[1], localIP[2], localIP[3]);
+  Serial.println("DHCP Server: Enabled");
+  Serial.println("========================================");
+  Serial.println();
+
+  LOG_INFO(EventSource::SYSTEM, "=== System Ready ===");
+  return true;
+}
+
 void setup()
 {
-  delay(5000); // delay for time to start monitor
   Serial.begin(115200);
+  while (!Serial && millis() < BOOT_MONITOR_WAIT_MS) {
+  }
 
   Serial.print("\r\n\n=== Teensy 4.1 AiO-NG-v6 New Dawn v");
   Serial.print(FIRMWARE_VERSION);
@@ -233,61 +288,25 @@ void setup()
   Serial.print("Initializing subsystems...");
 
   // Initialize ConfigManager FIRST - it has no dependencies
+  bootSequence.beginStage("Config");
   configManager.init();
   Serial.print("\r\n- ConfigManager initialized\r\n");
 
   // Initialize EventLogger SECOND - so all subsequent messages are formatted
   EventLogger::init();
   Serial.print("\r\n- EventLogger initialized (startup mode)\r\n");
-  delay(10);  // Small delay to ensure EventLogger is fully initialized
 
   // Initialize PGNProcessor (needed by QNetworkBase)
   PGNProcessor::init();
   LOG_INFO(EventSource::SYSTEM, "PGNProcessor initialized");
 
-  // Network and communication setup
+  // Start Ethernet early so link negotiation (a few seconds) overlaps the
+  // rest of boot; nothing below waits for it
+  bootSequence.beginStage("Network start");
   QNetworkBase::init();
   
-  // Wait for network speed to stabilize (some switches negotiate in steps)
-  LOG_INFO(EventSource::NETWORK, "Waiting for network speed negotiation...");
-  uint32_t startWait = millis();
-  int lastSpeed = 0;
-  
-  // Wait up to 10 seconds for link speed to stabilize
-  while (millis() - startWait < 10000) {
-    int currentSpeed = Ethernet.linkSpeed();
-    if (currentSpeed != lastSpeed) {
-      LOG_INFO(EventSource::NETWORK, "Link speed changed: %d Mbps", currentSpeed);
-      lastSpeed = currentSpeed;
-      startWait = millis(); // Reset timer on speed change
-    }
-    
-    // If we've been stable at 100Mbps for 2 seconds, we're good
-    if (currentSpeed == 100 && millis() - startWait > 2000) {
-      LOG_INFO(EventSource::NETWORK, "Link stable at 100 Mbps");
-      break;
-    }
-    
-    delay(100);
-  }
-  
-  // Additional delay for network stack to stabilize
-  LOG_INFO(EventSource::NETWORK, "Waiting for network stack to stabilize...");
-  delay(2000);
-  
-  // Verify we have an IP address
-  IPAddress localIP = Ethernet.localIP();
-  if (localIP == IPAddress(0, 0, 0, 0)) {
-    LOG_ERROR(EventSource::NETWORK, "No IP address assigned!");
-  } else {
-    LOG_INFO(EventSource::NETWORK, "IP ready: %d.%d.%d.%d", localIP[0], localIP[1], localIP[2], localIP[3]);
-    LOG_INFO(EventSource::NETWORK, "Final link speed: %d Mbps", Ethernet.linkSpeed());
-  }
-  
-  // Network stack is ready but don't initialize AsyncUDP yet
-  LOG_INFO(EventSource::NETWORK, "Network stack initialized");
-  
   // Set CAN bus speeds based on configuration
+  bootSequence.beginStage("CAN");
   CANSteerConfig canConfig = configManager.getCANSteerConfig();
   setCAN1Speed(canConfig.can1Speed == 1 ? 500000 : 250000);
   setCAN2Speed(canConfig.can2Speed == 1 ? 500000 : 250000);
@@ -297,6 +316,7 @@ void setup()
   initializeGlobalCANBuses();
   
   // Initialize RTCMProcessor
+  bootSequence.beginStage("Hardware");
   RTCMProcessor::init();
   LOG_INFO(EventSource::SYSTEM, "RTCMProcessor initialized");
 
@@ -305,8 +325,8 @@ void setup()
   {
     LOG_INFO(EventSource::SYSTEM, "HardwareManager initialized");
     
-    // Quick buzzer beep to indicate hardware is ready
-    hardwareManager.performBuzzerTest();
+    // Buzzer beep to indicate hardware is ready, finished in the background
+    hardwareManager.startBuzzerTest();
   }
   else
   {
@@ -323,6 +343,10 @@ void setup()
     LOG_ERROR(EventSource::SYSTEM, "CANManager FAILED");
   }
 
+  // J1939 address claim, transport and VT client on the ISO_Bus (idle if none is configured)
+  J1939Stack::init();
+  VTClient::init();
+
   // Initialize SerialManager
   if (serialManager.initializeSerial())
   {
@@ -343,9 +367,6 @@ void setup()
     LOG_ERROR(EventSource::SYSTEM, "GNSSProcessor FAILED");
   }
 
-  // Add a delay before I2C to let network/interrupts stabilize
-  delay(100);
-  
   // Initialize I2CManager later in sequence after critical systems
   if (i2cManager.initializeI2C())
   {
@@ -367,18 +388,8 @@ void setup()
     LOG_ERROR(EventSource::SYSTEM, "LEDManagerFSM FAILED");
   }
 
-  // Initialize IMUProcessor
-  if (imuProcessor.initialize())
-  {
-    LOG_INFO(EventSource::SYSTEM, "IMUProcessor initialized");
-    imuProcessor.registerPGNCallbacks();
-  }
-  else
-  {
-    LOG_ERROR(EventSource::SYSTEM, "IMUProcessor FAILED");
-  }
-
   // Initialize ADProcessor
+  bootSequence.beginStage("Sensors");
   // Set the instance pointer so getInstance() returns the correct object
   ADProcessor::instance = &adProcessor;
   if (adProcessor.init())
@@ -390,7 +401,28 @@ void setup()
     LOG_ERROR(EventSource::SYSTEM, "ADProcessor FAILED");
   }
   
+  bootSequence.beginStage("Detection");
+  // Probe CAN heartbeats, the IMU, known I2C devices and the motor side by side;
+  // boot waits for the slowest probe instead of all of them in turn
+  DeviceDetector detector;
+  detector.add(canManager.getDeviceProbe());
+  detector.add(imuProcessor.getDeviceProbe());
+  detector.add(i2cManager.getDeviceProbe());
+  detector.add(MotorDriverManager::getInstance()->getDeviceProbe());
+  detector.run();
+
+  if (imuProcessor.isIMUInitialized())
+  {
+    LOG_INFO(EventSource::SYSTEM, "IMUProcessor initialized");
+    imuProcessor.registerPGNCallbacks();
+  }
+  else
+  {
+    LOG_ERROR(EventSource::SYSTEM, "IMUProcessor FAILED");
+  }
+
   // Initialize Motor Driver BEFORE PWMProcessor to ensure correct PWM resolution
+  bootSequence.beginStage("Control");
   motorPTR = MotorDriverManager::getInstance()->detectAndCreateMotorDriver(&hardwareManager, &canManager);
   
   if (motorPTR && motorPTR->init()) {
@@ -417,11 +449,15 @@ void setup()
   NAVProcessor::init();
   LOG_INFO(EventSource::SYSTEM, "NAVProcessor initialized");
 
-  // NOW initialize AsyncUDP after ALL hardware is up
+  // UDP sockets bind without a link, so AgOpenGPS traffic flows as soon as it is up
   LOG_INFO(EventSource::SYSTEM, "All hardware initialized, starting AsyncUDP");
   QNEthernetUDPHandler::init();
   LOG_INFO(EventSource::SYSTEM, "AsyncUDP handlers ready");
 
+  // Initialize NTRIP client (idle unless a caster is configured)
+  NTRIPClient::init();
+  LOG_INFO(EventSource::SYSTEM, "NTRIPClient initialized");
+
   // Initialize AutosteerProcessor
   AutosteerProcessor* autosteerPTR = AutosteerProcessor::getInstance();
   if (autosteerPTR->init()) {
@@ -458,90 +494,88 @@ void setup()
   cmdHandler->setMachineProcessor(machinePTR);
   LOG_INFO(EventSource::SYSTEM, "CommandHandler initialized");
 
-  // Initialize WebManager
-  if (webManager.begin()) {
-    LOG_INFO(EventSource::SYSTEM, "WebManager initialized");
-  } else {
-    LOG_ERROR(EventSource::SYSTEM, "WebManager FAILED");
-  }
-
   // Exit startup mode - start enforcing configured log levels
   EventLogger::getInstance()->setStartupMode(false);
 
-  // Mark web manager as ready for SSE updates
-  webManager.setSystemReady(true);
-
   // ============================================
   // Initialize SimpleScheduler
   // ============================================
+  bootSequence.beginStage("Scheduler");
   LOG_INFO(EventSource::SYSTEM, "Initializing SimpleScheduler...");
 
   // Add EVERY_LOOP tasks (no timing)
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, taskEthernetLoop, "Ethernet Loop");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, taskQNetworkPoll, "QNetwork Poll");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, taskUDPPoll, "UDP Poll");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, taskGPS1Serial, "GPS1 Serial");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, taskGPS2Serial, "GPS2 Serial");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, taskAutosteer, "Autosteer");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, taskEthernetLoop, "Ethernet Loop");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, taskQNetworkPoll, "QNetwork Poll");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, taskUDPPoll, "UDP Poll");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, taskGPS1Serial, "GPS1 Serial");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, taskGPS2Serial, "GPS2 Serial");
 
   // Add these as EVERY_LOOP for now (they have no timing currently)
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     imuProcessor.process();
   }, "IMU");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     adProcessor.process();
   }, "ADProcessor");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     esp32Interface.process();
   }, "ESP32");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     RTCMProcessor::getInstance()->process();
   }, "RTCM");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
+    NTRIPClient::getInstance()->process();
+  }, "NTRIP");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     EncoderProcessor::getInstance()->process();
   }, "Encoder");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     MachineProcessor::getInstance()->process();
   }, "Machine");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     pwmProcessor.process();
   }, "PWM");
-  scheduler.addTask(SimpleScheduler::EVERY_LOOP, []{
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
     KickoutMonitor::getInstance()->process();
   }, "Kickout Monitor");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
+    J1939Stack::getInstance()->process();
+  }, "J1939");
+  addSchedulerTask(SimpleScheduler::EVERY_LOOP, []{
+    processCANTransmit();
+  }, "CAN TX");
 
   // Add 100Hz tasks (critical timing)
-  scheduler.addTask(SimpleScheduler::HZ_100, taskAutosteer, "Autosteer");
-  scheduler.addTask(SimpleScheduler::HZ_100, taskWebHandleClient, "Web Client");
-  scheduler.addTask(SimpleScheduler::HZ_100, taskWebBroadcastTelemetry, "Web Telemetry");
-
-  // Add 50Hz tasks (motor control)
-  scheduler.addTask(SimpleScheduler::HZ_50, taskMotorDriver, "Motor Driver");
+  addSchedulerTask(SimpleScheduler::HZ_100, taskWebHandleClient, "Web Client");
+  addSchedulerTask(SimpleScheduler::HZ_100, taskWebBroadcastTelemetry, "Web Telemetry");
+  addSchedulerTask(SimpleScheduler::HZ_100, []{
+    canManager.process();
+  }, "CAN Monitor");
+  addSchedulerTask(SimpleScheduler::HZ_100, []{
+    bootSequence.process();
+  }, "Boot");
 
   // Add 10Hz tasks (UI and status)
-  scheduler.addTask(SimpleScheduler::HZ_10, taskLEDUpdate, "LED Update");
-  scheduler.addTask(SimpleScheduler::HZ_10, taskNetworkCheck, "Network Check");
-  scheduler.addTask(SimpleScheduler::HZ_10, taskNAVProcess, "NAV Process");
-  scheduler.addTask(SimpleScheduler::HZ_10, taskKickoutSendPGN250, "PGN250 Send");
-  scheduler.addTask(SimpleScheduler::HZ_10, []{
+  addSchedulerTask(SimpleScheduler::HZ_10, taskLEDUpdate, "LED Update");
+  addSchedulerTask(SimpleScheduler::HZ_10, taskNetworkCheck, "Network Check");
+  addSchedulerTask(SimpleScheduler::HZ_10, taskNAVProcess, "NAV Process");
+  addSchedulerTask(SimpleScheduler::HZ_10, taskKickoutSendPGN250, "PGN250 Send");
+  addSchedulerTask(SimpleScheduler::HZ_10, []{
     CommandHandler::getInstance()->process();
   }, "CommandHandler");
-
-  LOG_INFO(EventSource::SYSTEM, "SimpleScheduler initialized with %d tasks",
-           5 + 8 + 3 + 1 + 5); // EVERY_LOOP + 100Hz + 50Hz + 10Hz
-
-  // Display access information
-  localIP = Ethernet.localIP();  // Reuse existing variable
-  Serial.println("\r\n");
-  Serial.println("========================================");
-  Serial.println("=== AiO New Dawn - System Ready ===");
-  Serial.println("========================================");
-  Serial.printf("IP Address: %d.%d.%d.%d\r\n", localIP[0], localIP[1], localIP[2], localIP[3]);
-  Serial.printf("Web Interface: http://%d.%d.%d.%d\r\n", localIP[0], localIP[1], localIP[2], localIP[3]);
-  Serial.println("DHCP Server: Enabled");
-  Serial.println("========================================");
-  Serial.println();
-  
-  LOG_INFO(EventSource::SYSTEM, "=== System Ready ===");
+  addSchedulerTask(SimpleScheduler::HZ_10, []{
+    VTClient::getInstance()->process();
+  }, "VT Client");
+
+  LOG_INFO(EventSource::SYSTEM, "SimpleScheduler initialized with %d tasks", scheduler.getTaskCount());
+
+  // Control path is up; the rest runs from the scheduler so it cannot hold
+  // steering back
+  bootSequence.addBackgroundStep("Web server", bootStepWebServer);
+  bootSequence.addBackgroundStep("Buzzer", bootStepBuzzer);
+  bootSequence.addBackgroundStep("Ethernet link", bootStepEthernetLink);
+  bootSequence.setControlReady();
 }
 
 // Macro for timing a process
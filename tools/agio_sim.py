@@ -0,0 +1,407 @@
+#!/usr/bin/env python3
+"""
+AgIO stand-in and round-trip latency benchmark for the AiO firmware.
+
+Streams realistic AgOpenGPS PGNs at the module over real UDP and timestamps
+the module's replies, so the cost of QNEthernetUDPHandler / PGNProcessor /
+control loop scheduling can be tracked from release to release.
+
+Traffic sent (to <module>:8888, from local port 9999 like AgIO):
+    PGN 200  Hello                      --rate-200 (default 1 Hz)
+    PGN 254  Steer data                 --rate-254 (default 10 Hz)
+    PGN 239  Machine data               --rate-239 (default 10 Hz)
+    PGN 252  Steer settings             --rate-252 (default off, written to EEPROM!)
+    PGN 251  Steer config               --rate-251 (default off, written to EEPROM!)
+    RTCM     filler on port 2233        --rtcm-load bytes/s (default off)
+
+Measurements:
+    steer    PGN 254 autosteer/guidance toggle -> first PGN 253 whose switch
+             byte (bit 1, steerState) reflects it. Includes the 100 Hz
+             autosteer tick phase, i.e. what AgOpenGPS actually observes.
+    machine  PGN 239 section 1 toggle -> first machine hello reply (PGN 123)
+             whose relayLo bit 0 reflects it. Hello probes are sent every
+             --poll-ms while a probe is outstanding.
+    loss     PGN 200 hellos sent vs steer hello replies (PGN 126) received,
+             PGN 253 inter-arrival gaps, PANDA/PAOGI rate if GNSS is present.
+    sensor   PGN 250 turn sensor reports: inter-arrival gaps and value. With
+             --sensor-threshold, a reading reaching it while steering is
+             armed (grab the wheel / press the sensor) starts a kickout probe
+             that ends at the first PGN 253 showing steering off.
+
+Usage:
+    python3 tools/agio_sim.py --module 192.168.5.126 --duration 60
+    python3 tools/agio_sim.py --rate-254 50 --rate-239 50 --rtcm-load 20000 --json r.json
+
+The host must be on the module subnet (module replies are broadcast to
+x.x.x.255:9999). Run with autosteer/section hardware disconnected - probes
+arm steering and switch section 1.
+"""
+
+import argparse
+import json
+import socket
+import threading
+import time
+
+PGN_PORT = 8888
+RTCM_PORT = 2233
+AGIO_PORT = 9999
+
+SRC_AGIO = 0x7F
+SRC_STEER = 0x7E
+SRC_MACHINE = 0x7B
+
+
+def pgn_packet(pgn, payload, src=SRC_AGIO):
+    body = bytearray([0x80, 0x81, src, pgn, len(payload)]) + bytes(payload)
+    if pgn in (200, 201, 202):
+        return bytes(body + b"\x47")  # AgIO fixed CRC
+    return bytes(body + bytes([sum(body[2:]) & 0xFF]))
+
+
+def percentile(values, p):
+    if not values:
+        return float("nan")
+    s = sorted(values)
+    k = min(len(s) - 1, max(0, int(round(p / 100.0 * (len(s) - 1)))))
+    return s[k]
+
+
+def summarize(values):
+    if not values:
+        return {"count": 0}
+    return {
+        "count": len(values),
+        "min_ms": round(min(values), 3),
+        "p50_ms": round(percentile(values, 50), 3),
+        "p95_ms": round(percentile(values, 95), 3),
+        "p99_ms": round(percentile(values, 99), 3),
+        "max_ms": round(max(values), 3),
+        "mean_ms": round(sum(values) / len(values), 3),
+    }
+
+
+class Probe:
+    """One outstanding state toggle waiting for the module to reflect it."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.expected = None
+        self.sent_at = 0.0
+        self.results = []
+        self.timeouts = 0
+
+    def start(self, expected, now):
+        with self.lock:
+            if self.expected is not None:
+                self.timeouts += 1
+            self.expected = expected
+            self.sent_at = now
+
+    def pending(self):
+        with self.lock:
+            return self.expected is not None
+
+    def observe(self, value, now):
+        with self.lock:
+            if self.expected is not None and value == self.expected:
+                self.results.append((now - self.sent_at) * 1000.0)
+                self.expected = None
+
+    def cancel(self):
+        with self.lock:
+            self.expected = None
+
+    def expire(self, now, timeout):
+        with self.lock:
+            if self.expected is not None and now - self.sent_at > timeout:
+                self.timeouts += 1
+                self.expected = None
+
+
+class AgIOSim:
+    def __init__(self, args):
+        self.args = args
+        self.module = (args.module, PGN_PORT)
+        self.sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self.sock.setsockopt(socket.SOL_SOCKET, socket.SO_BROADCAST, 1)
+        # PGNProcessor only accepts packets from source port 9999
+        self.sock.bind(("0.0.0.0", AGIO_PORT))
+        self.sock.settimeout(0.2)
+        self.running = True
+
+        # Simulated AgOpenGPS state
+        self.steer_on = False
+        self.section1 = False
+
+        self.steer_probe = Probe()
+        self.machine_probe = Probe()
+        self.kickout_probe = Probe()
+
+        self.sent = {200: 0, 239: 0, 251: 0, 252: 0, 254: 0}
+        self.rtcm_bytes = 0
+        self.rx = {}
+        self.hello_replies = {SRC_STEER: 0, SRC_MACHINE: 0}
+        self.pgn253_times = []
+        self.pgn250_times = []
+        self.sensor_max = 0
+        self.sensor_last = 0
+        self.steer_armed = False
+        self.nmea_times = []
+        self.bad_crc = 0
+
+    # --- transmit -----------------------------------------------------
+
+    def send(self, pgn, payload):
+        self.sock.sendto(pgn_packet(pgn, payload), self.module)
+        self.sent[pgn] += 1
+
+    def send_hello(self):
+        self.send(200, [56, 0, 0])
+
+    def send_254(self):
+        speed = int(self.args.speed * 10)
+        status = 0x41 if self.steer_on else 0x00  # bit 0 guidance, bit 6 autosteer
+        angle = int(self.args.steer_angle * 100) & 0xFFFF
+        self.send(254, [speed & 0xFF, speed >> 8, status,
+                        angle & 0xFF, angle >> 8, 0, 0, 0])
+
+    def send_239(self):
+        sc1_8 = 0x01 if self.section1 else 0x00
+        speed = int(self.args.speed * 10) & 0xFF
+        self.send(239, [0, speed, 0, 0, 0, 0, sc1_8, 0])
+
+    def send_252(self):
+        # kp, highPWM, lowPWM, minPWM, counts, wasOffset(2), ackerman
+        self.send(252, [40, 235, 60, 40, 110, 0, 0, 100])
+
+    def send_251(self):
+        # set0, pulseCount, minSpeed, set1, reserved
+        self.send(251, [0, 3, 1, 0, 0, 0, 0, 0])
+
+    def sender(self):
+        a = self.args
+        streams = [(200, a.rate_200, self.send_hello),
+                   (254, a.rate_254, self.send_254),
+                   (239, a.rate_239, self.send_239),
+                   (252, a.rate_252, self.send_252),
+                   (251, a.rate_251, self.send_251)]
+        start = time.perf_counter()
+        next_due = {pgn: start for pgn, rate, _ in streams if rate > 0}
+        next_steer_probe = start + a.warmup
+        next_machine_probe = start + a.warmup + a.probe_interval / 2
+        next_poll = 0.0
+        rtcm_sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM) if a.rtcm_load > 0 else None
+        rtcm_chunk = bytes([0xD3, 0x00]) + bytes(a.rtcm_packet - 2)
+        rtcm_next = start
+
+        while self.running:
+            now = time.perf_counter()
+
+            # Steer probe: flip guidance + autosteer bits and send at once
+            if now >= next_steer_probe:
+                self.steer_on = not self.steer_on
+                self.kickout_probe.cancel()  # Our own disarm is not a kickout
+                self.steer_probe.start(0 if self.steer_on else 1, now)  # steerState 0 = armed
+                self.send_254()
+                next_steer_probe += a.probe_interval
+
+            # Machine probe: flip section 1 and start hello polling
+            if now >= next_machine_probe:
+                self.section1 = not self.section1
+                self.machine_probe.start(1 if self.section1 else 0, now)
+                self.send_239()
+                next_poll = now
+                next_machine_probe += a.probe_interval
+
+            if self.machine_probe.pending() and now >= next_poll:
+                self.send_hello()
+                next_poll = now + a.poll_ms / 1000.0
+
+            for pgn, rate, fn in streams:
+                if rate > 0 and now >= next_due[pgn]:
+                    fn()
+                    next_due[pgn] += 1.0 / rate
+                    if next_due[pgn] < now:
+                        next_due[pgn] = now  # Fell behind - don't burst
+
+            if rtcm_sock and now >= rtcm_next:
+                rtcm_sock.sendto(rtcm_chunk, (a.module, RTCM_PORT))
+                self.rtcm_bytes += len(rtcm_chunk)
+                rtcm_next += len(rtcm_chunk) / float(a.rtcm_load)
+                if rtcm_next < now:
+                    rtcm_next = now
+
+            self.steer_probe.expire(now, a.timeout)
+            self.machine_probe.expire(now, a.timeout)
+            self.kickout_probe.expire(now, a.timeout)
+            time.sleep(0.0005)
+
+    # --- receive ------------------------------------------------------
+
+    def receiver(self):
+        while self.running:
+            try:
+                data, addr = self.sock.recvfrom(2048)
+            except socket.timeout:
+                continue
+            now = time.perf_counter()
+            if addr[0] != self.args.module:
+                continue
+
+            if data[:1] == b"$":
+                if data.startswith(b"$PANDA") or data.startswith(b"$PAOGI"):
+                    self.nmea_times.append(now)
+                continue
+
+            if len(data) < 6 or data[0] != 0x80 or data[1] != 0x81:
+                continue
+            # Hello replies may carry the fixed AgIO checksum (71) instead of the sum
+            hello = data[2] == data[3] and data[-1] == 0x47
+            if not hello and (sum(data[2:-1]) & 0xFF) != data[-1]:
+                self.bad_crc += 1
+                continue
+
+            src, pgn = data[2], data[3]
+            self.rx[pgn] = self.rx.get(pgn, 0) + 1
+
+            if pgn == 253 and len(data) >= 14:
+                self.pgn253_times.append(now)
+                steer_state = (data[11] >> 1) & 0x01
+                self.steer_armed = steer_state == 0
+                self.steer_probe.observe(steer_state, now)
+                self.kickout_probe.observe(steer_state, now)
+            elif pgn == 250 and len(data) >= 7:
+                # Byte 5: turn sensor value (encoder count, pressure or current)
+                value = data[5]
+                self.pgn250_times.append(now)
+                self.sensor_max = max(self.sensor_max, value)
+                threshold = self.args.sensor_threshold
+                if (threshold > 0 and value >= threshold and self.sensor_last < threshold
+                        and self.steer_armed and not self.kickout_probe.pending()):
+                    self.kickout_probe.start(1, now)  # steerState 1 = off
+                self.sensor_last = value
+            elif pgn == src and src in self.hello_replies:
+                self.hello_replies[src] += 1
+                if src == SRC_MACHINE and len(data) >= 7:
+                    self.machine_probe.observe(data[5] & 0x01, now)
+
+    # --- run ----------------------------------------------------------
+
+    def run(self):
+        threads = [threading.Thread(target=self.receiver, daemon=True),
+                   threading.Thread(target=self.sender, daemon=True)]
+        for t in threads:
+            t.start()
+        try:
+            time.sleep(self.args.duration)
+        except KeyboardInterrupt:
+            pass
+        self.running = False
+        for t in threads:
+            t.join(timeout=1.0)
+
+        # Leave the module disarmed with sections off
+        self.steer_on = False
+        self.section1 = False
+        self.send_254()
+        self.send_239()
+        return self.report()
+
+    def report(self):
+        a = self.args
+        gaps = [(b - c) * 1000.0 for c, b in zip(self.pgn253_times, self.pgn253_times[1:])]
+        nmea_gaps = [(b - c) * 1000.0 for c, b in zip(self.nmea_times, self.nmea_times[1:])]
+        sensor_gaps = [(b - c) * 1000.0 for c, b in zip(self.pgn250_times, self.pgn250_times[1:])]
+        hellos = self.sent[200]
+        steer_replies = self.hello_replies[SRC_STEER]
+
+        result = {
+            "config": {k: v for k, v in vars(a).items()},
+            "sent": self.sent,
+            "rtcm_bytes": self.rtcm_bytes,
+            "received": {str(k): v for k, v in sorted(self.rx.items())},
+            "bad_crc": self.bad_crc,
+            "steer_rtt": summarize(self.steer_probe.results),
+            "steer_timeouts": self.steer_probe.timeouts,
+            "machine_latency": summarize(self.machine_probe.results),
+            "machine_timeouts": self.machine_probe.timeouts,
+            "hello_loss_pct": round(100.0 * (1 - steer_replies / hellos), 2) if hellos else None,
+            "pgn253_rate_hz": round(len(self.pgn253_times) / a.duration, 1),
+            "pgn253_gap": summarize(gaps),
+            "pgn253_gaps_over_50ms": sum(1 for g in gaps if g > 50.0),
+            "pgn250_rate_hz": round(len(self.pgn250_times) / a.duration, 1),
+            "pgn250_gap": summarize(sensor_gaps),
+            "pgn250_gaps_over_150ms": sum(1 for g in sensor_gaps if g > 150.0),
+            "sensor_max": self.sensor_max,
+            "kickout_latency": summarize(self.kickout_probe.results),
+            "kickout_timeouts": self.kickout_probe.timeouts,
+            "nmea_gap": summarize(nmea_gaps),
+        }
+
+        def line(name, s, timeouts):
+            if s["count"] == 0:
+                print("%-22s no samples (%d timeouts)" % (name, timeouts))
+            else:
+                print("%-22s n=%d min=%.2f p50=%.2f p95=%.2f p99=%.2f max=%.2f ms, %d timeouts" %
+                      (name, s["count"], s["min_ms"], s["p50_ms"], s["p95_ms"],
+                       s["p99_ms"], s["max_ms"], timeouts))
+
+        print("\n=== AgIO sim results (%.0f s) ===" % a.duration)
+        print("Sent: %s, RTCM %d B" % (", ".join("%d=%d" % kv for kv in self.sent.items()), self.rtcm_bytes))
+        print("Received: %s, bad CRC %d" % (", ".join("%d=%d" % kv for kv in sorted(self.rx.items())), self.bad_crc))
+        line("PGN254 -> PGN253", result["steer_rtt"], result["steer_timeouts"])
+        line("PGN239 -> output", result["machine_latency"], result["machine_timeouts"])
+        if hellos:
+            print("%-22s %d/%d steer replies, %.2f%% loss" %
+                  ("Hello loss", steer_replies, hellos, result["hello_loss_pct"]))
+        line("PGN253 interval", result["pgn253_gap"], 0)
+        print("%-22s %.1f Hz, %d gaps > 50 ms" %
+              ("PGN253 rate", result["pgn253_rate_hz"], result["pgn253_gaps_over_50ms"]))
+        if sensor_gaps:
+            line("PGN250 interval", result["pgn250_gap"], 0)
+            print("%-22s %.1f Hz, %d gaps > 150 ms, max value %d" %
+                  ("PGN250 rate", result["pgn250_rate_hz"], result["pgn250_gaps_over_150ms"],
+                   self.sensor_max))
+        if a.sensor_threshold > 0:
+            line("PGN250 -> PGN253 off", result["kickout_latency"], result["kickout_timeouts"])
+        if nmea_gaps:
+            line("PANDA/PAOGI interval", result["nmea_gap"], 0)
+
+        if a.json:
+            with open(a.json, "w") as f:
+                json.dump(result, f, indent=2)
+            print("Results written to %s" % a.json)
+        return result
+
+
+def main():
+    ap = argparse.ArgumentParser(description="AgIO stand-in and PGN latency benchmark")
+    ap.add_argument("--module", default="192.168.5.126", help="module IP address")
+    ap.add_argument("--duration", type=float, default=30.0, help="seconds to run")
+    ap.add_argument("--warmup", type=float, default=2.0, help="seconds before first probe")
+    ap.add_argument("--rate-200", type=float, default=1.0)
+    ap.add_argument("--rate-254", type=float, default=10.0)
+    ap.add_argument("--rate-239", type=float, default=10.0)
+    ap.add_argument("--rate-252", type=float, default=0.0, help="steer settings (saved to EEPROM)")
+    ap.add_argument("--rate-251", type=float, default=0.0, help="steer config (saved to EEPROM)")
+    ap.add_argument("--rtcm-load", type=int, default=0, help="RTCM filler bytes/s to port 2233")
+    ap.add_argument("--rtcm-packet", type=int, default=512, help="RTCM filler datagram size")
+    ap.add_argument("--probe-interval", type=float, default=1.0, help="seconds between state toggles")
+    ap.add_argument("--poll-ms", type=float, default=2.0, help="hello poll period during machine probe")
+    ap.add_argument("--timeout", type=float, default=0.5, help="probe timeout in seconds")
+    ap.add_argument("--speed", type=float, default=8.0, help="simulated speed km/h")
+    ap.add_argument("--steer-angle", type=float, default=0.0, help="steer angle setpoint degrees")
+    ap.add_argument("--sensor-threshold", type=int, default=0,
+                    help="PGN 250 value that counts as a kickout (0 = off), for the kickout latency")
+    ap.add_argument("--json", help="write results to this file")
+    args = ap.parse_args()
+
+    print("AgIO sim -> %s:%d for %.0f s (254 @ %g Hz, 239 @ %g Hz, RTCM %d B/s)" %
+          (args.module, PGN_PORT, args.duration, args.rate_254, args.rate_239, args.rtcm_load))
+    AgIOSim(args).run()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,271 @@
+#!/usr/bin/env python3
+"""
+CAN capture/replay helper for the AiO on-board CAN capture ring.
+
+Device control (HTTP):
+    python3 tools/can_capture.py --host 192.168.5.126 start [--bus 3]
+    python3 tools/can_capture.py --host 192.168.5.126 stop
+    python3 tools/can_capture.py --host 192.168.5.126 download -o fendt.log [--rx-only]
+    python3 tools/can_capture.py --host 192.168.5.126 upload fendt.log
+    python3 tools/can_capture.py --host 192.168.5.126 replay [--loop]
+
+Offline:
+    python3 tools/can_capture.py stats fendt.log
+    python3 tools/can_capture.py vcan fendt.log --map can3=vcan0 [--rx-only] [--speed 2]
+
+Logs are candump -l format: "(seconds.micros) canN ID#DATA", so they also
+work with can-utils (canplayer, cansniffer via vcan). Interface names can1-3
+are the AiO bus numbers. Frames the module transmitted are only in binary
+captures (bus bit 7) and are dropped by --rx-only or when converting.
+
+Binary format: 16 byte header ("AIOCAN\\0\\1", uint32 record count, 4 spare)
+followed by 20 byte little-endian records: uint32 timeUs, uint32 id (bit 31 =
+extended), uint8 bus (bit 7 = TX), uint8 len, 8 data bytes, uint16 spare.
+
+Replay on the device injects the received frames into the bus RX queues
+with their original timing, so TractorCANDriver/KeyaCANDriver handle them
+exactly as live traffic. Bench use only - it will engage/ready whatever the
+recording says. On a PC, tools/can_host.cpp runs the same drivers against
+a log or a vcan interface.
+"""
+
+import argparse
+import json
+import re
+import socket
+import struct
+import time
+import urllib.request
+
+BIN_MAGIC = b"AIOCAN\x00\x01"
+RECORD = struct.Struct("<IIBB8sH")
+ID_EXTENDED = 0x80000000
+BUS_TX = 0x80
+CAN_EFF_FLAG = 0x80000000
+LINE_RE = re.compile(r"\((\d+)\.(\d+)\)\s+(\S+)\s+([0-9A-Fa-f]+)#([0-9A-Fa-f]*)")
+
+
+class Frame:
+    __slots__ = ("time_us", "iface", "id", "ext", "data", "tx")
+
+    def __init__(self, time_us, iface, can_id, ext, data, tx=False):
+        self.time_us = time_us
+        self.iface = iface
+        self.id = can_id
+        self.ext = ext
+        self.data = data
+        self.tx = tx
+
+
+def read_candump(path):
+    frames = []
+    with open(path) as f:
+        for line in f:
+            m = LINE_RE.match(line.strip())
+            if not m:
+                continue
+            sec, frac, iface, ident, data = m.groups()
+            time_us = int(sec) * 1000000 + int(frac.ljust(6, "0")[:6])
+            frames.append(Frame(time_us, iface, int(ident, 16), len(ident) > 3, bytes.fromhex(data)))
+    return frames
+
+
+def read_binary(blob):
+    if blob[:8] != BIN_MAGIC:
+        raise SystemExit("not an AiO CAN capture (bad magic)")
+    count = struct.unpack_from("<I", blob, 8)[0]
+    frames = []
+    last = None
+    unwrapped = 0
+    for i in range(count):
+        off = 16 + i * RECORD.size
+        if off + RECORD.size > len(blob):
+            break
+        t, ident, bus, length, data, _ = RECORD.unpack_from(blob, off)
+        if last is not None:
+            unwrapped += (t - last) & 0xFFFFFFFF
+        last = t
+        frames.append(Frame(unwrapped, "can%d" % (bus & 0x03), ident & ~ID_EXTENDED,
+                            bool(ident & ID_EXTENDED), data[:min(length, 8)], bool(bus & BUS_TX)))
+    return frames
+
+
+def read_any(path):
+    with open(path, "rb") as f:
+        head = f.read(8)
+    if head == BIN_MAGIC:
+        with open(path, "rb") as f:
+            return read_binary(f.read())
+    return read_candump(path)
+
+
+def to_binary(frames):
+    out = bytearray(BIN_MAGIC + struct.pack("<II", len(frames), 0))
+    for fr in frames:
+        m = re.search(r"(\d+)$", fr.iface)
+        bus = int(m.group(1)) if m else 1
+        if not 1 <= bus <= 3:
+            raise SystemExit("interface %s does not map to AiO bus 1-3 (rename it canN)" % fr.iface)
+        ident = fr.id | (ID_EXTENDED if fr.ext else 0)
+        out += RECORD.pack(fr.time_us & 0xFFFFFFFF, ident, bus | (BUS_TX if fr.tx else 0),
+                           len(fr.data), fr.data.ljust(8, b"\x00"), 0)
+    return bytes(out)
+
+
+def format_candump(fr):
+    ident = ("%08X" if fr.ext else "%03X") % fr.id
+    return "(%d.%06d) %s %s#%s" % (fr.time_us // 1000000, fr.time_us % 1000000,
+                                   fr.iface, ident, fr.data.hex().upper())
+
+
+# ----- Device control -----
+
+def http(host, path, body=None, content_type="application/json", timeout=30):
+    req = urllib.request.Request("http://%s%s" % (host, path), data=body)
+    if body is not None:
+        req.add_header("Content-Type", content_type)
+    with urllib.request.urlopen(req, timeout=timeout) as resp:
+        return resp.read()
+
+
+def control(host, action, **extra):
+    payload = dict(action=action, **extra)
+    status = json.loads(http(host, "/api/can/capture", json.dumps(payload).encode()))
+    print(json.dumps(status, indent=2))
+
+
+def cmd_status(args):
+    print(json.dumps(json.loads(http(args.host, "/api/can/capture")), indent=2))
+
+
+def cmd_start(args):
+    mask = 0
+    for bus in args.bus or [1, 2, 3]:
+        mask |= 1 << (bus - 1)
+    control(args.host, "start", busMask=mask)
+
+
+def cmd_download(args):
+    if args.binary:
+        blob = http(args.host, "/api/can/capture/bin")
+        frames = read_binary(blob)
+        if args.output.endswith(".bin"):
+            open(args.output, "wb").write(blob)
+            print("%d records -> %s" % (len(frames), args.output))
+            return
+    else:
+        text = http(args.host, "/api/can/capture/log" + ("?rx=1" if args.rx_only else "")).decode()
+        open(args.output, "w").write(text)
+        print("%d frames -> %s" % (text.count("\n"), args.output))
+        return
+    if args.rx_only:
+        frames = [f for f in frames if not f.tx]
+    with open(args.output, "w") as f:
+        for fr in frames:
+            f.write(format_candump(fr) + "\n")
+    print("%d frames -> %s" % (len(frames), args.output))
+
+
+def cmd_upload(args):
+    frames = [f for f in read_any(args.file) if not f.tx]
+    if not frames:
+        raise SystemExit("no received frames in %s" % args.file)
+    t0 = frames[0].time_us
+    for fr in frames:
+        fr.time_us -= t0
+    reply = http(args.host, "/api/can/capture/upload", to_binary(frames), "application/octet-stream")
+    print(reply.decode())
+
+
+# ----- Offline -----
+
+def cmd_stats(args):
+    frames = read_any(args.file)
+    if not frames:
+        raise SystemExit("no frames")
+    span = max((frames[-1].time_us - frames[0].time_us) / 1e6, 1e-6)
+    table = {}
+    for fr in frames:
+        key = (fr.iface, fr.id, fr.ext, fr.tx)
+        table.setdefault(key, []).append(fr.time_us)
+
+    print("%d frames over %.2f s" % (len(frames), span))
+    print("%-5s %-8s %2s %7s %8s %10s %10s %10s" % ("bus", "id", "tx", "count", "rate", "mean ms", "jitter ms", "max ms"))
+    for (iface, ident, ext, tx), times in sorted(table.items(), key=lambda kv: -len(kv[1])):
+        gaps = [(b - a) / 1000.0 for a, b in zip(times, times[1:])]
+        mean = sum(gaps) / len(gaps) if gaps else 0.0
+        jitter = sum(abs(g - mean) for g in gaps) / len(gaps) if gaps else 0.0
+        print("%-5s %-8s %2s %7d %7.1f/s %10.2f %10.2f %10.2f" % (
+            iface, ("%08X" if ext else "%03X") % ident, "tx" if tx else "", len(times),
+            len(times) / span, mean, jitter, max(gaps) if gaps else 0.0))
+
+
+def cmd_vcan(args):
+    frames = read_any(args.file)
+    if args.rx_only:
+        frames = [f for f in frames if not f.tx]
+    mapping = dict(m.split("=", 1) for m in args.map)
+
+    sockets = {}
+    for fr in frames:
+        iface = mapping.get(fr.iface, fr.iface)
+        if iface not in sockets:
+            s = socket.socket(socket.PF_CAN, socket.SOCK_RAW, socket.CAN_RAW)
+            s.bind((iface,))
+            sockets[iface] = s
+
+    start = time.monotonic()
+    t0 = frames[0].time_us if frames else 0
+    for fr in frames:
+        due = (fr.time_us - t0) / 1e6 / args.speed
+        delay = due - (time.monotonic() - start)
+        if delay > 0:
+            time.sleep(delay)
+        can_id = fr.id | (CAN_EFF_FLAG if fr.ext else 0)
+        sockets[mapping.get(fr.iface, fr.iface)].send(
+            struct.pack("=IB3x8s", can_id, len(fr.data), fr.data.ljust(8, b"\x00")))
+    print("%d frames sent in %.2f s" % (len(frames), time.monotonic() - start))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="AiO CAN capture/replay helper")
+    ap.add_argument("--host", default="192.168.5.126", help="AiO module address")
+    sub = ap.add_subparsers(dest="cmd", required=True)
+
+    sub.add_parser("status").set_defaults(func=cmd_status)
+    p = sub.add_parser("start")
+    p.add_argument("--bus", type=int, action="append", choices=[1, 2, 3])
+    p.set_defaults(func=cmd_start)
+    sub.add_parser("stop").set_defaults(func=lambda a: control(a.host, "stop"))
+    sub.add_parser("clear").set_defaults(func=lambda a: control(a.host, "clear"))
+    p = sub.add_parser("replay", help="replay the device ring into its RX queues")
+    p.add_argument("--loop", action="store_true")
+    p.set_defaults(func=lambda a: control(a.host, "replay", loop=a.loop))
+
+    p = sub.add_parser("download")
+    p.add_argument("-o", "--output", required=True)
+    p.add_argument("--binary", action="store_true", help="fetch binary (includes TX frames)")
+    p.add_argument("--rx-only", action="store_true")
+    p.set_defaults(func=cmd_download)
+
+    p = sub.add_parser("upload", help="load a candump/binary log into the device ring")
+    p.add_argument("file")
+    p.set_defaults(func=cmd_upload)
+
+    p = sub.add_parser("stats", help="per-ID rate and jitter of a log")
+    p.add_argument("file")
+    p.set_defaults(func=cmd_stats)
+
+    p = sub.add_parser("vcan", help="replay a log onto SocketCAN interfaces")
+    p.add_argument("file")
+    p.add_argument("--map", action="append", default=[], help="log iface=host iface, e.g. can3=vcan0")
+    p.add_argument("--rx-only", action="store_true")
+    p.add_argument("--speed", type=float, default=1.0)
+    p.set_defaults(func=cmd_vcan)
+
+    args = ap.parse_args()
+    args.func(args)
+
+
+if __name__ == "__main__":
+    main()
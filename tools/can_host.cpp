@@ -0,0 +1,379 @@
+// can_host.cpp - Run the CAN steering drivers on a Linux host
+// Builds TractorCANDriver (every brand policy) or the standalone
+// KeyaCANDriver against tools/host: FlexCAN_T4 on SocketCAN, the firmware's
+// own CANGlobals and CANTxScheduler on top, host stand-ins for Arduino,
+// EventLogger and ConfigManager. Frames come from
+//
+//     live     SocketCAN interfaces (--if can3=vcan0), e.g. a log played
+//              with canplayer or tools/can_capture.py vcan, or a real bus
+//     replay   a candump -l log (--replay), injected into the bus RX queues
+//              at their recorded times on a simulated clock, so a run is
+//              repeatable and takes a fraction of the recording's length
+//
+// The driver is ticked like the firmware: processFeedback() at 100Hz (the
+// autosteer tick), process() at 50Hz, the TX schedulers every 1ms, with
+// the mailboxes sent in arbitration order and refilled between frames. Ready
+// and engage changes print to stdout with their time; --tx-log writes every
+// frame the driver sends in candump -l format. Replaying a capture and
+// diffing the output against a known-good run catches brand protocol
+// regressions. The summary shows per-frame handler cost in host CPU time.
+//
+// Build and run from the repo root:
+//     g++ -O2 -std=gnu++17 -pthread -Itools/host -Ilib/aio_autosteer
+//         -Ilib/aio_communications -Ilib/aio_system -o can_host tools/can_host.cpp
+//         tools/host/HostCAN.cpp lib/aio_communications/CANGlobals.cpp
+//         lib/aio_communications/CANTxScheduler.cpp
+//         lib/aio_autosteer/TractorCANDriver.cpp lib/aio_autosteer/TractorBrandPolicy.cpp
+//     ./can_host tractor --brand fendt --replay fendt.log --pwm 40 --tx-log tx.log
+//     ./can_host tractor --brand keya --vbus 3 --if can3=vcan0
+//     ./can_host keya --if can3=vcan0 [--duration 30]
+//
+// Brands: caseih, cat, claas, fendt, fendt-one, jcb, keya, lindner, valtra.
+// --vbus/--kbus pick the steer and button buses (default CAN3 and CAN1);
+// --pwm sets the steering command and enables the driver, --debug shows
+// LOG_DEBUG output. vcan setup: ip link add dev vcan0 type vcan && ip link set up vcan0
+#include <signal.h>
+#include <string>
+#include <vector>
+#include "CANBus.h"
+#include "ConfigManager.h"
+#include "EventLogger.h"
+#include "HostCAN.h"
+#include "KeyaCANDriver.h"
+#include "TractorCANDriver.h"
+
+ConfigManager configManager;
+
+namespace {
+
+constexpr uint32_t TICK_US = 1000;
+constexpr uint32_t FEEDBACK_PERIOD_MS = 10;     // Autosteer tick
+constexpr uint32_t PROCESS_PERIOD_MS = 20;      // SimpleScheduler 50Hz group
+constexpr uint32_t REPLAY_TAIL_MS = 1000;       // Run on after the log so timeouts show
+
+struct LogFrame {
+    uint64_t timeUs;
+    uint8_t bus;
+    CAN_message_t msg;
+};
+
+struct BrandName {
+    const char* name;
+    TractorBrand brand;
+};
+
+const BrandName BRANDS[] = {
+    {"caseih", TractorBrand::CASEIH_NH},
+    {"cat", TractorBrand::CAT_MT},
+    {"claas", TractorBrand::CLAAS},
+    {"fendt", TractorBrand::FENDT},
+    {"fendt-one", TractorBrand::FENDT_ONE},
+    {"jcb", TractorBrand::JCB},
+    {"keya", TractorBrand::GENERIC},
+    {"lindner", TractorBrand::LINDNER},
+    {"valtra", TractorBrand::VALTRA_MASSEY},
+};
+
+volatile sig_atomic_t stopRequested = 0;
+FILE* txLog = nullptr;
+uint32_t txFrames = 0;
+
+void onSignal(int) { stopRequested = 1; }
+
+void printFrame(FILE* out, uint64_t timeUs, uint8_t bus, const CAN_message_t& msg) {
+    fprintf(out, "(%llu.%06llu) can%d ", (unsigned long long)(timeUs / 1000000),
+            (unsigned long long)(timeUs % 1000000), bus);
+    fprintf(out, msg.flags.extended ? "%08X#" : "%03X#", (unsigned)msg.id);
+    for (uint8_t i = 0; i < msg.len; i++) {
+        fprintf(out, "%02X", msg.buf[i]);
+    }
+    fputc('\n', out);
+}
+
+void onTxFrame(uint8_t busNum, const CAN_message_t& msg, uint32_t) {
+    txFrames++;
+    if (txLog) {
+        printFrame(txLog, host::nowMicros(), busNum, msg);
+    }
+}
+
+// candump -l: "(1699999999.123456) can3 0CEF2CF0#0102". Interfaces can1-3 are
+// AiO bus numbers, as in tools/can_capture.py logs; other lines are skipped.
+bool loadLog(const char* path, std::vector<LogFrame>& frames) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        return false;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        unsigned long long sec, usec;
+        char iface[32], frame[64];
+        if (sscanf(line, " (%llu.%llu) %31s %63s", &sec, &usec, iface, frame) != 4) {
+            continue;
+        }
+        int bus = 0;
+        if (sscanf(iface, "can%d", &bus) != 1 || bus < 1 || bus > 3) {
+            continue;
+        }
+        char* hash = strchr(frame, '#');
+        if (!hash || hash[1] == 'R') {
+            continue;
+        }
+
+        LogFrame lf;
+        lf.timeUs = sec * 1000000ULL + usec;
+        lf.bus = bus;
+        lf.msg.flags.extended = (hash - frame) > 3;
+        lf.msg.id = strtoul(std::string(frame, hash - frame).c_str(), nullptr, 16);
+        lf.msg.len = 0;
+        for (const char* p = hash + 1; p[0] && p[1] && lf.msg.len < 8; p += 2) {
+            char byte[3] = {p[0], p[1], 0};
+            lf.msg.buf[lf.msg.len++] = (uint8_t)strtoul(byte, nullptr, 16);
+        }
+        frames.push_back(lf);
+    }
+    fclose(f);
+    return true;
+}
+
+bool isEngaged(TractorCANDriver& driver, TractorBrand brand) {
+    switch (brand) {
+        case TractorBrand::CASEIH_NH:     return driver.isCaseIHEngaged();
+        case TractorBrand::CAT_MT:        return driver.isCATMTEngaged();
+        case TractorBrand::CLAAS:         return driver.isClaasEngaged();
+        case TractorBrand::FENDT:
+        case TractorBrand::FENDT_ONE:     return driver.isFendtButtonPressed();
+        case TractorBrand::JCB:           return driver.isJcbEngaged();
+        case TractorBrand::LINDNER:       return driver.isLindnerEngaged();
+        case TractorBrand::VALTRA_MASSEY: return driver.isEngageButtonPressed();
+        default:                          return false;
+    }
+}
+
+void setBusFunction(CANSteerConfig& config, uint8_t busNum, CANFunction function) {
+    switch (busNum) {
+        case 1: config.can1Function = static_cast<uint8_t>(function); break;
+        case 2: config.can2Function = static_cast<uint8_t>(function); break;
+        case 3: config.can3Function = static_cast<uint8_t>(function); break;
+    }
+}
+
+HostCANInterface* getInterface(uint8_t busNum) {
+    switch (busNum) {
+        case 1: return &globalCAN1;
+        case 2: return &globalCAN2;
+        case 3: return &globalCAN3;
+        default: return nullptr;
+    }
+}
+
+int usage() {
+    fprintf(stderr,
+            "usage: can_host tractor --brand NAME [--vbus N] [--kbus N] [options]\n"
+            "       can_host keya [options]\n"
+            "options: --if canN=IFACE  --replay LOG  --tx-log FILE|-  --pwm N\n"
+            "         --duration S  --debug\n");
+    return 2;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return usage();
+    }
+    const bool tractor = strcmp(argv[1], "tractor") == 0;
+    if (!tractor && strcmp(argv[1], "keya") != 0) {
+        return usage();
+    }
+
+    const BrandName* brand = nullptr;
+    int vbus = 3;
+    int kbus = 1;
+    const char* replayPath = nullptr;
+    const char* txLogPath = nullptr;
+    bool enable = false;
+    int pwm = 0;
+    double duration = 0;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (arg == "--debug") {
+            EventLogger::getInstance()->setLevel(EventSeverity::DEBUG);
+            continue;
+        }
+        if (!value) {
+            return usage();
+        }
+        i++;
+        if (arg == "--brand") {
+            for (const BrandName& b : BRANDS) {
+                if (strcmp(b.name, value) == 0) brand = &b;
+            }
+            if (!brand) {
+                fprintf(stderr, "unknown brand '%s'\n", value);
+                return 2;
+            }
+        } else if (arg == "--vbus") {
+            vbus = atoi(value);
+        } else if (arg == "--kbus") {
+            kbus = atoi(value);
+        } else if (arg == "--if") {
+            int bus = 0;
+            const char* eq = strchr(value, '=');
+            HostCANInterface* can = (eq && sscanf(value, "can%d=", &bus) == 1) ? getInterface(bus) : nullptr;
+            if (!can) {
+                return usage();
+            }
+            if (!can->attach(eq + 1)) {
+                fprintf(stderr, "cannot open SocketCAN interface '%s'\n", eq + 1);
+                return 1;
+            }
+        } else if (arg == "--replay") {
+            replayPath = value;
+        } else if (arg == "--tx-log") {
+            txLogPath = value;
+        } else if (arg == "--pwm") {
+            pwm = atoi(value);
+            enable = true;
+        } else if (arg == "--duration") {
+            duration = atof(value);
+        } else {
+            return usage();
+        }
+    }
+    if (tractor && !brand) {
+        return usage();
+    }
+    if (vbus < 1 || vbus > 3 || kbus < 1 || kbus > 3) {
+        return usage();
+    }
+
+    std::vector<LogFrame> frames;
+    if (replayPath) {
+        if (!loadLog(replayPath, frames) || frames.empty()) {
+            fprintf(stderr, "no frames in '%s'\n", replayPath);
+            return 1;
+        }
+        host::simMicros() = 0;
+    }
+    if (txLogPath) {
+        txLog = strcmp(txLogPath, "-") == 0 ? stdout : fopen(txLogPath, "w");
+        if (!txLog) {
+            fprintf(stderr, "cannot write '%s'\n", txLogPath);
+            return 1;
+        }
+    }
+
+    initializeGlobalCANBuses();
+    setCANFrameObservers(nullptr, onTxFrame);
+
+    TractorCANDriver* tractorDriver = nullptr;
+    MotorDriverInterface* driver = nullptr;
+    if (tractor) {
+        CANSteerConfig config;
+        config.brand = static_cast<uint8_t>(brand->brand);
+        if (brand->brand == TractorBrand::GENERIC) {
+            setBusFunction(config, vbus, CANFunction::KEYA);
+        } else {
+            setBusFunction(config, vbus, CANFunction::V_BUS);
+            if (kbus != vbus) {
+                setBusFunction(config, kbus, CANFunction::K_BUS);
+            }
+        }
+        configManager.setCANSteerConfig(config);
+        tractorDriver = new TractorCANDriver();
+        driver = tractorDriver;
+    } else {
+        driver = new KeyaCANDriver();
+    }
+    driver->init();
+    driver->enable(enable);
+    driver->setPWM(pwm);
+
+    signal(SIGINT, onSignal);
+    const uint64_t logStart = frames.empty() ? 0 : frames.front().timeUs;
+    const uint64_t endUs = !frames.empty() ? frames.back().timeUs - logStart + REPLAY_TAIL_MS * 1000ULL
+                                           : (uint64_t)(duration * 1e6);
+    const uint64_t startUs = host::nowMicros();
+    size_t nextFrame = 0;
+    uint32_t injected = 0;
+    uint32_t lastFeedbackMs = 0;
+    uint32_t lastProcessMs = 0;
+    uint64_t feedbackCycles = 0;
+    uint32_t feedbackCalls = 0;
+    bool wasDetected = false;
+    bool wasEngaged = false;
+
+    while (!stopRequested) {
+        uint64_t elapsedUs = host::nowMicros() - startUs;
+        if (endUs && elapsedUs >= endUs) {
+            break;
+        }
+
+        while (nextFrame < frames.size() && frames[nextFrame].timeUs - logStart <= elapsedUs) {
+            if (injectCANFrame(frames[nextFrame].bus, frames[nextFrame].msg)) {
+                injected++;
+            }
+            nextFrame++;
+        }
+
+        uint32_t now = millis();
+        if (now - lastFeedbackMs >= FEEDBACK_PERIOD_MS) {
+            lastFeedbackMs = now;
+            uint32_t start = ARM_DWT_CYCCNT;
+            driver->processFeedback();
+            feedbackCycles += ARM_DWT_CYCCNT - start;
+            feedbackCalls++;
+        }
+        if (now - lastProcessMs >= PROCESS_PERIOD_MS) {
+            lastProcessMs = now;
+            driver->process();
+        }
+        processCANTransmit();
+        for (uint8_t busNum = 1; busNum <= 3; busNum++) {
+            while (hostCANTransmit(busNum)) {
+                processCANTransmit();
+            }
+        }
+
+        bool detected = driver->isDetected();
+        bool engaged = tractorDriver && isEngaged(*tractorDriver, brand->brand);
+        if (detected != wasDetected || engaged != wasEngaged) {
+            printf("%10.3f  ready %d  engaged %d\n", elapsedUs / 1e6, detected, engaged);
+            wasDetected = detected;
+            wasEngaged = engaged;
+        }
+
+        if (host::simMicros() >= 0) {
+            host::simMicros() += TICK_US;
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(TICK_US));
+        }
+    }
+
+    printf("\n%s: %u frames in, %u frames out\n", driver->getTypeName(),
+           replayPath ? injected : 0, txFrames);
+    if (feedbackCalls > 0) {
+        printf("processFeedback() avg %.2f us over %u calls\n",
+               feedbackCycles / (F_CPU_ACTUAL / 1e6) / feedbackCalls, feedbackCalls);
+    }
+    for (uint8_t busNum = 1; busNum <= 3; busNum++) {
+        const CANTxStats& tx = getCANBus(busNum)->getTxScheduler().getStats();
+        if (tx.steerSent || tx.sent || tx.dropped) {
+            printf("CAN%d TX: steer %u, other %u, dropped %u\n", busNum,
+                   (unsigned)tx.steerSent, (unsigned)tx.sent, (unsigned)tx.dropped);
+        }
+    }
+    if (tractorDriver) {
+        tractorDriver->printCANStatus();
+    }
+    fflush(stdout);
+
+    if (txLog && txLog != stdout) {
+        fclose(txLog);
+    }
+    // Reader threads block in recv() - leave without tearing the buses down
+    std::_Exit(0);
+}
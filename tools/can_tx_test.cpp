@@ -0,0 +1,392 @@
+// can_tx_test.cpp - Host checks for CAN transmit ordering
+// Runs the firmware's CANTxScheduler on the tools/host backend, where the
+// transmit mailboxes stay pending until hostCANTransmit() sends the winner
+// of arbitration, one frame at a time with a scheduler pass in between -
+// the interleaving that reorders frames on the board if the scheduler
+// refills a lower mailbox while older frames with the same ID still wait.
+//
+//     burst    same-ID frames through send(), alongside periodic and
+//              steering traffic, must come out in send() order
+//     etp      J1939Stack sends a multi-window ETP message to a scripted
+//              receiver on the other end of the wire, which grants CTS
+//              windows larger than the scheduler queue, checks that every
+//              DT sequence number arrives in order and acknowledges
+//     vt       VTClient connects to a scripted VT that has no stored
+//              versions, uploads the object pool over TP in 16-packet
+//              windows and must reach the connected state with the VT
+//              holding exactly the pool tools/vt_pool.py generated
+//
+// Build and run from the repo root:
+//     g++ -O2 -std=gnu++17 -pthread -Itools/host -Ilib/aio_communications
+//         -Ilib/aio_isobus -Ilib/aio_system -o can_tx_test tools/can_tx_test.cpp
+//         tools/host/HostCAN.cpp lib/aio_communications/CANGlobals.cpp
+//         lib/aio_communications/CANTxScheduler.cpp
+//         lib/aio_communications/J1939Stack.cpp lib/aio_isobus/VTClient.cpp
+//     ./can_tx_test
+// Exits non-zero if a check fails.
+#include <vector>
+#include "CANBus.h"
+#include "ConfigManager.h"
+#include "HostCAN.h"
+#include "J1939Stack.h"
+#include "VTClient.h"
+#include "VTObjectPool.h"
+
+ConfigManager configManager;
+
+namespace {
+
+constexpr uint8_t BUS = 1;
+constexpr uint32_t BURST_ID = 0x18EB2A80;       // TP.DT-like, priority 6
+constexpr uint32_t PERIODIC_ID = 0x0CFF0180;    // Wins arbitration over the burst
+constexpr uint32_t STEER_ID = 0x0CEF2CF0;
+constexpr uint8_t BURST_FRAMES = 12;
+
+constexpr uint8_t PEER_ADDRESS = 0x26;
+constexpr uint32_t ETP_PGN = 0xE700;            // ECU to VT
+constexpr uint32_t ETP_SIZE = 2500;             // 358 packets
+constexpr uint8_t ETP_WINDOW = 64;              // Packets per CTS
+constexpr uint8_t VT_WINDOW = 16;
+constexpr uint32_t VT_STATUS_MS = 1000;
+constexpr uint32_t VT_PROCESS_MS = 100;         // VTClient runs at 10Hz
+
+int failures = 0;
+
+void check(bool ok, const char* test, const char* what) {
+    printf("%-8s %-4s %s\n", test, ok ? "ok" : "FAIL", what);
+    if (!ok) {
+        failures++;
+    }
+}
+
+CAN_message_t makeFrame(uint32_t id, uint8_t seq) {
+    CAN_message_t msg;
+    msg.id = id;
+    msg.flags.extended = 1;
+    msg.len = 8;
+    msg.buf[0] = seq;
+    return msg;
+}
+
+void testBurst() {
+    CANTxScheduler& tx = getCANBus(BUS)->getTxScheduler();
+    int8_t periodic = tx.addPeriodic(makeFrame(PERIODIC_ID, 0), 1, 1);
+
+    // Everything the scheduler takes is in the mailboxes or the queue before
+    // the first frame leaves, so every refill below races the older frames
+    bool accepted = true;
+    for (uint8_t i = 0; i < BURST_FRAMES; i++) {
+        accepted &= tx.send(makeFrame(BURST_ID, i));
+    }
+    tx.sendSteer(0, makeFrame(STEER_ID, 0));
+    check(accepted, "burst", "scheduler takes the whole burst");
+
+    std::vector<uint8_t> order;
+    uint32_t others = 0;
+    CAN_message_t sent;
+    for (uint32_t step = 0; step < 200 && hostCANTransmit(BUS, &sent); step++) {
+        if (sent.id == BURST_ID) {
+            order.push_back(sent.buf[0]);
+        } else {
+            others++;
+        }
+        host::simMicros() += 500;       // One frame at 250kbps
+        tx.process();
+    }
+    tx.removePeriodic(periodic);
+    while (hostCANTransmit(BUS)) {
+        tx.process();
+    }
+
+    bool inOrder = order.size() == BURST_FRAMES;
+    for (size_t i = 0; inOrder && i < order.size(); i++) {
+        inOrder = order[i] == i;
+    }
+    if (!inOrder) {
+        printf("         burst order:");
+        for (uint8_t seq : order) {
+            printf(" %u", seq);
+        }
+        printf("\n");
+    }
+    check(inOrder, "burst", "same-ID frames leave in send() order");
+    check(others > 1, "burst", "periodic and steering frames interleave");
+}
+
+// The far end of a TP or ETP transfer to PEER_ADDRESS, fed the frames on the wire
+struct TpReceiver {
+    static constexpr uint32_t MAX_SIZE = 4096;
+
+    uint8_t window;
+    bool extended = false;
+    uint32_t pgn = 0;
+    uint32_t size = 0;
+    uint32_t nextPacket = 1;
+    uint32_t windowEnd = 0;
+    uint32_t dpoOffset = 0;
+    uint32_t windows = 0;
+    uint32_t outOfOrder = 0;
+    bool complete = false;
+    uint8_t data[MAX_SIZE];
+
+    explicit TpReceiver(uint8_t packetsPerCTS) : window(packetsPerCTS) {}
+
+    void reply(const uint8_t* d) {
+        uint32_t cm = extended ? J1939Stack::PGN_ETP_CM : J1939Stack::PGN_TP_CM;
+        CAN_message_t msg;
+        msg.id = (7UL << 26) | ((cm | J1939Stack::getInstance()->getAddress()) << 8) | PEER_ADDRESS;
+        msg.flags.extended = 1;
+        msg.len = 8;
+        memcpy(msg.buf, d, 8);
+        injectCANFrame(BUS, msg);
+    }
+
+    void sendCTS() {
+        uint32_t count = (size + 6) / 7 - nextPacket + 1;
+        if (count > window) {
+            count = window;
+        }
+        windowEnd = nextPacket + count - 1;
+        windows++;
+        uint8_t d[8] = {(uint8_t)(extended ? 21 : 17), (uint8_t)count, (uint8_t)nextPacket,
+                        (uint8_t)(extended ? nextPacket >> 8 : 0xFF), (uint8_t)(extended ? nextPacket >> 16 : 0xFF),
+                        (uint8_t)pgn, (uint8_t)(pgn >> 8), (uint8_t)(pgn >> 16)};
+        reply(d);
+    }
+
+    void sendEOMA() {
+        uint8_t d[8] = {(uint8_t)(extended ? 23 : 19), (uint8_t)size, (uint8_t)(size >> 8),
+                        (uint8_t)(extended ? size >> 16 : (size + 6) / 7),
+                        (uint8_t)(extended ? size >> 24 : 0xFF),
+                        (uint8_t)pgn, (uint8_t)(pgn >> 8), (uint8_t)(pgn >> 16)};
+        reply(d);
+    }
+
+    // True if the frame belonged to the transfer
+    bool onFrame(const CAN_message_t& msg) {
+        uint32_t pf = (msg.id >> 16) & 0xFF;
+        if (((msg.id >> 8) & 0xFF) != PEER_ADDRESS) {
+            return false;
+        }
+        const uint8_t* d = msg.buf;
+        if (pf == (J1939Stack::PGN_TP_CM >> 8) || pf == (J1939Stack::PGN_ETP_CM >> 8)) {
+            if (d[0] == 16 || d[0] == 20) {         // RTS
+                extended = d[0] == 20;
+                size = d[1] | (d[2] << 8) | (extended ? ((uint32_t)d[3] << 16) | ((uint32_t)d[4] << 24) : 0);
+                pgn = d[5] | (d[6] << 8) | ((uint32_t)d[7] << 16);
+                nextPacket = 1;
+                dpoOffset = 0;
+                complete = size > MAX_SIZE;
+                if (!complete) {
+                    sendCTS();
+                }
+            } else if (d[0] == 22) {                // DPO
+                dpoOffset = d[2] | (d[3] << 8) | ((uint32_t)d[4] << 16);
+            }
+            return true;
+        }
+        if (pf != (J1939Stack::PGN_TP_DT >> 8) && pf != (J1939Stack::PGN_ETP_DT >> 8)) {
+            return false;
+        }
+
+        uint32_t packet = dpoOffset + d[0];
+        if (packet != nextPacket) {
+            outOfOrder++;
+            return true;
+        }
+        uint32_t offset = (packet - 1) * 7;
+        uint32_t n = size - offset > 7 ? 7 : size - offset;
+        memcpy(data + offset, &d[1], n);
+        nextPacket++;
+        if (offset + n == size) {
+            sendEOMA();
+            complete = true;
+        } else if (packet == windowEnd) {
+            sendCTS();
+        }
+        return true;
+    }
+};
+
+// A VT with no stored pool versions at PEER_ADDRESS
+struct ScriptedVT {
+    TpReceiver pool{VT_WINDOW};
+    uint32_t lastStatusMs = 0;
+    bool statusSent = false;
+    bool poolComplete = false;      // Transfer finished when End of Object Pool came
+
+    void sendToECU(const uint8_t* d, uint8_t destination) {
+        CAN_message_t msg;
+        msg.id = (5UL << 26) | ((VTClient::PGN_VT_TO_ECU | destination) << 8) | PEER_ADDRESS;
+        msg.flags.extended = 1;
+        msg.len = 8;
+        memcpy(msg.buf, d, 8);
+        injectCANFrame(BUS, msg);
+    }
+
+    void tick() {
+        if (statusSent && millis() - lastStatusMs < VT_STATUS_MS) {
+            return;
+        }
+        uint8_t d[8] = {0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};  // VT Status
+        sendToECU(d, J1939Stack::GLOBAL_ADDRESS);
+        lastStatusMs = millis();
+        statusSent = true;
+    }
+
+    void onFrame(const CAN_message_t& msg) {
+        if (pool.onFrame(msg) || ((msg.id >> 16) & 0xFF) != (VTClient::PGN_ECU_TO_VT >> 8) ||
+            ((msg.id >> 8) & 0xFF) != PEER_ADDRESS) {
+            return;
+        }
+
+        uint8_t ecu = msg.id & 0xFF;
+        uint8_t d[8];
+        memset(d, 0xFF, sizeof(d));
+        d[0] = msg.buf[0];
+        switch (msg.buf[0]) {
+            case 0xC0:          // Get Memory: VT version 4, enough memory
+                d[1] = 4;
+                d[2] = 0;
+                break;
+            case 0xDF:          // Get Versions: none stored
+                d[0] = 0xE0;
+                d[1] = 0;
+                break;
+            case 0x12:          // End of Object Pool: no errors
+                poolComplete = pool.complete;
+                d[1] = 0;
+                d[2] = 0xFF;
+                d[3] = 0xFF;
+                d[4] = 0xFF;
+                d[5] = 0xFF;
+                d[6] = 0;
+                break;
+            case 0xD0:          // Store Version: ok
+                d[5] = 0;
+                break;
+            default:
+                return;         // Maintenance, live values
+        }
+        sendToECU(d, ecu);
+    }
+};
+
+TpReceiver etpReceiver(ETP_WINDOW);
+ScriptedVT vt;
+uint8_t etpPayload[ETP_SIZE];
+int etpResult = -1;
+
+void onEtpDone(uint32_t, uint8_t, bool ok, void*) { etpResult = ok; }
+void etpPeer(const CAN_message_t& msg) { etpReceiver.onFrame(msg); }
+void vtPeer(const CAN_message_t& msg) { vt.onFrame(msg); }
+
+// Firmware loop, one frame on the wire per pass
+void runWire(J1939Stack& stack, uint32_t passes, void (*peer)(const CAN_message_t& msg)) {
+    for (uint32_t i = 0; i < passes; i++) {
+        stack.process();
+        processCANTransmit();
+        CAN_message_t sent;
+        if (hostCANTransmit(BUS, &sent) && peer) {
+            peer(sent);
+        }
+        host::simMicros() += 500;
+    }
+}
+
+void testEtp() {
+    CANSteerConfig config;
+    config.can1Function = static_cast<uint8_t>(CANFunction::ISO_BUS);
+    configManager.setCANSteerConfig(config);
+    J1939Stack::init();
+    J1939Stack& stack = *J1939Stack::getInstance();
+    runWire(stack, (J1939Stack::CLAIM_WAIT_MS + 10) * 2, nullptr);
+    check(stack.isAddressClaimed(), "etp", "address claimed");
+
+    for (uint32_t i = 0; i < ETP_SIZE; i++) {
+        etpPayload[i] = (uint8_t)(i * 7 + i / 251);
+    }
+    bool started = stack.send(ETP_PGN, PEER_ADDRESS, etpPayload, ETP_SIZE, 7, onEtpDone);
+    check(started, "etp", "transfer starts");
+
+    // Other traffic shares the queue with the DT packets
+    CANTxScheduler& tx = getCANBus(BUS)->getTxScheduler();
+    int8_t periodic = tx.addPeriodic(makeFrame(PERIODIC_ID, 0), 5, 5);
+    for (uint32_t pass = 0; pass < 20000 && etpResult < 0; pass++) {
+        if (pass % 50 == 0) {
+            writeCANFrame(BUS, makeFrame(BURST_ID, (uint8_t)pass));
+        }
+        runWire(stack, 1, etpPeer);
+    }
+    tx.removePeriodic(periodic);
+    runWire(stack, 100, nullptr);
+
+    printf("         %u packets in %u CTS windows\n",
+           (unsigned)(etpReceiver.nextPacket - 1), (unsigned)etpReceiver.windows);
+    check(etpReceiver.extended && etpReceiver.windows > 1, "etp", "ETP transfer spans several CTS windows");
+    check(etpReceiver.outOfOrder == 0, "etp", "DT sequence numbers arrive in order");
+    check(etpReceiver.complete && memcmp(etpReceiver.data, etpPayload, ETP_SIZE) == 0, "etp",
+          "receiver reassembles the message");
+    check(etpResult == 1 && stack.getStats().abortsSent == 0, "etp", "sender completes without abort");
+}
+
+// PackBits, independent of VTClient's streaming decoder
+uint32_t unpackPool(uint8_t* out, uint32_t capacity) {
+    uint32_t in = 0;
+    uint32_t n = 0;
+    while (in < VT_POOL_PACKED_SIZE) {
+        uint8_t c = VT_POOL_PACKED[in++];
+        if (c < 128) {
+            for (uint32_t k = 0; k <= c && n < capacity; k++) {
+                out[n++] = VT_POOL_PACKED[in++];
+            }
+        } else if (c > 128) {
+            uint8_t b = VT_POOL_PACKED[in++];
+            for (uint32_t k = 0; k < 257u - c && n < capacity; k++) {
+                out[n++] = b;
+            }
+        }
+    }
+    return n;
+}
+
+void testVT() {
+    J1939Stack& stack = *J1939Stack::getInstance();
+    VTClient::init();
+    VTClient& client = *VTClient::getInstance();
+    uint32_t abortsBefore = stack.getStats().abortsSent;
+
+    uint32_t lastProcessMs = millis();
+    for (uint32_t pass = 0; pass < 40000 && !client.isConnected(); pass++) {
+        vt.tick();
+        if (millis() - lastProcessMs >= VT_PROCESS_MS) {
+            lastProcessMs = millis();
+            client.process();
+        }
+        runWire(stack, 1, vtPeer);
+    }
+
+    static uint8_t pool[TpReceiver::MAX_SIZE];
+    uint32_t poolSize = unpackPool(pool, sizeof(pool));
+    const TpReceiver& rx = vt.pool;
+    printf("         pool %u bytes in %u TP windows, upload %u ms\n", (unsigned)(rx.size ? rx.size - 1 : 0),
+           (unsigned)rx.windows, (unsigned)client.getStats().uploadMs);
+    check(poolSize == VT_POOL_SIZE, "vt", "packed pool expands to VT_POOL_SIZE");
+    check(!rx.extended && rx.windows > 1 && rx.outOfOrder == 0, "vt", "pool arrives over TP in order");
+    check(vt.poolComplete && rx.size == VT_POOL_SIZE + 1 && rx.data[0] == 0x11 &&
+          memcmp(rx.data + 1, pool, VT_POOL_SIZE) == 0, "vt", "VT holds the generated pool");
+    check(client.isConnected() && client.getStats().uploads == 1, "vt", "client connected after one upload");
+    check(stack.getStats().abortsSent == abortsBefore, "vt", "no transfer aborted");
+}
+
+} // namespace
+
+int main() {
+    host::simMicros() = 0;
+    testBurst();
+    testEtp();
+    testVT();
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
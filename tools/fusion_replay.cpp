@@ -0,0 +1,697 @@
+// fusion_replay.cpp - Offline replay and parameter sweep for the wheel angle fusion
+// Replays recorded sessions through lib/aio_autosteer/SteerAngleEKF and the
+// HeadingRateTracker, ticking at the control rate in the same order as
+// WheelAngleFusion::update() (predict, GNSS speed and heading rate, IMU,
+// WAS, Keya encoder). The analog WAS in the recording is the ground truth,
+// so it is not fused unless use_was=1. Every parameter set runs over every
+// session; sets are spread over the CPU cores and reported by angle RMS
+// error, with the CPU cost of one fusion update.
+//
+// Sessions are text, one timestamped sample per line. CAN lines are candump
+// -l format, so captures from tools/can_capture.py drop straight in:
+//
+//     # was_offset=0 was_cpd=30 was_invert=0     WAS calibration (header)
+//     (12.345678) can1 07000001#1F400000000A0000  Keya heartbeat
+//     (12.350000) gnss $GNVTG,...*hh              VTG heading/speed, HPR dual heading
+//     (12.351000) imu 1.25                        Yaw rate, deg/s
+//     (12.352000) was 2310                        Raw WAS counts
+//
+// Without a field recording, "synth" writes a session from the vehicle
+// model with sensor noise, latency and biases.
+//
+// Build and run from the repo root:
+//     g++ -O2 -pthread -Ilib/aio_autosteer -o fusion_replay tools/fusion_replay.cpp
+//         lib/aio_autosteer/SteerAngleEKF.cpp lib/aio_autosteer/SteerPlant.cpp
+//     ./fusion_replay synth -o session.log [--duration 180] [--seed 1]
+//     ./fusion_replay session.log [more.log] [-j 8] [--top 20] [--csv]
+//         [--set gnss_lat=50,100,150] [--set rate_noise=50:400:50] ...
+//     ./fusion_replay --keys
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include "SteerAngleEKF.h"
+#include "SteerPlant.h"
+
+namespace {
+
+constexpr uint32_t KEYA_HEARTBEAT_ID = 0x07000001;
+constexpr float KNOTS_TO_MS = 0.514444f;
+constexpr float MAX_HEALTHY_SIGMA = 2.0f;           // WheelAngleFusion health limits
+constexpr uint32_t SENSOR_TIMEOUT_US = 500000;
+
+// ---------------------------------------------------------------------------
+// Sessions
+
+enum class EventType : uint8_t { WAS, KEYA, GNSS_VTG, GNSS_HPR, IMU };
+
+struct Event {
+    uint32_t us;            // From the start of the session
+    EventType type;
+    float a;                // WAS raw, Keya position, heading or yaw rate
+    float b;                // VTG speed (m/s)
+};
+
+struct Session {
+    std::string name;
+    std::vector<Event> events;
+    int16_t wasOffset = 0;
+    float wasCountsPerDegree = 100.0f;
+    bool wasInvert = false;
+
+    // ADProcessor::getWASAngle()
+    float wasAngle(float raw) const {
+        float angle = (raw - 2048.0f - wasOffset) / wasCountsPerDegree;
+        return wasInvert ? -angle : angle;
+    }
+};
+
+uint8_t nmeaChecksum(const char* start, const char* end) {
+    uint8_t sum = 0;
+    for (const char* p = start; p < end; p++) {
+        sum ^= (uint8_t)*p;
+    }
+    return sum;
+}
+
+// Splits "$GNVTG,a,b,...*hh" into fields; false if the checksum is wrong
+bool splitNMEA(const char* sentence, std::vector<std::string>& fields) {
+    if (sentence[0] != '$') {
+        return false;
+    }
+    const char* star = strchr(sentence, '*');
+    const char* end = star ? star : sentence + strlen(sentence);
+    if (star && strtoul(star + 1, nullptr, 16) != nmeaChecksum(sentence + 1, star)) {
+        return false;
+    }
+    fields.clear();
+    const char* field = sentence + 1;
+    for (const char* p = field; p <= end; p++) {
+        if (p == end || *p == ',') {
+            fields.emplace_back(field, p - field);
+            field = p + 1;
+        }
+    }
+    return fields.size() > 1 && fields[0].size() >= 5;
+}
+
+bool parseGNSS(const char* sentence, Event& e) {
+    std::vector<std::string> f;
+    if (!splitNMEA(sentence, f)) {
+        return false;
+    }
+    const char* type = f[0].c_str() + f[0].size() - 3;
+    // Same fields GNSSProcessor uses
+    if (strcmp(type, "VTG") == 0 && f.size() > 5 && !f[1].empty() && !f[5].empty()) {
+        e.type = EventType::GNSS_VTG;
+        e.a = strtof(f[1].c_str(), nullptr);
+        e.b = strtof(f[5].c_str(), nullptr) * KNOTS_TO_MS;
+        return true;
+    }
+    if (strcmp(type, "HPR") == 0 && f.size() > 2 && !f[2].empty()) {
+        e.type = EventType::GNSS_HPR;
+        e.a = strtof(f[2].c_str(), nullptr);
+        return true;
+    }
+    return false;
+}
+
+// "ID#DATA" from candump; only the Keya heartbeat matters here
+bool parseCAN(const char* frame, Event& e) {
+    const char* hash = strchr(frame, '#');
+    if (!hash || hash - frame != 8) {
+        return false;
+    }
+    uint32_t id = strtoul(std::string(frame, hash - frame).c_str(), nullptr, 16);
+    if (id != KEYA_HEARTBEAT_ID || strlen(hash + 1) < 4) {
+        return false;
+    }
+    // Bytes 0-1: position, big-endian
+    char pos[5] = {hash[1], hash[2], hash[3], hash[4], '\0'};
+    e.type = EventType::KEYA;
+    e.a = (float)strtoul(pos, nullptr, 16);
+    return true;
+}
+
+void parseHeader(const char* line, Session& session) {
+    char key[32];
+    char value[32];
+    const char* p = line + 1;
+    int used = 0;
+    while (sscanf(p, " %31[^= ]=%31s%n", key, value, &used) == 2) {
+        if (strcmp(key, "was_offset") == 0) session.wasOffset = (int16_t)atoi(value);
+        else if (strcmp(key, "was_cpd") == 0) session.wasCountsPerDegree = strtof(value, nullptr);
+        else if (strcmp(key, "was_invert") == 0) session.wasInvert = atoi(value) != 0;
+        p += used;
+    }
+}
+
+bool loadSession(const char* path, Session& session) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+    session.name = path;
+
+    char line[512];
+    bool haveStart = false;
+    uint64_t startUs = 0;
+    size_t skipped = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '#') {
+            parseHeader(line, session);
+            continue;
+        }
+        unsigned long sec = 0, usec = 0;
+        char source[16];
+        int used = 0;
+        if (sscanf(line, "(%lu.%lu) %15s %n", &sec, &usec, source, &used) != 3) {
+            if (line[0] != '\0') skipped++;
+            continue;
+        }
+        const char* payload = line + used;
+        uint64_t us = (uint64_t)sec * 1000000ULL + usec;
+        if (!haveStart) {
+            startUs = us;
+            haveStart = true;
+        }
+
+        Event e = {};
+        e.us = (uint32_t)(us - startUs);
+        bool ok = false;
+        if (strncmp(source, "can", 3) == 0) {
+            ok = parseCAN(payload, e);
+            if (!ok) continue;      // Other traffic on the bus is expected
+        } else if (strcmp(source, "gnss") == 0) {
+            ok = parseGNSS(payload, e);
+            if (!ok && strstr(payload, "VTG") == nullptr && strstr(payload, "HPR") == nullptr) {
+                continue;           // GGA and friends carry nothing for the filter
+            }
+        } else if (strcmp(source, "imu") == 0) {
+            e.type = EventType::IMU;
+            ok = sscanf(payload, "%f", &e.a) == 1;
+        } else if (strcmp(source, "was") == 0) {
+            e.type = EventType::WAS;
+            ok = sscanf(payload, "%f", &e.a) == 1;
+        }
+        if (ok) {
+            session.events.push_back(e);
+        } else {
+            skipped++;
+        }
+    }
+    fclose(file);
+
+    // candump output from several interfaces may be slightly out of order
+    std::stable_sort(session.events.begin(), session.events.end(),
+                     [](const Event& x, const Event& y) { return x.us < y.us; });
+    if (skipped) {
+        fprintf(stderr, "%s: skipped %zu unreadable lines\n", path, skipped);
+    }
+    if (session.events.empty()) {
+        fprintf(stderr, "%s: no usable samples\n", path);
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Parameter sets
+
+struct ReplayParams {
+    SteerAngleEKF::Params ekf;
+    float encoderCountsPerDegree = 100.0f;
+    int rateHz = 100;
+    bool useWAS = false;
+    bool useEncoder = true;
+    bool useGNSS = true;
+    bool useIMU = true;
+};
+
+struct Key {
+    const char* name;
+    const char* help;
+    void (*apply)(ReplayParams& p, float v);
+};
+
+const Key KEYS[] = {
+    {"wheelbase", "m", [](ReplayParams& p, float v) { p.ekf.wheelbase = v; }},
+    {"min_speed", "m/s", [](ReplayParams& p, float v) { p.ekf.minSpeed = v; }},
+    {"rate_noise", "angle acceleration noise, (deg/s^2)^2/Hz", [](ReplayParams& p, float v) { p.ekf.rateNoise = v; }},
+    {"enc_bias_noise", "deg^2/s", [](ReplayParams& p, float v) { p.ekf.encoderBiasNoise = v; }},
+    {"yaw_bias_noise", "(deg/s)^2/s", [](ReplayParams& p, float v) { p.ekf.yawBiasNoise = v; }},
+    {"gate", "innovation gate, sigma", [](ReplayParams& p, float v) { p.ekf.gateSigma = v; }},
+    {"window", "adaptive noise window, samples", [](ReplayParams& p, float v) { p.ekf.innovationWindow = (uint16_t)v; }},
+    {"was_noise", "deg", [](ReplayParams& p, float v) { p.ekf.sensorNoise[SteerAngleEKF::WAS] = v; }},
+    {"enc_noise", "deg", [](ReplayParams& p, float v) { p.ekf.sensorNoise[SteerAngleEKF::ENCODER] = v; }},
+    {"gnss_noise", "deg/s", [](ReplayParams& p, float v) { p.ekf.sensorNoise[SteerAngleEKF::GNSS_HEADING_RATE] = v; }},
+    {"imu_noise", "deg/s", [](ReplayParams& p, float v) { p.ekf.sensorNoise[SteerAngleEKF::IMU_YAW_RATE] = v; }},
+    {"was_lat", "ms", [](ReplayParams& p, float v) { p.ekf.latencyMs[SteerAngleEKF::WAS] = (uint16_t)v; }},
+    {"enc_lat", "ms", [](ReplayParams& p, float v) { p.ekf.latencyMs[SteerAngleEKF::ENCODER] = (uint16_t)v; }},
+    {"gnss_lat", "ms", [](ReplayParams& p, float v) { p.ekf.latencyMs[SteerAngleEKF::GNSS_HEADING_RATE] = (uint16_t)v; }},
+    {"imu_lat", "ms", [](ReplayParams& p, float v) { p.ekf.latencyMs[SteerAngleEKF::IMU_YAW_RATE] = (uint16_t)v; }},
+    {"counts_per_deg", "Keya encoder counts per wheel degree", [](ReplayParams& p, float v) { p.encoderCountsPerDegree = v; }},
+    {"rate", "control loop Hz", [](ReplayParams& p, float v) { p.rateHz = (int)v; }},
+    {"use_was", "0/1", [](ReplayParams& p, float v) { p.useWAS = v != 0.0f; }},
+    {"use_encoder", "0/1", [](ReplayParams& p, float v) { p.useEncoder = v != 0.0f; }},
+    {"use_gnss", "0/1", [](ReplayParams& p, float v) { p.useGNSS = v != 0.0f; }},
+    {"use_imu", "0/1", [](ReplayParams& p, float v) { p.useIMU = v != 0.0f; }},
+};
+
+const Key* findKey(const std::string& name) {
+    for (const Key& k : KEYS) {
+        if (name == k.name) return &k;
+    }
+    return nullptr;
+}
+
+struct Sweep {
+    const Key* key;
+    std::vector<float> values;
+};
+
+// "key=v1,v2,v3" or "key=from:to:step"
+bool parseSweep(const char* arg, Sweep& sweep) {
+    const char* eq = strchr(arg, '=');
+    if (!eq) return false;
+    sweep.key = findKey(std::string(arg, eq - arg));
+    if (!sweep.key) return false;
+
+    float from, to, step;
+    if (sscanf(eq + 1, "%f:%f:%f", &from, &to, &step) == 3 && step > 0.0f) {
+        for (float v = from; v <= to + step * 0.001f; v += step) {
+            sweep.values.push_back(v);
+        }
+    } else {
+        for (const char* p = eq + 1; *p; ) {
+            char* end;
+            sweep.values.push_back(strtof(p, &end));
+            if (end == p) return false;
+            p = *end == ',' ? end + 1 : end;
+        }
+    }
+    return !sweep.values.empty();
+}
+
+struct Candidate {
+    ReplayParams params;
+    std::string label;
+};
+
+std::vector<Candidate> expand(const std::vector<Sweep>& sweeps) {
+    std::vector<Candidate> out(1);
+    for (const Sweep& s : sweeps) {
+        std::vector<Candidate> next;
+        for (const Candidate& c : out) {
+            for (float v : s.values) {
+                Candidate n = c;
+                s.key->apply(n.params, v);
+                char text[48];
+                snprintf(text, sizeof(text), "%s%s=%g", n.label.empty() ? "" : " ", s.key->name, v);
+                n.label += text;
+                next.push_back(n);
+            }
+        }
+        out.swap(next);
+    }
+    if (out[0].label.empty()) out[0].label = "defaults";
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Replay
+
+struct Result {
+    double sumSq = 0.0;
+    double sumSqHealthy = 0.0;
+    float maxError = 0.0f;
+    uint64_t samples = 0;
+    uint64_t healthy = 0;
+    uint64_t updates = 0;
+    double updateNs = 0.0;      // Total time in the filter
+    uint32_t rejected = 0;
+
+    float rms() const { return samples ? (float)std::sqrt(sumSq / samples) : 0.0f; }
+    float rmsHealthy() const { return healthy ? (float)std::sqrt(sumSqHealthy / healthy) : 0.0f; }
+    float healthyPct() const { return samples ? 100.0f * healthy / samples : 0.0f; }
+    double nsPerUpdate() const { return updates ? updateNs / updates : 0.0; }
+};
+
+// WheelAngleFusion::isHealthy() without the update watchdog
+bool isHealthy(const SteerAngleEKF& ekf) {
+    uint32_t newest = 0;
+    bool any = false;
+    for (uint8_t s = 0; s < SteerAngleEKF::SENSOR_COUNT; s++) {
+        const SteerAngleEKF::SensorStats& stats = ekf.getStats((SteerAngleEKF::Sensor)s);
+        if (stats.accepted > 0 && (!any || (int32_t)(stats.lastFusedUs - newest) > 0)) {
+            newest = stats.lastFusedUs;
+            any = true;
+        }
+    }
+    return any && ekf.getTimeUs() - newest <= SENSOR_TIMEOUT_US &&
+           ekf.getAngleVariance() < MAX_HEALTHY_SIGMA * MAX_HEALTHY_SIGMA;
+}
+
+void replay(const Session& session, const ReplayParams& p, float warmupSec, Result& r) {
+    SteerAngleEKF ekf;
+    ekf.setParams(p.ekf);
+    ekf.reset(0.0f);
+    HeadingRateTracker headingRate;
+
+    const uint32_t tickUs = 1000000UL / p.rateHz;
+    const float dt = 1.0f / p.rateHz;
+    const uint32_t warmupUs = (uint32_t)(warmupSec * 1e6f);
+
+    // Latest values, as the processors would hold them
+    float speed = 0.0f;
+    bool haveWAS = false;
+    float wasTruth = 0.0f;
+    bool haveKeya = false;
+    uint16_t keyaPosition = 0;
+    uint16_t keyaLastPosition = 0;
+    float encoderAngle = 0.0f;
+
+    size_t next = 0;
+    const std::vector<Event>& events = session.events;
+    const uint32_t endUs = events.back().us;
+    std::chrono::steady_clock::duration filterTime{0};
+
+    for (uint32_t now = 0; now <= endUs; now += tickUs) {
+        // Samples that arrived since the last tick
+        bool newVTG = false, newHPR = false, newIMU = false;
+        float vtgHeading = 0.0f, hprHeading = 0.0f, imuRate = 0.0f;
+        uint32_t gnssMs = 0;
+        for (; next < events.size() && events[next].us <= now; next++) {
+            const Event& e = events[next];
+            switch (e.type) {
+                case EventType::WAS:
+                    wasTruth = session.wasAngle(e.a);
+                    haveWAS = true;
+                    break;
+                case EventType::KEYA:
+                    keyaPosition = (uint16_t)e.a;
+                    if (!haveKeya) keyaLastPosition = keyaPosition;
+                    haveKeya = true;
+                    break;
+                case EventType::GNSS_VTG:
+                    vtgHeading = e.a;
+                    speed = e.b;
+                    newVTG = true;
+                    gnssMs = e.us / 1000;
+                    break;
+                case EventType::GNSS_HPR:
+                    hprHeading = e.a;
+                    newHPR = true;
+                    gnssMs = e.us / 1000;
+                    break;
+                case EventType::IMU:
+                    imuRate = e.a;
+                    newIMU = true;
+                    break;
+            }
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ekf.predict(dt, now);
+
+        // GNSS: dual heading when the receiver sends it
+        if (newVTG || newHPR) {
+            float heading = newHPR ? hprHeading : vtgHeading;
+            if (headingRate.update(gnssMs, heading) && p.useGNSS) {
+                ekf.fuseYawRate(SteerAngleEKF::GNSS_HEADING_RATE, headingRate.rate, speed);
+            }
+        }
+        if (newIMU && p.useIMU) {
+            ekf.fuseYawRate(SteerAngleEKF::IMU_YAW_RATE, imuRate, speed);
+        }
+        if (haveWAS && p.useWAS) {
+            ekf.fuseWAS(wasTruth);
+        }
+        if (haveKeya && p.useEncoder) {
+            // KeyaCANDriver::getPositionDelta() wraps at 16 bits
+            int16_t delta = (int16_t)(keyaPosition - keyaLastPosition);
+            keyaLastPosition = keyaPosition;
+            encoderAngle += (float)delta / p.encoderCountsPerDegree;
+            ekf.fuseEncoder(encoderAngle);
+        }
+        filterTime += std::chrono::steady_clock::now() - start;
+        r.updates++;
+
+        if (haveWAS && now >= warmupUs) {
+            float error = ekf.getAngle() - wasTruth;
+            r.sumSq += error * error;
+            r.samples++;
+            if (std::fabs(error) > r.maxError) r.maxError = std::fabs(error);
+            if (isHealthy(ekf)) {
+                r.sumSqHealthy += error * error;
+                r.healthy++;
+            }
+        }
+    }
+
+    for (uint8_t s = 0; s < SteerAngleEKF::SENSOR_COUNT; s++) {
+        r.rejected += ekf.getStats((SteerAngleEKF::Sensor)s).rejected;
+    }
+    r.updateNs += std::chrono::duration<double, std::nano>(filterTime).count();
+}
+
+// ---------------------------------------------------------------------------
+// Synthetic session
+
+void writeNMEA(FILE* out, uint64_t us, const char* body) {
+    const char* end = body + strlen(body);
+    fprintf(out, "(%llu.%06llu) gnss $%s*%02X\n", (unsigned long long)(us / 1000000),
+            (unsigned long long)(us % 1000000), body, nmeaChecksum(body, end));
+}
+
+void writeStamp(FILE* out, uint64_t us) {
+    fprintf(out, "(%llu.%06llu) ", (unsigned long long)(us / 1000000), (unsigned long long)(us % 1000000));
+}
+
+int synth(int argc, char** argv) {
+    const char* path = nullptr;
+    float duration = 180.0f;
+    unsigned seed = 1;
+    bool dual = false;
+    for (int i = 0; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) path = argv[++i];
+        else if (strcmp(argv[i], "--duration") == 0 && i + 1 < argc) duration = strtof(argv[++i], nullptr);
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) seed = (unsigned)atoi(argv[++i]);
+        else if (strcmp(argv[i], "--dual") == 0) dual = true;
+    }
+    if (!path) {
+        fprintf(stderr, "synth needs -o <file>\n");
+        return 1;
+    }
+    FILE* out = fopen(path, "w");
+    if (!out) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+
+    // Sensors as seen on a tractor: WAS 30 counts/deg, Keya 100 counts/deg
+    // with an unknown zero, GNSS 10Hz 100ms late, IMU 100Hz with a bias
+    const float wasCpd = 30.0f;
+    const float wasNoise = 0.1f;            // deg
+    const float countsPerDeg = 100.0f;
+    const float encoderBias = 5.0f;         // deg
+    const float gnssHeadingNoise = 0.05f;   // deg
+    const float imuBias = 0.7f;             // deg/s
+    const float imuNoise = 0.3f;            // deg/s
+    const float wheelbase = 2.5f;
+    const int gnssLatencyMs = 100, encoderLatencyMs = 20, imuLatencyMs = 10;
+
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    fprintf(out, "# Synthetic session: seed %u, %.0f s, wheelbase %.2f m\n", seed, duration, wheelbase);
+    fprintf(out, "# was_offset=0 was_cpd=%g was_invert=0\n", wasCpd);
+
+    VehicleModel vehicle(wheelbase);
+    vehicle.reset();
+    const float simDt = 0.001f;
+    const int steps = (int)(duration / simDt);
+    std::vector<float> angleHistory(steps + 1), headingHistory(steps + 1), yawHistory(steps + 1);
+    float angle = 0.0f;
+    uint64_t baseUs = 1000ULL * 1000000ULL;
+
+    for (int i = 0; i <= steps; i++) {
+        float t = i * simDt;
+
+        // Stop, drive off, stop again half way, drive on
+        float speed;
+        float half = duration / 2.0f;
+        if (t < 3.0f) speed = 0.0f;
+        else if (t < 8.0f) speed = (t - 3.0f) * 0.6f;
+        else if (t < half) speed = 3.0f;
+        else if (t < half + 8.0f) speed = 0.0f;
+        else speed = std::min(3.0f, (t - half - 8.0f) * 0.6f);
+
+        // Slow curves and a headland turn every 40 s, rate limited like a real actuator
+        float target = 6.0f * std::sin(t * 0.9f) + 3.0f * std::sin(t * 0.23f);
+        if (std::fmod(t, 40.0f) > 30.0f) target = 25.0f;
+        float maxStep = 25.0f * simDt;
+        angle += std::max(-maxStep, std::min(maxStep, target - angle));
+
+        vehicle.step(speed, angle, simDt);
+        angleHistory[i] = angle;
+        headingHistory[i] = vehicle.getHeading();
+        yawHistory[i] = vehicle.getYawRate();
+
+        uint64_t us = baseUs + (uint64_t)i * 1000ULL;
+        int ms = i;     // One sim step per millisecond
+
+        if (ms % 10 == 0) {
+            float raw = 2048.0f + (angle + wasNoise * normal(rng)) * wasCpd;
+            writeStamp(out, us);
+            fprintf(out, "was %d\n", (int)std::lround(raw));
+
+            float imuRate = yawHistory[std::max(0, i - imuLatencyMs)] + imuBias + imuNoise * normal(rng);
+            writeStamp(out, us + 300);
+            fprintf(out, "imu %.3f\n", imuRate);
+        }
+        if (ms % 20 == 5) {
+            float encAngle = angleHistory[std::max(0, i - encoderLatencyMs)] + encoderBias;
+            uint16_t position = (uint16_t)(int32_t)std::lround(encAngle * countsPerDeg);
+            writeStamp(out, us);
+            fprintf(out, "can1 %08X#%04X000000000000\n", KEYA_HEARTBEAT_ID, position);
+        }
+        if (ms % 100 == 50) {
+            const float* history = headingHistory.data();
+            float heading = history[std::max(0, i - gnssLatencyMs)] + gnssHeadingNoise * normal(rng);
+            heading = std::fmod(heading + 360.0f, 360.0f);
+            char body[96];
+            snprintf(body, sizeof(body), "GNVTG,%.2f,T,,M,%.3f,N,%.3f,K,D", heading, speed / KNOTS_TO_MS,
+                     speed * 3.6f);
+            writeNMEA(out, us, body);
+            if (dual) {
+                snprintf(body, sizeof(body), "GNHPR,%06.2f,%.2f,0.00,0.00,4,20,1.0,0000", t, heading);
+                writeNMEA(out, us + 200, body);
+            }
+        }
+    }
+    fclose(out);
+    printf("%d s session -> %s\n", (int)duration, path);
+    return 0;
+}
+
+void usage() {
+    fprintf(stderr,
+            "usage: fusion_replay <session.log>... [-j threads] [--warmup s] [--top n] [--csv]\n"
+            "                     [--set key=v1,v2,... | --set key=from:to:step]...\n"
+            "       fusion_replay synth -o <session.log> [--duration s] [--seed n] [--dual]\n"
+            "       fusion_replay --keys\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "synth") == 0) {
+        return synth(argc - 2, argv + 2);
+    }
+
+    std::vector<const char*> paths;
+    std::vector<Sweep> sweeps;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    float warmup = 5.0f;
+    size_t top = 20;
+    bool csv = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            threads = std::max(1, atoi(argv[++i]));
+        } else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc) {
+            warmup = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--top") == 0 && i + 1 < argc) {
+            top = (size_t)atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else if (strcmp(argv[i], "--set") == 0 && i + 1 < argc) {
+            Sweep s;
+            if (!parseSweep(argv[++i], s)) {
+                fprintf(stderr, "Bad --set %s (see --keys)\n", argv[i]);
+                return 1;
+            }
+            sweeps.push_back(s);
+        } else if (strcmp(argv[i], "--keys") == 0) {
+            ReplayParams d;
+            printf("Keys for --set (defaults match FusionConfig):\n");
+            for (const Key& k : KEYS) printf("  %-15s %s\n", k.name, k.help);
+            printf("Defaults: rate %d Hz, wheelbase %.2f, counts/deg %.0f, WAS %s\n", d.rateHz, d.ekf.wheelbase,
+                   d.encoderCountsPerDegree, d.useWAS ? "fused" : "truth only");
+            return 0;
+        } else if (argv[i][0] == '-') {
+            usage();
+            return 1;
+        } else {
+            paths.push_back(argv[i]);
+        }
+    }
+    if (paths.empty()) {
+        usage();
+        return 1;
+    }
+
+    std::vector<Session> sessions(paths.size());
+    for (size_t i = 0; i < paths.size(); i++) {
+        if (!loadSession(paths[i], sessions[i])) return 1;
+    }
+
+    std::vector<Candidate> candidates = expand(sweeps);
+    std::vector<Result> results(candidates.size());
+    for (const Candidate& c : candidates) {
+        if (c.params.rateHz <= 0 || c.params.encoderCountsPerDegree == 0.0f || c.params.ekf.wheelbase <= 0.0f) {
+            fprintf(stderr, "Invalid parameter set: %s\n", c.label.c_str());
+            return 1;
+        }
+    }
+
+    // Each worker takes the next parameter set until none are left
+    threads = std::min<unsigned>(threads, candidates.size());
+    std::atomic<size_t> nextIndex{0};
+    auto worker = [&]() {
+        for (size_t i = nextIndex++; i < candidates.size(); i = nextIndex++) {
+            for (const Session& s : sessions) {
+                replay(s, candidates[i].params, warmup, results[i]);
+            }
+        }
+    };
+    auto wallStart = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; t++) pool.emplace_back(worker);
+    for (std::thread& t : pool) t.join();
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::vector<size_t> order(candidates.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return results[a].rms() < results[b].rms(); });
+
+    if (csv) {
+        printf("params,rms_deg,rms_healthy_deg,max_deg,healthy_pct,rejected,ns_per_update\n");
+        for (size_t i : order) {
+            const Result& r = results[i];
+            printf("\"%s\",%.4f,%.4f,%.3f,%.1f,%u,%.1f\n", candidates[i].label.c_str(), r.rms(), r.rmsHealthy(),
+                   r.maxError, r.healthyPct(), r.rejected, r.nsPerUpdate());
+        }
+        return 0;
+    }
+
+    printf("%zu parameter sets x %zu sessions on %u threads in %.2f s\n", candidates.size(), sessions.size(),
+           threads, wallSec);
+    printf("%8s %8s %8s %8s %8s %8s  %s\n", "rms deg", "healthy", "max deg", "% ok", "rejected", "ns/upd",
+           "params");
+    for (size_t n = 0; n < order.size() && n < top; n++) {
+        const Result& r = results[order[n]];
+        printf("%8.3f %8.3f %8.2f %8.1f %8u %8.1f  %s\n", r.rms(), r.rmsHealthy(), r.maxError, r.healthyPct(),
+               r.rejected, r.nsPerUpdate(), candidates[order[n]].label.c_str());
+    }
+    return 0;
+}
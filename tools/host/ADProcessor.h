@@ -0,0 +1,21 @@
+// ADProcessor.h - Host stand-in for the firmware ADProcessor
+// Only the calibrated WAS angle VTClient shows on the VT; a tool sets
+// wasAngle directly. Used by tools/can_tx_test.cpp.
+#ifndef HOST_ADPROCESSOR_H
+#define HOST_ADPROCESSOR_H
+
+#include "Arduino.h"
+
+class ADProcessor {
+public:
+    static ADProcessor* getInstance() {
+        static ADProcessor instance;
+        return &instance;
+    }
+
+    float getWASAngle() const { return wasAngle; }
+
+    float wasAngle = 0.0f;
+};
+
+#endif // HOST_ADPROCESSOR_H
@@ -0,0 +1,93 @@
+// Arduino.h - Minimal host stand-in for building firmware headers off target
+// Only what the plain-C++ autosteer pieces (MotorDriverInterface,
+// SimMotorDriver), the host CAN drivers and the J1939 stack need; used by
+// tools/steer_bench.cpp, tools/can_host.cpp and tools/can_tx_test.cpp.
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+using std::abs;
+
+#ifndef constrain
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#endif
+
+namespace host {
+
+// millis()/micros() follow the wall clock, or a simulated clock once a
+// tool sets one (replays run faster than real time and repeat exactly)
+inline int64_t& simMicros() {
+    static int64_t us = -1;
+    return us;
+}
+
+inline uint64_t wallNanos() {
+    static const auto start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count();
+}
+
+inline uint64_t nowMicros() {
+    return simMicros() >= 0 ? (uint64_t)simMicros() : wallNanos() / 1000;
+}
+
+// Stands in for interrupt masking: the CAN reader threads take it around
+// their receive callbacks, __disable_irq() takes it in the main thread
+inline std::recursive_mutex& irqLock() {
+    static std::recursive_mutex lock;
+    return lock;
+}
+
+} // namespace host
+
+inline uint32_t millis() { return (uint32_t)(host::nowMicros() / 1000); }
+inline uint32_t micros() { return (uint32_t)host::nowMicros(); }
+
+inline void delay(uint32_t ms) {
+    if (host::simMicros() >= 0) {
+        host::simMicros() += (int64_t)ms * 1000;
+    } else {
+        std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    }
+}
+
+// The DWT cycle counter always measures real CPU time, one "cycle" per ns
+#define F_CPU_ACTUAL 1000000000UL
+#define ARM_DWT_CYCCNT ((uint32_t)host::wallNanos())
+
+#define __disable_irq() host::irqLock().lock()
+#define __enable_irq() host::irqLock().unlock()
+
+// Teensy memory sections, and the MAC fuse J1939 builds its NAME from
+#define DMAMEM
+#define PROGMEM
+#define HW_OCOTP_MAC0 0x0004A1B2UL
+
+struct HostSerial {
+    void print(const char* s) { fputs(s, stdout); }
+    void println(const char* s = "") { printf("%s\r\n", s); }
+    void printf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
+};
+
+inline HostSerial Serial;
+#endif // __cplusplus
+
+#endif // HOST_ARDUINO_H
@@ -0,0 +1,58 @@
+// ConfigManager.h - Host stand-in for the firmware ConfigManager
+// Only the CAN steering configuration TractorCANDriver and J1939Stack read.
+// The types are copied from lib/aio_config/ConfigManager.h and must stay in
+// step with it. Each tool defines the configManager instance and fills it in.
+#ifndef HOST_CONFIGMANAGER_H
+#define HOST_CONFIGMANAGER_H
+
+#include "Arduino.h"
+
+// CAN bus functions
+enum class CANFunction : uint8_t {
+    NONE = 0,
+    KEYA = 1,
+    V_BUS = 2,
+    ISO_BUS = 3,
+    K_BUS = 4
+};
+
+// CAN Steer configuration structure
+struct CANSteerConfig {
+    // Brand selection
+    uint8_t brand = 9;          // 0=Disabled, 1=Fendt, 2=Valtra, etc, 9=Generic (default)
+
+    // CAN1 configuration
+    uint8_t can1Speed = 0;      // 0=250k, 1=500k
+    uint8_t can1Function = 0;   // CANFunction enum
+    uint8_t can1Name = 0;       // 0=None, 1=V_Bus, 2=K_Bus, 3=ISO_Bus
+
+    // CAN2 configuration
+    uint8_t can2Speed = 0;      // 0=250k, 1=500k
+    uint8_t can2Function = 0;   // CANFunction enum
+    uint8_t can2Name = 0;       // 0=None, 1=V_Bus, 2=K_Bus, 3=ISO_Bus
+
+    // CAN3 configuration
+    uint8_t can3Speed = 0;      // 0=250k, 1=500k
+    uint8_t can3Function = 0;   // CANFunction enum
+    uint8_t can3Name = 0;       // 0=None, 1=V_Bus, 2=K_Bus, 3=ISO_Bus
+
+    uint8_t moduleID = 0x1C;    // Module ID for protocols that need it
+    uint8_t reserved[1];        // Future expansion
+};
+
+class ConfigManager {
+public:
+    static ConfigManager* getInstance();
+
+    CANSteerConfig getCANSteerConfig() const { return canSteerConfig; }
+    void setCANSteerConfig(const CANSteerConfig& config) { canSteerConfig = config; }
+
+private:
+    CANSteerConfig canSteerConfig;
+};
+
+extern ConfigManager configManager;
+
+inline ConfigManager* ConfigManager::getInstance() { return &configManager; }
+
+#endif // HOST_CONFIGMANAGER_H
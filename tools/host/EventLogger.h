@@ -0,0 +1,74 @@
+// EventLogger.h - Host stand-in for the firmware event logger
+// Same severities, sources and LOG_* macros; messages go to stderr with the
+// current millis(). Used by tools/can_host.cpp.
+#ifndef HOST_EVENT_LOGGER_H
+#define HOST_EVENT_LOGGER_H
+
+#include "Arduino.h"
+
+enum class EventSeverity : uint8_t {
+    EMERGENCY = 0,  // System is unusable
+    ALERT = 1,      // Action must be taken immediately
+    CRITICAL = 2,   // Critical conditions
+    ERROR = 3,      // Error conditions
+    WARNING = 4,    // Warning conditions
+    NOTICE = 5,     // Normal but significant condition
+    INFO = 6,       // Informational messages
+    DEBUG = 7       // Debug-level messages
+};
+
+enum class EventSource : uint8_t {
+    SYSTEM = 0,
+    NETWORK = 1,
+    GNSS = 2,
+    IMU = 3,
+    AUTOSTEER = 4,
+    MACHINE = 5,
+    CAN = 6,
+    CONFIG = 7,
+    USER = 8
+};
+
+class EventLogger {
+public:
+    static EventLogger* getInstance() {
+        static EventLogger instance;
+        return &instance;
+    }
+
+    void setLevel(EventSeverity level) { maxLevel = level; }
+
+    void log(EventSeverity severity, EventSource source, const char* format, ...) {
+        if (severity > maxLevel) {
+            return;
+        }
+        static const char* const severityNames[] = {
+            "EMERG", "ALERT", "CRIT", "ERROR", "WARN", "NOTICE", "INFO", "DEBUG"
+        };
+        static const char* const sourceNames[] = {
+            "SYSTEM", "NETWORK", "GNSS", "IMU", "AUTOSTEER", "MACHINE", "CAN", "CONFIG", "USER"
+        };
+        fprintf(stderr, "[%8lu.%03lu] %s/%s: ", (unsigned long)(millis() / 1000),
+                (unsigned long)(millis() % 1000), severityNames[(uint8_t)severity],
+                sourceNames[(uint8_t)source]);
+        va_list args;
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+        fputc('\n', stderr);
+    }
+
+private:
+    EventSeverity maxLevel = EventSeverity::INFO;
+};
+
+#define LOG_EMERGENCY(source, ...) EventLogger::getInstance()->log(EventSeverity::EMERGENCY, source, __VA_ARGS__)
+#define LOG_ALERT(source, ...) EventLogger::getInstance()->log(EventSeverity::ALERT, source, __VA_ARGS__)
+#define LOG_CRITICAL(source, ...) EventLogger::getInstance()->log(EventSeverity::CRITICAL, source, __VA_ARGS__)
+#define LOG_ERROR(source, ...) EventLogger::getInstance()->log(EventSeverity::ERROR, source, __VA_ARGS__)
+#define LOG_WARNING(source, ...) EventLogger::getInstance()->log(EventSeverity::WARNING, source, __VA_ARGS__)
+#define LOG_NOTICE(source, ...) EventLogger::getInstance()->log(EventSeverity::NOTICE, source, __VA_ARGS__)
+#define LOG_INFO(source, ...) EventLogger::getInstance()->log(EventSeverity::INFO, source, __VA_ARGS__)
+#define LOG_DEBUG(source, ...) EventLogger::getInstance()->log(EventSeverity::DEBUG, source, __VA_ARGS__)
+
+#endif // HOST_EVENT_LOGGER_H
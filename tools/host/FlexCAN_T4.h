@@ -0,0 +1,77 @@
+// FlexCAN_T4.h - Host stand-in for FlexCAN_T4 on Linux SocketCAN
+// Just the API the firmware CAN layer uses (CANGlobals, CANTxScheduler,
+// CANRxQueue). Each bus can be attached to a SocketCAN interface such as
+// vcan0; onReceive() + enableMBInterrupts() start a reader thread that
+// calls the handler the way the FlexCAN ISR does. An unattached bus reads
+// nothing and discards writes. Implemented in HostCAN.cpp.
+#ifndef HOST_FLEXCAN_T4_H
+#define HOST_FLEXCAN_T4_H
+
+#include <stdint.h>
+
+typedef struct CAN_message_t {
+  uint32_t id = 0;          // can identifier
+  uint16_t timestamp = 0;   // FlexCAN time when message arrived
+  uint8_t idhit = 0; // filter that id came from
+  struct {
+    bool extended = 0; // identifier is extended (29-bit)
+    bool remote = 0;  // remote transmission request packet type
+    bool overrun = 0; // message overrun
+    bool reserved = 0;
+  } flags;
+  uint8_t len = 8;      // length of data
+  uint8_t buf[8] = { 0 };       // data
+  int8_t mb = 0;       // used to identify mailbox reception
+  uint8_t bus = 0;      // used to identify where the message came from when events() is used.
+  bool seq = 0;         // sequential frames
+} CAN_message_t;
+
+typedef void (*_MB_ptr)(const CAN_message_t &msg); /* mailbox / global callbacks */
+
+typedef enum CAN_DEV_TABLE { CAN0 = 0, CAN1 = 1, CAN2 = 2, CAN3 = 3 } CAN_DEV_TABLE;
+typedef enum FLEXCAN_RXQUEUE_TABLE { RX_SIZE_256 = (uint16_t)256 } FLEXCAN_RXQUEUE_TABLE;
+typedef enum FLEXCAN_TXQUEUE_TABLE { TX_SIZE_16 = (uint16_t)16, TX_SIZE_256 = (uint16_t)256 } FLEXCAN_TXQUEUE_TABLE;
+typedef enum FLEXCAN_MBFILTER { ACCEPT_ALL = 0, REJECT_ALL = 1 } FLEXCAN_MBFILTER;
+
+// One receive filter in SocketCAN terms: a frame matches if
+// (frame id & mask) == (id & mask) and its ID type equals extended
+struct HostCANFilter {
+    uint32_t id;
+    uint32_t mask;
+    bool extended;
+};
+
+class HostCANInterface {
+public:
+    // Bind to a SocketCAN interface before begin(). False if it cannot be opened.
+    bool attach(const char* ifname);
+    bool isAttached() const { return fd >= 0; }
+    const char* getInterfaceName() const { return ifname; }
+
+    void begin() {}
+    void setBaudRate(uint32_t) {}     // The interface's bit rate is set with ip link
+
+    int read(CAN_message_t& msg);
+    int write(const CAN_message_t& msg);
+
+    void onReceive(_MB_ptr handler) { rxHandler = handler; }
+    void enableMBInterrupts();
+
+    void setMBFilter(FLEXCAN_MBFILTER filter);
+    // Replace the kernel receive filters (HostCANBus::setRxFilters)
+    void setFilters(const HostCANFilter* filters, uint8_t count);
+
+private:
+    int fd = -1;
+    char ifname[16] = "";
+    _MB_ptr rxHandler = nullptr;
+    bool readerStarted = false;
+
+    void readerLoop();
+};
+
+template <CAN_DEV_TABLE _bus, FLEXCAN_RXQUEUE_TABLE _rxSize = RX_SIZE_256, FLEXCAN_TXQUEUE_TABLE _txSize = TX_SIZE_16>
+class FlexCAN_T4 : public HostCANInterface {
+};
+
+#endif // HOST_FLEXCAN_T4_H
@@ -0,0 +1,21 @@
+// GNSSProcessor.h - Host stand-in for the firmware GNSSProcessor
+// Only the fix quality VTClient shows on the VT. Used by tools/can_tx_test.cpp.
+#ifndef HOST_GNSSPROCESSOR_H
+#define HOST_GNSSPROCESSOR_H
+
+#include "Arduino.h"
+
+struct GNSSData {
+    uint8_t fixQuality = 0;     // 0=invalid, 1=GPS, 2=DGPS, 4=RTK, 5=Float
+};
+
+class GNSSProcessor {
+public:
+    const GNSSData& getData() const { return gpsData; }
+
+    GNSSData gpsData;
+};
+
+inline GNSSProcessor gnssProcessor;
+
+#endif // HOST_GNSSPROCESSOR_H
@@ -0,0 +1,286 @@
+// HostCAN.cpp - SocketCAN backend for the host build of the CAN layer
+// Replaces lib/aio_communications/CANBus.cpp (FlexCAN registers) on Linux.
+// lib/aio_communications/CANGlobals.cpp and CANTxScheduler.cpp build on top
+// of it unchanged, so drivers see the same queues, observers and scheduler
+// as on the board. Transmit mailboxes hold their frame until
+// hostCANTransmit() puts the winner of arbitration on the wire, the way
+// FlexCAN picks among pending mailboxes. Acceptance filters become kernel
+// CAN_RAW_FILTER lists with the same shared-mask grouping the mailboxes
+// use, so frames that pass on the board pass here.
+#include <errno.h>
+#include <linux/can.h>
+#include <linux/can/raw.h>
+#include <net/if.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "CANBus.h"
+#include "HostCAN.h"
+
+static const uint32_t STD_ID_MASK = 0x7FF;
+static const uint32_t EXT_ID_MASK = 0x1FFFFFFF;
+
+static void toFrame(const CAN_message_t& msg, struct can_frame& frame) {
+    memset(&frame, 0, sizeof(frame));
+    frame.can_id = msg.flags.extended ? ((msg.id & EXT_ID_MASK) | CAN_EFF_FLAG) : (msg.id & STD_ID_MASK);
+    if (msg.flags.remote) {
+        frame.can_id |= CAN_RTR_FLAG;
+    }
+    frame.can_dlc = msg.len > 8 ? 8 : msg.len;
+    memcpy(frame.data, msg.buf, frame.can_dlc);
+}
+
+static void fromFrame(const struct can_frame& frame, CAN_message_t& msg) {
+    msg = CAN_message_t();
+    msg.flags.extended = (frame.can_id & CAN_EFF_FLAG) != 0;
+    msg.flags.remote = (frame.can_id & CAN_RTR_FLAG) != 0;
+    msg.id = frame.can_id & (msg.flags.extended ? EXT_ID_MASK : STD_ID_MASK);
+    msg.len = frame.can_dlc > 8 ? 8 : frame.can_dlc;
+    memcpy(msg.buf, frame.data, msg.len);
+}
+
+// ===== HostCANInterface =====
+
+bool HostCANInterface::attach(const char* name) {
+    int s = socket(PF_CAN, SOCK_RAW, CAN_RAW);
+    if (s < 0) {
+        return false;
+    }
+
+    struct ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, name, IFNAMSIZ - 1);
+    struct sockaddr_can addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.can_family = AF_CAN;
+    if (ioctl(s, SIOCGIFINDEX, &ifr) < 0) {
+        close(s);
+        return false;
+    }
+    addr.can_ifindex = ifr.ifr_ifindex;
+    if (bind(s, (struct sockaddr*)&addr, sizeof(addr)) < 0) {
+        close(s);
+        return false;
+    }
+
+    fd = s;
+    strncpy(ifname, name, sizeof(ifname) - 1);
+    return true;
+}
+
+int HostCANInterface::read(CAN_message_t& msg) {
+    if (fd < 0) {
+        return 0;
+    }
+    struct can_frame frame;
+    if (recv(fd, &frame, sizeof(frame), MSG_DONTWAIT) != (ssize_t)sizeof(frame)) {
+        return 0;
+    }
+    fromFrame(frame, msg);
+    return 1;
+}
+
+int HostCANInterface::write(const CAN_message_t& msg) {
+    if (fd < 0) {
+        return 1;   // No interface - the frame goes nowhere, as on an unterminated bus
+    }
+    struct can_frame frame;
+    toFrame(msg, frame);
+    return ::write(fd, &frame, sizeof(frame)) == (ssize_t)sizeof(frame) ? 1 : 0;
+}
+
+void HostCANInterface::enableMBInterrupts() {
+    if (fd < 0 || readerStarted) {
+        return;
+    }
+    readerStarted = true;
+    std::thread(&HostCANInterface::readerLoop, this).detach();
+}
+
+void HostCANInterface::readerLoop() {
+    while (true) {
+        struct can_frame frame;
+        ssize_t n = recv(fd, &frame, sizeof(frame), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n != (ssize_t)sizeof(frame)) {
+            return;
+        }
+
+        CAN_message_t msg;
+        fromFrame(frame, msg);
+        // The main thread's __disable_irq() keeps this "ISR" out
+        std::lock_guard<std::recursive_mutex> guard(host::irqLock());
+        if (rxHandler) {
+            rxHandler(msg);
+        }
+    }
+}
+
+void HostCANInterface::setMBFilter(FLEXCAN_MBFILTER filter) {
+    if (filter == ACCEPT_ALL) {
+        HostCANFilter all[2] = {{0, 0, false}, {0, 0, true}};
+        setFilters(all, 2);
+    } else {
+        setFilters(nullptr, 0);
+    }
+}
+
+void HostCANInterface::setFilters(const HostCANFilter* filters, uint8_t count) {
+    if (fd < 0) {
+        return;
+    }
+    struct can_filter kernel[64];
+    if (count > 64) {
+        count = 64;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+        // CAN_EFF_FLAG in the mask makes the ID type part of the match
+        kernel[i].can_id = filters[i].id | (filters[i].extended ? CAN_EFF_FLAG : 0);
+        kernel[i].can_mask = filters[i].mask | CAN_EFF_FLAG;
+    }
+    setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, count ? kernel : nullptr, count * sizeof(struct can_filter));
+}
+
+// ===== CANBus on SocketCAN =====
+
+namespace {
+
+class HostCANBus : public CANBus {
+public:
+    HostCANBus(HostCANInterface& c, uint8_t num) : CANBus(num), can(c) {}
+
+    bool setRxFilters(const uint32_t* stdIds, uint8_t stdCount,
+                      const uint32_t* extIds, uint8_t extCount) override {
+        HostCANFilter filters[2 * RX_MB_PER_TYPE * MAX_IDS_PER_MB];
+        uint8_t count = 0;
+        rxFiltered = true;
+        bool exactStd = addFilters(filters, count, stdIds, stdCount, false);
+        bool exactExt = addFilters(filters, count, extIds, extCount, true);
+        can.setFilters(filters, count);
+        return exactStd && exactExt;
+    }
+
+    void acceptAll() override {
+        can.setMBFilter(ACCEPT_ALL);
+        rxFiltered = false;
+    }
+
+    bool isTxMailboxIdle(uint8_t mb) const override { return !txPending[mb - TX_FIRST_MB]; }
+
+    void loadTxMailbox(uint8_t mb, const CAN_message_t& msg) override {
+        txFrames[mb - TX_FIRST_MB] = msg;
+        txPending[mb - TX_FIRST_MB] = true;
+    }
+
+    bool abortTxMailbox(uint8_t mb, uint32_t) override {
+        bool pending = txPending[mb - TX_FIRST_MB];
+        txPending[mb - TX_FIRST_MB] = false;
+        return pending;
+    }
+
+    // Lowest arbitration value wins, then the lowest mailbox
+    bool transmit(CAN_message_t* sent) {
+        int8_t winner = -1;
+        uint32_t winnerKey = 0;
+        for (uint8_t i = 0; i < TX_MB_COUNT; i++) {
+            if (!txPending[i]) {
+                continue;
+            }
+            uint32_t key = arbitrationKey(txFrames[i]);
+            if (winner < 0 || key < winnerKey) {
+                winner = i;
+                winnerKey = key;
+            }
+        }
+        if (winner < 0) {
+            return false;
+        }
+        can.write(txFrames[winner]);
+        if (sent) {
+            *sent = txFrames[winner];
+        }
+        txPending[winner] = false;
+        return true;
+    }
+
+private:
+    static constexpr uint8_t TX_FIRST_MB = CANTxScheduler::FIRST_TX_MB;
+    static constexpr uint8_t TX_MB_COUNT = CANTxScheduler::TX_MB_COUNT;
+
+    HostCANInterface& can;
+    CAN_message_t txFrames[TX_MB_COUNT];
+    bool txPending[TX_MB_COUNT] = {};
+
+    // Bits in the order they go on the wire: base ID, IDE (a standard frame
+    // beats an extended one with the same base ID), then the extended bits
+    static uint32_t arbitrationKey(const CAN_message_t& msg) {
+        if (!msg.flags.extended) {
+            return (msg.id & STD_ID_MASK) << 19;
+        }
+        uint32_t id = msg.id & EXT_ID_MASK;
+        return ((id >> 18) << 19) | (1u << 18) | (id & 0x3FFFF);
+    }
+
+    // Same mailbox grouping as FlexCANBus::programMailboxes(); a mailbox
+    // holding several IDs matches every ID that agrees on their common bits
+    static bool addFilters(HostCANFilter* filters, uint8_t& count,
+                           const uint32_t* ids, uint8_t idCount, bool extended) {
+        const uint8_t mbCount = RX_MB_PER_TYPE;
+        const uint8_t maxIds = MAX_IDS_PER_MB;
+        const uint32_t fullMask = extended ? EXT_ID_MASK : STD_ID_MASK;
+
+        if (idCount == 0) {
+            return true;
+        }
+
+        if (idCount > mbCount * maxIds) {
+            filters[count++] = {0, 0, extended};
+            return false;
+        }
+
+        if (idCount <= mbCount) {
+            for (uint8_t i = 0; i < idCount; i++) {
+                filters[count++] = {ids[i], fullMask, extended};
+            }
+            return true;
+        }
+
+        uint8_t next = 0;
+        for (uint8_t i = 0; i < mbCount && next < idCount; i++) {
+            uint8_t n = (idCount - next + (mbCount - i) - 1) / (mbCount - i);
+            uint32_t differ = 0;
+            for (uint8_t k = 1; k < n; k++) {
+                differ |= ids[next] ^ ids[next + k];
+            }
+            filters[count++] = {ids[next], fullMask & ~differ, extended};
+            next += n;
+        }
+        return false;
+    }
+};
+
+HostCANBus canBus1(globalCAN1, 1);
+HostCANBus canBus2(globalCAN2, 2);
+HostCANBus canBus3(globalCAN3, 3);
+
+} // namespace
+
+static HostCANBus* getHostCANBus(uint8_t busNum) {
+    switch (busNum) {
+        case 1: return &canBus1;
+        case 2: return &canBus2;
+        case 3: return &canBus3;
+        default: return nullptr;
+    }
+}
+
+CANBus* getCANBus(uint8_t busNum) {
+    return getHostCANBus(busNum);
+}
+
+bool hostCANTransmit(uint8_t busNum, CAN_message_t* sent) {
+    HostCANBus* bus = getHostCANBus(busNum);
+    return bus && bus->transmit(sent);
+}
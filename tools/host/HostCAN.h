@@ -0,0 +1,14 @@
+// HostCAN.h - Host-only controls for the SocketCAN CANBus backend
+// On the board FlexCAN sends pending mailboxes on its own; here a tool
+// decides when the wire is free, so it can interleave transmit completions
+// with the firmware loop (tools/can_host.cpp, tools/can_tx_test.cpp).
+#ifndef HOST_CAN_H
+#define HOST_CAN_H
+
+#include "CANBus.h"
+
+// Send the pending transmit mailbox that wins arbitration and free it.
+// False if no mailbox on this bus is pending.
+bool hostCANTransmit(uint8_t busNum, CAN_message_t* sent = nullptr);
+
+#endif // HOST_CAN_H
@@ -0,0 +1,20 @@
+// MachineProcessor.h - Host stand-in for the firmware MachineProcessor
+// Only the section states VTClient shows on the VT. Used by tools/can_tx_test.cpp.
+#ifndef HOST_MACHINEPROCESSOR_H
+#define HOST_MACHINEPROCESSOR_H
+
+#include "Arduino.h"
+
+class MachineProcessor {
+public:
+    static MachineProcessor* getInstance() {
+        static MachineProcessor instance;
+        return &instance;
+    }
+
+    uint16_t getSectionStates() const { return sectionStates; }
+
+    uint16_t sectionStates = 0;
+};
+
+#endif // HOST_MACHINEPROCESSOR_H
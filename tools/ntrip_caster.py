@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""
+Stand-in NTRIP caster for exercising the AiO on-board NTRIP client.
+
+Serves one mountpoint over NTRIP v1 (ICY 200 OK) or v2 (HTTP/1.1 chunked),
+depending on the Ntrip-Version header the client sends. Streams either a
+recorded raw RTCM3 file (looped) or synthetic CRC-valid frames, and prints
+any GGA sentences the client uploads.
+
+Usage:
+    python3 tools/ntrip_caster.py --port 2101 --mount TEST --user u --password p
+    python3 tools/ntrip_caster.py --rtcm capture.rtcm3 --rate 2
+
+Then configure the AiO (web UI or POST /api/ntrip/config) with this host's
+IP, port and mountpoint.
+"""
+
+import argparse
+import base64
+import socket
+import struct
+import threading
+import time
+
+
+def crc24q(data):
+    crc = 0
+    for b in data:
+        crc ^= b << 16
+        for _ in range(8):
+            crc <<= 1
+            if crc & 0x1000000:
+                crc ^= 0x1864CFB
+    return crc & 0xFFFFFF
+
+
+def rtcm_frame(payload):
+    header = bytes([0xD3, (len(payload) >> 8) & 0x03, len(payload) & 0xFF])
+    body = header + payload
+    return body + struct.pack(">I", crc24q(body))[1:]
+
+
+def synthetic_frames():
+    """One 1005 (station ARP) and one dummy 1077-sized frame per epoch."""
+    msg1005 = bytearray(19)
+    msg1005[0] = (1005 >> 4) & 0xFF
+    msg1005[1] = (1005 & 0x0F) << 4
+    msg1077 = bytearray(180)
+    msg1077[0] = (1077 >> 4) & 0xFF
+    msg1077[1] = (1077 & 0x0F) << 4
+    return [rtcm_frame(bytes(msg1005)), rtcm_frame(bytes(msg1077))]
+
+
+def recorded_epochs(path, frames_per_epoch):
+    """Split a raw RTCM3 capture into frames and group them into epochs."""
+    data = open(path, "rb").read()
+    frames = []
+    i = 0
+    while i + 6 <= len(data):
+        if data[i] != 0xD3:
+            i += 1
+            continue
+        length = ((data[i + 1] & 0x03) << 8) | data[i + 2]
+        end = i + 3 + length + 3
+        if end > len(data):
+            break
+        frame = data[i:end]
+        if crc24q(frame[:-3]) == int.from_bytes(frame[-3:], "big"):
+            frames.append(frame)
+            i = end
+        else:
+            i += 1
+    return [frames[k:k + frames_per_epoch] for k in range(0, len(frames), frames_per_epoch)]
+
+
+class Session(threading.Thread):
+    def __init__(self, conn, addr, args, epochs):
+        super().__init__(daemon=True)
+        self.conn = conn
+        self.addr = addr
+        self.args = args
+        self.epochs = epochs
+
+    def read_request(self):
+        data = b""
+        while b"\r\n\r\n" not in data:
+            chunk = self.conn.recv(1024)
+            if not chunk:
+                return None, b""
+            data += chunk
+        head, rest = data.split(b"\r\n\r\n", 1)
+        return head.decode(errors="replace").split("\r\n"), rest
+
+    def reject(self, v2, status, body=""):
+        if v2:
+            msg = "HTTP/1.1 %s\r\nConnection: close\r\n\r\n%s" % (status, body)
+        elif status.startswith("404"):
+            msg = "SOURCETABLE 200 OK\r\n\r\nENDSOURCETABLE\r\n"
+        else:
+            msg = "HTTP/1.0 %s\r\n\r\n" % status
+        self.conn.sendall(msg.encode())
+
+    def run(self):
+        try:
+            self.serve()
+        except (ConnectionError, OSError) as e:
+            print("[%s] closed: %s" % (self.addr[0], e))
+        finally:
+            self.conn.close()
+
+    def serve(self):
+        lines, pending = self.read_request()
+        if not lines:
+            return
+        print("[%s] %s" % (self.addr[0], lines[0]))
+        headers = {}
+        for line in lines[1:]:
+            if ":" in line:
+                k, v = line.split(":", 1)
+                headers[k.strip().lower()] = v.strip()
+
+        v2 = "ntrip/2" in headers.get("ntrip-version", "").lower()
+        parts = lines[0].split()
+        mount = parts[1].lstrip("/") if len(parts) > 1 else ""
+
+        if mount != self.args.mount:
+            self.reject(v2, "404 Not Found")
+            return
+
+        if self.args.user:
+            expected = base64.b64encode(("%s:%s" % (self.args.user, self.args.password)).encode()).decode()
+            if headers.get("authorization", "") != "Basic " + expected:
+                self.reject(v2, "401 Unauthorized")
+                return
+
+        if "ntrip-gga" in headers:
+            print("[%s] GGA (header): %s" % (self.addr[0], headers["ntrip-gga"]))
+
+        if v2:
+            self.conn.sendall(b"HTTP/1.1 200 OK\r\nNtrip-Version: Ntrip/2.0\r\n"
+                              b"Content-Type: gnss/data\r\nTransfer-Encoding: chunked\r\n\r\n")
+        else:
+            self.conn.sendall(b"ICY 200 OK\r\n")
+
+        self.conn.setblocking(False)
+        sent = 0
+        epoch = 0
+        start = time.time()
+        rx = pending
+        while True:
+            for frame in self.epochs[epoch % len(self.epochs)]:
+                out = frame
+                if v2:
+                    out = b"%x\r\n" % len(frame) + frame + b"\r\n"
+                if self.args.split:
+                    # Deliberately split frames across TCP segments
+                    half = len(out) // 2
+                    self.conn.sendall(out[:half])
+                    time.sleep(0.005)
+                    self.conn.sendall(out[half:])
+                else:
+                    self.conn.sendall(out)
+                sent += len(frame)
+            epoch += 1
+
+            try:
+                data = self.conn.recv(1024)
+                if data == b"":
+                    raise ConnectionError("client closed")
+                rx += data
+            except BlockingIOError:
+                pass
+            while b"\n" in rx:
+                line, rx = rx.split(b"\n", 1)
+                if line.strip():
+                    print("[%s] GGA: %s" % (self.addr[0], line.strip().decode(errors="replace")))
+
+            if self.args.drop_after and time.time() - start > self.args.drop_after:
+                print("[%s] dropping connection (--drop-after)" % self.addr[0])
+                return
+
+            if epoch % (5 * self.args.rate) == 0:
+                print("[%s] %d bytes RTCM sent" % (self.addr[0], sent))
+            time.sleep(1.0 / self.args.rate)
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Stand-in NTRIP caster for AiO NTRIP client testing")
+    ap.add_argument("--port", type=int, default=2101)
+    ap.add_argument("--mount", default="TEST")
+    ap.add_argument("--user", default="")
+    ap.add_argument("--password", default="")
+    ap.add_argument("--rtcm", help="raw RTCM3 capture to loop instead of synthetic frames")
+    ap.add_argument("--frames-per-epoch", type=int, default=6)
+    ap.add_argument("--rate", type=int, default=1, help="epochs per second")
+    ap.add_argument("--split", action="store_true", help="split each frame across two TCP writes")
+    ap.add_argument("--drop-after", type=float, default=0, help="close each session after N seconds")
+    args = ap.parse_args()
+
+    epochs = recorded_epochs(args.rtcm, args.frames_per_epoch) if args.rtcm else [synthetic_frames()]
+    if not epochs:
+        raise SystemExit("no valid RTCM3 frames in %s" % args.rtcm)
+
+    srv = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+    srv.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    srv.bind(("0.0.0.0", args.port))
+    srv.listen(4)
+    print("Caster listening on :%d, mountpoint /%s" % (args.port, args.mount))
+    while True:
+        conn, addr = srv.accept()
+        Session(conn, addr, args, epochs).start()
+
+
+if __name__ == "__main__":
+    main()
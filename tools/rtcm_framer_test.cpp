@@ -0,0 +1,210 @@
+// rtcm_framer_test.cpp - Host checks for the RTCM3 framer
+// Feeds lib/aio_system/RTCMFramer byte streams the way the UDP and serial
+// correction paths do and compares what comes out with the frames put in.
+//
+//     clean       back-to-back frames, fed whole and split across reads
+//     falselong   a stray 0xD3 with a plausible 1000-byte length ahead of
+//                 real frames - each must come out on its own last byte
+//     falseshort  a stray 0xD3 whose length ends inside the next real frame
+//                 fails its CRC; parsing resumes right after the false
+//                 preamble and loses nothing but the bytes before 0xD3
+//     reserved    a stray 0xD3 followed by non-zero reserved bits
+//     fuzz        random frames mixed with garbage rich in 0xD3 bytes
+//
+// Build and run from the repo root:
+//     g++ -O2 -std=gnu++17 -Itools/host -Ilib/aio_system -o rtcm_framer_test
+//         tools/rtcm_framer_test.cpp lib/aio_system/RTCMFramer.cpp
+//     ./rtcm_framer_test
+// Exits non-zero if a check fails.
+#include <stdlib.h>
+#include <vector>
+#include "RTCMFramer.h"
+
+namespace {
+
+typedef std::vector<uint8_t> Bytes;
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+    printf("  %s %s\n", ok ? "ok  " : "FAIL", what);
+    if (!ok) {
+        failures++;
+    }
+}
+
+Bytes makeFrame(uint16_t messageType, uint16_t length, uint32_t seed) {
+    Bytes frame;
+    frame.push_back(RTCMFramer::PREAMBLE);
+    frame.push_back((length >> 8) & 0x03);
+    frame.push_back(length & 0xFF);
+    for (uint16_t i = 0; i < length; i++) {
+        seed = seed * 1103515245 + 12345;
+        frame.push_back((seed >> 16) & 0xFF);
+    }
+    if (length >= 2) {
+        frame[3] = messageType >> 4;
+        frame[4] = (frame[4] & 0x0F) | ((messageType & 0x0F) << 4);
+    }
+    uint32_t crc = RTCMFramer::crc24q(frame.data(), frame.size());
+    frame.push_back((crc >> 16) & 0xFF);
+    frame.push_back((crc >> 8) & 0xFF);
+    frame.push_back(crc & 0xFF);
+    return frame;
+}
+
+void append(Bytes& stream, const Bytes& more) {
+    stream.insert(stream.end(), more.begin(), more.end());
+}
+
+struct Output {
+    std::vector<Bytes> frames;
+    std::vector<size_t> readyAt;    // Stream offset of the byte that completed each frame
+};
+
+// Feeds in reads of `chunk` bytes, taking every frame a read produces
+Output feed(RTCMFramer& framer, const Bytes& stream, size_t chunk) {
+    Output out;
+    for (size_t start = 0; start < stream.size(); start += chunk) {
+        size_t end = start + chunk < stream.size() ? start + chunk : stream.size();
+        for (size_t i = start; i < end; i++) {
+            bool ready = framer.processByte(stream[i]);
+            while (ready) {
+                const uint8_t* frame = framer.getFrame();
+                out.frames.push_back(Bytes(frame, frame + framer.getFrameLength()));
+                out.readyAt.push_back(i);
+                ready = framer.processPending();
+            }
+        }
+    }
+    return out;
+}
+
+bool sameFrames(const Output& out, const std::vector<Bytes>& expected) {
+    return out.frames == expected;
+}
+
+void testClean() {
+    printf("clean\n");
+    std::vector<Bytes> frames;
+    Bytes stream;
+    const uint16_t lengths[] = {19, 0, 1023, 64, 2, 300};
+    for (uint8_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        frames.push_back(makeFrame(1005 + i, lengths[i], i));
+        append(stream, frames.back());
+    }
+
+    const size_t chunks[] = {stream.size(), 1, 7, 512};
+    for (size_t chunk : chunks) {
+        RTCMFramer framer;
+        Output out = feed(framer, stream, chunk);
+        char what[64];
+        snprintf(what, sizeof(what), "all frames, %zu-byte reads", chunk);
+        check(sameFrames(out, frames), what);
+        check(framer.getCRCErrors() == 0 && framer.getBytesDiscarded() == 0, "nothing rejected");
+    }
+
+    RTCMFramer framer;
+    framer.processByte(0x42);
+    bool ready = false;
+    for (uint8_t b : makeFrame(1077, 40, 9)) {
+        ready = framer.processByte(b);
+    }
+    check(ready && framer.getMessageType() == 1077, "message type read from payload");
+}
+
+void testFalseLong() {
+    printf("falselong\n");
+    // 0xD3 0x03 0xE8: a 1000-byte payload that never ends with a valid CRC
+    Bytes stream = {0x11, RTCMFramer::PREAMBLE, 0x03, 0xE8, 0x22};
+    std::vector<Bytes> frames;
+    std::vector<size_t> lastByte;
+    for (uint8_t i = 0; i < 4; i++) {
+        frames.push_back(makeFrame(1074 + i, 50 + 30 * i, 100 + i));
+        append(stream, frames.back());
+        lastByte.push_back(stream.size() - 1);
+    }
+
+    RTCMFramer framer;
+    Output out = feed(framer, stream, 1);
+    check(sameFrames(out, frames), "real frames behind the false preamble recovered");
+    check(out.readyAt == lastByte, "each frame ready on its own last byte");
+    check(framer.getCRCErrors() == 1, "false candidate counted once");
+    // Leading byte, false preamble, its two length bytes and the stray byte
+    check(framer.getBytesDiscarded() == 5, "only bytes outside frames discarded");
+}
+
+void testFalseShort() {
+    printf("falseshort\n");
+    Bytes first = makeFrame(1005, 30, 7);
+    Bytes second = makeFrame(1087, 80, 8);
+    // Length 20 ends inside the first real frame, so its CRC check fails there
+    Bytes stream = {RTCMFramer::PREAMBLE, 0x00, 20, 0x01};
+    append(stream, first);
+    append(stream, second);
+
+    for (size_t chunk : {(size_t)1, (size_t)16, stream.size()}) {
+        RTCMFramer framer;
+        Output out = feed(framer, stream, chunk);
+        char what[64];
+        snprintf(what, sizeof(what), "both frames after the CRC failure, %zu-byte reads", chunk);
+        check(sameFrames(out, {first, second}), what);
+        check(framer.getCRCErrors() == 1, "one CRC error");
+        check(framer.getBytesDiscarded() == 4, "false preamble and bytes before the next 0xD3 dropped");
+    }
+}
+
+void testReserved() {
+    printf("reserved\n");
+    Bytes frame = makeFrame(1230, 12, 3);
+    Bytes stream = {RTCMFramer::PREAMBLE, 0x40};
+    append(stream, frame);
+
+    RTCMFramer framer;
+    Output out = feed(framer, stream, 1);
+    check(sameFrames(out, {frame}), "frame after bad reserved bits recovered");
+    check(framer.getCRCErrors() == 0, "header rejection is not a CRC error");
+    check(framer.getBytesDiscarded() == 2, "false preamble and reserved byte dropped");
+}
+
+void testFuzz() {
+    printf("fuzz\n");
+    srand(1);
+    int runs = 200;
+    int good = 0;
+    for (int run = 0; run < runs; run++) {
+        std::vector<Bytes> frames;
+        Bytes stream;
+        for (int i = 0; i < 20; i++) {
+            int garbage = rand() % 40;
+            for (int g = 0; g < garbage; g++) {
+                // One byte in four a preamble, lengths anywhere
+                stream.push_back(rand() % 4 == 0 ? RTCMFramer::PREAMBLE : rand() & 0xFF);
+            }
+            frames.push_back(makeFrame(1000 + rand() % 300, rand() % 400, rand()));
+            append(stream, frames.back());
+        }
+
+        RTCMFramer framer;
+        Output out = feed(framer, stream, 1 + rand() % 600);
+        if (sameFrames(out, frames)) {
+            good++;
+        }
+    }
+    char what[64];
+    snprintf(what, sizeof(what), "%d/%d streams recovered every frame in order", good, runs);
+    check(good == runs, what);
+}
+
+} // namespace
+
+int main() {
+    testClean();
+    testFalseLong();
+    testFalseShort();
+    testReserved();
+    testFuzz();
+
+    printf(failures ? "%d check(s) failed\n" : "all checks passed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,308 @@
+// steer_bench.cpp - Host closed-loop benchmark for the autosteer controller
+// Runs lib/aio_autosteer/SteerController against the SteerPlant models
+// (DC motor with backlash, orbital valve with dead time, Keya with RPM
+// feedback) through SimMotorDriver, the same way AutosteerProcessor drives
+// a real motor: WAS counts in through the 1kHz analog scan (SimAnalogSource),
+// the ADProcessor WAS filter and calibration, the
+// minPWM offset and highPWM clamp on the way out, CAN/serial commands at
+// 50Hz. Each gain set runs at 100, 200 and 500Hz on three scenarios:
+//
+//     step    10 deg target step
+//     ramp    5 deg/s target ramp (AgOpenGPS sends targets at 10Hz)
+//     line    vehicle model at 2.5 m/s acquiring a line 1 m to the side
+//
+// and reports rise time, overshoot, settling, steady-state error, ramp and
+// cross-track RMS, and the CPU time of one loop tick (sense, compute,
+// actuate, without the plant). Use --csv to keep results for comparing
+// firmware versions.
+//
+// Build and run from the repo root:
+//     g++ -O2 -Itools/host -Ilib/aio_autosteer -o steer_bench tools/steer_bench.cpp
+//         lib/aio_autosteer/SteerController.cpp lib/aio_autosteer/SteerPlant.cpp
+//         lib/aio_autosteer/AnalogScan.cpp lib/aio_autosteer/AnalogFilter.cpp
+//     ./steer_bench [--csv]
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include "AnalogFilter.h"
+#include "AnalogScan.h"
+#include "SimAnalogSource.h"
+#include "SimMotorDriver.h"
+#include "SteerController.h"
+#include "SteerPlant.h"
+
+namespace {
+
+constexpr float SIM_DT = 0.0005f;           // Plant integration step (2kHz)
+constexpr uint32_t SIM_DT_US = 500;
+constexpr uint32_t SCAN_PERIOD_US = 1000;   // ADProcessor background scan
+constexpr uint8_t WAS_PIN = 0;
+constexpr uint8_t WAS_CHANNEL = 0;
+constexpr int MOTOR_TX_RATE_HZ = 50;        // Matches AutosteerProcessor
+constexpr float HIGH_PWM = 180.0f;
+constexpr float MIN_PWM = 10.0f;
+constexpr int16_t WAS_OFFSET = 0;
+constexpr float WAS_COUNTS_PER_DEGREE = 30.0f;
+constexpr float WHEELBASE = 2.5f;           // WheelAngleFusion default
+constexpr float LINE_SPEED = 2.5f;          // m/s
+constexpr float LINE_OFFSET = 1.0f;         // m
+
+struct GainSet {
+    const char* name;
+    float kp, ki, kd, kff;
+};
+
+const GainSet GAINS[] = {
+    {"P (default)", 20.0f, 0.0f, 0.0f, 0.0f},
+    {"PI", 20.0f, 15.0f, 0.0f, 0.0f},
+    {"PID", 20.0f, 15.0f, 1.0f, 0.0f},
+    {"PID+FF", 20.0f, 15.0f, 1.0f, 6.0f},
+};
+
+const int RATES[] = {100, 200, 500};
+
+enum class Scenario { STEP, RAMP, LINE };
+
+struct Result {
+    float riseSec = -1.0f;      // 10% to 90% of the step
+    float overshootPct = 0.0f;
+    float settleSec = -1.0f;    // Last time outside 0.5 deg
+    float steadyError = 0.0f;   // Mean |angle error| over the last second
+    float rampRms = 0.0f;       // RMS angle error while following the ramp
+    float lineRms = 0.0f;       // RMS cross-track error once on the line
+    float lineSettleSec = -1.0f;// Last time more than 0.1 m off the line
+    double tickNs = 0.0;        // Sense + compute + actuate per tick
+};
+
+// The plant's WAS counts go to the simulated ADC; the "sense" stage reads
+// them back from the scan ring like ADProcessor::sampleWAS()
+SimAnalogSource adcSource;
+AnalogScan scan;
+uint32_t simUs = 0;
+
+void wasSink(int16_t raw, void* context) {
+    (void)context;
+    adcSource.setValue(WAS_PIN, (uint16_t)raw);
+}
+
+// ADProcessor::getWASAngle() without the logging
+float wasAngle(float raw) {
+    return (raw - 2048.0f - WAS_OFFSET) / WAS_COUNTS_PER_DEGREE;
+}
+
+// AutosteerProcessor::updateMotorControl() PWM shaping
+int16_t shapePWM(float out) {
+    int16_t pwm = (int16_t)out;
+    if (pwm < 0) pwm -= (int16_t)MIN_PWM;
+    else if (pwm > 0) pwm += (int16_t)MIN_PWM;
+    if (pwm > HIGH_PWM) pwm = (int16_t)HIGH_PWM;
+    if (pwm < -HIGH_PWM) pwm = -(int16_t)HIGH_PWM;
+    return pwm;
+}
+
+// Targets change at 10Hz like PGN 254 from AgOpenGPS
+float scriptedTarget(Scenario scenario, float t) {
+    float tq = std::floor(t * 10.0f) / 10.0f;
+    if (scenario == Scenario::STEP) {
+        return tq >= 0.5f ? 10.0f : 0.0f;
+    }
+    if (tq < 0.5f) return 0.0f;
+    if (tq < 3.5f) return (tq - 0.5f) * 5.0f;
+    return 15.0f;
+}
+
+// Stanley-style guidance towards the line x = 0, heading north
+float lineTarget(const VehicleModel& vehicle) {
+    float headingError = vehicle.getHeading();
+    if (headingError > 180.0f) headingError -= 360.0f;
+    float xte = vehicle.getX();
+    float target = -headingError - std::atan2(1.5f * xte, LINE_SPEED) * 180.0f / (float)M_PI;
+    if (target > 30.0f) target = 30.0f;
+    if (target < -30.0f) target = -30.0f;
+    return target;
+}
+
+Result run(SteerPlant& plant, MotorDriverType type, const GainSet& gains, int rateHz, Scenario scenario) {
+    const float duration = scenario == Scenario::STEP ? 5.0f : (scenario == Scenario::RAMP ? 6.0f : 15.0f);
+    const int simPerTick = (int)std::lround(1.0f / rateHz / SIM_DT);
+    const int txDivider = rateHz / MOTOR_TX_RATE_HZ;
+    const float dt = 1.0f / rateHz;
+
+    plant.reset();
+    SimMotorDriver driver(plant, type);
+    driver.setWASCalibration(WAS_OFFSET, WAS_COUNTS_PER_DEGREE, false);
+    driver.setWASSink(wasSink, nullptr);
+    driver.init();
+    driver.enable(true);
+    driver.advance(0.0f);
+    scan.setChannel(WAS_CHANNEL, WAS_PIN, true);
+    scan.start(&adcSource, SCAN_PERIOD_US);
+    uint32_t wasTail = scan.ring(WAS_CHANNEL).getHead();
+    float wasFiltered = 2048.0f;
+    AnalogFilterConfig wasFilterConfig;     // ADProcessor defaults
+    wasFilterConfig.decimation = 2;
+    wasFilterConfig.average = 2;
+    AnalogFilter wasFilter(wasFilterConfig);
+
+    VehicleModel vehicle(WHEELBASE);
+    vehicle.reset(LINE_OFFSET, 0.0f, 0.0f);
+
+    SteerController controller;
+    SteerController::Params params;
+    params.kp = gains.kp;
+    params.ki = gains.ki;
+    params.kd = gains.kd;
+    params.kff = gains.kff;
+    params.outputLimit = HIGH_PWM;
+
+    Result r;
+    float target = 0.0f;
+    float lastTargetTime = 0.0f;
+    float targetRate = 0.0f;
+    float t10 = -1.0f;
+    float peak = 0.0f;
+    float lastOutside = 0.0f;
+    float lastOffLine = 0.0f;
+    double steadySum = 0.0, rampSq = 0.0, lineSq = 0.0;
+    int steadyCount = 0, rampCount = 0, lineCount = 0;
+    int motorTxTick = 0;
+    std::chrono::steady_clock::duration tickTime{0};
+
+    const int ticks = (int)(duration * rateHz);
+    for (int tick = 0; tick < ticks; tick++) {
+        const float t = tick * dt;
+
+        // New target from "AgOpenGPS" every 100ms
+        if (tick % (rateHz / 10) == 0) {
+            float newTarget = scenario == Scenario::LINE ? lineTarget(vehicle) : scriptedTarget(scenario, t);
+            targetRate = tick > 0 ? (newTarget - target) / (t - lastTargetTime) : 0.0f;
+            target = newTarget;
+            lastTargetTime = t;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        // Sense: scans since the last tick through the WAS filter, counts to degrees
+        AnalogSample samples[AnalogRing::SIZE];
+        uint8_t count = scan.ring(WAS_CHANNEL).readSince(wasTail, samples, AnalogRing::SIZE);
+        for (uint8_t i = 0; i < count; i++) {
+            if (wasFilter.push(samples[i].value)) {
+                wasFiltered = wasFilter.outputCounts();
+            }
+        }
+        float angle = wasAngle(wasFiltered);
+        // Compute: control law and shaping
+        float out = controller.update(params, target, targetRate, angle, dt);
+        driver.setPWM(shapePWM(out));
+        // Actuate: CAN/serial transmit at 50Hz
+        if (++motorTxTick >= txDivider) {
+            motorTxTick = 0;
+            driver.process();
+        }
+        tickTime += std::chrono::steady_clock::now() - start;
+
+        for (int i = 0; i < simPerTick; i++) {
+            driver.advance(SIM_DT);
+            simUs += SIM_DT_US;
+            adcSource.advanceTo(simUs);
+            vehicle.step(scenario == Scenario::LINE ? LINE_SPEED : 0.0f, plant.getWheelAngle(), SIM_DT);
+        }
+
+        float actual = plant.getWheelAngle();
+        float err = actual - target;
+        if (scenario == Scenario::STEP && t >= 0.5f) {
+            if (t10 < 0.0f && actual >= 1.0f) t10 = t;
+            if (r.riseSec < 0.0f && actual >= 9.0f) r.riseSec = t - t10;
+            if (actual > peak) peak = actual;
+            if (std::fabs(err) > 0.5f) lastOutside = t;
+        }
+        if (scenario == Scenario::RAMP && t >= 0.5f && t < 3.5f) {
+            rampSq += err * err;
+            rampCount++;
+        }
+        if (scenario == Scenario::LINE) {
+            if (std::fabs(vehicle.getX()) > 0.1f) lastOffLine = t;
+            if (t >= duration - 5.0f) {
+                lineSq += vehicle.getX() * vehicle.getX();
+                lineCount++;
+            }
+        } else if (t >= duration - 1.0f) {
+            steadySum += std::fabs(err);
+            steadyCount++;
+        }
+    }
+
+    if (scenario == Scenario::STEP) {
+        r.overshootPct = peak > 10.0f ? (peak - 10.0f) * 10.0f : 0.0f;
+        r.settleSec = lastOutside - 0.5f + dt;
+    }
+    if (scenario == Scenario::LINE) {
+        r.lineSettleSec = lastOffLine + dt;
+        r.lineRms = lineCount ? (float)std::sqrt(lineSq / lineCount) : 0.0f;
+    }
+    r.steadyError = steadyCount ? (float)(steadySum / steadyCount) : 0.0f;
+    r.rampRms = rampCount ? (float)std::sqrt(rampSq / rampCount) : 0.0f;
+    r.tickNs = std::chrono::duration<double, std::nano>(tickTime).count() / ticks;
+    return r;
+}
+
+void printValue(float v, const char* fmt) {
+    if (v < 0.0f) {
+        printf("%8s", "-");
+    } else {
+        printf(fmt, v);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool csv = argc > 1 && strcmp(argv[1], "--csv") == 0;
+
+    DCMotorPlant motor;
+    OrbitalValvePlant valve;
+    KeyaPlant keya;
+    struct {
+        SteerPlant* plant;
+        MotorDriverType type;
+    } plants[] = {
+        {&motor, MotorDriverType::CYTRON_MD30C},
+        {&valve, MotorDriverType::DANFOSS},
+        {&keya, MotorDriverType::KEYA_CAN},
+    };
+
+    if (csv) {
+        printf("plant,gains,rate_hz,rise_s,overshoot_pct,settle_s,steady_deg,ramp_rms_deg,"
+               "line_rms_m,line_settle_s,tick_ns\n");
+    }
+
+    for (auto& p : plants) {
+        if (!csv) {
+            printf("\nPlant: %s\n", p.plant->getName());
+            printf("%-12s %4s | %8s %8s %8s %8s | %8s | %8s %8s | %8s\n", "gains", "Hz",
+                   "rise s", "over %", "settle s", "ss deg", "ramp rms", "xte rms", "line s", "tick ns");
+        }
+        for (const GainSet& gains : GAINS) {
+            for (int rate : RATES) {
+                Result step = run(*p.plant, p.type, gains, rate, Scenario::STEP);
+                Result ramp = run(*p.plant, p.type, gains, rate, Scenario::RAMP);
+                Result line = run(*p.plant, p.type, gains, rate, Scenario::LINE);
+                double tickNs = (step.tickNs + ramp.tickNs + line.tickNs) / 3.0;
+
+                if (csv) {
+                    printf("%s,%s,%d,%.3f,%.1f,%.3f,%.3f,%.3f,%.3f,%.2f,%.1f\n", p.plant->getName(), gains.name,
+                           rate, step.riseSec, step.overshootPct, step.settleSec, step.steadyError,
+                           ramp.rampRms, line.lineRms, line.lineSettleSec, tickNs);
+                    continue;
+                }
+                printf("%-12s %4d | ", gains.name, rate);
+                printValue(step.riseSec, "%8.3f");
+                printf(" %8.1f ", step.overshootPct);
+                printValue(step.settleSec, "%8.3f");
+                printf(" %8.3f | %8.3f | %8.3f %8.2f | %8.1f\n", step.steadyError, ramp.rampRms,
+                       line.lineRms, line.lineSettleSec, tickNs);
+            }
+        }
+    }
+    return 0;
+}
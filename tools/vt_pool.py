@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+Builds the ISOBUS VT object pool for lib/aio_isobus and writes it as a
+PackBits-compressed PROGMEM array (VTObjectPool.h).
+
+The pool uses VT version 3 objects only and is laid out for a 200x200 data
+mask, the smallest a VT may report, so it needs no scaling:
+
+    Working set 0       designator "AiO"
+    Data mask 1000      title, steer angle, fix quality, 16 section boxes
+    Output number 3000  steer angle, value = angle * 10 + STEER_OFFSET
+    Output number 3001  fix quality (GGA code)
+    Fill attrs 4100+n   section n colour, switched with Change Attribute
+
+VTClient streams the compressed bytes straight from flash and hashes them
+for the version label, so any change here yields a fresh upload on the VT.
+
+Usage:
+    python3 tools/vt_pool.py                  # writes lib/aio_isobus/VTObjectPool.h
+    python3 tools/vt_pool.py --out other.h
+"""
+
+import argparse
+import os
+import struct
+
+# Object types (ISO 11783-6 Annex B)
+WORKING_SET = 0
+DATA_MASK = 1
+OUTPUT_STRING = 11
+OUTPUT_NUMBER = 12
+RECTANGLE = 14
+FONT_ATTRIBUTES = 23
+LINE_ATTRIBUTES = 24
+FILL_ATTRIBUTES = 25
+
+NONE = 0xFFFF
+
+# Standard palette
+BLACK, WHITE, GREEN, GREY, YELLOW = 0, 1, 2, 8, 14
+
+# Font sizes
+FONT_8X12, FONT_16X24 = 2, 5
+
+ID_WORKING_SET = 0
+ID_DATA_MASK = 1000
+ID_TITLE, ID_LABEL_STEER, ID_LABEL_FIX, ID_LABEL_SECTIONS, ID_DESIGNATOR = 2000, 2001, 2002, 2003, 2004
+ID_STEER_ANGLE, ID_FIX_QUALITY = 3000, 3001
+ID_SECTION_RECT, ID_SECTION_FILL = 4000, 4100
+ID_FONT_SMALL, ID_FONT_LARGE = 5000, 5001
+ID_LINE = 6000
+
+SECTIONS = 16
+STEER_OFFSET = 1000
+SECTION_ON, SECTION_OFF = GREEN, GREY
+
+
+def header(obj_id, obj_type):
+    return struct.pack("<HB", obj_id, obj_type)
+
+
+def children(objs):
+    return b"".join(struct.pack("<Hhh", i, x, y) for i, x, y in objs)
+
+
+def working_set(obj_id, mask, objs):
+    return (header(obj_id, WORKING_SET) + struct.pack("<BBHBBB", BLACK, 1, mask, len(objs), 0, 1)
+            + children(objs) + b"en")
+
+
+def data_mask(obj_id, objs):
+    return header(obj_id, DATA_MASK) + struct.pack("<BHBB", BLACK, NONE, len(objs), 0) + children(objs)
+
+
+def output_string(obj_id, w, h, font, text):
+    value = text.encode("ascii")
+    return (header(obj_id, OUTPUT_STRING)
+            + struct.pack("<HHBHBHBH", w, h, BLACK, font, 0, NONE, 0, len(value)) + value + b"\x00")
+
+
+def output_number(obj_id, w, h, font, value, offset, scale, decimals):
+    return (header(obj_id, OUTPUT_NUMBER)
+            + struct.pack("<HHBHBHIifBBBB", w, h, BLACK, font, 0, NONE, value, offset, scale,
+                          decimals, 0, 2, 0))
+
+
+def rectangle(obj_id, line, w, h, fill):
+    return header(obj_id, RECTANGLE) + struct.pack("<HHHBHB", line, w, h, 0, fill, 0)
+
+
+def font_attributes(obj_id, colour, size):
+    return header(obj_id, FONT_ATTRIBUTES) + struct.pack("<BBBBB", colour, size, 0, 0, 0)
+
+
+def line_attributes(obj_id, colour, width):
+    return header(obj_id, LINE_ATTRIBUTES) + struct.pack("<BBHB", colour, width, 0xFFFF, 0)
+
+
+def fill_attributes(obj_id, colour):
+    return header(obj_id, FILL_ATTRIBUTES) + struct.pack("<BBHB", 2, colour, NONE, 0)
+
+
+def build_pool():
+    mask_children = [
+        (ID_TITLE, 0, 0),
+        (ID_LABEL_STEER, 4, 32),
+        (ID_STEER_ANGLE, 90, 24),
+        (ID_LABEL_FIX, 4, 72),
+        (ID_FIX_QUALITY, 90, 64),
+        (ID_LABEL_SECTIONS, 4, 108),
+    ]
+    mask_children += [(ID_SECTION_RECT + n, 4 + 12 * n, 128) for n in range(SECTIONS)]
+
+    objects = [
+        working_set(ID_WORKING_SET, ID_DATA_MASK, [(ID_DESIGNATOR, 0, 0)]),
+        data_mask(ID_DATA_MASK, mask_children),
+        output_string(ID_DESIGNATOR, 60, 24, ID_FONT_SMALL, "AiO"),
+        output_string(ID_TITLE, 200, 16, ID_FONT_SMALL, "AiO New Dawn"),
+        output_string(ID_LABEL_STEER, 80, 16, ID_FONT_SMALL, "Steer"),
+        output_string(ID_LABEL_FIX, 80, 16, ID_FONT_SMALL, "Fix"),
+        output_string(ID_LABEL_SECTIONS, 192, 16, ID_FONT_SMALL, "Sections"),
+        output_number(ID_STEER_ANGLE, 106, 32, ID_FONT_LARGE, STEER_OFFSET, -STEER_OFFSET, 0.1, 1),
+        output_number(ID_FIX_QUALITY, 106, 32, ID_FONT_LARGE, 0, 0, 1.0, 0),
+        font_attributes(ID_FONT_SMALL, WHITE, FONT_8X12),
+        font_attributes(ID_FONT_LARGE, YELLOW, FONT_16X24),
+        line_attributes(ID_LINE, WHITE, 1),
+    ]
+    for n in range(SECTIONS):
+        objects.append(rectangle(ID_SECTION_RECT + n, ID_LINE, 10, 40, ID_SECTION_FILL + n))
+        objects.append(fill_attributes(ID_SECTION_FILL + n, SECTION_OFF))
+    return b"".join(objects)
+
+
+def packbits(data):
+    """PackBits: n < 128 -> n+1 literal bytes follow, n > 128 -> next byte repeated 257-n times"""
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        run = 1
+        while i + run < len(data) and run < 128 and data[i + run] == data[i]:
+            run += 1
+        if run >= 3:
+            out += bytes([257 - run, data[i]])
+            i += run
+            continue
+        start = i
+        while i < len(data) and i - start < 128:
+            if i + 2 < len(data) and data[i] == data[i + 1] == data[i + 2]:
+                break
+            i += 1
+        out.append(i - start - 1)
+        out += data[start:i]
+    return bytes(out)
+
+
+def unpackbits(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        n = data[i]
+        i += 1
+        if n < 128:
+            out += data[i:i + n + 1]
+            i += n + 1
+        elif n > 128:
+            out += bytes([data[i]]) * (257 - n)
+            i += 1
+    return bytes(out)
+
+
+def write_header(path, pool, packed):
+    rows = []
+    for i in range(0, len(packed), 16):
+        rows.append("    " + ", ".join("0x%02X" % b for b in packed[i:i + 16]) + ",")
+
+    with open(path, "w", newline="\n") as f:
+        f.write("// VTObjectPool.h - Generated by tools/vt_pool.py, do not edit\n")
+        f.write("// ISOBUS VT object pool (version 3 objects, 200x200 data mask), PackBits-compressed\n")
+        f.write("#ifndef VT_OBJECT_POOL_H\n#define VT_OBJECT_POOL_H\n\n#include <Arduino.h>\n\n")
+        f.write("constexpr uint32_t VT_POOL_SIZE = %d;\n" % len(pool))
+        f.write("constexpr uint32_t VT_POOL_PACKED_SIZE = %d;\n\n" % len(packed))
+        f.write("static const uint8_t VT_POOL_PACKED[VT_POOL_PACKED_SIZE] PROGMEM = {\n")
+        f.write("\n".join(rows) + "\n};\n\n")
+        f.write("// Objects updated at runtime\n")
+        f.write("constexpr uint16_t VT_OBJ_STEER_ANGLE = %d;       // Value = angle * 10 + VT_STEER_ANGLE_OFFSET\n" % ID_STEER_ANGLE)
+        f.write("constexpr uint16_t VT_OBJ_FIX_QUALITY = %d;\n" % ID_FIX_QUALITY)
+        f.write("constexpr uint16_t VT_OBJ_SECTION_FILL_FIRST = %d;\n" % ID_SECTION_FILL)
+        f.write("constexpr uint8_t VT_SECTION_COUNT = %d;\n" % SECTIONS)
+        f.write("constexpr int32_t VT_STEER_ANGLE_OFFSET = %d;\n" % STEER_OFFSET)
+        f.write("constexpr uint8_t VT_COLOUR_SECTION_ON = %d;\n" % SECTION_ON)
+        f.write("constexpr uint8_t VT_COLOUR_SECTION_OFF = %d;\n\n" % SECTION_OFF)
+        f.write("#endif // VT_OBJECT_POOL_H\n")
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    parser = argparse.ArgumentParser(description="Generate the VT object pool header")
+    parser.add_argument("--out", default=os.path.join(root, "lib", "aio_isobus", "VTObjectPool.h"))
+    args = parser.parse_args()
+
+    pool = build_pool()
+    packed = packbits(pool)
+    assert unpackbits(packed) == pool
+    write_header(args.out, pool, packed)
+    print("%s: pool %d bytes, packed %d bytes" % (args.out, len(pool), len(packed)))
+
+
+if __name__ == "__main__":
+    main()